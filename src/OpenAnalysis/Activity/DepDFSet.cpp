@@ -20,32 +20,123 @@ namespace OA {
 
 static bool debug = false;
 
+unsigned int DepLocTable::idOf(OA_ptr<Location> loc)
+{
+    std::map<OA_ptr<Location>,unsigned int>::const_iterator 
+        found = mIds.find(loc);
+    if (found != mIds.end()) {
+        return found->second;
+    }
+    unsigned int id = mLocs.size();
+    mIds[loc] = id;
+    mLocs.push_back(loc);
+
+    // same buckets as LocDFSet::addToMap
+    OA_ptr<Location> baseLoc = loc->getBaseLoc();
+    if (baseLoc->isaNamed()) {
+        OA_ptr<NamedLoc> namedLoc = baseLoc.convert<NamedLoc>();
+        associateWithBaseHandle(namedLoc->getSymHandle(), id);
+
+        OA_ptr<SymHandleIterator> symIter = namedLoc->getFullOverlapIter();
+        for ( ; symIter->isValid(); (*symIter)++ ) {
+            associateWithBaseHandle(symIter->current(), id);
+        }
+        symIter = namedLoc->getPartOverlapIter();
+        for ( ; symIter->isValid(); (*symIter)++ ) {
+            associateWithBaseHandle(symIter->current(), id);
+        }
+    } else if (baseLoc->isaUnnamed()) {
+        OA_ptr<UnnamedLoc> unnamedLoc = baseLoc.convert<UnnamedLoc>();
+        associateWithBaseHandle(unnamedLoc->getExprHandle(), id);
+    } else if (baseLoc->isaInvisible()) {
+        mInvisibleIds.push_back(id);
+    } else if (baseLoc->isaUnknown()) {
+        mUnknownIds.push_back(id);
+    }
+    return id;
+}
+
+void DepLocTable::associateWithBaseHandle(IRHandle baseHandle, unsigned int id)
+{
+    std::vector<unsigned int>& ids = mBaseToIds[baseHandle];
+    if (ids.empty() || ids.back() != id) {
+        ids.push_back(id);
+    }
+}
+
+int DepLocTable::findId(OA_ptr<Location> loc) const
+{
+    std::map<OA_ptr<Location>,unsigned int>::const_iterator 
+        found = mIds.find(loc);
+    return found == mIds.end() ? -1 : (int)found->second;
+}
+
+void DepLocTable::overlapping(OA_ptr<Location> loc, 
+                              const SparseBitVector& among,
+                              SparseBitVector& result) const
+{
+    if (loc->isaUnknown()) {
+        result.unionWith(among);
+        return;
+    }
+
+    std::vector<unsigned int>::const_iterator idIter;
+    for (idIter=mUnknownIds.begin(); idIter!=mUnknownIds.end(); idIter++) {
+        if (among.test(*idIter)) { result.set(*idIter); }
+    }
+
+    const std::vector<unsigned int>* candidates = 0;
+    OA_ptr<Location> baseLoc = loc->getBaseLoc();
+    IRHandle baseHandle(0);
+    if (baseLoc->isaNamed()) {
+        baseHandle = baseLoc.convert<NamedLoc>()->getSymHandle();
+    } else if (baseLoc->isaUnnamed()) {
+        baseHandle = baseLoc.convert<UnnamedLoc>()->getExprHandle();
+    } else if (baseLoc->isaInvisible()) {
+        candidates = &mInvisibleIds;
+    }
+    if (baseHandle != IRHandle(0)) {
+        std::map<IRHandle,std::vector<unsigned int> >::const_iterator
+            found = mBaseToIds.find(baseHandle);
+        if (found != mBaseToIds.end()) { candidates = &found->second; }
+    }
+    if (candidates == 0) { return; }
+
+    for (idIter=candidates->begin(); idIter!=candidates->end(); idIter++) {
+        if (among.test(*idIter) && loc->mayOverlap(*mLocs[*idIter])) {
+            result.set(*idIter);
+        }
+    }
+}
+
 //! default constructor
 DepDFSet::DepDFSet() //: mMakeImplicitExplicitMemoized(false)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_DepDFSet:ALL", debug);
-    mImplicitRemoves = new DataFlow::LocDFSet;
-    mUses = new DataFlow::LocDFSet;
-    mDefs = new DataFlow::LocDFSet;
+    mLocTable = new DepLocTable;
+}
+
+DepDFSet::DepDFSet(OA_ptr<DepLocTable> locTable) : mLocTable(locTable)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_DepDFSet:ALL", debug);
 }
 
 //! copy constructor
-DepDFSet::DepDFSet(const DepDFSet &other) //: mMakeImplicitExplicitMemoized(false)
+DepDFSet::DepDFSet(const DepDFSet &other)
+    : mImplicitRemoves(other.mImplicitRemoves),
+      mLocTable(other.mLocTable),
+      mUseToDefs(other.mUseToDefs), mDefToUses(other.mDefToUses),
+      mUses(other.mUses), mDefs(other.mDefs)
 { 
-    mImplicitRemoves = other.mImplicitRemoves;
-    mUseToDefsMap = other.mUseToDefsMap;
-    mDefToUsesMap = other.mDefToUsesMap;
-    mDefs = other.mDefs;
-    mUses = other.mUses;
 }
 
 //! assignment
 DepDFSet& DepDFSet::operator=(const DepDFSet &other)
 {
-    //mMakeImplicitExplicitMemoized = other.mMakeImplicitExplicitMemoized;
+    mLocTable = other.mLocTable;
     mImplicitRemoves = other.mImplicitRemoves;
-    mUseToDefsMap = other.mUseToDefsMap;
-    mDefToUsesMap = other.mDefToUsesMap;
+    mUseToDefs = other.mUseToDefs;
+    mDefToUses = other.mDefToUses;
     mDefs = other.mDefs;
     mUses = other.mUses;
     return *this;
@@ -64,7 +155,9 @@ OA_ptr<DataFlow::DataFlowSet> DepDFSet::clone()
 
 bool DepDFSet::operator==(DataFlow::DataFlowSet &other) const
 { 
-    DepDFSet& recastOther = dynamic_cast<DepDFSet&>(other);
+    DepDFSet renumbered(mLocTable);
+    const DepDFSet& recastOther 
+        = inTable(dynamic_cast<DepDFSet&>(other), renumbered);
     bool retval = true;
 
     // make sure that each have their implicits made explicit
@@ -75,8 +168,7 @@ bool DepDFSet::operator==(DataFlow::DataFlowSet &other) const
     //recastOther.makeImplicitExplicit();
 
     if (mImplicitRemoves == recastOther.mImplicitRemoves
-        && mUseToDefsMap == recastOther.mUseToDefsMap
-        && mDefToUsesMap == recastOther.mDefToUsesMap) 
+        && mUseToDefs == recastOther.mUseToDefs) 
     {
         retval = true;
     } else {
@@ -201,37 +293,14 @@ OA_ptr<LocIterator> DepDFSet::getDefsIterator(const OA_ptr<Location> use) const
     OA_ptr<DataFlow::LocDFSet> retSet;
     retSet = new DataFlow::LocDFSet();
 
-    // get iterator over uses the given location overlaps with
-    OA_ptr<LocIterator> useOverlapIter
-        = mUses->getOverlapLocIterator(use);
-    for ( ; useOverlapIter->isValid(); (*useOverlapIter)++ ) {
-        OA_ptr<Location> loc = useOverlapIter->current();
-
-        // iterator over associated defs
-        LocToLocDFSetMap::const_iterator pos = mUseToDefsMap.find(loc);
-        if (pos!=mUseToDefsMap.end()) {
-            OA_ptr<LocIterator> locIter = pos->second->getLocIterator();
-            for ( ; locIter->isValid(); (*locIter)++ ) {
-                retSet->insert(locIter->current());
-            }
-        }
-    }
 
-    // loop over sets that the use 
-    /*
-    LocToLocDFSetMap::const_iterator mapIter;
-    for (mapIter=mUseToDefsMap.begin();
-         mapIter!=mUseToDefsMap.end(); mapIter++ )
-    {
-        OA_ptr<Location> depuse = mapIter->first;
-        if (depuse->mayOverlap(*use)) {
-            OA_ptr<LocIterator> locIter = mapIter->second->getLocIterator();
-            for ( ; locIter->isValid(); (*locIter)++ ) {
-                retSet->insert(locIter->current());
-            }
-        }
+    // defs associated with the uses the given location overlaps with
+    SparseBitVector defs;
+    overlapDefs(use, defs);
+    SparseBitVectorIterator defIter(defs);
+    for ( ; defIter.isValid(); ++defIter) {
+        retSet->insert(mLocTable->locOf(defIter.current()));
     }
-    */
 
     // see if reflexive dep for use loc should be included,
     // only reason why it wouldn't is if use
@@ -239,7 +308,8 @@ OA_ptr<LocIterator> DepDFSet::getDefsIterator(const OA_ptr<Location> use) const
     // FIXME: ok could put hasMustOverlapLoc, but for now going with 
     // conservative assumption which means equivalenced symbols will get
     // short shrifted. insertDep if use==def makes same assumption.
-    if (!mImplicitRemoves->hasLoc(use)) {
+    int id = mLocTable->findId(use);
+    if (id < 0 || !mImplicitRemoves.test(id)) {
         retSet->insert(use);
     }
 
@@ -248,54 +318,26 @@ OA_ptr<LocIterator> DepDFSet::getDefsIterator(const OA_ptr<Location> use) const
     retval = new DataFlow::LocDFSetIterator(*retSet);
     return retval;
 }
-  
+
 OA_ptr<LocIterator> DepDFSet::getUsesIterator(OA_ptr<Location> def) const
 {
     OA_ptr<DataFlow::LocDFSet> retSet;
     retSet = new DataFlow::LocDFSet();
 
-    // get iterator over uses the given location overlaps with
-    OA_ptr<LocIterator> defOverlapIter
-        = mDefs->getOverlapLocIterator(def);
-    for ( ; defOverlapIter->isValid(); (*defOverlapIter)++ ) {
-        OA_ptr<Location> loc = defOverlapIter->current();
-        if (debug) {
-            std::cout << "getUsesIterator: loc = ";
-            loc->dump(std::cout);
-        }
-
-        // iterator over associated deps
-        LocToLocDFSetMap::const_iterator pos = mDefToUsesMap.find(loc);
-        if (pos!=mDefToUsesMap.end()) {
-            OA_ptr<LocIterator> locIter = pos->second->getLocIterator();
-            for ( ; locIter->isValid(); (*locIter)++ ) {
-                retSet->insert(locIter->current());
-            }
-        }
-    }
 
-    /*
-    LocToLocDFSetMap::const_iterator mapIter;
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
-    {
-        OA_ptr<Location> depdef = mapIter->first;
-        if (depdef->mayOverlap(*def)) {
-            OA_ptr<LocIterator> locIter = mapIter->second->getLocIterator();
-            for ( ; locIter->isValid(); (*locIter)++ ) {
-                retSet->insert(locIter->current());
-            }
-        }
+    // uses associated with the defs the given location overlaps with
+    SparseBitVector uses;
+    overlapUses(def, uses);
+    SparseBitVectorIterator useIter(uses);
+    for ( ; useIter.isValid(); ++useIter) {
+        retSet->insert(mLocTable->locOf(useIter.current()));
     }
-    */
 
     // see if reflexive dep for def loc should be included,
     // only reason why it wouldn't is if def
     // is in the ImplicitRemoves
-    // FIXME: ok could put hasMustOverlapLoc, but for now going with 
-    // conservative assumption which means equivalenced symbols will get
-    // short shrifted
-    if (!mImplicitRemoves->hasLoc(def)) {
+    int id = mLocTable->findId(def);
+    if (id < 0 || !mImplicitRemoves.test(id)) {
         retSet->insert(def);
     }
 
@@ -304,52 +346,57 @@ OA_ptr<LocIterator> DepDFSet::getUsesIterator(OA_ptr<Location> def) const
     return retval;
 }
 
+void DepDFSet::overlapDefs(OA_ptr<Location> loc, SparseBitVector& result) const
+{
+    SparseBitVector uses;
+    mLocTable->overlapping(loc, mUses, uses);
+    SparseBitVectorIterator useIter(uses);
+    for ( ; useIter.isValid(); ++useIter) {
+        result.unionWith(mUseToDefs.find(useIter.current())->second);
+    }
+}
+
+void DepDFSet::overlapUses(OA_ptr<Location> loc, SparseBitVector& result) const
+{
+    SparseBitVector defs;
+    mLocTable->overlapping(loc, mDefs, defs);
+    SparseBitVectorIterator defIter(defs);
+    for ( ; defIter.isValid(); ++defIter) {
+        result.unionWith(mDefToUses.find(defIter.current())->second);
+    }
+}
+
 /*!
    Does a union of all dep pairs and stores the result in this.
 */
 DepDFSet& DepDFSet::setUnion(DataFlow::DataFlowSet &other)
 {
-    DepDFSet& recastOther = dynamic_cast<DepDFSet&>(other);
+    DepDFSet renumbered(mLocTable);
+    const DepDFSet& recastOther 
+        = inTable(dynamic_cast<DepDFSet&>(other), renumbered);
     if (debug) {
         std::cout << "DepDFSet::setUnion" << std::endl;
     }
 
-    // for each use in other
-    LocToLocDFSetMap::const_iterator mapIter;
-    for (mapIter=recastOther.mUseToDefsMap.begin();
-         mapIter!=recastOther.mUseToDefsMap.end(); mapIter++ )
+    // union each row of the matrix in both directions
+    BitMatrix::const_iterator rowIter;
+    for (rowIter=recastOther.mUseToDefs.begin();
+         rowIter!=recastOther.mUseToDefs.end(); rowIter++ )
     {
-        OA_ptr<Location> use = mapIter->first;
-
-        // if this use is already in our map then just union it into
-        // the associated defs location set
-        // if not then will have to make a new LocDFSet and
-        // then essentially do the same thing
-        if (mUseToDefsMap[use].ptrEqual(0)) {
-            mUseToDefsMap[use] = new DataFlow::LocDFSet;
-        }
-        *(mUseToDefsMap[use]) 
-            = mUseToDefsMap[use]->setUnion(*(mapIter->second));
+        mUseToDefs[rowIter->first].unionWith(rowIter->second);
     }
-    
-    // for each def in other
-    for (mapIter=recastOther.mDefToUsesMap.begin();
-         mapIter!=recastOther.mDefToUsesMap.end(); mapIter++ )
+    for (rowIter=recastOther.mDefToUses.begin();
+         rowIter!=recastOther.mDefToUses.end(); rowIter++ )
     {
-        OA_ptr<Location> def = mapIter->first;
-
-        if (mDefToUsesMap[def].ptrEqual(0)) {
-            mDefToUsesMap[def] = new DataFlow::LocDFSet;
-        }
-        mDefToUsesMap[def]->setUnion(*(mapIter->second));
+        mDefToUses[rowIter->first].unionWith(rowIter->second);
     }
 
     // take on all of other's implicitRemoves that we already have
-    mImplicitRemoves->setIntersect(*(recastOther.mImplicitRemoves));
+    mImplicitRemoves.intersectWith(recastOther.mImplicitRemoves);
 
     // union the uses and defs sets
-    mUses->setUnion(*(recastOther.mUses));
-    mDefs->setUnion(*(recastOther.mDefs));
+    mUses.unionWith(recastOther.mUses);
+    mDefs.unionWith(recastOther.mDefs);
 
     return *this;
 }
@@ -359,7 +406,15 @@ DepDFSet& DepDFSet::setUnion(DataFlow::DataFlowSet &other)
 //! has been killed due to a must def
 bool DepDFSet::isImplicitRemoved(const OA_ptr<Location> loc) const
 {
-    return mImplicitRemoves->hasLoc(loc);
+    int id = mLocTable->findId(loc);
+    return id >= 0 && mImplicitRemoves.test(id);
+}
+
+OA_ptr<LocIterator> DepDFSet::getImplicitRemovesIterator() const
+{
+    OA_ptr<DataFlow::LocDFSetIterator> retval;
+    retval = new DataFlow::LocDFSetIterator(*getLocSet(mImplicitRemoves));
+    return retval;
 }
 
 /*!
@@ -382,7 +437,9 @@ unless the given parameters overlap with something in the implicitRemoves list.
 */
 DepDFSet& DepDFSet::compose(DataFlow::DataFlowSet &other)
 {
-    DepDFSet& recastOther = dynamic_cast<DepDFSet&>(other);
+    DepDFSet renumbered(mLocTable);
+    const DepDFSet& recastOther 
+        = inTable(dynamic_cast<DepDFSet&>(other), renumbered);
     if (debug) {
         std::cout << "DepDFSet::compose" << std::endl;
         std::cout << "\t*this = ";
@@ -391,127 +448,72 @@ DepDFSet& DepDFSet::compose(DataFlow::DataFlowSet &other)
         recastOther.dump(std::cout);
     }
     
-    OA_ptr<DepDFSet> tempDFSet;
-    tempDFSet = new DepDFSet;
+    DepDFSet result(mLocTable);
     
-    // have to do these before do insertDeps because could be inserting
-    // a dep that will take things out of the mImplicitRemoves set
-    tempDFSet->mImplicitRemoves->setUnion(*(mImplicitRemoves)); 
-    tempDFSet->mImplicitRemoves->setUnion(*(recastOther.mImplicitRemoves)); 
+    // have to do these before the reflexive pairs are taken out below
+    // because they take things out of the mImplicitRemoves set
+    result.mImplicitRemoves = mImplicitRemoves;
+    result.mImplicitRemoves.unionWith(recastOther.mImplicitRemoves);
 
-    // iterate over deps in this keying off the def
-    // see if the def overlaps with anything in recastOther
-    LocToLocDFSetMap::const_iterator mapIter;
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
+    // defs of the composition for each use, including reflexive pairs
+    BitMatrix product;
     {
-        OA_ptr<Location> def1 = mapIter->first;
-        if (debug) {
-            std::cout << "def1 = "; def1->dump(std::cout); 
-            std::cout << std::endl;
-        }
-        OA_ptr<DataFlow::LocDFSet> use1Set = mapIter->second;
-        if (debug) {
-            std::cout << "use1Set = "; use1Set->dump(std::cout);
+        // for each def1 of this, the def2s of other where def1 overlaps
+        // with use2, plus def1 itself unless <def1,def1> has been
+        // removed from other, go in the row of each use1 of def1
+        BitMatrix::const_iterator rowIter;
+        for (rowIter=mDefToUses.begin(); rowIter!=mDefToUses.end(); rowIter++) {
+            unsigned int def1 = rowIter->first;
+            SparseBitVector defs2;
+            recastOther.overlapDefs(mLocTable->locOf(def1), defs2);
+            if (!recastOther.mImplicitRemoves.test(def1)) {
+                defs2.set(def1);
+            }
+            if (defs2.empty()) { continue; }
+
+            SparseBitVectorIterator use1Iter(rowIter->second);
+            for ( ; use1Iter.isValid(); ++use1Iter) {
+                product[use1Iter.current()].unionWith(defs2);
+            }
         }
 
-        // get all the defs in use2,def2 where def1 overlaps with use2
-        OA_ptr<LocIterator> def2Iter = recastOther.getDefsIterator(def1);
-
-        // loop over all use1,def1 pairs
-        OA_ptr<LocIterator> use1Iter = use1Set->getLocIterator();
-        for ( ; use1Iter->isValid(); (*use1Iter)++ ) {
-            OA_ptr<Location> use1 = use1Iter->current();
-
-            // get all the defs in use2, def2 where def1 overlaps with use2
-            for (def2Iter->reset(); def2Iter->isValid(); (*def2Iter)++ ) {
-                tempDFSet->insertDep(use1, def2Iter->current());
-                if (debug) {
-                    std::cout << "inserting <use1,def2Iter->current> = "; 
-                    use1->dump(std::cout); 
-                    std::cout << " , ";
-                    def2Iter->current()->dump(std::cout); 
-                    std::cout << std::endl;
-                }
+        // for each use2 of other, the use1s of this where def1 overlaps
+        // with use2, plus use2 itself unless <use2,use2> has been
+        // removed from this, get all the def2s of use2
+        for (rowIter=recastOther.mUseToDefs.begin();
+             rowIter!=recastOther.mUseToDefs.end(); rowIter++) 
+        {
+            unsigned int use2 = rowIter->first;
+            SparseBitVector uses1;
+            overlapUses(mLocTable->locOf(use2), uses1);
+            if (!mImplicitRemoves.test(use2)) {
+                uses1.set(use2);
             }
 
-            /*
-            // as long as d,d has not been removed from recastOther,
-            // where d overlaps def1, we should add use1,def1 to result
-            // if it was removed but is explicitly in recastOther then
-            // use1,def1 was correctly inserted into the result in above code
-            // eg. x = x + y, x,x will be explictly in recastOther and
-            // be an implicit that is removed due to the mustdef of x
-            if (! recastOther.isImplicitRemoved(def1) ) {
-                tempDFSet->insertDep(use1,def1);
-                if (debug) {
-                    std::cout << "inserting <use1,def1> = "; 
-                    use1->dump(std::cout); 
-                    std::cout << " , ";
-                    def1->dump(std::cout); 
-                    std::cout << std::endl;
-                }
+            SparseBitVectorIterator use1Iter(uses1);
+            for ( ; use1Iter.isValid(); ++use1Iter) {
+                product[use1Iter.current()].unionWith(rowIter->second);
             }
-            */
         }
     }
 
-    // iterate over deps in recastOther keying off the use
-    // see if the use overlaps with anything in this
-    // even if it doesn't insert dep pairs for use,def 
-    // as long as use,use hasn't been removed from this
-    for (mapIter=recastOther.mUseToDefsMap.begin();
-         mapIter!=recastOther.mUseToDefsMap.end(); mapIter++ )
-    {
-        OA_ptr<Location> use2 = mapIter->first;
-        if (debug) {
-            std::cout << "use2 = "; use2->dump(std::cout); 
-            std::cout << std::endl;
-        }
-        OA_ptr<DataFlow::LocDFSet> def2Set = mapIter->second;
-        assert(!def2Set.ptrEqual(0));
-        if (debug) {
-            std::cout << "def2Set = ";
-            def2Set->dump(std::cout);
+    // as in insertDep, a reflexive pair only takes the location out
+    // of the implicit removes
+    BitMatrix::iterator rowIter;
+    for (rowIter=product.begin(); rowIter!=product.end(); rowIter++) {
+        unsigned int use = rowIter->first;
+        if (rowIter->second.test(use)) {
+            rowIter->second.reset(use);
+            result.mImplicitRemoves.reset(use);
         }
-
-        OA_ptr<LocIterator> use1Iter = getUsesIterator(use2);
-
-        // loop over all use2,def2 pairs
-        OA_ptr<LocIterator> def2Iter = def2Set->getLocIterator();
-        for ( ; def2Iter->isValid(); (*def2Iter)++ ) {
-            OA_ptr<Location> def2 = def2Iter->current();
-
-            // get all the uses in use1,def1 where def1 overlaps with use2
-            for (use1Iter->reset(); use1Iter->isValid(); (*use1Iter)++ ) {
-                tempDFSet->insertDep(use1Iter->current(), def2);
-                if (debug) {
-                    std::cout << "inserting <use1Iter->current,def2> = "; 
-                    use1Iter->current()->dump(std::cout); 
-                    std::cout << " , ";
-                    def2->dump(std::cout); 
-                    std::cout << std::endl;
-                }
-            }
-
-            /*
-            // as long as u,u has not been removed from this,
-            // where u overlaps use2, we should add use2,def2 to result
-            if (! isImplicitRemoved(use2) ) {
-                tempDFSet->insertDep(use2,def2);
-                if (debug) {
-                    std::cout << "inserting <use2,def2> = "; 
-                    use2->dump(std::cout); 
-                    std::cout << " , ";
-                    def2->dump(std::cout); 
-                    std::cout << std::endl;
-                }
-            }
-            */
+        if (!rowIter->second.empty()) {
+            result.mUseToDefs[use] = rowIter->second;
+            result.mUses.set(use);
         }
     }
+    result.transpose();
 
-    (*this) = *tempDFSet;
+    (*this) = result;
     if (debug) {
         std::cout << "\t*this = ";
         dump(std::cout);
@@ -539,6 +541,10 @@ DepDFSet& DepDFSet::setIntersect(DataFlowSet &other)
 //*****************************************************************
 void DepDFSet::dump(std::ostream &os) 
 {
+    LocToLocDFSetMap useToDefsMap, defToUsesMap;
+    getLocMap(mUseToDefs, useToDefsMap);
+    getLocMap(mDefToUses, defToUsesMap);
+
   /*  
     os << "\tmUseToDefsMap.size() = " << mUseToDefsMap.size() << std::endl;
     os << "\tmDefToUsesMap.size() = " << mDefToUsesMap.size() << std::endl;
@@ -548,8 +554,8 @@ void DepDFSet::dump(std::ostream &os)
     // iterate over all uses
     std::map<OA_ptr<Location>,OA_ptr<DataFlow::LocDFSet> >::const_iterator 
         mapIter;
-    for (mapIter=mUseToDefsMap.begin();
-         mapIter!=mUseToDefsMap.end(); mapIter++ )
+    for (mapIter=useToDefsMap.begin();
+         mapIter!=useToDefsMap.end(); mapIter++ )
     {
         OA_ptr<Location> use = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -563,8 +569,8 @@ void DepDFSet::dump(std::ostream &os)
     
     os << "\tdefs" << std::endl;
     // iterate over all defs
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
+    for (mapIter=defToUsesMap.begin();
+         mapIter!=defToUsesMap.end(); mapIter++ )
     {
         OA_ptr<Location> def = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -577,18 +583,22 @@ void DepDFSet::dump(std::ostream &os)
     }
    
     os << "\tmImplicitRemoves = ";
-    mImplicitRemoves->dump(os);
+    getLocSet(mImplicitRemoves)->dump(os);
   
     os << "\tmUses = ";
-    mUses->dump(os);
+    getLocSet(mUses)->dump(os);
   
     os << "\tmDefs = ";
-    mDefs->dump(os);
+    getLocSet(mDefs)->dump(os);
 
 }
 
 void DepDFSet::dump(std::ostream &os) const
 {
+    LocToLocDFSetMap useToDefsMap, defToUsesMap;
+    getLocMap(mUseToDefs, useToDefsMap);
+    getLocMap(mDefToUses, defToUsesMap);
+
    
 /*
     os << "\tmUseToDefsMap.size() = " << mUseToDefsMap.size() << std::endl;
@@ -599,8 +609,8 @@ void DepDFSet::dump(std::ostream &os) const
     // iterate over all uses
     std::map<OA_ptr<Location>,OA_ptr<DataFlow::LocDFSet> >::const_iterator 
         mapIter;
-    for (mapIter=mUseToDefsMap.begin();
-         mapIter!=mUseToDefsMap.end(); mapIter++ )
+    for (mapIter=useToDefsMap.begin();
+         mapIter!=useToDefsMap.end(); mapIter++ )
     {
         OA_ptr<Location> use = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -614,8 +624,8 @@ void DepDFSet::dump(std::ostream &os) const
     
     os << "\tdefs" << std::endl;
     // iterate over all defs
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
+    for (mapIter=defToUsesMap.begin();
+         mapIter!=defToUsesMap.end(); mapIter++ )
     {
         OA_ptr<Location> def = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -628,19 +638,23 @@ void DepDFSet::dump(std::ostream &os) const
     }
    
     os << "\tmImplicitRemoves = ";
-    mImplicitRemoves->dump(os);
+    getLocSet(mImplicitRemoves)->dump(os);
   
     os << "\tmUses = ";
-    mUses->dump(os);
+    getLocSet(mUses)->dump(os);
   
     os << "\tmDefs = ";
-    mDefs->dump(os);
+    getLocSet(mDefs)->dump(os);
 
  }
 
 
 void DepDFSet::dump(std::ostream &os, OA_ptr<IRHandlesIRInterface> ir) 
 {
+    LocToLocDFSetMap useToDefsMap, defToUsesMap;
+    getLocMap(mUseToDefs, useToDefsMap);
+    getLocMap(mDefToUses, defToUsesMap);
+
 /*
     os << "\tmUseToDefsMap.size() = " << mUseToDefsMap.size() << std::endl;
     os << "\tmDefToUsesMap.size() = " << mDefToUsesMap.size() << std::endl;
@@ -650,8 +664,8 @@ void DepDFSet::dump(std::ostream &os, OA_ptr<IRHandlesIRInterface> ir)
     os << "\tuses" << std::endl;
     // iterate over all uses
     std::map<OA_ptr<Location>,OA_ptr<DataFlow::LocDFSet> >::const_iterator mapIter;
-    for (mapIter=mUseToDefsMap.begin();
-         mapIter!=mUseToDefsMap.end(); mapIter++ )
+    for (mapIter=useToDefsMap.begin();
+         mapIter!=useToDefsMap.end(); mapIter++ )
     {
         OA_ptr<Location> use = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -665,8 +679,8 @@ void DepDFSet::dump(std::ostream &os, OA_ptr<IRHandlesIRInterface> ir)
     
     os << "\tdefs" << std::endl;
     // iterate over all defs
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
+    for (mapIter=defToUsesMap.begin();
+         mapIter!=defToUsesMap.end(); mapIter++ )
     {
         OA_ptr<Location> def = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -680,23 +694,27 @@ void DepDFSet::dump(std::ostream &os, OA_ptr<IRHandlesIRInterface> ir)
     
     // dump implicitRemoves
     os << "\tmImplicitRemoves = ";
-    mImplicitRemoves->dump(os,ir); 
+    getLocSet(mImplicitRemoves)->dump(os,ir); 
   
     os << "\tmUses = ";
-    mUses->dump(os,ir);
+    getLocSet(mUses)->dump(os,ir);
   
     os << "\tmDefs = ";
-    mDefs->dump(os,ir);
+    getLocSet(mDefs)->dump(os,ir);
 
 }
 
 void DepDFSet::output(OA::IRHandlesIRInterface& ir) {
+    LocToLocDFSetMap useToDefsMap, defToUsesMap;
+    getLocMap(mUseToDefs, useToDefsMap);
+    getLocMap(mDefToUses, defToUsesMap);
+
     
     // iterate over all uses
     sOutBuild->mapStart("mUseToDefsMap","UseLoc","DefLocSet");
     std::map<OA_ptr<Location>,OA_ptr<DataFlow::LocDFSet> >::const_iterator mapIter;
-    for (mapIter=mUseToDefsMap.begin();
-         mapIter!=mUseToDefsMap.end(); mapIter++ )
+    for (mapIter=useToDefsMap.begin();
+         mapIter!=useToDefsMap.end(); mapIter++ )
     {
         OA_ptr<Location> use = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -713,8 +731,8 @@ void DepDFSet::output(OA::IRHandlesIRInterface& ir) {
     
     // iterate over all defs
     sOutBuild->mapStart("mDefToUsesMap","DefLoc","UseLocSet");
-    for (mapIter=mDefToUsesMap.begin();
-         mapIter!=mDefToUsesMap.end(); mapIter++ )
+    for (mapIter=defToUsesMap.begin();
+         mapIter!=defToUsesMap.end(); mapIter++ )
     {
         OA_ptr<Location> def = mapIter->first;
         OA_ptr<DataFlow::LocDFSet> locset = mapIter->second;
@@ -734,17 +752,17 @@ void DepDFSet::output(OA::IRHandlesIRInterface& ir) {
     std::ostringstream label1;
     label1 << indt << "ImplicitRemoves:";
     sOutBuild->outputString( label1.str() );
-    mImplicitRemoves->output(ir); 
+    getLocSet(mImplicitRemoves)->output(ir); 
 
     std::ostringstream label2;
     label2 << indt << "Uses:";
     sOutBuild->outputString( label2.str() );
-    mUses->output(ir); 
+    getLocSet(mUses)->output(ir); 
 
     std::ostringstream label3;
     label3 << indt << "Defs:";
     sOutBuild->outputString( label3.str() );
-    mDefs->output(ir); 
+    getLocSet(mDefs)->output(ir); 
     
 }
 
@@ -766,23 +784,21 @@ void DepDFSet::output(OA::IRHandlesIRInterface& ir) {
 
 */
 void DepDFSet::insertDep(OA_ptr<Location> use, OA_ptr<Location> def)
+{
+    addDep(mLocTable->idOf(use), mLocTable->idOf(def));
+}
+
+void DepDFSet::addDep(unsigned int use, unsigned int def)
 {
     if (use==def) {
-        mImplicitRemoves->remove(use);
+        mImplicitRemoves.reset(use);
 
     } else {
-        if (mUseToDefsMap[use].ptrEqual(0)) {
-            mUseToDefsMap[use] = new DataFlow::LocDFSet;
-        }
-        if (mDefToUsesMap[def].ptrEqual(0)) {
-            mDefToUsesMap[def] = new DataFlow::LocDFSet;
-        }
-
-        mUseToDefsMap[use]->insert(def);
-        mDefToUsesMap[def]->insert(use);
+        mUseToDefs[use].set(def);
+        mDefToUses[def].set(use);
 
-        mUses->insert(use);
-        mDefs->insert(def);
+        mUses.set(use);
+        mDefs.set(def);
     }
 }
 
@@ -798,7 +814,84 @@ void DepDFSet::removeImplicitDep(OA_ptr<Location> use, OA_ptr<Location> def)
     // overlap each other, sublocs that only have partial accuracy will
     // only may loc
     if (use->mustOverlap(*def)) {
-        mImplicitRemoves->insert(use);
+        mImplicitRemoves.set(mLocTable->idOf(use));
+    }
+}
+
+void DepDFSet::transpose()
+{
+    mDefToUses.clear();
+    mDefs.clear();
+    BitMatrix::const_iterator rowIter;
+    for (rowIter=mUseToDefs.begin(); rowIter!=mUseToDefs.end(); rowIter++) {
+        SparseBitVectorIterator defIter(rowIter->second);
+        for ( ; defIter.isValid(); ++defIter) {
+            mDefToUses[defIter.current()].set(rowIter->first);
+            mDefs.set(defIter.current());
+        }
+    }
+}
+
+const DepDFSet& DepDFSet::inTable(const DepDFSet& other, 
+                                  DepDFSet& renumbered) const
+{
+    if (other.mLocTable.ptrEqual(mLocTable)) { return other; }
+
+    BitMatrix::const_iterator rowIter;
+    for (rowIter=other.mUseToDefs.begin(); rowIter!=other.mUseToDefs.end();
+         rowIter++)
+    {
+        unsigned int use 
+            = mLocTable->idOf(other.mLocTable->locOf(rowIter->first));
+        SparseBitVectorIterator defIter(rowIter->second);
+        for ( ; defIter.isValid(); ++defIter) {
+            renumbered.addDep(use, 
+                mLocTable->idOf(other.mLocTable->locOf(defIter.current())));
+        }
+    }
+    SparseBitVectorIterator idIter(other.mImplicitRemoves);
+    for ( ; idIter.isValid(); ++idIter) {
+        renumbered.mImplicitRemoves.set(
+            mLocTable->idOf(other.mLocTable->locOf(idIter.current())));
+    }
+    return renumbered;
+}
+
+//*****************************************************************
+// Locations for the numbers
+//*****************************************************************
+
+OA_ptr<DataFlow::LocDFSet> DepDFSet::getLocSet(const SparseBitVector& ids) const
+{
+    OA_ptr<DataFlow::LocDFSet> retval;
+    retval = new DataFlow::LocDFSet;
+    SparseBitVectorIterator idIter(ids);
+    for ( ; idIter.isValid(); ++idIter) {
+        retval->insert(mLocTable->locOf(idIter.current()));
+    }
+    return retval;
+}
+
+void DepDFSet::getLocMap(const BitMatrix& matrix, 
+                         LocToLocDFSetMap& result) const
+{
+    BitMatrix::const_iterator rowIter;
+    for (rowIter=matrix.begin(); rowIter!=matrix.end(); rowIter++) {
+        result[mLocTable->locOf(rowIter->first)] 
+            = getLocSet(rowIter->second);
+    }
+}
+
+DepIterator::DepIterator(OA_ptr<DepDFSet> dfSet) : mIndex(0)
+{
+    DepDFSet::LocToLocDFSetMap useToDefsMap;
+    dfSet->getLocMap(dfSet->mUseToDefs, useToDefsMap);
+    DepDFSet::LocToLocDFSetMap::const_iterator mapIter;
+    for (mapIter=useToDefsMap.begin(); mapIter!=useToDefsMap.end(); mapIter++) {
+        DataFlow::LocDFSetIterator defIter(*(mapIter->second));
+        for ( ; defIter.isValid(); ++defIter) {
+            mDeps.push_back(std::make_pair(mapIter->first, defIter.current()));
+        }
     }
 }
 
@@ -18,26 +18,80 @@
 
 #include <iostream>
 #include <map>
+#include <vector>
 
 // abstract interface that this class implements
 #include <OpenAnalysis/DataFlow/DataFlowSet.hpp>
 #include <OpenAnalysis/Location/Locations.hpp>
 #include <OpenAnalysis/DataFlow/LocDFSet.hpp>
+#include <OpenAnalysis/Utils/SparseBitVector.hpp>
 
 namespace OA {
   namespace Activity {
 
 class DepIterator;
 
+/*!
+   Numbers the locations the DepDFSets of one analysis have seen,
+   comparing them by value.  The numbers are also indexed by base
+   location the way LocDFSet indexes its locations, to find which
+   ones a location overlaps.
+
+   Sets that are composed with each other should share a table, see
+   the DepDFSet constructors.  There is no lock: sets sharing a table
+   may be read from several threads, but only changed from one.
+*/
+class DepLocTable {
+  public:
+    DepLocTable() {}
+    ~DepLocTable() {}
+
+    //! number of loc, giving it one if it doesn't have one yet
+    unsigned int idOf(OA_ptr<Location> loc);
+    //! number of loc, or -1 if it doesn't have one
+    int findId(OA_ptr<Location> loc) const;
+    OA_ptr<Location> locOf(unsigned int id) const { return mLocs[id]; }
+
+    //! sets the bits in result of the locations in among that
+    //! LocDFSet::getOverlapLocIterator(loc) would return for a set
+    //! holding the among locations
+    void overlapping(OA_ptr<Location> loc, const SparseBitVector& among,
+                     SparseBitVector& result) const;
+
+  private:
+    void associateWithBaseHandle(IRHandle baseHandle, unsigned int id);
+
+    std::map<OA_ptr<Location>,unsigned int> mIds;
+    std::vector<OA_ptr<Location> > mLocs;
+    std::map<IRHandle,std::vector<unsigned int> > mBaseToIds;
+    std::vector<unsigned int> mInvisibleIds;
+    std::vector<unsigned int> mUnknownIds;
+};
+
 /*!
    A set of differentiable dependence pairs, <useLoc,defLoc>.
    Dependences to self are implicit unless removed with removeDep.
+
+   Every location is given a number the first time a DepDFSet sees
+   it, and the pairs are kept as a boolean matrix: for each use a bit
+   vector of its defs, and the transpose for each def.  compose is a
+   boolean matrix product done a row at a time by OR-ing bit vectors.
+   Locations are compared by value, and a query location matches the
+   locations it overlaps as in LocDFSet::getOverlapLocIterator.
+
+   The numbers come from a DepLocTable.  A manager passes its table
+   to the sets it builds; a set made with the default constructor
+   gets a table of its own.  When two sets with different tables are
+   combined, the argument is renumbered into the table of this set
+   first.
  */
     class DepDFSet : public virtual DataFlow::DataFlowSet,
                      public virtual Annotation {
 public:
   DepDFSet();
-  //! copy constructor
+  //! an empty set numbering its locations in locTable
+  DepDFSet(OA_ptr<DepLocTable> locTable);
+  //! copy constructor, shares the table of other
   DepDFSet(const DepDFSet &other); 
   ~DepDFSet() {}
 
@@ -114,72 +168,71 @@ public:
   //! has been killed due to a must def
   bool isImplicitRemoved(const OA_ptr<Location> loc) const;
 
+  //! get an iterator over the locations whose implicit pair has
+  //! been removed
+  OA_ptr<LocIterator> getImplicitRemovesIterator() const;
 
-private:
-  //! helper function for iterators, makes all implicit deps explicit
-  //! except those that have been removed explicitly
-  //void makeImplicitExplicit();
-  //bool mMakeImplicitExplicitMemoized;
 
+private:
   friend class DepIterator;
 
+  //! bit vector of numbered locations for each numbered location
+  typedef std::map<unsigned int,SparseBitVector> BitMatrix;
+
+  void addDep(unsigned int use, unsigned int def);
+  //! defs of the uses that loc overlaps, without the reflexive pair
+  void overlapDefs(OA_ptr<Location> loc, SparseBitVector& result) const;
+  //! uses of the defs that loc overlaps, without the reflexive pair
+  void overlapUses(OA_ptr<Location> loc, SparseBitVector& result) const;
+  //! sets mDefToUses and mDefs from mUseToDefs
+  void transpose();
+  //! other if it shares the table of this, else renumbered filled
+  //! with the pairs of other numbered in the table of this
+  const DepDFSet& inTable(const DepDFSet& other, DepDFSet& renumbered) const;
+
+  // for output and iterators
+  OA_ptr<DataFlow::LocDFSet> getLocSet(const SparseBitVector& ids) const;
+  void getLocMap(const BitMatrix& matrix, LocToLocDFSetMap& result) const;
+
   // It is implicitly assumed that dep <a,a> is in each DepDFSet
   // for all locations.  This is a set of locations where this
   // implicit dep has been removed with removeImplicitDep.
   // If <a,a> is then explicitly inserted with insertDep, then
   // anything that overlaps with a will be removed from this set
-  OA_ptr<DataFlow::LocDFSet> mImplicitRemoves;
+  SparseBitVector mImplicitRemoves;
+
+  //! gives the locations for the numbers in the bit vectors
+  OA_ptr<DepLocTable> mLocTable;
 
-  LocToLocDFSetMap mUseToDefsMap;
-  LocToLocDFSetMap mDefToUsesMap;
+  BitMatrix mUseToDefs;
+  BitMatrix mDefToUses;
 
   // maintain sets of the uses and defs as well
-  OA_ptr<DataFlow::LocDFSet> mUses;
-  OA_ptr<DataFlow::LocDFSet> mDefs;
+  SparseBitVector mUses;
+  SparseBitVector mDefs;
 
 };
 
 class DepIterator {
   public:
-    DepIterator(OA_ptr<DepDFSet> dfSet) : mDFSet(dfSet) 
-      { mIter = mDFSet->mUseToDefsMap.begin(); 
-        if (mIter!=mDFSet->mUseToDefsMap.end()) {
-          mDefIter = new DataFlow::LocDFSetIterator(*(mIter->second));
-          while (!mDefIter->isValid() && mIter!=mDFSet->mUseToDefsMap.end()) {
-            mIter++;
-            mDefIter = new DataFlow::LocDFSetIterator(*(mIter->second));
-          }
-        }
-      }
+    DepIterator(OA_ptr<DepDFSet> dfSet);
     virtual ~DepIterator() {}
 
     OA_ptr<Location> use() const 
-      { return mIter->first; }
+      { return mDeps[mIndex].first; }
     OA_ptr<Location> def() const
-      { return mDefIter->current(); }
+      { return mDeps[mIndex].second; }
 
     bool isValid() const
-      { if (mIter!=mDFSet->mUseToDefsMap.end() && mDefIter->isValid())
-          { return true; } else { return false; }
-      }
+      { return mIndex < mDeps.size(); }
                     
-    void operator++()
-      {
-        (*mDefIter)++;
-        while (!mDefIter->isValid() && mIter!=mDFSet->mUseToDefsMap.end()) {
-            mIter++;
-            if (mIter!=mDFSet->mUseToDefsMap.end()) {
-                mDefIter = new DataFlow::LocDFSetIterator(*(mIter->second));
-            }
-        }
-      }
+    void operator++() { mIndex++; }
 
     void operator++(int) { ++*this; }
 
   private:
-    OA_ptr<DepDFSet> mDFSet;
-    DepDFSet::LocToLocDFSetMap::const_iterator mIter;
-    OA_ptr<LocIterator> mDefIter;
+    std::vector<std::pair<OA_ptr<Location>,OA_ptr<Location> > > mDeps;
+    unsigned int mIndex;
 
 };
 
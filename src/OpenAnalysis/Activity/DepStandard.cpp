@@ -20,6 +20,11 @@ namespace OA {
 
 static bool debug = false;
 
+DepStandard::DepStandard()
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_DepStandard:ALL", debug);
+}
+
 
 //*****************************************************************
 // Interface Implementation
@@ -32,7 +37,6 @@ static bool debug = false;
 OA_ptr<LocIterator> 
 DepStandard::getMayDefIterator(StmtHandle stmt, const OA_ptr<Location> use)
 {
-    OA_DEBUG_CTRL_MACRO("DEBUG_DepStandard:ALL", debug);
     if (mDepDFSet[stmt].ptrEqual(0)) {
         mDepDFSet[stmt] = new DepDFSet;
     }
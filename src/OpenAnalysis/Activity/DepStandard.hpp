@@ -34,7 +34,7 @@ namespace OA {
 */
 class DepStandard {
   public:
-    DepStandard() {}
+    DepStandard();
     ~DepStandard() {}
 
     //*****************************************************************
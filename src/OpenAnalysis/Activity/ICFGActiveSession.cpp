@@ -0,0 +1,93 @@
+/*! \file
+
+  \brief Implementation of ICFGActiveSession.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ICFGActiveSession.hpp"
+#include <Utils/Util.hpp>
+#include <sys/time.h>
+
+namespace OA {
+  namespace Activity {
+
+static bool debug = false;
+
+//! wall clock seconds
+static double seconds()
+{
+    struct timeval now;
+    gettimeofday(&now, 0);
+    return now.tv_sec + now.tv_usec / 1e6;
+}
+
+ICFGActiveSession::ICFGActiveSession(
+        OA_ptr<ActivityIRInterface> _ir,
+        OA_ptr<ICFG::ICFGInterface> icfg,
+        OA_ptr<DataFlow::ParamBindings> paramBind,
+        OA_ptr<Alias::InterAliasInterface> interAlias,
+        OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+        DataFlow::DFPImplement algorithm)
+    : mIR(_ir), mICFG(icfg), mParamBind(paramBind), mInterAlias(interAlias),
+      mInterSE(interSE), mAlgorithm(algorithm), mConcurrent(false),
+      mSummaries(false), mNumAnalyses(0), mAnalysisSeconds(0.0),
+      mDepSeconds(0.0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ICFGActiveSession:ALL", debug);
+}
+
+OA_ptr<ICFGDep> ICFGActiveSession::getICFGDep()
+{
+    if (mICFGDep.ptrEqual(0)) {
+        double start = seconds();
+        ManagerICFGDep depman(mIR);
+        depman.setProcSummaries(mSummaries);
+        mICFGDep = depman.performAnalysis(mICFG, mParamBind, mInterAlias,
+                                          mAlgorithm);
+        mDepSeconds = seconds() - start;
+        if (debug) {
+            std::cout << "ICFGActiveSession: ICFGDep took " << mDepSeconds
+                      << " s" << std::endl;
+        }
+    }
+    return mICFGDep;
+}
+
+/*!
+   A new ManagerICFGActive for each call, so nothing from the last
+   seeds is left in its solver.
+*/
+OA_ptr<InterActive> ICFGActiveSession::analyze()
+{
+    OA_ptr<ICFGDep> icfgDep = getICFGDep();
+
+    double start = seconds();
+    ManagerICFGActive activeman(mIR);
+    activeman.setConcurrentUsefulVary(mConcurrent);
+    OA_ptr<InterActive> retval
+        = activeman.performAnalysis(mICFG, mParamBind, mInterAlias, mInterSE,
+                                    icfgDep, mAlgorithm);
+    double elapsed = seconds() - start;
+
+    mNumAnalyses++;
+    mAnalysisSeconds += elapsed;
+    if (debug) {
+        std::cout << "ICFGActiveSession: analysis " << mNumAnalyses
+                  << " took " << elapsed << " s" << std::endl;
+    }
+    return retval;
+}
+
+double ICFGActiveSession::getAnalysesPerSecond()
+{
+    if (mAnalysisSeconds <= 0.0) { return 0.0; }
+    return mNumAnalyses / mAnalysisSeconds;
+}
+
+  } // end of Activity namespace
+} // end of OA namespace
@@ -0,0 +1,98 @@
+/*! \file
+
+  \brief Declarations for rerunning ICFG activity analysis with other
+         independent and dependent locations.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef ICFGActiveSession_h
+#define ICFGActiveSession_h
+
+//--------------------------------------------------------------------
+// OpenAnalysis headers
+#include <OpenAnalysis/Activity/ManagerICFGActive.hpp>
+#include <OpenAnalysis/Activity/ManagerICFGDep.hpp>
+#include <OpenAnalysis/Activity/InterActive.hpp>
+#include <OpenAnalysis/IRInterface/ActivityIRInterface.hpp>
+
+namespace OA {
+  namespace Activity {
+
+/*!
+   Holds the results that ManagerICFGActive needs but that don't depend
+   on the independent and dependent locations: the ICFG, ParamBindings,
+   alias and side-effect results, and the ICFGDep.  The ICFGDep is
+   built the first time analyze is called and reused after that.
+
+   analyze reads the independent and dependent locations from the IR
+   each time, so a client that changes what getIndepMemRefExprIter and
+   getDepMemRefExprIter return between calls gets activity for each
+   choice of them while only the useful, vary, and active passes are
+   redone.
+
+   The session also keeps how many times analyze was called and the
+   time spent in it, to give the number of seed choices analyzed per
+   second.
+*/
+class ICFGActiveSession {
+public:
+  ICFGActiveSession(OA_ptr<ActivityIRInterface> _ir,
+                    OA_ptr<ICFG::ICFGInterface> icfg,
+                    OA_ptr<DataFlow::ParamBindings> paramBind,
+                    OA_ptr<Alias::InterAliasInterface> interAlias,
+                    OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+                    DataFlow::DFPImplement algorithm = DataFlow::ITERATIVE);
+  ~ICFGActiveSession() {}
+
+  //! same as ManagerICFGActive::setConcurrentUsefulVary
+  void setConcurrentUsefulVary(bool concurrent) { mConcurrent = concurrent; }
+
+  //! same as ManagerICFGActive::setProcSummaries, only has an effect
+  //! before the first analyze
+  void setProcSummaries(bool summaries) { mSummaries = summaries; }
+
+  //! activity for the independent and dependent locations the IR
+  //! currently gives
+  OA_ptr<InterActive> analyze();
+
+  //! the ICFGDep shared by all calls to analyze, built if needed
+  OA_ptr<ICFGDep> getICFGDep();
+
+  //---------------------------------
+  // throughput
+  //---------------------------------
+  //! number of times analyze has been called
+  int getNumAnalyses() { return mNumAnalyses; }
+  //! seconds spent in analyze, not counting building the ICFGDep
+  double getAnalysisSeconds() { return mAnalysisSeconds; }
+  //! seconds spent building the ICFGDep
+  double getDepSeconds() { return mDepSeconds; }
+  //! calls to analyze per second of getAnalysisSeconds
+  double getAnalysesPerSecond();
+
+private:
+  OA_ptr<ActivityIRInterface> mIR;
+  OA_ptr<ICFG::ICFGInterface> mICFG;
+  OA_ptr<DataFlow::ParamBindings> mParamBind;
+  OA_ptr<Alias::InterAliasInterface> mInterAlias;
+  OA_ptr<SideEffect::InterSideEffectInterface> mInterSE;
+  DataFlow::DFPImplement mAlgorithm;
+
+  bool mConcurrent;
+  bool mSummaries;
+  OA_ptr<ICFGDep> mICFGDep;
+
+  int mNumAnalyses;
+  double mAnalysisSeconds;
+  double mDepSeconds;
+};
+
+  } // end of Activity namespace
+} // end of OA namespace
+
+#endif
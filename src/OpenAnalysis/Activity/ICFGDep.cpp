@@ -20,6 +20,12 @@ namespace OA {
 
 static bool debug = false;
 
+ICFGDep::ICFGDep()
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ICFGDep:ALL", debug);
+    mNoDeps = new DepDFSet;
+}
+
 
 //*****************************************************************
 // Interface Implementation
@@ -32,11 +38,7 @@ static bool debug = false;
 OA_ptr<LocIterator> 
 ICFGDep::getMayDefIterator(StmtHandle stmt, const OA_ptr<Location> use)
 {
-    OA_DEBUG_CTRL_MACRO("DEBUG_ICFGDep:ALL", debug);
-    if (mDepDFSet[stmt].ptrEqual(0)) {
-        mDepDFSet[stmt] = new DepDFSet;
-    }
-    return mDepDFSet[stmt]->getDefsIterator(use);
+    return getDeps(stmt)->getDefsIterator(use);
 }
 
 /*!
@@ -48,14 +50,11 @@ ICFGDep::getMayDefIterator(StmtHandle stmt, const OA_ptr<Location> use)
 OA_ptr<LocIterator> 
 ICFGDep::getDiffUseIterator(StmtHandle stmt, OA_ptr<Location> def)
 {
-
-    if (mDepDFSet[stmt].ptrEqual(0)) {
-        mDepDFSet[stmt] = new DepDFSet;
-    }
+    OA_ptr<DepDFSet> deps = getDeps(stmt);
     if (debug) {
-        mDepDFSet[stmt]->dump(std::cout);
+        deps->dump(std::cout);
     }
-    return mDepDFSet[stmt]->getUsesIterator(def);
+    return deps->getUsesIterator(def);
 }
     
 //! Return an iterator over all locations that are definitely
@@ -63,15 +62,56 @@ ICFGDep::getDiffUseIterator(StmtHandle stmt, OA_ptr<Location> def)
 OA_ptr<LocIterator> ICFGDep::getMustDefIterator(StmtHandle stmt)
 {
   OA_ptr<LocSetIterator> retval;
-  if (mMustDefMap[stmt].ptrEqual(0)) {
+  std::map<StmtHandle,OA_ptr<LocSet> >::const_iterator 
+      found = mMustDefMap.find(stmt);
+  if (found == mMustDefMap.end() || found->second.ptrEqual(0)) {
     OA_ptr<LocSet> emptySet; emptySet = new LocSet;
     retval = new LocSetIterator(emptySet);  
   } else {
-    retval = new LocSetIterator(mMustDefMap[stmt]); 
+    retval = new LocSetIterator(found->second); 
   }
   return retval;
 }
 
+//! Return the summary of proc, null if there is none
+OA_ptr<DepDFSet> ICFGDep::getProcSummary(ProcHandle proc)
+{
+    OA_ptr<DepDFSet> retval;
+    std::map<ProcHandle,OA_ptr<DepDFSet> >::const_iterator 
+        found = mProcSummary.find(proc);
+    if (found != mProcSummary.end()) {
+        retval = found->second;
+    }
+    return retval;
+}
+
+//! Return the summary for the call node of call, null if there is none
+OA_ptr<DepDFSet> ICFGDep::getCallSummary(CallHandle call)
+{
+    OA_ptr<DepDFSet> retval;
+    std::map<CallHandle,OA_ptr<DepDFSet> >::const_iterator 
+        found = mCallSummary.find(call);
+    if (found != mCallSummary.end()) {
+        retval = found->second;
+    }
+    return retval;
+}
+
+/*!
+   The DepDFSet for stmt, or an empty one if stmt has none.  Looks
+   the stmt up without adding it, so the queries don't change the
+   maps.
+*/
+OA_ptr<DepDFSet> ICFGDep::getDeps(StmtHandle stmt)
+{
+    std::map<StmtHandle,OA_ptr<DepDFSet> >::const_iterator 
+        found = mDepDFSet.find(stmt);
+    if (found == mDepDFSet.end() || found->second.ptrEqual(0)) {
+        return mNoDeps;
+    }
+    return found->second;
+}
+
 
 //*****************************************************************
 // Construction methods
@@ -133,6 +173,17 @@ void ICFGDep::dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir)
             depDFSet->dump(os,ir);
         }
     }
+    if (!mProcSummary.empty()) {
+        std::cout << "ProcSummaries = " << std::endl;
+        std::map<ProcHandle,OA_ptr<DepDFSet> >::iterator procIter;
+        for (procIter=mProcSummary.begin(); procIter!=mProcSummary.end();
+             procIter++) 
+        {
+            std::cout << "\tproc = " << ir->toString(procIter->first) 
+                      << std::endl;
+            procIter->second->dump(os,ir);
+        }
+    }
 
     std::cout << std::endl;
 }
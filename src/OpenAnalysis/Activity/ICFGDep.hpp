@@ -40,7 +40,7 @@ namespace OA {
 */
     class ICFGDep : public virtual Annotation {
   public:
-    ICFGDep() {}
+    ICFGDep();
     ~ICFGDep() {}
 
     //*****************************************************************
@@ -62,6 +62,19 @@ namespace OA {
     //! defined in the given stmt
     OA_ptr<LocIterator> getMustDefIterator(StmtHandle stmt);
 
+    //! Return the DepDFSet for the given stmt, an empty one if the
+    //! stmt has no dependences
+    OA_ptr<DepDFSet> getDepDFSet(StmtHandle stmt) { return getDeps(stmt); }
+
+    //! Return the dependences from the entry to the exit of proc,
+    //! or a null pointer if proc has not been summarized
+    OA_ptr<DepDFSet> getProcSummary(ProcHandle proc);
+
+    //! Return the dependences across the call node whose CALL_RETURN
+    //! edge has the given call, in terms of caller locations, or a
+    //! null pointer if the callees have not been summarized
+    OA_ptr<DepDFSet> getCallSummary(CallHandle call);
+
     //*****************************************************************
     // Construction methods
     //*****************************************************************
@@ -76,6 +89,14 @@ namespace OA {
 
     //! Insert must def location 
     void insertMustDefForStmt(StmtHandle stmt, OA_ptr<Location> def);
+
+    //! map proc to the DepDFSet from its entry to its exit
+    void mapProcToSummary(ProcHandle proc, OA_ptr<DepDFSet> depDFSet)
+      { mProcSummary[proc] = depDFSet; }
+
+    //! map call to the callee summaries mapped into the caller
+    void mapCallToSummary(CallHandle call, OA_ptr<DepDFSet> depDFSet)
+      { mCallSummary[call] = depDFSet; }
    
     //*****************************************************************
     // Annotation Interface
@@ -88,10 +109,18 @@ namespace OA {
     void dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir);
 
   private:
+    OA_ptr<DepDFSet> getDeps(StmtHandle stmt);
+
     std::map<StmtHandle,OA_ptr<DepDFSet> > mDepDFSet;
 
     std::map<StmtHandle,OA_ptr<LocSet> > mMustDefMap;
 
+    std::map<ProcHandle,OA_ptr<DepDFSet> > mProcSummary;
+    std::map<CallHandle,OA_ptr<DepDFSet> > mCallSummary;
+
+    //! what statements without a DepDFSet are queried with
+    OA_ptr<DepDFSet> mNoDeps;
+
 };
 
 
@@ -29,12 +29,13 @@ ManagerDepStandard::ManagerDepStandard(OA_ptr<ActivityIRInterface> _ir)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_ManagerDepStandard:ALL", debug);
     mSolver = new DataFlow::CFGDFSolver(DataFlow::CFGDFSolver::Forward,*this);
+    mLocTable = new DepLocTable;
 }
 
 OA_ptr<DataFlow::DataFlowSet> ManagerDepStandard::initializeTop()
 {
     OA_ptr<DepDFSet>  retval;
-    retval = new DepDFSet;
+    retval = new DepDFSet(mLocTable);
     return retval;
 }
 
@@ -163,7 +164,7 @@ ManagerDepStandard::transfer(OA_ptr<DataFlow::DataFlowSet> in,
     
     // new DepDFSet for this stmt
     OA_ptr<DepDFSet> stmtDepDFSet;
-    stmtDepDFSet = new DepDFSet;
+    stmtDepDFSet = new DepDFSet(mLocTable);
     
     // set of must defs and differentiable uses for this statement
     LocSet mustDefSet;
@@ -276,8 +277,10 @@ ManagerDepStandard::transfer(OA_ptr<DataFlow::DataFlowSet> in,
             eTreePtr->acceptVisitor(evalVisitor);
             if (debug) { eTreePtr->dump(std::cout,mIR); }
             if ( evalVisitor.isMemRef() ) {
-                MemRefHandle memref = evalVisitor.getMemRef();
-                assert(0); // need to rewrite alg, see MMS
+                // ParamBindings can't tell us about reference parameters
+                // anymore, so like ManagerICFGDep all actuals are
+                // treated as uses, which is conservative
+                //MemRefHandle memref = evalVisitor.getMemRef();
                 //if (mParamBind->isRefParam(
                 //        mParamBind->getCalleeFormal(call,memref)) )
                 //{
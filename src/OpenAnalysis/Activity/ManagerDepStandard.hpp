@@ -53,6 +53,12 @@ public:
         OA_ptr<DataFlow::ParamBindings> paramBind,
         DataFlow::DFPImplement algorithm);
 
+  //! table the locations of the DepDFSets this manager builds are
+  //! numbered in; each manager starts with a table of its own, and
+  //! managers whose sets are composed with each other can share one
+  OA_ptr<DepLocTable> getLocTable() { return mLocTable; }
+  void setLocTable(OA_ptr<DepLocTable> locTable) { mLocTable = locTable; }
+
   //------------------------------------------------------------------
   // Implementing the callbacks for CFGDFProblem
   //------------------------------------------------------------------
@@ -85,6 +91,7 @@ private: // member variables
   OA_ptr<InterDep> mInterDep;
   OA_ptr<CFG::CFGInterface> mCFG;
   OA_ptr<DataFlow::ParamBindings> mParamBind;
+  OA_ptr<DepLocTable> mLocTable;
   // Added by PLM 07/26/06
   OA_ptr<DataFlow::CFGDFSolver> mSolver;
   
@@ -10,11 +10,6 @@
   Copyright (c) 2006, Contributors <br>
   All rights reserved. <br>
   See ../../../Copyright.txt for details. <br>
-
-
-  Side-effect results are used to estimate the effect of procedure calls.
-  Also used to seed independent and dependent variables for procedures who
-  have unknown loc in their independent or dependent location seeds.
 */
 
 #include "ManagerEachActive.hpp"
@@ -27,13 +22,14 @@ namespace OA {
 static bool debug = false;
 
 ManagerEachActive::ManagerEachActive(
-    OA_ptr<Activity::ActivityIRInterface> _ir) : mIR(_ir)
+    OA_ptr<Activity::ActivityIRInterface> _ir) : mIR(_ir), mNumThreads(0)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_ManagerEachActive:ALL", debug);
 }
 
 /*!
-   Just calls ManagerActiveStandard::performAnalysis on each procedure
+   Gathers the input for each procedure, analyzes the procedures on a
+   ThreadPool, then maps each procedure to its ActiveStandard.
 */
 OA_ptr<InterActive> 
 ManagerEachActive::performAnalysis(
@@ -45,22 +41,57 @@ ManagerEachActive::performAnalysis(
   OA_ptr<InterActive> retval;
   retval = new InterActive;
 
-  // Iterate over the procedures
+  // the tasks refer to the inputs, so the vector must not grow
+  // once the first task has been added
+  std::vector<ProcInput> inputs;
   for ( procIter->reset(); procIter->isValid(); ++(*procIter)) { 
-    
-    ProcHandle proc = (irhandle_t)(procIter->current().hval());
+    inputs.push_back(ProcInput());
+    ProcInput& input = inputs.back();
+    input.proc = (irhandle_t)(procIter->current().hval());
+
+    // get Alias::Interface and CFG for this proc
+    input.alias = interAlias->getAliasResults(input.proc);
+    input.cfg = eachCFG->getCFGResults(input.proc);
+
+    // the sets for calls are numbered in the table of the dep manager,
+    // so the procedures don't share any table
+    input.depman = new ManagerDepStandard(mIR);
+    gatherInput(input, interSE);
+
+    input.varyman = new ManagerVaryStandard(mIR);
+    input.usefulman = new ManagerUsefulStandard(mIR);
+    input.activeman = new ManagerActiveStandard(mIR);
+  }
 
-    // get Alias::Interface for this proc
-    OA_ptr<Alias::Interface> alias;
-    alias = interAlias->getAliasResults(proc);
+  ThreadPool pool(mNumThreads);
+  std::vector<ProcInput>::iterator inputIter;
+  for (inputIter=inputs.begin(); inputIter!=inputs.end(); inputIter++) {
+    OA_ptr<ThreadTask> task;
+    task = new ProcTask(*this, *inputIter);
+    pool.add(task);
+  }
+  pool.wait();
 
-    // get CFG for this proc
-    OA_ptr<CFG::CFGInterface> cfg;
-    cfg = eachCFG->getCFGResults(proc);
+  // put activity results in InterActive
+  for (inputIter=inputs.begin(); inputIter!=inputs.end(); inputIter++) {
+    if (debug) { inputIter->active->dump(std::cout, mIR); }
+    retval->mapProcToActive(inputIter->proc, inputIter->active);
+  }
+ 
+  return retval;
+}
 
-    // create Active manager
-    OA_ptr<Activity::ManagerActiveStandard> activeman;
-    activeman = new Activity::ManagerActiveStandard(mIR);
+/*!
+   Side-effect results are used to estimate the effect of procedure
+   calls.  Also used to seed independent and dependent variables for
+   procedures who have unknown loc in their independent or dependent
+   location seeds.
+*/
+void ManagerEachActive::gatherInput(ProcInput& input,
+        OA_ptr<SideEffect::InterSideEffectInterface> interSE)
+{
+    ProcHandle proc = input.proc;
+    OA_ptr<Alias::Interface> alias = input.alias;
 
     // get iterator over independent locations for procedure
     OA_ptr<LocIterator> indepIter;
@@ -105,12 +136,13 @@ ManagerEachActive::performAnalysis(
             break;
         }
     }
+    input.indepSet = new DataFlow::LocDFSet;
+    for ( indepIter->reset(); indepIter->isValid(); (*indepIter)++) {
+        input.indepSet->insert(indepIter->current());
+    }
     if (debug) {
-      std::cout << "\tManagerEachActive, Indep locations: " << std::cout;
-      for ( indepIter->reset(); indepIter->isValid(); (*indepIter)++) {
-        indepIter->current()->dump(std::cout,mIR);
-        //std::cout << mIR->toString(indepIter->current()) << " ";
-      }
+      std::cout << "\tManagerEachActive, Indep locations: " << std::endl;
+      input.indepSet->dump(std::cout,mIR);
       std::cout << "----" << std::endl;
     }
     
@@ -122,25 +154,62 @@ ManagerEachActive::performAnalysis(
             break;
         }
     }
+    input.depSet = new DataFlow::LocDFSet;
+    for ( depIter->reset(); depIter->isValid(); (*depIter)++) {
+        input.depSet->insert(depIter->current());
+    }
     if (debug) {
-      std::cout << "\tManagerEachActive, Dep locations: " << std::cout;
-      for ( depIter->reset(); depIter->isValid(); (*depIter)++) {
-        depIter->current()->dump(std::cout,mIR);
-        //std::cout << mIR->toString(depIter->current()) << " ";
-      }
+      std::cout << "\tManagerEachActive, Dep locations: " << std::endl;
+      input.depSet->dump(std::cout,mIR);
       std::cout << "----" << std::endl;
     }
-    
-    assert(0); // this is broken as of 4/4/05
-    //OA_ptr<ActiveStandard> active = activeman->performAnalysis(proc,
-    //                                    cfg,alias,interSE, indepIter, depIter);
 
-    // put activity results in InterMPICFGActivity
-    //retval->mapProcToActive(proc,active);
+    // any location the call may use may reach any location it may
+    // define, other locations are left alone
+    input.callDeps = new InterDep;
+    OA_ptr<IRStmtIterator> stmtIter = mIR->getStmtIterator(proc);
+    for ( ; stmtIter->isValid(); (*stmtIter)++ ) {
+      OA_ptr<IRCallsiteIterator> callIter 
+          = mIR->getCallsites(stmtIter->current());
+      for ( ; callIter->isValid(); ++(*callIter)) {
+        CallHandle call = callIter->current();
+        OA_ptr<DepDFSet> callDep; 
+        callDep = new DepDFSet(input.depman->getLocTable());
+        OA_ptr<LocIterator> useIter = interSE->getUSEIterator(call);
+        OA_ptr<LocIterator> modIter = interSE->getMODIterator(call);
+        for ( ; useIter->isValid(); (*useIter)++ ) {
+          for (modIter->reset(); modIter->isValid(); (*modIter)++ ) {
+            callDep->insertDep(useIter->current(), modIter->current());
+          }
+        }
+        input.callDeps->mapCallToDep(call, callDep);
+      }
+    }
+}
 
-  }
- 
-  return retval;
+/*!
+   Only writes input, so it can run for different procedures at the
+   same time.  Besides the IR it also queries input.alias, which may
+   be shared with other procedures but isn't changed by queries.
+*/
+void ManagerEachActive::analyzeProc(ProcInput& input)
+{
+    OA_ptr<DataFlow::ParamBindings> noParamBind;
+    OA_ptr<DepStandard> dep 
+        = input.depman->performAnalysis(input.proc, input.alias, input.cfg,
+                                        input.callDeps, noParamBind,
+                                        DataFlow::ITERATIVE);
+
+    OA_ptr<VaryStandard> vary 
+        = input.varyman->performAnalysis(input.proc, input.cfg, dep,
+                                         input.indepSet, DataFlow::ITERATIVE);
+
+    OA_ptr<UsefulStandard> useful 
+        = input.usefulman->performAnalysis(input.proc, input.cfg, dep,
+                                           input.depSet, DataFlow::ITERATIVE);
+
+    input.active = input.activeman->performAnalysis(input.proc, input.cfg,
+                                                    input.alias, vary, useful);
 }
  
 
@@ -19,13 +19,20 @@
 //--------------------------------------------------------------------
 // OpenAnalysis headers
 
+#include <vector>
+
 #include <OpenAnalysis/Activity/ManagerActiveStandard.hpp>
+#include <OpenAnalysis/Activity/ManagerDepStandard.hpp>
+#include <OpenAnalysis/Activity/ManagerVaryStandard.hpp>
+#include <OpenAnalysis/Activity/ManagerUsefulStandard.hpp>
+#include <OpenAnalysis/Activity/InterDep.hpp>
 #include <OpenAnalysis/IRInterface/ActivityIRInterface.hpp>
 
 #include <OpenAnalysis/Activity/InterActive.hpp>
 #include <OpenAnalysis/CFG/EachCFGInterface.hpp>
 #include <OpenAnalysis/Alias/InterAliasInterface.hpp>
 #include <OpenAnalysis/SideEffect/InterSideEffectInterface.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 
 namespace OA {
   namespace Activity {
@@ -33,21 +40,76 @@ namespace OA {
 
 /*! 
    Generates InterActive.
+
+   Each procedure is analyzed on its own with ManagerDepStandard,
+   ManagerVaryStandard, ManagerUsefulStandard, and ManagerActiveStandard.
+   The effect of a call is estimated as every location in its USE set
+   reaching every location in its MOD set.
+
+   The alias, side-effect, and CFG results, the seeds, and the call
+   estimates are all gathered before any procedure is analyzed, so
+   the procedures can then be analyzed on a ThreadPool.  The workers
+   still query the alias results of their procedure.  That is safe
+   because Alias::Interface queries only read, AliasMap's included,
+   even when interAlias hands several procedures the same object.
+   The ActiveStandard for each procedure is put in InterActive
+   afterwards, in the order of the procIter.
 */
 class ManagerEachActive {
 public:
   ManagerEachActive(OA_ptr<Activity::ActivityIRInterface> _ir);
   ~ManagerEachActive () {}
 
+  //! threads to analyze procedures on, 0 means ThreadPool's default
+  void setNumThreads(unsigned int numThreads) { mNumThreads = numThreads; }
+
   OA_ptr<InterActive> performAnalysis(
           OA_ptr<IRProcIterator> procIter,
           OA_ptr<Alias::InterAliasInterface> interAlias,
           OA_ptr<SideEffect::InterSideEffectInterface> interSE,
           OA_ptr<CFG::EachCFGInterface> eachCFG);
 
+private:
+  //! what the analysis of one procedure needs, and its result
+  struct ProcInput {
+    ProcHandle proc;
+    OA_ptr<Alias::Interface> alias;
+    OA_ptr<CFG::CFGInterface> cfg;
+    OA_ptr<InterDep> callDeps;
+    OA_ptr<DataFlow::LocDFSet> indepSet;
+    OA_ptr<DataFlow::LocDFSet> depSet;
+
+    // managers are made up front so that only one thread reads the
+    // debug settings
+    OA_ptr<ManagerDepStandard> depman;
+    OA_ptr<ManagerVaryStandard> varyman;
+    OA_ptr<ManagerUsefulStandard> usefulman;
+    OA_ptr<ManagerActiveStandard> activeman;
+
+    OA_ptr<ActiveStandard> active;
+  };
+
+  //! gathers the seeds and call estimates for input.proc
+  void gatherInput(ProcInput& input,
+                   OA_ptr<SideEffect::InterSideEffectInterface> interSE);
+
+  //! runs dep, vary, useful, and active analysis for input.proc
+  void analyzeProc(ProcInput& input);
+
+  class ProcTask : public virtual ThreadTask {
+    public:
+      ProcTask(ManagerEachActive& manager, ProcInput& input)
+          : mManager(manager), mInput(input) {}
+      void run() { mManager.analyzeProc(mInput); }
+    private:
+      ManagerEachActive& mManager;
+      ProcInput& mInput;
+  };
+
 private: // member variables
 
   OA_ptr<Activity::ActivityIRInterface> mIR;
+  unsigned int mNumThreads;
 };
 
   } // end of Activity namespace
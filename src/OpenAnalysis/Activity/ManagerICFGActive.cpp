@@ -24,17 +24,16 @@ namespace OA {
 static bool debug = false;
 
 ManagerICFGActive::ManagerICFGActive(
-    OA_ptr<Activity::ActivityIRInterface> _ir) : mIR(_ir)
+    OA_ptr<Activity::ActivityIRInterface> _ir) 
+    : mIR(_ir), mConcurrent(false), mSummaries(false)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_ManagerICFGActive:ALL", debug);
     mSolver = new DataFlow::ICFGDFSolver(DataFlow::ICFGDFSolver::Backward,*this);
 }
 
 /*!
-   First calls Manager's to get ICFGDep and ICFGUseful results.
-
-   Then does Vary and Activity analysis at same time over the ICFG using
-   an ICFGDFSolver.
+   First calls Manager's to get ICFGDep results, then does the rest
+   of the analysis with them.
 */
 OA_ptr<InterActive> 
 ManagerICFGActive::performAnalysis(
@@ -44,46 +43,86 @@ ManagerICFGActive::performAnalysis(
         OA_ptr<SideEffect::InterSideEffectInterface> interSE,
         DataFlow::DFPImplement algorithm)
 {
-  OA_ptr<InterActive> retval;
-  retval = new InterActive;
-
   // create a Manager that generates dep information for each statement in
   // ICFG
   OA_ptr<ManagerICFGDep> depman;
   depman = new ManagerICFGDep(mIR);
+  depman->setProcSummaries(mSummaries);
   OA_ptr<ICFGDep> icfgDep = depman->performAnalysis(icfg, paramBind,
                                                     interAlias,
                                                     algorithm);
 
   if (debug) { icfgDep->output(*mIR); }
 
- 
-  if (debug) {
-      std::cout << "Calling usefulman->performAnalysis() ...\n";
-      std::cout.flush();
-  }
+  return performAnalysis(icfg, paramBind, interAlias, interSE, icfgDep,
+                         algorithm);
+}
+
+/*!
+   Calls Manager's to get ICFGUseful results and the locations that
+   are varied and active, using the given ICFGDep.
+
+   Then does Activity analysis over the ICFG using an ICFGDFSolver.
+*/
+OA_ptr<InterActive> 
+ManagerICFGActive::performAnalysis(
+        OA_ptr<ICFG::ICFGInterface> icfg,
+        OA_ptr<DataFlow::ParamBindings> paramBind,
+        OA_ptr<Alias::InterAliasInterface> interAlias,
+        OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+        OA_ptr<ICFGDep> icfgDep,
+        DataFlow::DFPImplement algorithm)
+{
+  OA_ptr<InterActive> retval;
+  retval = new InterActive;
 
   OA_ptr<ManagerICFGUseful> usefulman;
   usefulman = new ManagerICFGUseful(mIR);
-  OA_ptr<InterUseful> 
-    interUseful = usefulman->performAnalysis(icfg, paramBind, interAlias, 
-                                             interSE, icfgDep,
-                                             algorithm);
+  OA_ptr<InterUseful> interUseful;
 
-  retval->setNumIterUseful(interUseful->getNumIter());
-  if (debug) { interUseful->output(*mIR); }
-  
   // ManagerICFGVaryActive does vary analysis and determines which
   // locations are active coming Into a stmt and Outof a stmt
-  if (debug) {
-      std::cout << "Calling varyman->performAnalysis() ...\n";
-      std::cout.flush();
-  }
-
   OA_ptr<ManagerICFGVaryActive> varyman;
   varyman = new ManagerICFGVaryActive(mIR);
-  OA_ptr<ActivePerStmt> active = varyman->performAnalysis(icfg, paramBind,
-          interAlias, icfgDep, interUseful,algorithm);
+  OA_ptr<ActivePerStmt> active;
+
+  if (mConcurrent) {
+      if (debug) {
+          std::cout << "Calling usefulman and varyman concurrently ...\n";
+          std::cout.flush();
+      }
+
+      ThreadPool pool(2);
+      OA_ptr<ThreadTask> task;
+      task = new UsefulTask(usefulman, icfg, paramBind, interAlias, interSE,
+                            icfgDep, algorithm, interUseful);
+      pool.add(task);
+      task = new VaryTask(varyman, icfg, paramBind, interAlias, icfgDep,
+                          algorithm);
+      pool.add(task);
+      pool.wait();
+
+      active = varyman->intersectUseful(interUseful);
+
+  } else {
+      if (debug) {
+          std::cout << "Calling usefulman->performAnalysis() ...\n";
+          std::cout.flush();
+      }
+      interUseful = usefulman->performAnalysis(icfg, paramBind, interAlias, 
+                                               interSE, icfgDep,
+                                               algorithm);
+
+      if (debug) {
+          std::cout << "Calling varyman->performAnalysis() ...\n";
+          std::cout.flush();
+      }
+      active = varyman->performAnalysis(icfg, paramBind,
+              interAlias, icfgDep, interUseful,algorithm);
+  }
+
+  retval->setNumIterUseful(interUseful->getNumIter());
+  if (debug) { interUseful->output(*mIR); }
 
   retval->setNumIterVary(active->getNumIter());
   if (debug) { active->output(*mIR); }
@@ -31,6 +31,7 @@
 #include <OpenAnalysis/Alias/InterAliasInterface.hpp>
 #include <OpenAnalysis/SideEffect/InterSideEffectInterface.hpp>
 #include <OpenAnalysis/CallGraph/CallGraphInterface.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 
 namespace OA {
   namespace Activity {
@@ -38,12 +39,35 @@ namespace OA {
 
 /*! 
    Generates InterActive.
+
+   Once ICFGDep has been computed the useful analysis and the vary
+   analysis don't depend on each other, only the intersection of
+   their results does.  With setConcurrentUsefulVary(true) they are
+   run on two threads of a ThreadPool, reading the same ICFG, ICFGDep,
+   ParamBindings, and alias results.  Without OA_ENABLE_THREADS they
+   run one after the other as before.
+
+   With setProcSummaries(true) ManagerICFGDep also summarizes each
+   procedure.  At a summarized call both analyses apply the callee
+   summary along the CALL_RETURN edge and take nothing back from the
+   callee, so the caller no longer waits for the callee to be solved.
+   The callee is still reached from the call, which gives its stmts
+   their sets.  The results at the return can be smaller than
+   without summaries, because they only depend on that call.
 */
 class ManagerICFGActive : public virtual DataFlow::ICFGDFProblem {
 public:
   ManagerICFGActive(OA_ptr<Activity::ActivityIRInterface> _ir);
   ~ManagerICFGActive () {}
 
+  //! whether to run the useful and vary analyses at the same time,
+  //! the default is not to
+  void setConcurrentUsefulVary(bool concurrent) { mConcurrent = concurrent; }
+
+  //! whether to compute and apply procedure summaries, the default
+  //! is not to
+  void setProcSummaries(bool summaries) { mSummaries = summaries; }
+
   OA_ptr<InterActive> performAnalysis(
           OA_ptr<ICFG::ICFGInterface> icfg,
           OA_ptr<DataFlow::ParamBindings> paramBind,
@@ -51,6 +75,17 @@ public:
           OA_ptr<SideEffect::InterSideEffectInterface> interSE,
           DataFlow::DFPImplement algorithm);
 
+  //! uses icfgDep instead of computing it, the ICFGDep doesn't depend
+  //! on the independent and dependent locations so it can be reused
+  //! when only those change
+  OA_ptr<InterActive> performAnalysis(
+          OA_ptr<ICFG::ICFGInterface> icfg,
+          OA_ptr<DataFlow::ParamBindings> paramBind,
+          OA_ptr<Alias::InterAliasInterface> interAlias,
+          OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+          OA_ptr<ICFGDep> icfgDep,
+          DataFlow::DFPImplement algorithm);
+
 private:
   //========================================================
   // implementation of ICFGDFProblem interface
@@ -107,6 +142,64 @@ private:
  OA_ptr<DataFlow::DataFlowSet> callToReturn(ProcHandle caller,
     OA_ptr<DataFlow::DataFlowSet> dfset, CallHandle call, ProcHandle callee);
 
+  //--------------------------------------------------------
+  // tasks for running useful and vary at the same time, each
+  // with its own Manager and solver
+  //--------------------------------------------------------
+  class UsefulTask : public virtual ThreadTask {
+    public:
+      UsefulTask(OA_ptr<ManagerICFGUseful> man,
+                 OA_ptr<ICFG::ICFGInterface> icfg,
+                 OA_ptr<DataFlow::ParamBindings> paramBind,
+                 OA_ptr<Alias::InterAliasInterface> interAlias,
+                 OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+                 OA_ptr<ICFGDep> icfgDep,
+                 DataFlow::DFPImplement algorithm,
+                 OA_ptr<InterUseful>& result)
+          : mMan(man), mICFG(icfg), mParamBind(paramBind),
+            mInterAlias(interAlias), mInterSE(interSE), mICFGDep(icfgDep),
+            mAlgorithm(algorithm), mResult(result) {}
+      void run() 
+      {
+          mResult = mMan->performAnalysis(mICFG, mParamBind, mInterAlias,
+                                          mInterSE, mICFGDep, mAlgorithm);
+      }
+    private:
+      OA_ptr<ManagerICFGUseful> mMan;
+      OA_ptr<ICFG::ICFGInterface> mICFG;
+      OA_ptr<DataFlow::ParamBindings> mParamBind;
+      OA_ptr<Alias::InterAliasInterface> mInterAlias;
+      OA_ptr<SideEffect::InterSideEffectInterface> mInterSE;
+      OA_ptr<ICFGDep> mICFGDep;
+      DataFlow::DFPImplement mAlgorithm;
+      OA_ptr<InterUseful>& mResult;
+  };
+
+  class VaryTask : public virtual ThreadTask {
+    public:
+      VaryTask(OA_ptr<ManagerICFGVaryActive> man,
+               OA_ptr<ICFG::ICFGInterface> icfg,
+               OA_ptr<DataFlow::ParamBindings> paramBind,
+               OA_ptr<Alias::InterAliasInterface> interAlias,
+               OA_ptr<ICFGDep> icfgDep,
+               DataFlow::DFPImplement algorithm)
+          : mMan(man), mICFG(icfg), mParamBind(paramBind),
+            mInterAlias(interAlias), mICFGDep(icfgDep), 
+            mAlgorithm(algorithm) {}
+      void run() 
+      {
+          mMan->performVary(mICFG, mParamBind, mInterAlias, mICFGDep,
+                            mAlgorithm);
+      }
+    private:
+      OA_ptr<ManagerICFGVaryActive> mMan;
+      OA_ptr<ICFG::ICFGInterface> mICFG;
+      OA_ptr<DataFlow::ParamBindings> mParamBind;
+      OA_ptr<Alias::InterAliasInterface> mInterAlias;
+      OA_ptr<ICFGDep> mICFGDep;
+      DataFlow::DFPImplement mAlgorithm;
+  };
+
 private: // member variables
 
   OA_ptr<Activity::ActivityIRInterface> mIR;
@@ -118,6 +211,8 @@ private: // member variables
   OA_ptr<DataFlow::ICFGDFSolver> mSolver;
   OA_ptr<ICFG::ICFGInterface> mICFG;
   OA_ptr<ActivePerStmt> mActive;
+  bool mConcurrent;
+  bool mSummaries;
 };
 
   } // end of Activity namespace
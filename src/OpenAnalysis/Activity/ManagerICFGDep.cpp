@@ -24,7 +24,8 @@ static bool debug = false;
 
 /*!
 */
-ManagerICFGDep::ManagerICFGDep(OA_ptr<ActivityIRInterface> _ir) : mIR(_ir)
+ManagerICFGDep::ManagerICFGDep(OA_ptr<ActivityIRInterface> _ir) 
+    : mIR(_ir), mSummaries(false)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_ManagerICFGDep:ALL", debug);
     mSolver = new DataFlow::ICFGDFSolver(DataFlow::ICFGDFSolver::Forward,*this);
@@ -33,6 +34,7 @@ ManagerICFGDep::ManagerICFGDep(OA_ptr<ActivityIRInterface> _ir) : mIR(_ir)
 
 /*!
     In transfer function creates a DepDFSet for each stmt.
+    Then summarizes each procedure if setProcSummaries(true).
 */
 OA_ptr<ICFGDep> ManagerICFGDep::performAnalysis(
                     OA_ptr<ICFG::ICFGInterface> icfg,
@@ -44,6 +46,7 @@ OA_ptr<ICFGDep> ManagerICFGDep::performAnalysis(
     std::cout << "In ManagerICFGDep::performAnalysis" << std::endl;
   }
   mDep = new ICFGDep();
+  mLocTable = new DepLocTable;
 
   // store results that will be needed in callbacks
   mICFG = icfg;
@@ -53,10 +56,246 @@ OA_ptr<ICFGDep> ManagerICFGDep::performAnalysis(
   // call iterative data-flow solver for ICFG
   mSolver->solve(icfg,algorithm);
 
+  if (mSummaries) {
+    mSummaryState.clear();
+    mEntryNode.clear();
+    mExitNode.clear();
+    OA_ptr<ICFG::NodesIteratorInterface> nodeIter;
+    nodeIter = icfg->getICFGEntryNodesIterator();
+    for ( ; nodeIter->isValid(); ++(*nodeIter)) {
+      OA_ptr<ICFG::NodeInterface> node = nodeIter->currentICFGNode();
+      mEntryNode[node->getProc()] = node;
+    }
+    nodeIter = icfg->getICFGExitNodesIterator();
+    for ( ; nodeIter->isValid(); ++(*nodeIter)) {
+      OA_ptr<ICFG::NodeInterface> node = nodeIter->currentICFGNode();
+      mExitNode[node->getProc()] = node;
+    }
+
+    std::map<ProcHandle,OA_ptr<ICFG::NodeInterface> >::iterator procIter;
+    for (procIter=mEntryNode.begin(); procIter!=mEntryNode.end(); procIter++) {
+      summarizeProc(procIter->first);
+    }
+  }
+
   return mDep;
 
 }
 
+//========================================================
+// procedure summaries
+//========================================================
+
+/*!
+   Composes the stmt DepDFSets over the CFLOW and CALL_RETURN edges of
+   proc, unioning them where paths meet, until the DepDFSet reaching
+   each node no longer changes.  The stmts of a call node are not
+   composed because the solvers only pass the set before the call
+   along the CALL_RETURN edge; the callee summaries are used instead.
+
+   Callees are summarized first.  Reaching a procedure that is still
+   being summarized means recursion, and then neither it nor its
+   callers get a summary.  Neither does a procedure whose exit can't
+   be reached.
+*/
+bool ManagerICFGDep::summarizeProc(ProcHandle proc)
+{
+  std::map<ProcHandle,SummaryState>::iterator state 
+      = mSummaryState.find(proc);
+  if (state != mSummaryState.end()) {
+    return state->second == SUMMARY_DONE;
+  }
+  if (mEntryNode.find(proc) == mEntryNode.end()
+      || mExitNode.find(proc) == mExitNode.end()) 
+  {
+    mSummaryState[proc] = SUMMARY_NONE;
+    return false;
+  }
+  mSummaryState[proc] = SUMMARY_PENDING;
+
+  if (debug) {
+    std::cout << "ManagerICFGDep::summarizeProc " << mIR->toString(proc)
+              << std::endl;
+  }
+
+  // DepDFSet from the entry to the start of each node reached so far
+  std::map<OA_ptr<ICFG::NodeInterface>,OA_ptr<DepDFSet> > inDeps;
+  std::list<OA_ptr<ICFG::NodeInterface> > worklist;
+  OA_ptr<DepDFSet> summary;
+
+  OA_ptr<ICFG::NodeInterface> entry = mEntryNode[proc];
+  inDeps[entry] = new DepDFSet(mLocTable);
+  worklist.push_back(entry);
+  while (!worklist.empty()) {
+    OA_ptr<ICFG::NodeInterface> node = worklist.front();
+    worklist.pop_front();
+
+    OA_ptr<DepDFSet> out;
+    out = new DepDFSet(*inDeps[node]);
+    if (node->getType() == ICFG::CALL_NODE) {
+      OA_ptr<DepDFSet> callDeps = summarizeCall(node, proc);
+      if (callDeps.ptrEqual(0)) {
+        mSummaryState[proc] = SUMMARY_NONE;
+        return false;
+      }
+      out->compose(*callDeps);
+    } else {
+      OA_ptr<CFG::NodeStatementsIteratorInterface> stmtIter 
+          = node->getNodeStatementsIterator();
+      for ( ; stmtIter->isValid(); ++(*stmtIter)) {
+        out->compose(*mDep->getDepDFSet(stmtIter->current()));
+      }
+    }
+    if (node->getType() == ICFG::EXIT_NODE) {
+      summary = out;
+    }
+
+    // meet with what already reaches the successors in proc
+    OA_ptr<ICFG::EdgesIteratorInterface> edgeIter 
+        = node->getICFGOutgoingEdgesIterator();
+    for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+      OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+      if (edge->getType() != ICFG::CFLOW_EDGE
+          && edge->getType() != ICFG::CALL_RETURN_EDGE) 
+      {
+        continue;
+      }
+      OA_ptr<ICFG::NodeInterface> succ = edge->getICFGSink();
+      std::map<OA_ptr<ICFG::NodeInterface>,OA_ptr<DepDFSet> >::iterator
+          found = inDeps.find(succ);
+      if (found == inDeps.end()) {
+        inDeps[succ] = new DepDFSet(*out);
+        worklist.push_back(succ);
+      } else {
+        OA_ptr<DepDFSet> merged;
+        merged = new DepDFSet(*(found->second));
+        merged->setUnion(*out);
+        if (*merged != *(found->second)) {
+          found->second = merged;
+          worklist.push_back(succ);
+        }
+      }
+    }
+  }
+
+  if (summary.ptrEqual(0)) {
+    mSummaryState[proc] = SUMMARY_NONE;
+    return false;
+  }
+  if (debug) {
+    std::cout << "\tsummary = ";
+    summary->dump(std::cout, mIR);
+  }
+  mDep->mapProcToSummary(proc, summary);
+  mSummaryState[proc] = SUMMARY_DONE;
+  return true;
+}
+
+/*!
+   Unions the summaries of the callees of callNode after mapping them
+   into the caller, and records the result for the CallHandle of the
+   CALL_RETURN edge.  A call node with more than one callsite, or with
+   no defined callee, isn't summarized because its CALL_RETURN edge
+   can't tell the callsites apart.
+*/
+OA_ptr<DepDFSet> 
+ManagerICFGDep::summarizeCall(OA_ptr<ICFG::NodeInterface> callNode,
+                              ProcHandle caller)
+{
+  OA_ptr<DepDFSet> retval;
+
+  CallHandle call = CallHandle(0);
+  OA_ptr<ICFG::EdgesIteratorInterface> edgeIter 
+      = callNode->getICFGOutgoingEdgesIterator();
+  for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+    OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+    if (edge->getType() == ICFG::CALL_RETURN_EDGE) {
+      call = edge->getCall();
+    }
+  }
+  if (call == CallHandle(0)) { return retval; }
+
+  // already mapped when the call node was reached before
+  retval = mDep->getCallSummary(call);
+  if (!retval.ptrEqual(0)) { return retval; }
+
+  edgeIter = callNode->getICFGOutgoingEdgesIterator();
+  for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+    OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+    if (edge->getType() != ICFG::CALL_EDGE) { continue; }
+
+    ProcHandle callee = edge->getSinkProc();
+    if (edge->getCall() != call || !summarizeProc(callee)) {
+      OA_ptr<DepDFSet> none;
+      return none;
+    }
+    OA_ptr<DepDFSet> mapped = calleeToCaller(mDep->getProcSummary(callee),
+                                             call, caller, callee);
+    if (retval.ptrEqual(0)) {
+      retval = mapped;
+    } else {
+      retval->setUnion(*mapped);
+    }
+  }
+
+  if (!retval.ptrEqual(0)) {
+    mDep->mapCallToSummary(call, retval);
+  }
+  return retval;
+}
+
+/*!
+   Converts the dep pairs and the removed implicit pairs of the callee
+   summary to the may locations in the caller, as in
+   ManagerInterDep::atCallGraphEdge.  Callee locations with no caller
+   equivalent are dropped, and caller locations the callee can't see
+   keep their implicit pair.
+*/
+OA_ptr<DepDFSet> 
+ManagerICFGDep::calleeToCaller(OA_ptr<DepDFSet> calleeSummary,
+                               CallHandle call, ProcHandle caller,
+                               ProcHandle callee)
+{
+  OA_ptr<DepDFSet> retval;
+  retval = new DepDFSet(mLocTable);
+
+  // removed implicit pairs first, so that pairs inserted below can
+  // put them back
+  OA_ptr<LocIterator> removeIter 
+      = calleeSummary->getImplicitRemovesIterator();
+  for ( ; removeIter->isValid(); (*removeIter)++ ) {
+    DataFlow::CalleeToCallerVisitor visitor(callee, call, caller,
+                                            mInterAlias, mParamBind, mIR);
+    removeIter->current()->acceptVisitor(visitor);
+    OA_ptr<LocIterator> callerIter = visitor.getCallerLocIterator();
+    for ( ; callerIter->isValid(); (*callerIter)++ ) {
+      retval->removeImplicitDep(callerIter->current(), 
+                                callerIter->current());
+    }
+  }
+
+  OA_ptr<DepIterator> depIter = calleeSummary->getDepIterator();
+  for ( ; depIter->isValid(); (*depIter)++ ) {
+    DataFlow::CalleeToCallerVisitor useVisitor(callee, call, caller,
+                                               mInterAlias, mParamBind, mIR);
+    depIter->use()->acceptVisitor(useVisitor);
+    OA_ptr<LocIterator> useIter = useVisitor.getCallerLocIterator();
+
+    DataFlow::CalleeToCallerVisitor defVisitor(callee, call, caller,
+                                               mInterAlias, mParamBind, mIR);
+    depIter->def()->acceptVisitor(defVisitor);
+    OA_ptr<LocIterator> defIter = defVisitor.getCallerLocIterator();
+
+    for ( ; useIter->isValid(); (*useIter)++ ) {
+      for (defIter->reset(); defIter->isValid(); (*defIter)++ ) {
+        retval->insertDep(useIter->current(), defIter->current());
+      }
+    }
+  }
+
+  return retval;
+}
+
 //========================================================
 // implementation of ICFGDFProblem interface
 //========================================================
@@ -67,7 +306,7 @@ OA_ptr<DataFlow::DataFlowSet>
 ManagerICFGDep::initializeTop()
 {
     OA_ptr<DepDFSet>  retval;
-    retval = new DepDFSet;
+    retval = new DepDFSet(mLocTable);
     return retval;
 }
 
@@ -119,7 +358,7 @@ ManagerICFGDep::transfer(ProcHandle proc,
     
     // new DepDFSet for this stmt
     OA_ptr<DepDFSet> stmtDepDFSet;
-    stmtDepDFSet = new DepDFSet;
+    stmtDepDFSet = new DepDFSet(mLocTable);
     
     // set of must defs and differentiable uses for this statement
     LocSet mustDefSet;
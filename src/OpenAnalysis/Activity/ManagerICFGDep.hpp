@@ -16,6 +16,9 @@
 #define ManagerICFGDep_H
 
 //--------------------------------------------------------------------
+#include <list>
+#include <map>
+
 // OpenAnalysis headers
 #include "ICFGDep.hpp"
 #include "DepDFSet.hpp"
@@ -26,6 +29,7 @@
 #include <OpenAnalysis/DataFlow/ICFGDFSolver.hpp>
 #include <OpenAnalysis/DataFlow/ParamBindings.hpp>
 #include <OpenAnalysis/DataFlow/LocDFSet.hpp>
+#include <OpenAnalysis/DataFlow/CalleeToCallerVisitor.hpp>
 #include <OpenAnalysis/IRInterface/IRHandles.hpp>
 
 
@@ -40,6 +44,15 @@ namespace OA {
    FIXME: could be useful to other representations that handle
    propagation to function calls as well and doesn't need to have the
    stmt with a function call include the Dep relations for the call
+
+   With setProcSummaries(true) it also composes the stmt DepDFSets
+   from the entry to the exit of each procedure, applying the
+   summaries of callees at call nodes, and maps the callee summaries
+   of each call node into the caller.  ManagerICFGVaryActive and
+   ManagerICFGUseful then apply them along CALL_RETURN edges instead
+   of what comes back from the callees.
+   Procedures that are recursive, call into recursion, or have calls
+   without a defined callee are not summarized.
 */
 class ManagerICFGDep : public virtual DataFlow::ICFGDFProblem
 {
@@ -52,7 +65,32 @@ public:
                   OA_ptr<DataFlow::ParamBindings> paramBind,
                   OA_ptr<Alias::InterAliasInterface> interAlias,
                   DataFlow::DFPImplement algorithm);
+
+  //! whether performAnalysis also computes procedure summaries,
+  //! off by default
+  void setProcSummaries(bool summaries) { mSummaries = summaries; }
+
 private:
+  //========================================================
+  // procedure summaries
+  //========================================================
+  enum SummaryState { SUMMARY_PENDING, SUMMARY_DONE, SUMMARY_NONE };
+
+  //! composes the DepDFSets from entry to exit of proc, returns
+  //! false if proc can't be summarized
+  bool summarizeProc(ProcHandle proc);
+
+  //! dependences across callNode mapped into caller, null if a callee
+  //! can't be summarized
+  OA_ptr<DepDFSet> summarizeCall(OA_ptr<ICFG::NodeInterface> callNode,
+                                 ProcHandle caller);
+
+  //! maps the summary of callee into the caller at call
+  OA_ptr<DepDFSet> calleeToCaller(OA_ptr<DepDFSet> calleeSummary,
+                                  CallHandle call, ProcHandle caller,
+                                  ProcHandle callee);
+
+
   //========================================================
   // implementation of ICFGDFProblem interface
   //========================================================
@@ -121,6 +159,13 @@ private: // member variables
   OA_ptr<DataFlow::ParamBindings> mParamBind;
   OA_ptr<DataFlow::ICFGDFSolver> mSolver;
   OA_ptr<ICFG::ICFGInterface> mICFG;
+  //! numbers the locations of the sets built by performAnalysis
+  OA_ptr<DepLocTable> mLocTable;
+
+  bool mSummaries;
+  std::map<ProcHandle,SummaryState> mSummaryState;
+  std::map<ProcHandle,OA_ptr<ICFG::NodeInterface> > mEntryNode;
+  std::map<ProcHandle,OA_ptr<ICFG::NodeInterface> > mExitNode;
 
 };
 
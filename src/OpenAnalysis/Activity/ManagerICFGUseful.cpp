@@ -48,6 +48,8 @@ ManagerICFGUseful::performAnalysis(
   // create an empty InterUseful
   mInterUseful = new InterUseful();
 
+  findSummarizedCalls();
+
   // call iterative data-flow solver for ICFG
   mSolver->solve(icfg,algorithm);
 
@@ -68,6 +70,72 @@ ManagerICFGUseful::performAnalysis(
   return mInterUseful;
 }
 
+/*!
+   A summarized call only needs the useful set at the return node:
+   the summary gives what is useful before the call, so nothing has
+   to come back from the callees.  That doesn't hold when a callee or
+   one of its callees has dep locations, because those are useful no
+   matter what the caller uses afterwards.
+*/
+void ManagerICFGUseful::findSummarizedCalls()
+{
+  mSummarizedCalls.clear();
+
+  // the callees of each call, and the callers of each procedure
+  std::map<CallHandle,std::set<ProcHandle> > callees;
+  std::map<ProcHandle,std::set<ProcHandle> > callers;
+  OA_ptr<ICFG::EdgesIteratorInterface> edgeIter 
+      = mICFG->getICFGEdgesIterator();
+  for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+    OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+    if (edge->getType() == ICFG::CALL_EDGE) {
+      callees[edge->getCall()].insert(edge->getSinkProc());
+      callers[edge->getSinkProc()].insert(edge->getSourceProc());
+    }
+  }
+
+  // procedures with dep locations and all of their callers
+  std::set<ProcHandle> seeded;
+  std::list<ProcHandle> worklist;
+  OA_ptr<ICFG::NodesIteratorInterface> nodeIter 
+      = mICFG->getICFGEntryNodesIterator();
+  for ( ; nodeIter->isValid(); ++(*nodeIter)) {
+    ProcHandle proc = nodeIter->currentICFGNode()->getProc();
+    OA_ptr<MemRefExprIterator> depIter = mIR->getDepMemRefExprIter(proc);
+    depIter->reset();
+    if (depIter->isValid() && seeded.insert(proc).second) {
+      worklist.push_back(proc);
+    }
+  }
+  while (!worklist.empty()) {
+    std::set<ProcHandle>& procCallers = callers[worklist.front()];
+    worklist.pop_front();
+    std::set<ProcHandle>::iterator callerIter;
+    for (callerIter=procCallers.begin(); callerIter!=procCallers.end();
+         callerIter++) 
+    {
+      if (seeded.insert(*callerIter).second) {
+        worklist.push_back(*callerIter);
+      }
+    }
+  }
+
+  std::map<CallHandle,std::set<ProcHandle> >::iterator callIter;
+  for (callIter=callees.begin(); callIter!=callees.end(); callIter++) {
+    if (mICFGDep->getCallSummary(callIter->first).ptrEqual(0)) {
+      continue;
+    }
+    bool summarized = true;
+    std::set<ProcHandle>::iterator calleeIter;
+    for (calleeIter=callIter->second.begin(); 
+         calleeIter!=callIter->second.end(); calleeIter++) 
+    {
+      if (seeded.find(*calleeIter) != seeded.end()) { summarized = false; }
+    }
+    if (summarized) { mSummarizedCalls.insert(callIter->first); }
+  }
+}
+
 //========================================================
 // implementation of ICFGDFProblem interface
 //========================================================
@@ -330,6 +398,11 @@ ManagerICFGUseful::calleeToCaller(ProcHandle callee,
     if (debug) {
         std::cout << "-------- ManagerICFGUseful::calleeToCaller" << std::endl;
     }
+    // callToReturn applies the summary instead
+    if (mSummarizedCalls.find(call) != mSummarizedCalls.end()) {
+        return initializeTop();
+    }
+
     OA_ptr<DataFlow::LocDFSet> inRecast = dfset.convert<DataFlow::LocDFSet>();
 
     if (debug) {
@@ -454,6 +527,23 @@ ManagerICFGUseful::callToReturn(ProcHandle caller,
   retval = temp.convert<DataFlow::LocDFSet>();
   OA_ptr<LocIterator> usefulIter = remapdfset->getLocIterator();
 
+  // The uses in the summarized callees that the useful set depends
+  // on, including the useful locations they leave alone, are all
+  // that is useful before the call.  calleeToCaller adds nothing for
+  // these calls.
+  if (mSummarizedCalls.find(call) != mSummarizedCalls.end()) {
+      OA_ptr<DepDFSet> summary = mICFGDep->getCallSummary(call);
+      retval = new DataFlow::LocDFSet;
+      for ( ; usefulIter->isValid(); (*usefulIter)++ ) {
+          OA_ptr<LocIterator> useIter 
+              = summary->getUsesIterator(usefulIter->current());
+          for ( ; useIter->isValid(); (*useIter)++ ) {
+              retval->insert(useIter->current());
+          }
+      }
+      return retval;
+  }
+
   // Remove NonLocal Locations from the Useful Set
   usefulIter->reset();
   std::set<OA_ptr<Location> > removeLocs;
@@ -63,6 +63,10 @@ public:
                   DataFlow::DFPImplement algorithm);
 
 private:
+  //! the calls with a summary in ICFGDep whose callees, and their
+  //! callees, have no dep locations
+  void findSummarizedCalls();
+
   //========================================================
   // implementation of ICFGDFProblem interface
   //========================================================
@@ -134,6 +138,10 @@ private:
 
   std::map<ProcHandle,OA_ptr<UsefulStandard> > mUsefulMap;
 
+  //! calls whose call nodes get the ICFGDep summary applied to the
+  //! useful set at the return instead of what comes from the callee
+  std::set<CallHandle> mSummarizedCalls;
+
 };
 
   } // end of Activity namespace
@@ -38,32 +38,137 @@ ManagerICFGVaryActive::performAnalysis(
         OA_ptr<ICFGDep> icfgDep,
         OA_ptr<InterUseful> interUseful,
         DataFlow::DFPImplement algorithm)
+{
+  performVary(icfg, paramBind, interAlias, icfgDep, algorithm);
+  return intersectUseful(interUseful);
+}
+
+/*!
+   Solves for the vary sets, which are left in the InActive and
+   OutActive sets of the returned ActivePerStmt until intersectUseful
+   is called.  Doesn't need the useful results, so it can run at the
+   same time as ManagerICFGUseful.
+*/
+OA_ptr<Activity::ActivePerStmt> 
+ManagerICFGVaryActive::performVary(
+        OA_ptr<ICFG::ICFGInterface> icfg,
+        OA_ptr<DataFlow::ParamBindings> paramBind,
+        OA_ptr<Alias::InterAliasInterface> interAlias,
+        OA_ptr<ICFGDep> icfgDep,
+        DataFlow::DFPImplement algorithm)
 {
   // store results that will be needed in callbacks
   mICFG = icfg;
   mParamBind = paramBind;
   mICFGDep = icfgDep;
   mInterAlias = interAlias;
-  mInterUseful = interUseful;
 
   // create an empty ActivePerStmt
   mActive = new ActivePerStmt();
 
+  findSummarizedCalls();
+
   // call iterative data-flow solver for ICFG
   mSolver->solve(icfg,algorithm);
 
+  mActive->setNumIter(mSolver->getNumIter());
+    
+  if (debug) {
+      std:: cout << std::endl << "%+%+%+%+ Vary numIter = " 
+       << mSolver->getNumIter() 
+       << " +%+%+%+%" << std::endl << std::endl;
+  }
+
+  return mActive;
+}
+
+/*!
+   A summarized call only needs the vary set at the call node: the
+   summary gives what is varied after the call, so nothing has to
+   come back from the callees.  That doesn't hold when a callee or
+   one of its callees has indep locations, because those are varied
+   no matter what the caller passes in.
+*/
+void ManagerICFGVaryActive::findSummarizedCalls()
+{
+  mSummarizedCalls.clear();
+
+  // the callees of each call, and the callers of each procedure
+  std::map<CallHandle,std::set<ProcHandle> > callees;
+  std::map<ProcHandle,std::set<ProcHandle> > callers;
+  OA_ptr<ICFG::EdgesIteratorInterface> edgeIter 
+      = mICFG->getICFGEdgesIterator();
+  for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+    OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+    if (edge->getType() == ICFG::CALL_EDGE) {
+      callees[edge->getCall()].insert(edge->getSinkProc());
+      callers[edge->getSinkProc()].insert(edge->getSourceProc());
+    }
+  }
+
+  // procedures with indep locations and all of their callers
+  std::set<ProcHandle> seeded;
+  std::list<ProcHandle> worklist;
+  OA_ptr<ICFG::NodesIteratorInterface> nodeIter 
+      = mICFG->getICFGEntryNodesIterator();
+  for ( ; nodeIter->isValid(); ++(*nodeIter)) {
+    ProcHandle proc = nodeIter->currentICFGNode()->getProc();
+    OA_ptr<MemRefExprIterator> indepIter = mIR->getIndepMemRefExprIter(proc);
+    indepIter->reset();
+    if (indepIter->isValid() && seeded.insert(proc).second) {
+      worklist.push_back(proc);
+    }
+  }
+  while (!worklist.empty()) {
+    std::set<ProcHandle>& procCallers = callers[worklist.front()];
+    worklist.pop_front();
+    std::set<ProcHandle>::iterator callerIter;
+    for (callerIter=procCallers.begin(); callerIter!=procCallers.end();
+         callerIter++) 
+    {
+      if (seeded.insert(*callerIter).second) {
+        worklist.push_back(*callerIter);
+      }
+    }
+  }
+
+  std::map<CallHandle,std::set<ProcHandle> >::iterator callIter;
+  for (callIter=callees.begin(); callIter!=callees.end(); callIter++) {
+    if (mICFGDep->getCallSummary(callIter->first).ptrEqual(0)) {
+      continue;
+    }
+    bool summarized = true;
+    std::set<ProcHandle>::iterator calleeIter;
+    for (calleeIter=callIter->second.begin(); 
+         calleeIter!=callIter->second.end(); calleeIter++) 
+    {
+      if (seeded.find(*calleeIter) != seeded.end()) { summarized = false; }
+    }
+    if (summarized) { mSummarizedCalls.insert(callIter->first); }
+  }
+}
+
+/*!
+   Replaces the vary sets from performVary with the locations that
+   are both varied and useful.
+*/
+OA_ptr<Activity::ActivePerStmt> 
+ManagerICFGVaryActive::intersectUseful(OA_ptr<InterUseful> interUseful)
+{
+  mInterUseful = interUseful;
+
   OA_ptr<DataFlow::LocDFSet> retval;
   OA_ptr<LocIterator> usefulIter;
   OA_ptr<DataFlow::LocDFSet> varySet;
 
   // For each ICFG node:
   OA_ptr<ICFG::NodesIteratorInterface> nodeIter =
-    icfg->getICFGNodesIterator();
+    mICFG->getICFGNodesIterator();
   for ( ; nodeIter->isValid(); (*nodeIter)++) {
     OA_ptr<ICFG::NodeInterface> icfgNode = nodeIter->currentICFGNode();
     // get alias and active results for current procedure
     ProcHandle proc = icfgNode->getProc();
-    OA_ptr<Alias::Interface> alias = interAlias->getAliasResults(proc);
+    OA_ptr<Alias::Interface> alias = mInterAlias->getAliasResults(proc);
     OA_ptr<UsefulStandard> useful = mInterUseful->getUsefulResults(proc);
 
     // For each stmt in the ICFG node:
@@ -143,15 +248,7 @@ ManagerICFGVaryActive::performAnalysis(
     }
   }
 
-  
-  mActive->setNumIter(mSolver->getNumIter());
-    
-  if (debug) {
-      std:: cout << std::endl << "%+%+%+%+ Vary numIter = " 
-       << mSolver->getNumIter() 
-       << " +%+%+%+%" << std::endl << std::endl;
-  }
-    
+
   return mActive;
 }
 
@@ -466,6 +563,11 @@ OA_ptr<DataFlow::DataFlowSet>
 ManagerICFGVaryActive::calleeToCaller(ProcHandle callee,
     OA_ptr<DataFlow::DataFlowSet> dfset, CallHandle call, ProcHandle caller)
 {
+    // callToReturn applies the summary instead
+    if (mSummarizedCalls.find(call) != mSummarizedCalls.end()) {
+        return initializeTop();
+    }
+
     OA_ptr<DataFlow::LocDFSet> inRecast = dfset.convert<DataFlow::LocDFSet>();
     return inRecast->calleeToCaller(callee,call,caller,mInterAlias,
                                     mParamBind,mIR);
@@ -483,6 +585,22 @@ ManagerICFGVaryActive::callToReturn(ProcHandle caller,
   retval = temp.convert<DataFlow::LocDFSet>();
   OA_ptr<LocIterator> varyIter = remapdfset->getLocIterator();
 
+  // What the summarized callees define from the vary set, including
+  // the vary locations they leave alone, is all that is varied after
+  // the call.  calleeToCaller adds nothing for these calls.
+  if (mSummarizedCalls.find(call) != mSummarizedCalls.end()) {
+      OA_ptr<DepDFSet> summary = mICFGDep->getCallSummary(call);
+      retval = new DataFlow::LocDFSet;
+      for ( ; varyIter->isValid(); (*varyIter)++ ) {
+          OA_ptr<LocIterator> defIter 
+              = summary->getDefsIterator(varyIter->current());
+          for ( ; defIter->isValid(); (*defIter)++ ) {
+              retval->insert(defIter->current());
+          }
+      }
+      return retval;
+  }
+
   /**********
    * new pseudocode for removing killed definitions inside 
    * procedure along CallReturn Edge.
@@ -57,6 +57,16 @@ public:
                   OA_ptr<InterUseful> interUseful,
                   DataFlow::DFPImplement algorithm);
 
+  //! the two halves of performAnalysis, performVary doesn't use the
+  //! useful results
+  OA_ptr<ActivePerStmt> 
+  performVary(OA_ptr<ICFG::ICFGInterface> icfg,
+              OA_ptr<DataFlow::ParamBindings> paramBind,
+              OA_ptr<Alias::InterAliasInterface> interAlias,
+              OA_ptr<ICFGDep> icfgDep,
+              DataFlow::DFPImplement algorithm);
+  OA_ptr<ActivePerStmt> intersectUseful(OA_ptr<InterUseful> interUseful);
+
 private:
   //========================================================
   // helper routines
@@ -65,6 +75,10 @@ private:
         OA_ptr<LocIterator> varyIter,
         OA_ptr<LocIterator> usefulIter, StmtHandle stmt);
 
+  //! the calls with a summary in ICFGDep whose callees, and their
+  //! callees, have no indep locations
+  void findSummarizedCalls();
+
   //========================================================
   // implementation of ICFGDFProblem interface
   //========================================================
@@ -130,6 +144,9 @@ private:
   OA_ptr<DataFlow::ICFGDFSolver> mSolver;
   OA_ptr<ICFG::ICFGInterface> mICFG;
 
+  //! calls whose return nodes get the ICFGDep summary applied to
+  //! the vary set at the call instead of what returns from the callee
+  std::set<CallHandle> mSummarizedCalls;
 };
 
   } // end of Activity namespace
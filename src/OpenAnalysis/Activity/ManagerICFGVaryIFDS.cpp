@@ -0,0 +1,248 @@
+/*! \file
+
+  \brief Vary analysis as an IFDS problem.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerICFGVaryIFDS.hpp"
+#include <Utils/Util.hpp>
+
+
+namespace OA {
+  namespace Activity {
+
+static bool debug = false;
+
+ManagerICFGVaryIFDS::ManagerICFGVaryIFDS(
+        OA_ptr<ActivityIRInterface> _ir) : mIR(_ir)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerICFGVaryIFDS:ALL", debug);
+    mSolver = new DataFlow::ICFGIFDSSolver(DataFlow::ICFGIFDSSolver::Forward,
+                                           *this);
+}
+
+/*!
+   Solves for the facts before each ICFG node, then walks the
+   statements of the node to get the sets before and after each one,
+   as ManagerICFGVaryActive's transfer records them.
+*/
+OA_ptr<Activity::ActivePerStmt>
+ManagerICFGVaryIFDS::performVary(
+        OA_ptr<ICFG::ICFGInterface> icfg,
+        OA_ptr<DataFlow::ParamBindings> paramBind,
+        OA_ptr<Alias::InterAliasInterface> interAlias,
+        OA_ptr<ICFGDep> icfgDep)
+{
+  // store results that will be needed in callbacks
+  mICFG = icfg;
+  mParamBind = paramBind;
+  mICFGDep = icfgDep;
+  mInterAlias = interAlias;
+  mFacts = DataFlow::IFDSFactTable<OA_ptr<Location> >();
+  mKilledAt.clear();
+
+  // create an empty ActivePerStmt
+  mActive = new ActivePerStmt();
+
+  mSolver->solve(icfg);
+
+  OA_ptr<ICFG::NodesIteratorInterface> nodeIter =
+    mICFG->getICFGNodesIterator();
+  for ( ; nodeIter->isValid(); (*nodeIter)++) {
+    OA_ptr<ICFG::NodeInterface> icfgNode = nodeIter->currentICFGNode();
+    ProcHandle proc = icfgNode->getProc();
+
+    OA_ptr<DataFlow::IFDSFactSet> facts = mSolver->getInFacts(icfgNode);
+    OA_ptr<CFG::NodeStatementsIteratorInterface> stmtIter =
+      icfgNode->getNodeStatementsIterator();
+    for ( ; stmtIter->isValid(); (*stmtIter)++) {
+      StmtHandle stmt = stmtIter->current();
+      mActive->copyIntoInActive(stmt, toLocDFSet(*facts));
+
+      OA_ptr<DataFlow::IFDSFactSet> outFacts;
+      outFacts = new DataFlow::IFDSFactSet;
+      DataFlow::IFDSFactSet::iterator factIter;
+      for (factIter=facts->begin(); factIter!=facts->end(); factIter++) {
+        transfer(proc, *factIter, stmt, *outFacts);
+      }
+      mActive->copyIntoOutActive(stmt, toLocDFSet(*outFacts));
+      facts = outFacts;
+    }
+  }
+
+  if (debug) {
+      std::cout << std::endl << "%+%+%+%+ Vary IFDS facts = "
+       << mFacts.size() << ", path edges = " << mSolver->getNumPathEdges()
+       << " +%+%+%+%" << std::endl << std::endl;
+  }
+
+  return mActive;
+}
+
+//========================================================
+// helper routines
+//========================================================
+
+OA_ptr<DataFlow::LocDFSet>
+ManagerICFGVaryIFDS::toLocDFSet(const DataFlow::IFDSFactSet& facts)
+{
+    OA_ptr<DataFlow::LocDFSet> retval;
+    retval = new DataFlow::LocDFSet;
+    DataFlow::IFDSFactSet::const_iterator factIter;
+    for (factIter=facts.begin(); factIter!=facts.end(); factIter++) {
+        if (*factIter != DataFlow::IFDS_ZERO_FACT) {
+            retval->insert(mFacts.getValue(*factIter));
+        }
+    }
+    return retval;
+}
+
+void ManagerICFGVaryIFDS::insertFacts(OA_ptr<LocIterator> locIter,
+                                      DataFlow::IFDSFactSet& result)
+{
+    for (locIter->reset(); locIter->isValid(); (*locIter)++) {
+        result.insert(mFacts.getFact(locIter->current()));
+    }
+}
+
+/*!
+   The may locs of each deref of each actual, derefed until there
+   are none, as ManagerICFGVaryActive::callToReturn finds them.
+*/
+std::list<OA_ptr<Location> >&
+ManagerICFGVaryIFDS::killedAt(CallHandle call, ProcHandle caller)
+{
+  std::map<CallHandle,std::list<OA_ptr<Location> > >::iterator found
+      = mKilledAt.find(call);
+  if (found != mKilledAt.end()) { return found->second; }
+
+  std::list<OA_ptr<Location> >& killed = mKilledAt[call];
+  OA_ptr<Alias::Interface> callerAlias = mInterAlias->getAliasResults(caller);
+  OA_ptr<MemRefHandleIterator> mrefIter;
+  mrefIter = mParamBind->getActualIterator(call);
+  for( ;mrefIter->isValid(); ++(*mrefIter) ) {
+      OA_ptr<MemRefExprIterator> mreIter;
+      mreIter = mIR->getMemRefExprIterator(mrefIter->current());
+      for (; mreIter->isValid(); (*mreIter)++) {
+           OA_ptr<MemRefExpr> deref_mre = mreIter->current()->clone();
+           bool found_locs = true;
+           while (found_locs) {
+                found_locs = false;
+                OA_ptr<MemRefExpr> nullmre;
+                OA_ptr<Deref> deref;
+                deref = new Deref(MemRefExpr::USE,nullmre,1);
+                deref_mre = deref->composeWith(deref_mre);
+                OA_ptr<LocIterator> mayLocIter;
+                mayLocIter = callerAlias->getMayLocs(*deref_mre,caller);
+                for (; mayLocIter->isValid(); (*mayLocIter)++) {
+                     found_locs = true;
+                     killed.push_back(mayLocIter->current());
+                }
+           }
+      }
+  }
+  return killed;
+}
+
+//========================================================
+// implementation of ICFGIFDSProblem interface
+//========================================================
+
+/*!
+   The locations of the indep vars of proc, which
+   ManagerICFGVaryActive::entryTransfer adds on every entry
+*/
+void ManagerICFGVaryIFDS::initialFacts(ProcHandle proc,
+                                       DataFlow::IFDSFactSet& result)
+{
+    OA_ptr<MemRefExprIterator> indepIter = mIR->getIndepMemRefExprIter(proc);
+    OA_ptr<Alias::Interface> alias = mInterAlias->getAliasResults(proc);
+    for ( indepIter->reset(); indepIter->isValid(); (*indepIter)++ ) {
+        insertFacts(alias->getMayLocs(*indepIter->current(),proc), result);
+    }
+}
+
+//! the locations that may be defined from fact in stmt
+void ManagerICFGVaryIFDS::transfer(ProcHandle proc, DataFlow::IFDSFact fact,
+                                   OA::StmtHandle stmt,
+                                   DataFlow::IFDSFactSet& result)
+{
+    if (fact == DataFlow::IFDS_ZERO_FACT) { return; }
+    insertFacts(mICFGDep->getMayDefIterator(stmt, mFacts.getValue(fact)),
+                result);
+}
+
+//! what the location maps to in callee, and the location itself if
+//! it is a non local or a subset of one
+void ManagerICFGVaryIFDS::callerToCallee(ProcHandle caller,
+                                         DataFlow::IFDSFact fact,
+                                         CallHandle call, ProcHandle callee,
+                                         DataFlow::IFDSFactSet& result)
+{
+  if (fact == DataFlow::IFDS_ZERO_FACT) { return; }
+  OA_ptr<Location> loc = mFacts.getValue(fact);
+  DataFlow::LocDFSet single;
+  single.insert(loc);
+
+  OA_ptr<DataFlow::LocDFSet> mapped;
+  mapped = single.callerToCallee(caller,call,callee,mInterAlias,
+                                 mParamBind,mIR);
+  insertFacts(mapped->getLocIterator(), result);
+  mapped = single.callerToCalleeTransitive(caller,call,callee,mInterAlias,
+                                           mParamBind,mIR);
+  insertFacts(mapped->getLocIterator(), result);
+
+  OA_ptr<Location> base = loc;
+  if (loc->isaSubSet()) { base = loc.convert<LocSubSet>()->getLoc(); }
+  if (base->isaNamed() && !base.convert<NamedLoc>()->isLocal()) {
+      result.insert(fact);
+  }
+}
+
+void ManagerICFGVaryIFDS::calleeToCaller(ProcHandle callee,
+                                         DataFlow::IFDSFact fact,
+                                         CallHandle call, ProcHandle caller,
+                                         DataFlow::IFDSFactSet& result)
+{
+  if (fact == DataFlow::IFDS_ZERO_FACT) { return; }
+  DataFlow::LocDFSet single;
+  single.insert(mFacts.getValue(fact));
+  insertFacts(single.calleeToCaller(callee,call,caller,mInterAlias,
+                                    mParamBind,mIR)->getLocIterator(),
+              result);
+}
+
+/*!
+   Non local named locations and locations the callee must redefine
+   through the actuals go through the callee instead.  What the
+   callee summary in ICFGDep defines from the location is added.
+*/
+void ManagerICFGVaryIFDS::callToReturn(ProcHandle caller,
+                                       DataFlow::IFDSFact fact,
+                                       CallHandle call, ProcHandle callee,
+                                       DataFlow::IFDSFactSet& result)
+{
+  if (fact == DataFlow::IFDS_ZERO_FACT) { return; }
+  OA_ptr<Location> loc = mFacts.getValue(fact);
+
+  bool kept = !(loc->isaNamed() && !loc.convert<NamedLoc>()->isLocal());
+  std::list<OA_ptr<Location> >& killed = killedAt(call, caller);
+  std::list<OA_ptr<Location> >::iterator killIter;
+  for (killIter=killed.begin(); kept && killIter!=killed.end(); killIter++) {
+      if ((*killIter)->mustOverlap(*loc)) { kept = false; }
+  }
+  if (kept) { result.insert(fact); }
+
+  OA_ptr<DepDFSet> summary = mICFGDep->getCallSummary(call);
+  if (!summary.ptrEqual(0)) {
+      insertFacts(summary->getDefsIterator(loc), result);
+  }
+}
+
+  } // end of namespace Activity
+} // end of namespace OA
@@ -0,0 +1,107 @@
+/*! \file
+
+  \brief Declarations of a manager that does Vary analysis as an
+         IFDS problem.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef ManagerICFGVaryIFDS_H
+#define ManagerICFGVaryIFDS_H
+
+//--------------------------------------------------------------------
+#include <cassert>
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Alias/InterAliasInterface.hpp>
+#include <OpenAnalysis/IRInterface/ActivityIRInterface.hpp>
+
+#include <OpenAnalysis/DataFlow/ICFGIFDSProblem.hpp>
+#include <OpenAnalysis/DataFlow/ICFGIFDSSolver.hpp>
+#include <OpenAnalysis/DataFlow/ParamBindings.hpp>
+#include <OpenAnalysis/DataFlow/LocDFSet.hpp>
+#include <OpenAnalysis/Activity/ICFGDep.hpp>
+
+#include "ActivePerStmt.hpp"
+
+namespace OA {
+  namespace Activity {
+
+/*!
+    Computes the same vary sets as ManagerICFGVaryActive::performVary,
+    with ICFGIFDSSolver instead of ICFGDFSolver.  The facts are
+    locations and each callback of ManagerICFGVaryActive is applied
+    to one location at a time.  Varied locations only return from a
+    callee to the call sites whose locations varied them, so the sets
+    can be smaller than those of ManagerICFGVaryActive but never
+    larger.
+*/
+class ManagerICFGVaryIFDS : public virtual DataFlow::ICFGIFDSProblem
+{
+public:
+  ManagerICFGVaryIFDS(OA_ptr<ActivityIRInterface> _ir);
+  ~ManagerICFGVaryIFDS () {}
+
+  //! vary sets in the InActive and OutActive sets of each stmt
+  OA_ptr<ActivePerStmt>
+  performVary(OA_ptr<ICFG::ICFGInterface> icfg,
+              OA_ptr<DataFlow::ParamBindings> paramBind,
+              OA_ptr<Alias::InterAliasInterface> interAlias,
+              OA_ptr<ICFGDep> icfgDep);
+
+  //! path edges and summaries the solver needed
+  int getNumPathEdges() { return mSolver->getNumPathEdges(); }
+  int getNumSummaries() { return mSolver->getNumSummaries(); }
+
+private:
+  //========================================================
+  // helper routines
+  //========================================================
+  OA_ptr<DataFlow::LocDFSet> toLocDFSet(const DataFlow::IFDSFactSet& facts);
+  void insertFacts(OA_ptr<LocIterator> locIter,
+                   DataFlow::IFDSFactSet& result);
+
+  //! locations that the callees at call must redefine
+  std::list<OA_ptr<Location> >& killedAt(CallHandle call, ProcHandle caller);
+
+  //========================================================
+  // implementation of ICFGIFDSProblem interface
+  //========================================================
+  void initialFacts(ProcHandle proc, DataFlow::IFDSFactSet& result);
+
+  void transfer(ProcHandle proc, DataFlow::IFDSFact fact,
+                OA::StmtHandle stmt, DataFlow::IFDSFactSet& result);
+
+  void callerToCallee(ProcHandle caller, DataFlow::IFDSFact fact,
+                      CallHandle call, ProcHandle callee,
+                      DataFlow::IFDSFactSet& result);
+
+  void calleeToCaller(ProcHandle callee, DataFlow::IFDSFact fact,
+                      CallHandle call, ProcHandle caller,
+                      DataFlow::IFDSFactSet& result);
+
+  void callToReturn(ProcHandle caller, DataFlow::IFDSFact fact,
+                    CallHandle call, ProcHandle callee,
+                    DataFlow::IFDSFactSet& result);
+
+private:
+  OA_ptr<ActivePerStmt> mActive;
+  OA_ptr<ActivityIRInterface> mIR;
+  OA_ptr<DataFlow::ParamBindings> mParamBind;
+  OA_ptr<ICFGDep> mICFGDep;
+  OA_ptr<Alias::InterAliasInterface> mInterAlias;
+  OA_ptr<DataFlow::ICFGIFDSSolver> mSolver;
+  OA_ptr<ICFG::ICFGInterface> mICFG;
+
+  DataFlow::IFDSFactTable<OA_ptr<Location> > mFacts;
+  std::map<CallHandle,std::list<OA_ptr<Location> > > mKilledAt;
+};
+
+  } // end of Activity namespace
+} // end of OA namespace
+
+#endif
@@ -45,8 +45,10 @@ ManagerInterDep::performAnalysis(
   mInterSE = interSE;
   mEachCFG = eachCFG;
 
-  // create an empty InterDep
+  // create an empty InterDep, all procedures number their locations
+  // in one table so the sets for calls compose without renumbering
   mInterDep = new InterDep();
+  mLocTable = new DepLocTable;
 
   // call iterative data-flow solver for CallGraph
   mSolver->solve(callGraph,algorithm);
@@ -69,7 +71,7 @@ ManagerInterDep::performAnalysis(
 OA_ptr<DataFlow::DataFlowSet> ManagerInterDep::initializeTop()
 {
     OA_ptr<DepDFSet> retval;
-    retval = new DepDFSet;
+    retval = new DepDFSet(mLocTable);
     return retval;
 }
 
@@ -83,7 +85,7 @@ ManagerInterDep::initializeBottom()
     // specificallly have to say all defs depend on all uses
 
     OA_ptr<DepDFSet> retval;
-    retval = new DepDFSet;
+    retval = new DepDFSet(mLocTable);
     return retval;
 }
 
@@ -162,7 +164,7 @@ ManagerInterDep::atCallGraphNode(
     }
 
     // create empty depDFSet for this procedure
-    OA_ptr<DepDFSet> retval; retval = new DepDFSet;
+    OA_ptr<DepDFSet> retval; retval = new DepDFSet(mLocTable);
 
     // get alias results for this procedure
     OA_ptr<Alias::Interface> alias = mInterAlias->getAliasResults(proc);
@@ -170,6 +172,7 @@ ManagerInterDep::atCallGraphNode(
     // create empty Dep results for this procedure
     OA_ptr<ManagerDepStandard> depman;
     depman = new ManagerDepStandard(mIR);
+    depman->setLocTable(mLocTable);
     OA_ptr<DepStandard> depResults 
         = depman->performAnalysis(proc, alias,mEachCFG->getCFGResults(proc),
                                   mInterDep, mParamBind,
@@ -204,7 +207,7 @@ ManagerInterDep::atCallGraphEdge(
 
    // create a new DepDFSet that is empty
    OA_ptr<DepDFSet> retval;
-   retval = new DepDFSet;
+   retval = new DepDFSet(mLocTable);
 
    assert(callee != ProcHandle(0));
 
@@ -299,7 +302,7 @@ ManagerInterDep::atCallGraphEdge(
   
   // create a new DepDFSet that is empty
   OA_ptr<DepDFSet> retval;
-  retval = new DepDFSet;
+  retval = new DepDFSet(mLocTable);
   
   // if callee node is undefined then estimate Dep with side-effect results
   // FIXME: no way to pass up must defs, but this will still give us
@@ -356,7 +359,7 @@ ManagerInterDep::edgeToNode(CallHandle call,
 
     // create a new DepDFSet that is empty
     OA_ptr<DepDFSet> retval;
-    retval = new DepDFSet;
+    retval = new DepDFSet(mLocTable);
     
     // iterate over the deps for the call
     OA_ptr<DepIterator> depIter = recastCallDFSet->getDepIterator();
@@ -128,6 +128,7 @@ private:
   OA_ptr<CFG::EachCFGInterface> mEachCFG;
   OA_ptr<SideEffect::InterSideEffectInterface> mInterSE;
   OA_ptr<DataFlow::CallGraphDFSolver> mSolver;
+  OA_ptr<DepLocTable> mLocTable;
   
 };
 
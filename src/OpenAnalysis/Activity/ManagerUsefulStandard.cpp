@@ -76,15 +76,10 @@ OA_ptr<UsefulStandard> ManagerUsefulStandard::performAnalysis(ProcHandle proc,
   //DataFlow::CFGDFProblem::solve(cfg);
   mSolver->solve(cfg,algorithm);
 
-  // get the final useful set from the entry node
-  OA_ptr<CFG::NodeInterface> entry = cfg->getEntry();
-//  OA_ptr<DataFlow::DataFlowSet> dfset = mNodeOutSetMap[entry];
-  OA_ptr<DataFlow::DataFlowSet> dfset = mSolver->getOutSet(entry);
-
-  //  No routine is using this FinalUseful set, so depredated in UsefulStandard
+  //  No routine is using the FinalUseful set from the entry node, so
+  //  depredated in UsefulStandard
   //  All code is still there, but commented out. BK 8/06
   //  mUsefulMap->mapFinalUseful(dfset.convert<DataFlow::LocDFSet>());
-  assert(0);
  
   return mUsefulMap;
 
@@ -0,0 +1,180 @@
+/*! \file
+
+  \brief The AnnotationManager that generates VaryStandard.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerVaryStandard.hpp"
+#include <Utils/Util.hpp>
+
+
+namespace OA {
+  namespace Activity {
+
+static bool debug = false;
+
+/*!
+*/
+ManagerVaryStandard::ManagerVaryStandard(OA_ptr<ActivityIRInterface> _ir)
+    : mIR(_ir)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerVaryStandard:ALL", debug);
+    mSolver = new DataFlow::CFGDFSolver(DataFlow::CFGDFSolver::Forward,*this);
+}
+
+OA_ptr<DataFlow::DataFlowSet> ManagerVaryStandard::initializeTop()
+{
+    OA_ptr<DataFlow::LocDFSet>  retval;
+    retval = new DataFlow::LocDFSet;
+    return retval;
+}
+
+OA_ptr<DataFlow::DataFlowSet> ManagerVaryStandard::initializeBottom()
+{
+    // not used, see ManagerUsefulStandard::initializeBottom
+    OA_ptr<DataFlow::LocDFSet>  retval;
+    return retval;
+}
+
+/*!
+    Uses the CFGDFProblem::solve functionality to get In and Out
+    Vary sets for each basic block.   In transfer function
+    put OutVary locs in VaryStandard as well.
+*/
+OA_ptr<VaryStandard> ManagerVaryStandard::performAnalysis(ProcHandle proc,
+    OA_ptr<CFG::CFGInterface> cfg, OA_ptr<DepStandard> dep,
+    OA_ptr<DataFlow::LocDFSet> indepLocSet,
+    DataFlow::DFPImplement algorithm)
+{
+  if (debug) {
+    std::cout << "In ManagerVaryStandard::performAnalysis" << std::endl;
+  }
+  mVaryMap = new VaryStandard(proc);
+
+  // store Dep information for use within the transfer function
+  mDep = dep;
+
+  // store independent locations
+  mIndepLocSet = indepLocSet;
+  DataFlow::LocDFSetIterator indepIter(*mIndepLocSet);
+  for ( ; indepIter.isValid(); ++indepIter ) {
+    mVaryMap->insertIndepLoc(indepIter.current());
+  }
+
+  // store CFG for use in initialization
+  mCFG = cfg;
+
+  // use the dataflow solver to get the In and Out sets for the BBs
+  mSolver->solve(cfg,algorithm);
+
+  if (debug) { mVaryMap->dump(std::cout, mIR); }
+
+  return mVaryMap;
+}
+
+//------------------------------------------------------------------
+// Implementing the callbacks for CFGDFProblem
+//------------------------------------------------------------------
+
+/*!
+   The independent locations vary on entry to the procedure.
+*/
+OA_ptr<DataFlow::DataFlowSet>
+ManagerVaryStandard::initializeNodeIN(OA_ptr<CFG::NodeInterface> n)
+{
+     OA_ptr<DataFlow::LocDFSet> retval;
+     if (n.ptrEqual(mCFG->getEntry())) {
+        retval = mIndepLocSet->clone().convert<DataFlow::LocDFSet>();
+     } else {
+        retval = new DataFlow::LocDFSet;
+     }
+     return retval;
+}
+
+OA_ptr<DataFlow::DataFlowSet>
+ManagerVaryStandard::initializeNodeOUT(OA_ptr<CFG::NodeInterface> n)
+{
+     OA_ptr<DataFlow::LocDFSet> retval;
+     if (n.ptrEqual(mCFG->getEntry())) {
+        retval = mIndepLocSet->clone().convert<DataFlow::LocDFSet>();
+     } else {
+        retval = new DataFlow::LocDFSet;
+     }
+     return retval;
+}
+
+
+OA_ptr<DataFlow::DataFlowSet>
+ManagerVaryStandard::meet (OA_ptr<DataFlow::DataFlowSet> set1orig,
+                           OA_ptr<DataFlow::DataFlowSet> set2orig)
+{
+    OA_ptr<DataFlow::LocDFSet> set1
+        = set1orig.convert<DataFlow::LocDFSet>();
+    if (debug) {
+        std::cout << "ManagerVaryStandard::meet" << std::endl;
+        std::cout << "\tset1 = ";
+        set1->dump(std::cout,mIR);
+        std::cout << ", set2 = ";
+        set2orig->dump(std::cout,mIR);
+    }
+
+    DataFlow::LocDFSet retval
+        = set1->setUnion(*set2orig);
+
+    return retval.clone();
+}
+
+/*!
+    \brief Core of analysis algorithm.  Transfer function for a stmt.
+
+    OutVary is every location that may be defined from a location in
+    InVary, including the location itself unless it is must defined.
+*/
+OA_ptr<DataFlow::DataFlowSet>
+ManagerVaryStandard::transfer(OA_ptr<DataFlow::DataFlowSet> in,
+                              OA::StmtHandle stmt)
+{
+    OA_ptr<DataFlow::LocDFSet> inRecast
+        = in.convert<DataFlow::LocDFSet>();
+    OA_ptr<DataFlow::LocDFSet> outVary;
+    outVary = new DataFlow::LocDFSet;
+
+    if (debug) {
+        std::cout << "In transfer, stmt(hval=" << stmt.hval() << ")= ";
+        mIR->dump(stmt,std::cout);
+    }
+
+    // loop through all calls in the statement and record the InVary
+    // set for them
+    OA_ptr<IRCallsiteIterator> callsiteItPtr = mIR->getCallsites(stmt);
+    for ( ; callsiteItPtr->isValid(); ++(*callsiteItPtr)) {
+        CallHandle call = callsiteItPtr->current();
+
+        mVaryMap->copyIntoInVary(call, inRecast);
+    }
+
+    // use dep pairs to determine what locations should be in OutVary
+    DataFlow::LocDFSetIterator inLocIter(*inRecast);
+    for ( ; inLocIter.isValid(); ++inLocIter ) {
+      OA_ptr<Location> inLoc = inLocIter.current();
+      if (debug) { std::cout << "\tinLoc = ";  inLoc->dump(std::cout,mIR); }
+      OA_ptr<LocIterator> locIterPtr;
+      locIterPtr = mDep->getMayDefIterator(stmt,inLoc);
+      for ( ; locIterPtr->isValid(); (*locIterPtr)++ ) {
+          outVary->insert(locIterPtr->current());
+      }
+    }
+
+    // map to statement in results
+    mVaryMap->copyIntoOutVary(stmt, outVary);
+
+    return outVary;
+}
+
+  } // end of namespace Activity
+} // end of namespace OA
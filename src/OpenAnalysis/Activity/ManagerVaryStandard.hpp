@@ -0,0 +1,83 @@
+/*! \file
+
+  \brief Declarations of the AnnotationManager that generates a VaryStandard
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef VaryManagerStandard_h
+#define VaryManagerStandard_h
+
+//--------------------------------------------------------------------
+// OpenAnalysis headers
+#include "DepStandard.hpp"
+#include "VaryStandard.hpp"
+
+#include <OpenAnalysis/IRInterface/ActivityIRInterface.hpp>
+#include <OpenAnalysis/CFG/CFGInterface.hpp>
+#include <OpenAnalysis/DataFlow/CFGDFProblem.hpp>
+#include <OpenAnalysis/DataFlow/LocDFSet.hpp>
+#include <OpenAnalysis/DataFlow/CFGDFSolver.hpp>
+
+namespace OA {
+  namespace Activity {
+
+
+/*!
+   The AnnotationManager for VaryStandard.
+   The forward counterpart of ManagerUsefulStandard: starting from the
+   independent locations at the entry, OutVary for each stmt is every
+   location that may be defined from an InVary location according to
+   the DepStandard for the procedure.
+*/
+class ManagerVaryStandard
+    : private DataFlow::CFGDFProblem {
+public:
+  ManagerVaryStandard(OA_ptr<ActivityIRInterface> _ir);
+  ~ManagerVaryStandard () {}
+
+  //! indepLocSet is the set of independent locations
+  //! that the algorithm should calculate OutVary from
+  OA_ptr<VaryStandard> performAnalysis(ProcHandle,
+        OA_ptr<CFG::CFGInterface> cfg, OA_ptr<DepStandard> dep,
+        OA_ptr<DataFlow::LocDFSet> indepLocSet,
+        DataFlow::DFPImplement type);
+
+  //------------------------------------------------------------------
+  // Implementing the callbacks for CFGDFProblem
+  //------------------------------------------------------------------
+private:
+  OA_ptr<DataFlow::DataFlowSet> initializeTop();
+  OA_ptr<DataFlow::DataFlowSet> initializeBottom();
+
+  //! Should generate an in and out DataFlowSet for node
+  OA_ptr<DataFlow::DataFlowSet>
+             initializeNodeIN(OA_ptr<CFG::NodeInterface> n);
+  OA_ptr<DataFlow::DataFlowSet>
+             initializeNodeOUT(OA_ptr<CFG::NodeInterface> n);
+
+  OA_ptr<DataFlow::DataFlowSet>
+  meet (OA_ptr<DataFlow::DataFlowSet> set1, OA_ptr<DataFlow::DataFlowSet> set2);
+
+  OA_ptr<DataFlow::DataFlowSet>
+  transfer(OA_ptr<DataFlow::DataFlowSet> in, OA::StmtHandle stmt);
+
+private: // member variables
+
+  OA_ptr<ActivityIRInterface> mIR;
+  OA_ptr<DepStandard> mDep;
+  OA_ptr<VaryStandard> mVaryMap;
+  OA_ptr<DataFlow::LocDFSet> mIndepLocSet;
+  OA_ptr<CFG::CFGInterface> mCFG;
+  OA_ptr<DataFlow::CFGDFSolver> mSolver;
+
+};
+
+  } // end of Activity namespace
+} // end of OA namespace
+
+#endif
@@ -110,7 +110,7 @@ AliasResultType AliasMap::alias(MemRefHandle ref1, MemRefHandle ref2)
       // The sets do overlap.  If there is an overlapping MUST alias
       // set, return MUSTALIAS.  Else return MAYAliaS.
       for (it1 = temp.begin(); it1 != temp.end(); ++it1) {
-        if (mIdToSetStatusMap[*it1]==MUSTALIAS)
+        if (isMust(*it1))
           return MUSTALIAS;
       }
 
@@ -134,8 +134,12 @@ AliasResultType AliasMap::alias(MemRefHandle ref1, MemRefHandle ref2)
         return retval;
        }  
 
-        if (mayOverlapLocSets(*mIdToLocSetMap[*it1],
-                              *mIdToLocSetMap[*it2]) ) {
+        OA_ptr<LocSet> locs1 = findLocSet(*it1);
+        OA_ptr<LocSet> locs2 = findLocSet(*it2);
+        if (locs1.ptrEqual(0) || locs2.ptrEqual(0)) {
+          continue;
+        }
+        if (mayOverlapLocSets(*locs1, *locs2) ) {
           locationsOverlap = true;
           if (isMust(*it1) && isMust(*it2)) {
             retval = MUSTALIAS;
@@ -159,14 +163,26 @@ AliasResultType AliasMap::alias(MemRefHandle ref1, MemRefHandle ref2)
     return retval; 
 } 
 
+OA_ptr<LocSet> AliasMap::findLocSet(int setId)
+{
+    std::map<int,OA_ptr<LocSet> >::const_iterator found
+        = mIdToLocSetMap.find(setId);
+    if (found == mIdToLocSetMap.end()) {
+        OA_ptr<LocSet> none;
+        return none;
+    }
+    return found->second;
+}
+
 //! get iterator over all locations in a particular set
 OA_ptr<LocIterator> AliasMap::getLocIterator(int setId) 
 { OA_ptr<LocSetIterator> retval;
-  if (mIdToLocSetMap[setId].ptrEqual(0)) {
+  OA_ptr<LocSet> locs = findLocSet(setId);
+  if (locs.ptrEqual(0)) {
     OA_ptr<LocSet> emptySet; emptySet = new LocSet;
     retval = new LocSetIterator(emptySet);  // empty loc set
   } else {
-    retval = new LocSetIterator(mIdToLocSetMap[setId]); 
+    retval = new LocSetIterator(locs); 
   }
   return retval;
 }
@@ -198,15 +214,20 @@ OA_ptr<LocIterator> AliasMap::getMayLocs(MemRefHandle ref)
 
     // iterate over all the sets for this MemRefHandle and return
     // an iterator over all the locations in those sets
-    std::set<int>::iterator iter;
-    for (iter=mMemRefToIdMap[ref].begin();
-         iter!=mMemRefToIdMap[ref].end(); iter++)
+    std::map<MemRefHandle,std::set<int> >::const_iterator ids;
+    ids = mMemRefToIdMap.find(ref);
+    if (ids == mMemRefToIdMap.end()) {
+      retval = new LocSetIterator(locSet);
+      return retval;
+    }
+    std::set<int>::const_iterator iter;
+    for (iter=ids->second.begin(); iter!=ids->second.end(); iter++)
     {
-      if (!mIdToLocSetMap[*iter].ptrEqual(0))
+      OA_ptr<LocSet> locs = findLocSet(*iter);
+      if (!locs.ptrEqual(0))
       {
 
-         locSet = unionLocSets(*locSet, 
-                            *(mIdToLocSetMap[*iter]));
+         locSet = unionLocSets(*locSet, *locs);
       }
     }
 
@@ -224,15 +245,19 @@ OA_ptr<LocIterator> AliasMap::getMustLocs(MemRefHandle ref)
 
     // iterate over all the sets for this MemRefHandle and return
     // an iterator over all the locations in those sets
-    std::set<int>::iterator iter;
-    for (iter=mMemRefToIdMap[ref].begin();
-         iter!=mMemRefToIdMap[ref].end(); iter++)
+    std::map<MemRefHandle,std::set<int> >::const_iterator ids;
+    ids = mMemRefToIdMap.find(ref);
+    if (ids == mMemRefToIdMap.end()) {
+      retval = new LocSetIterator(locSet);
+      return retval;
+    }
+    std::set<int>::const_iterator iter;
+    for (iter=ids->second.begin(); iter!=ids->second.end(); iter++)
     {
-      if (mIdToSetStatusMap[*iter]==MUSTALIAS 
-          && !mIdToLocSetMap[*iter].ptrEqual(0)) 
+      OA_ptr<LocSet> locs = findLocSet(*iter);
+      if (isMust(*iter) && !locs.ptrEqual(0)) 
       {
-        locSet = unionLocSets(*locSet, 
-                              *(mIdToLocSetMap[*iter]));
+        locSet = unionLocSets(*locSet, *locs);
       }
     }
 
@@ -250,11 +275,13 @@ OA_ptr<LocIterator> AliasMap::getMayLocs(MemRefExpr &ref, ProcHandle proc)
     // iterate over all the sets for this MemRefHandle and return
     // an iterator over all the locations in those sets
     OA_ptr<MemRefExpr> refPtr = ref.clone();
-    if( mMREToIdMap.find(refPtr) != mMREToIdMap.end() ) {
-      int id = mMREToIdMap[refPtr];
-      if (!mIdToLocSetMap[id].ptrEqual(0))
+    std::map<OA_ptr<MemRefExpr>,int>::const_iterator mreId;
+    mreId = mMREToIdMap.find(refPtr);
+    if( mreId != mMREToIdMap.end() ) {
+      OA_ptr<LocSet> locs = findLocSet(mreId->second);
+      if (!locs.ptrEqual(0))
       {
-         locSet = unionLocSets(*locSet, *(mIdToLocSetMap[id]));
+         locSet = unionLocSets(*locSet, *locs);
       }
     }
 
@@ -289,11 +316,12 @@ OA_ptr<LocIterator> AliasMap::getMayLocs(MemRefExpr &ref, ProcHandle proc)
     }
    
     
-    if( mMREToIdMap.find(mreClone) != mMREToIdMap.end() ) {
-      int id = mMREToIdMap[mreClone];
-      if (!mIdToLocSetMap[id].ptrEqual(0))
+    mreId = mMREToIdMap.find(mreClone);
+    if( mreId != mMREToIdMap.end() ) {
+      OA_ptr<LocSet> locs = findLocSet(mreId->second);
+      if (!locs.ptrEqual(0))
       {
-         locSet = unionLocSets(*locSet, *(mIdToLocSetMap[id]));
+         locSet = unionLocSets(*locSet, *locs);
       }
     }
 
@@ -309,13 +337,13 @@ OA_ptr<LocIterator> AliasMap::getMustLocs(MemRefExpr &ref, ProcHandle proc)
     OA_ptr<LocSetIterator> retval;
 
     OA_ptr<MemRefExpr> refPtr = ref.clone();
-    if ( mMREToIdMap.find(refPtr) != mMREToIdMap.end() ) {
-      int id = mMREToIdMap[refPtr];
-      if (mIdToSetStatusMap[id]==MUSTALIAS 
-          && !mIdToLocSetMap[id].ptrEqual(0)) 
+    std::map<OA_ptr<MemRefExpr>,int>::const_iterator mreId;
+    mreId = mMREToIdMap.find(refPtr);
+    if ( mreId != mMREToIdMap.end() ) {
+      OA_ptr<LocSet> locs = findLocSet(mreId->second);
+      if (isMust(mreId->second) && !locs.ptrEqual(0)) 
       {
-        locSet = unionLocSets(*locSet, 
-                              *(mIdToLocSetMap[id]));
+        locSet = unionLocSets(*locSet, *locs);
       }
     }
 
@@ -348,14 +376,17 @@ OA_ptr<MemRefIterator> AliasMap::getMustAliases(MemRefHandle ref)
     for (it = ids->begin(); it != ids->end(); ++it) {
 
       int id = *it;
+      OA_ptr<LocSet> locs = findLocSet(id);
+      if (!isMust(id) || locs.ptrEqual(0)) {
+        continue;
+      }
 
       for (mapIter = mIdToLocSetMap.begin(); mapIter != mIdToLocSetMap.end();
            mapIter++) 
       {
           int otherId = mapIter->first;
-          if (mIdToSetStatusMap[otherId]==MUSTALIAS 
-              && mIdToSetStatusMap[id]==MUSTALIAS
-              && mayOverlapLocSets(*(mapIter->second),*mIdToLocSetMap[id])) 
+          if (isMust(otherId)
+              && mayOverlapLocSets(*(mapIter->second),*locs)) 
           {
               mustOverlapMapSetIds.insert(otherId);
           }
@@ -370,9 +401,14 @@ OA_ptr<MemRefIterator> AliasMap::getMustAliases(MemRefHandle ref)
     {
         int setId = *setIter;
 
-        MemRefSet::iterator memrefSetIter;
-        for (memrefSetIter=mIdToMemRefSetMap[setId].begin();
-             memrefSetIter!=mIdToMemRefSetMap[setId].end();
+        std::map<int,MemRefSet>::const_iterator memrefs;
+        memrefs = mIdToMemRefSetMap.find(setId);
+        if (memrefs == mIdToMemRefSetMap.end()) {
+            continue;
+        }
+        MemRefSet::const_iterator memrefSetIter;
+        for (memrefSetIter=memrefs->second.begin();
+             memrefSetIter!=memrefs->second.end();
              memrefSetIter++) 
         {
             mustSet->insert(*memrefSetIter);
@@ -408,12 +444,16 @@ OA_ptr<MemRefIterator> AliasMap::getMayAliases(MemRefHandle ref)
     for (it = ids->begin(); it != ids->end(); ++it) {
 
       int id = *it;
+      OA_ptr<LocSet> locs = findLocSet(id);
+      if (locs.ptrEqual(0)) {
+        continue;
+      }
 
       for (mapIter = mIdToLocSetMap.begin(); mapIter != mIdToLocSetMap.end();
            mapIter++) 
       {
           int otherId = mapIter->first;
-          if (mayOverlapLocSets(*(mapIter->second),*mIdToLocSetMap[id])) 
+          if (mayOverlapLocSets(*(mapIter->second),*locs)) 
           {
               mayOverlapMapSetIds.insert(otherId);
           }
@@ -428,9 +468,14 @@ OA_ptr<MemRefIterator> AliasMap::getMayAliases(MemRefHandle ref)
     {
         int setId = *setIter;
 
-        MemRefSet::iterator memrefSetIter;
-        for (memrefSetIter=mIdToMemRefSetMap[setId].begin();
-             memrefSetIter!=mIdToMemRefSetMap[setId].end();
+        std::map<int,MemRefSet>::const_iterator memrefs;
+        memrefs = mIdToMemRefSetMap.find(setId);
+        if (memrefs == mIdToMemRefSetMap.end()) {
+            continue;
+        }
+        MemRefSet::const_iterator memrefSetIter;
+        for (memrefSetIter=memrefs->second.begin();
+             memrefSetIter!=memrefs->second.end();
              memrefSetIter++) 
         {
             maySet->insert(*memrefSetIter);
@@ -469,7 +514,7 @@ OA_ptr<MemRefIterator> AliasMap::getMustAliases(OA_ptr<Location> loc)
         }
         */
 
-        if (mIdToSetStatusMap[otherId]==MUSTALIAS
+        if (isMust(otherId)
             && (!loc->isaSubSet())
             && mayOverlapLocSets(*(mapIter->second),
                                            singleEntrySet))
@@ -487,9 +532,14 @@ OA_ptr<MemRefIterator> AliasMap::getMustAliases(OA_ptr<Location> loc)
     {
         int setId = *setIter;
 
-        MemRefSet::iterator memrefSetIter;
-        for (memrefSetIter=mIdToMemRefSetMap[setId].begin();
-             memrefSetIter!=mIdToMemRefSetMap[setId].end();
+        std::map<int,MemRefSet>::const_iterator memrefs;
+        memrefs = mIdToMemRefSetMap.find(setId);
+        if (memrefs == mIdToMemRefSetMap.end()) {
+            continue;
+        }
+        MemRefSet::const_iterator memrefSetIter;
+        for (memrefSetIter=memrefs->second.begin();
+             memrefSetIter!=memrefs->second.end();
              memrefSetIter++) 
         {
             mustSet->insert(*memrefSetIter);
@@ -530,9 +580,14 @@ OA_ptr<MemRefIterator> AliasMap::getMayAliases(OA_ptr<Location> loc)
     {
         int setId = *setIter;
 
-        MemRefSet::iterator memrefSetIter;
-        for (memrefSetIter=mIdToMemRefSetMap[setId].begin();
-             memrefSetIter!=mIdToMemRefSetMap[setId].end();
+        std::map<int,MemRefSet>::const_iterator memrefs;
+        memrefs = mIdToMemRefSetMap.find(setId);
+        if (memrefs == mIdToMemRefSetMap.end()) {
+            continue;
+        }
+        MemRefSet::const_iterator memrefSetIter;
+        for (memrefSetIter=memrefs->second.begin();
+             memrefSetIter!=memrefs->second.end();
              memrefSetIter++) 
         {
             maySet->insert(*memrefSetIter);
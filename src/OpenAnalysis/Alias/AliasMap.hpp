@@ -172,7 +172,10 @@ class AliasMap : public virtual Alias::Interface,
 
     //! is the equivalence set a must alias equivalence set
     bool isMust(int setId)
-    { return (mIdToSetStatusMap[setId] == MUSTALIAS); }
+    { std::map<int,AliasResultType>::const_iterator found
+          = mIdToSetStatusMap.find(setId);
+      return (found != mIdToSetStatusMap.end()
+              && found->second == MUSTALIAS); }
 
     //*****************************************************************
     // Construction methods 
@@ -242,6 +245,10 @@ class AliasMap : public virtual Alias::Interface,
     void dump(std::ostream& os, OA_ptr<OA::IRHandlesIRInterface> ir);
 
   private:
+    //! the locations of the set, null if it has none.  Queries look
+    //! the maps up with this and find() rather than operator[], so
+    //! they don't add entries and several threads can make them.
+    OA_ptr<LocSet> findLocSet(int setId);
 
     OUTPUT
 
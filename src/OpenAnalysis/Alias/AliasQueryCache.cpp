@@ -0,0 +1,161 @@
+/*! \file
+
+  \brief Implementation of AliasQueryCache.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "AliasQueryCache.hpp"
+#include <Utils/Util.hpp>
+
+namespace OA {
+  namespace Alias {
+
+static bool debug = false;
+
+AliasQueryCache::AliasQueryCache(OA_ptr<AliasMap> aliasMap,
+                                 unsigned int cacheSize)
+    : mAliasMap(aliasMap), mCache(cacheSize > 0 ? cacheSize : 1),
+      mNumQueries(0), mNumHits(0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_AliasQueryCache:ALL", debug);
+
+    mIdToLocSet = mAliasMap->getIdToLocSetMap();
+    std::map<int,OA_ptr<LocSet> >::iterator setIter;
+    for (setIter=mIdToLocSet->begin(); setIter!=mIdToLocSet->end();
+         setIter++)
+    {
+        if (setIter->first >= 0 && mAliasMap->isMust(setIter->first)) {
+            mMustSets.set(setIter->first);
+        }
+    }
+
+    // MemRefHandles the map doesn't know about are left out and go
+    // to the AliasMap
+    OA_ptr<MemRefIterator> refIter = mAliasMap->getMemRefIter();
+    for ( ; refIter->isValid(); ++(*refIter)) {
+        MemRefHandle ref = refIter->current();
+        OA_ptr<std::set<int> > ids = mAliasMap->getMapSetIds(ref);
+        SparseBitVector& bits = mRefToSetIds[ref];
+        std::set<int>::iterator idIter;
+        for (idIter=ids->begin(); idIter!=ids->end(); idIter++) {
+            if (*idIter < 0) {
+                mRefToSetIds.erase(ref);
+                break;
+            }
+            bits.set(*idIter);
+        }
+    }
+}
+
+AliasResultType AliasQueryCache::alias(MemRefHandle ref1, MemRefHandle ref2)
+{
+    // the answer doesn't depend on the order of the refs
+    if (ref2 < ref1) {
+        MemRefHandle tmp = ref1; ref1 = ref2; ref2 = tmp;
+    }
+
+    std::map<MemRefHandle,SparseBitVector>::iterator ids1, ids2;
+    ids1 = mRefToSetIds.find(ref1);
+    ids2 = mRefToSetIds.find(ref2);
+    if (ids1 == mRefToSetIds.end() || ids2 == mRefToSetIds.end()) {
+        return mAliasMap->alias(ref1, ref2);
+    }
+
+    MutexLock guard(mLock);
+    mNumQueries++;
+
+    CacheEntry& entry
+        = mCache[(ref1.hval() * 31 + ref2.hval()) % mCache.size()];
+    if (entry.mValid && entry.mRef1 == ref1 && entry.mRef2 == ref2) {
+        mNumHits++;
+        return entry.mResult;
+    }
+
+    entry.mValid = true;
+    entry.mRef1 = ref1;
+    entry.mRef2 = ref2;
+    entry.mResult = computeAlias(ids1->second, ids2->second);
+
+    if (debug && (mNumQueries % 10000) == 0) {
+        std::cout << "AliasQueryCache: " << mNumHits << " hits in "
+                  << mNumQueries << " queries" << std::endl;
+    }
+
+    return entry.mResult;
+}
+
+AliasResultType AliasQueryCache::computeAlias(const SparseBitVector& ids1,
+                                              const SparseBitVector& ids2)
+{
+    // If either of the refs map to 0 (the unknown loc set), return
+    // MAYALIAS.
+    if (ids1.test(0) || ids2.test(0)) {
+        return MAYALIAS;
+    }
+
+    // If they share a set, it is a MUSTALIAS if one of the shared
+    // sets is.
+    SparseBitVector common = ids1;
+    common.intersectWith(ids2);
+    if (!common.empty()) {
+        return common.intersects(mMustSets) ? MUSTALIAS : MAYALIAS;
+    }
+
+    // otherwise see if the locations of their sets overlap
+    bool locationsOverlap = false;
+    for (SparseBitVectorIterator idIter(ids1); idIter.isValid(); ++idIter) {
+        const SparseBitVector& row = overlapRow(idIter.current());
+        if (!row.intersects(ids2)) { continue; }
+        locationsOverlap = true;
+        if (mMustSets.test(idIter.current())) {
+            SparseBitVector mustOverlap = row;
+            mustOverlap.intersectWith(ids2);
+            if (mustOverlap.intersects(mMustSets)) {
+                return MUSTALIAS;
+            }
+        }
+    }
+
+    return locationsOverlap ? MAYALIAS : NOALIAS;
+}
+
+const SparseBitVector& AliasQueryCache::overlapRow(int setId)
+{
+    std::map<int,SparseBitVector>::iterator found = mOverlapRows.find(setId);
+    if (found != mOverlapRows.end()) { return found->second; }
+
+    SparseBitVector& row = mOverlapRows[setId];
+    OA_ptr<LocSet> locs = (*mIdToLocSet)[setId];
+    if (locs.ptrEqual(0)) { return row; }
+
+    std::map<int,OA_ptr<LocSet> >::iterator setIter;
+    for (setIter=mIdToLocSet->begin(); setIter!=mIdToLocSet->end();
+         setIter++)
+    {
+        if (setIter->first < 0 || setIter->second.ptrEqual(0)) { continue; }
+        if (mayOverlapLocSets(*locs, *(setIter->second))) {
+            row.set(setIter->first);
+        }
+    }
+    return row;
+}
+
+int AliasQueryCache::getNumQueries()
+{
+    MutexLock guard(mLock);
+    return mNumQueries;
+}
+
+int AliasQueryCache::getNumHits()
+{
+    MutexLock guard(mLock);
+    return mNumHits;
+}
+
+  } // end of namespace Alias
+} // end of namespace OA
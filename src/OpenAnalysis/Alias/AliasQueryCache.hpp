@@ -0,0 +1,107 @@
+/*! \file
+
+  \brief Declarations for an Alias::Interface that answers alias queries
+         for an AliasMap from precomputed bit vectors and remembers
+         recent answers.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef AliasQueryCache_H
+#define AliasQueryCache_H
+
+#include <map>
+#include <vector>
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/Utils/SparseBitVector.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
+#include <OpenAnalysis/Alias/AliasMap.hpp>
+
+namespace OA {
+  namespace Alias {
+
+/*!
+   Gives the same answers as the AliasMap it is built from, which
+   clients such as UDDUChains ask about pairs of MemRefHandles over
+   and over.
+
+   When constructed, the alias map set ids of each MemRefHandle, and
+   the sets that are MUSTALIAS, are put in SparseBitVectors, so that
+   sharing a set is one intersection instead of building and
+   intersecting std::sets.  Which sets have overlapping locations is
+   worked out the first time a set is involved in a query.  The last
+   cacheSize answers are kept in a direct mapped table keyed by the
+   pair of MemRefHandles.
+
+   The AliasMap must not change after the cache has been built.
+   Queries can come from several threads.  Those the table can't
+   answer go to AliasMap::alias, which only reads the AliasMap.
+*/
+class AliasQueryCache : public virtual Alias::Interface {
+  public:
+    AliasQueryCache(OA_ptr<AliasMap> aliasMap, unsigned int cacheSize = 4096);
+    ~AliasQueryCache() {}
+
+    //*****************************************************************
+    // Alias::Interface
+    //*****************************************************************
+
+    //! indicate the aliasing relationship between two memory references
+    AliasResultType alias(MemRefHandle ref1, MemRefHandle ref2);
+
+    //! the rest go to the AliasMap
+    OA_ptr<LocIterator> getMayLocs(MemRefHandle ref)
+      { return mAliasMap->getMayLocs(ref); }
+    OA_ptr<LocIterator> getMustLocs(MemRefHandle ref)
+      { return mAliasMap->getMustLocs(ref); }
+    OA_ptr<LocIterator> getMayLocs(MemRefExpr &ref, ProcHandle proc)
+      { return mAliasMap->getMayLocs(ref, proc); }
+    OA_ptr<LocIterator> getMustLocs(MemRefExpr &ref, ProcHandle proc)
+      { return mAliasMap->getMustLocs(ref, proc); }
+    OA_ptr<MemRefIterator> getMemRefIter()
+      { return mAliasMap->getMemRefIter(); }
+
+    //*****************************************************************
+    // statistics
+    //*****************************************************************
+    int getNumQueries();
+    //! number of queries answered from the table of recent answers
+    int getNumHits();
+
+  private:
+    //! answer from the bit vectors of the set ids of both refs
+    AliasResultType computeAlias(const SparseBitVector& ids1,
+                                 const SparseBitVector& ids2);
+    //! the sets whose locations may overlap those of setId,
+    //! caller holds mLock
+    const SparseBitVector& overlapRow(int setId);
+
+    struct CacheEntry {
+      CacheEntry() : mValid(false), mResult(MAYALIAS) {}
+      bool mValid;
+      MemRefHandle mRef1;
+      MemRefHandle mRef2;
+      AliasResultType mResult;
+    };
+
+    OA_ptr<AliasMap> mAliasMap;
+    //! alias map set ids of each MemRefHandle the map knows about
+    std::map<MemRefHandle,SparseBitVector> mRefToSetIds;
+    SparseBitVector mMustSets;
+    OA_ptr<std::map<int,OA_ptr<LocSet> > > mIdToLocSet;
+    std::map<int,SparseBitVector> mOverlapRows;
+
+    std::vector<CacheEntry> mCache;
+    int mNumQueries;
+    int mNumHits;
+    Mutex mLock;
+};
+
+  } // end of Alias namespace
+} // end of OA namespace
+
+#endif
@@ -0,0 +1,606 @@
+/*! \file
+
+  \brief The AnnotationManager that generates AliasMaps with a flow
+         and context insensitive inclusion-based points-to analysis.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerAndersenAliasMap.hpp"
+#include <Utils/Util.hpp>
+
+
+namespace OA {
+  namespace Alias {
+
+static bool debug = false;
+
+//! a node on the depth first search of ManagerAndersenAliasMap::detectCycles
+struct CycleFrame {
+    CycleFrame(int n, std::vector<int>& s) : mNode(n), mSuccs(s), mPos(0) {}
+    int mNode;
+    std::vector<int> mSuccs;
+    unsigned int mPos;
+};
+
+ManagerAndersenAliasMap::ManagerAndersenAliasMap(
+    OA_ptr<AliasIRInterface> _ir)
+  : ManagerFIAlias(_ir), mNumCollapsed(0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerAndersenAliasMap:ALL", debug);
+}
+
+OA_ptr<Alias::InterAliasMap>
+ManagerAndersenAliasMap::performAnalysis( OA_ptr<IRProcIterator> procIter )
+{
+    // create an empty InterAliasMap
+    mInterAliasMap = new InterAliasMap();
+
+    // map each MemRefExpr to a unique id
+    initMemRefExprs(procIter);
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        mAnalyzedProcs.insert(procIter->current());
+    }
+
+    buildConstraints(procIter);
+
+    // solve, then bind the indirect calls that got callees and
+    // solve again until no new callees show up
+    solve();
+    while (resolveIndirectCalls()) {
+        solve();
+    }
+
+    if (debug) {
+        std::cout << "ManagerAndersenAliasMap: " << getNumNodes()
+                  << " nodes, " << getNumCollapsed() << " collapsed, "
+                  << getTotalPointsToSize() << " total points-to size"
+                  << std::endl;
+    }
+
+    buildAliasMaps(procIter);
+
+    return mInterAliasMap;
+}
+
+int ManagerAndersenAliasMap::getTotalPointsToSize()
+{
+    int retval = 0;
+    for (int id=1; id<(int)mIDToMRE.size(); id++) {
+        retval += mNodes[rep(id)].mPts.count();
+    }
+    return retval;
+}
+
+//--------------------------------------------------------------------
+// building the constraints
+//--------------------------------------------------------------------
+
+int ManagerAndersenAliasMap::idOf(OA_ptr<MemRefExpr> mre)
+{
+    MemRefExprIDTable::iterator found = mMREToID.find(mre);
+    if (found == mMREToID.end()) { return 0; }
+    return found->second;
+}
+
+void
+ManagerAndersenAliasMap::buildConstraints(OA_ptr<IRProcIterator> procIter)
+{
+    mRep = new UnionFindUniverse(2*mCount);
+    mIDToMRE.resize(mCount);
+    mContentNode.resize(mCount, -1);
+    for (int i=0; i<mCount; i++) {
+        newNode();
+    }
+
+    // objects and the constraints between an mre and its sub mre
+    MemRefExprIDTable::iterator mreIter;
+    for (mreIter=mMREToID.begin(); mreIter!=mMREToID.end(); mreIter++) {
+        mIDToMRE[mreIter->second] = mreIter->first;
+    }
+    for (int id=1; id<mCount; id++) {
+        OA_ptr<MemRefExpr> mre = mIDToMRE[id];
+        if (mre.ptrEqual(0)) { continue; }
+
+        if (mre->isaNamed() || mre->isaUnnamed() || mre->isaUnknown()) {
+            // an object accesses itself
+            mContentNode[id] = newNode();
+            mNodes[id].mPts.set(id);
+            push(id);
+
+        } else if (mre->isaRefOp()) {
+            OA_ptr<RefOp> refop = mre.convert<RefOp>();
+            if (refop->isaAddressOf()) { continue; }
+
+            int inner = idOf(refop->getMemRefExpr());
+            if (inner == 0) {
+                if (debug) {
+                    std::cout << "ManagerAndersenAliasMap: no id for inner"
+                              << " mre of ";
+                    mre->output(*mIR);
+                }
+                continue;
+            }
+            if (refop->isaDeref()) {
+                // *q accesses what q points to
+                addLoad(inner, id);
+            } else {
+                // subsets access the same objects as their base
+                addCopyEdge(inner, id);
+            }
+        }
+    }
+
+    // pointer assignments and calls
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        ProcHandle currProc = procIter->current();
+        OA_ptr<IRStmtIterator> stmtIterPtr = mIR->getStmtIterator(currProc);
+        for ( ; stmtIterPtr->isValid(); ++(*stmtIterPtr)) {
+            StmtHandle stmt = stmtIterPtr->current();
+
+            OA_ptr<PtrAssignPairStmtIterator> pairIter
+                = mIR->getPtrAssignStmtPairIterator(stmt);
+            for ( ; pairIter->isValid(); (*pairIter)++ ) {
+                int target = idOf(pairIter->currentTarget());
+                int value = valueNode(pairIter->currentSource());
+                if (target == 0 || value < 0) { continue; }
+                // the objects target accesses may now point to value
+                addStore(target, value);
+            }
+
+            OA_ptr<IRCallsiteIterator> callIter = mIR->getCallsites(stmt);
+            for ( ; callIter->isValid(); (*callIter)++ ) {
+                CallHandle call = callIter->current();
+                OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
+                if (callMRE->isaNamed()) {
+                    SymHandle sym = callMRE.convert<NamedRef>()->getSymHandle();
+                    ProcHandle callee = mIR->getProcHandle(sym);
+                    if (callee != ProcHandle(0)) {
+                        bindCall(call, callee);
+                    }
+                } else {
+                    int callNode = idOf(callMRE);
+                    if (callNode != 0) {
+                        mIndirectCalls.push_back(
+                            IndirectCall(call, callNode));
+                    }
+                }
+            }
+        }
+    }
+}
+
+int ManagerAndersenAliasMap::valueNode(OA_ptr<MemRefExpr> source)
+{
+    // &x evaluates to the objects x accesses
+    if (source->isaRefOp()) {
+        OA_ptr<RefOp> refop = source.convert<RefOp>();
+        if (refop->isaAddressOf()) {
+            int inner = idOf(refop->getMemRefExpr());
+            return inner == 0 ? -1 : inner;
+        }
+    }
+
+    // anything else evaluates to what the objects it accesses point to
+    int id = idOf(source);
+    if (id == 0) { return -1; }
+    std::map<int,int>::iterator found = mValueNode.find(id);
+    if (found != mValueNode.end()) { return found->second; }
+
+    int value = newNode();
+    addLoad(id, value);
+    mValueNode[id] = value;
+    return value;
+}
+
+void ManagerAndersenAliasMap::bindCall(CallHandle call, ProcHandle callee)
+{
+    OA_ptr<ParamBindPtrAssignIterator> pairIter
+        = mIR->getParamBindPtrAssignIterator(call);
+    for ( ; pairIter->isValid(); (*pairIter)++ ) {
+        SymHandle formalSym
+            = mIR->getFormalSym(callee, pairIter->currentFormalId());
+        // if the signature doesn't match then don't process
+        if (formalSym==SymHandle(0)) { continue; }
+
+        OA_ptr<MemRefExpr> formalmre;
+        formalmre = new NamedRef(MemRefExpr::DEF, formalSym);
+        int formal = idOf(formalmre);
+        int value = valueNode(pairIter->currentActual());
+        if (formal == 0 || value < 0) { continue; }
+
+        // formal = actual
+        addStore(formal, value);
+    }
+}
+
+bool ManagerAndersenAliasMap::resolveIndirectCalls()
+{
+    bool changed = false;
+    std::vector<IndirectCall>::iterator callIter;
+    for (callIter=mIndirectCalls.begin(); callIter!=mIndirectCalls.end();
+         callIter++)
+    {
+        SparseBitVectorIterator objIter(mNodes[rep(callIter->mCallNode)].mPts);
+        std::vector<unsigned int> objs;
+        for ( ; objIter.isValid(); ++objIter) {
+            objs.push_back(objIter.current());
+        }
+
+        std::vector<unsigned int>::iterator objsIter;
+        for (objsIter=objs.begin(); objsIter!=objs.end(); objsIter++) {
+            OA_ptr<MemRefExpr> obj = mIDToMRE[*objsIter];
+            if (!obj->isaNamed()) { continue; }
+            SymHandle sym = obj.convert<NamedRef>()->getSymHandle();
+            ProcHandle callee = mIR->getProcHandle(sym);
+            if (callee == ProcHandle(0)) { continue; }
+            if (callIter->mCallees.insert(callee).second) {
+                bindCall(callIter->mCall, callee);
+                changed = true;
+            }
+        }
+    }
+    return changed;
+}
+
+//--------------------------------------------------------------------
+// the solver
+//--------------------------------------------------------------------
+
+int ManagerAndersenAliasMap::newNode()
+{
+    mNodes.push_back(Node());
+    mOnWorklist.push_back(false);
+    return mNodes.size() - 1;
+}
+
+void ManagerAndersenAliasMap::push(int n)
+{
+    if (!mOnWorklist[n]) {
+        mOnWorklist[n] = true;
+        mWorklist.push_back(n);
+    }
+}
+
+void ManagerAndersenAliasMap::addCopyEdge(int src, int dst)
+{
+    src = rep(src);
+    dst = rep(dst);
+    if (src == dst) { return; }
+    if (mNodes[src].mCopyTo.insert(dst).second) {
+        // a new edge gets everything src has, not just what is new
+        if (mNodes[dst].mPts.unionWith(mNodes[src].mPts)) {
+            push(dst);
+        }
+    }
+}
+
+void ManagerAndersenAliasMap::addLoad(int ptr, int dst)
+{
+    ptr = rep(ptr);
+    mNodes[ptr].mLoadTo.push_back(dst);
+    // objects already propagated won't be visited again
+    std::vector<unsigned int> objs;
+    mNodes[ptr].mPrevPts.getBits(objs);
+    std::vector<unsigned int>::iterator iter;
+    for (iter=objs.begin(); iter!=objs.end(); iter++) {
+        if (mContentNode[*iter] >= 0) {
+            addCopyEdge(mContentNode[*iter], dst);
+        }
+    }
+}
+
+void ManagerAndersenAliasMap::addStore(int ptr, int src)
+{
+    ptr = rep(ptr);
+    mNodes[ptr].mStoreFrom.push_back(src);
+    std::vector<unsigned int> objs;
+    mNodes[ptr].mPrevPts.getBits(objs);
+    std::vector<unsigned int>::iterator iter;
+    for (iter=objs.begin(); iter!=objs.end(); iter++) {
+        if (mContentNode[*iter] >= 0) {
+            addCopyEdge(src, mContentNode[*iter]);
+        }
+    }
+}
+
+void ManagerAndersenAliasMap::solve()
+{
+    while (!mWorklist.empty()) {
+        int n = mWorklist.front();
+        mWorklist.pop_front();
+        mOnWorklist[n] = false;
+        if (rep(n) != n) { continue; } // was collapsed
+        processNode(n);
+    }
+}
+
+void ManagerAndersenAliasMap::processNode(int n)
+{
+    SparseBitVector delta;
+    delta.setDifference(mNodes[n].mPts, mNodes[n].mPrevPts);
+    if (delta.empty()) { return; }
+    mNodes[n].mPrevPts = mNodes[n].mPts;
+
+    // complex constraints add edges for the new objects, mNodes
+    // is a deque so the references stay valid as nodes are added
+    std::vector<int> loads = mNodes[n].mLoadTo;
+    std::vector<int> stores = mNodes[n].mStoreFrom;
+    for (SparseBitVectorIterator objIter(delta); objIter.isValid(); ++objIter) {
+        int content = mContentNode[objIter.current()];
+        if (content < 0) { continue; }
+        std::vector<int>::iterator iter;
+        for (iter=loads.begin(); iter!=loads.end(); iter++) {
+            addCopyEdge(content, *iter);
+        }
+        for (iter=stores.begin(); iter!=stores.end(); iter++) {
+            addCopyEdge(*iter, content);
+        }
+    }
+    if (rep(n) != n) { return; }
+
+    // then the new objects go along the copy edges
+    std::vector<int> succs(mNodes[n].mCopyTo.begin(),
+                           mNodes[n].mCopyTo.end());
+    std::vector<int>::iterator succIter;
+    for (succIter=succs.begin(); succIter!=succs.end(); succIter++) {
+        int m = rep(*succIter);
+        if (m == n) { continue; }
+        if (mNodes[m].mPts.unionWith(delta)) {
+            push(m);
+        }
+        // equal sets hint at a cycle, only look once per edge
+        if (mNodes[m].mPts == mNodes[n].mPts
+            && mCheckedEdges.insert(std::make_pair(n,m)).second)
+        {
+            detectCycles(m);
+            if (rep(n) != n) {
+                push(rep(n));
+                return;
+            }
+        }
+    }
+}
+
+void ManagerAndersenAliasMap::detectCycles(int start)
+{
+    // iterative Tarjan over the copy edges between representatives
+    std::map<int,int> index, low;
+    std::vector<int> stack;
+    std::set<int> onStack;
+    std::vector<std::vector<int> > sccs;
+
+    std::vector<CycleFrame> dfs;
+    int counter = 0;
+
+    std::vector<int> succs;
+    for (std::set<int>::iterator iter=mNodes[start].mCopyTo.begin();
+         iter!=mNodes[start].mCopyTo.end(); iter++)
+    {
+        succs.push_back(rep(*iter));
+    }
+    index[start] = low[start] = counter++;
+    stack.push_back(start);
+    onStack.insert(start);
+    dfs.push_back(CycleFrame(start, succs));
+
+    while (!dfs.empty()) {
+        CycleFrame& f = dfs.back();
+        if (f.mPos < f.mSuccs.size()) {
+            int w = f.mSuccs[f.mPos++];
+            if (w == f.mNode) { continue; }
+            if (index.find(w) == index.end()) {
+                succs.clear();
+                for (std::set<int>::iterator iter=mNodes[w].mCopyTo.begin();
+                     iter!=mNodes[w].mCopyTo.end(); iter++)
+                {
+                    succs.push_back(rep(*iter));
+                }
+                index[w] = low[w] = counter++;
+                stack.push_back(w);
+                onStack.insert(w);
+                dfs.push_back(CycleFrame(w, succs));
+            } else if (onStack.find(w) != onStack.end()) {
+                if (index[w] < low[f.mNode]) { low[f.mNode] = index[w]; }
+            }
+        } else {
+            int v = f.mNode;
+            dfs.pop_back();
+            if (low[v] == index[v]) {
+                std::vector<int> scc;
+                int w;
+                do {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack.erase(w);
+                    scc.push_back(w);
+                } while (w != v);
+                if (scc.size() > 1) { sccs.push_back(scc); }
+            }
+            if (!dfs.empty() && low[v] < low[dfs.back().mNode]) {
+                low[dfs.back().mNode] = low[v];
+            }
+        }
+    }
+
+    std::vector<std::vector<int> >::iterator sccIter;
+    for (sccIter=sccs.begin(); sccIter!=sccs.end(); sccIter++) {
+        int into = (*sccIter)[0];
+        for (unsigned int i=1; i<sccIter->size(); i++) {
+            collapse(into, (*sccIter)[i]);
+        }
+    }
+}
+
+void ManagerAndersenAliasMap::collapse(int into, int from)
+{
+    into = rep(into);
+    from = rep(from);
+    if (into == from) { return; }
+
+    mRep->Union(into, from, into);
+    mNumCollapsed++;
+
+    Node& a = mNodes[into];
+    Node& b = mNodes[from];
+    a.mPts.unionWith(b.mPts);
+    // only what both had sent is known to be at all the successors
+    a.mPrevPts.intersectWith(b.mPrevPts);
+    a.mCopyTo.insert(b.mCopyTo.begin(), b.mCopyTo.end());
+    a.mCopyTo.erase(into);
+    a.mCopyTo.erase(from);
+    a.mLoadTo.insert(a.mLoadTo.end(), b.mLoadTo.begin(), b.mLoadTo.end());
+    a.mStoreFrom.insert(a.mStoreFrom.end(),
+                        b.mStoreFrom.begin(), b.mStoreFrom.end());
+
+    b.mPts.clear();
+    b.mPrevPts.clear();
+    b.mCopyTo.clear();
+    b.mLoadTo.clear();
+    b.mStoreFrom.clear();
+
+    push(into);
+}
+
+//--------------------------------------------------------------------
+// results
+//--------------------------------------------------------------------
+
+void
+ManagerAndersenAliasMap::buildAliasMaps( OA_ptr<IRProcIterator> procIter )
+{
+    if (debug) { std::cout << "=========== Building AliasMap ========"
+                           << std::endl; }
+
+    for (procIter->reset();  procIter->isValid(); (*procIter)++ ) {
+      ProcHandle proc = procIter->current();
+
+      // create an alias map for this procedure
+      OA_ptr<AliasMap> aliasMap;
+      aliasMap = new AliasMap(proc);
+
+      // sets are shared by the mres that access the same locations
+      std::map<LocSet,int> locSetToAliasMapId;
+      // locations of each object in this proc, none if not visible
+      std::map<int,LocSet> objToLocs;
+
+      for (int id=1; id<(int)mIDToMRE.size(); id++) {
+          OA_ptr<MemRefExpr> mre = mIDToMRE[id];
+          if (mre.ptrEqual(0) || mre->isaAddressOf()) { continue; }
+
+          // mres not visible in this proc are in other alias maps
+          VisibleBaseVisitor mreVisitor(mIR, proc);
+          mre->acceptVisitor(mreVisitor);
+          if (!mreVisitor.isBaseVisible()) { continue; }
+
+          LocSet locs;
+          bool unknown = false;
+
+          // an mre with a fixed location only accesses that location
+          FixedLocationVisitor visitor(mIR, proc, aliasMap);
+          mre->acceptVisitor(visitor);
+          OA_ptr<LocSetIterator> locSetIterPtr =
+              visitor.getDirectRefLocIterator();
+          if (locSetIterPtr->isValid()) {
+              for (; locSetIterPtr->isValid(); ++(*locSetIterPtr) ) {
+                  locs.insert(locSetIterPtr->current());
+              }
+
+          // otherwise it accesses the locations of its objects
+          } else {
+              bool allVisible = true;
+              SparseBitVector& pts = mNodes[rep(id)].mPts;
+              for (SparseBitVectorIterator objIter(pts); objIter.isValid();
+                   ++objIter)
+              {
+                  int obj = objIter.current();
+                  if (mIDToMRE[obj]->isaUnknown()) { unknown = true; break; }
+
+                  if (objToLocs.find(obj) == objToLocs.end()) {
+                      FixedLocationVisitor objVisitor(mIR, proc, aliasMap);
+                      mIDToMRE[obj]->acceptVisitor(objVisitor);
+                      OA_ptr<LocSetIterator> objLocIter
+                          = objVisitor.getDirectRefLocIterator();
+                      for (; objLocIter->isValid(); ++(*objLocIter)) {
+                          objToLocs[obj].insert(objLocIter->current());
+                      }
+                  }
+                  if (objToLocs[obj].empty()) {
+                      allVisible = false;
+                  }
+                  locs.insert(objToLocs[obj].begin(), objToLocs[obj].end());
+              }
+
+              // objects not visible here are reached through formals
+              // and non-locals, which is what InvisibleLocs stand for
+              if (!allVisible || pts.empty()) {
+                  InvisibleLocationVisitor invVisitor(mIR, proc,
+                                                      mProcToFormalSet[proc]);
+                  mre->acceptVisitor(invVisitor);
+                  if (invVisitor.isInvisibleRef()) {
+                      locs.insert(invVisitor.getInvisibleRefLoc());
+                  } else if (!allVisible) {
+                      unknown = true;
+                  }
+              }
+          }
+
+          // nothing known about what it accesses
+          if (unknown || locs.empty()) {
+              aliasMap->mapMemRefToMapSet(mre,
+                                          aliasMap->getUnknownLocSetId());
+              continue;
+          }
+
+          std::map<LocSet,int>::iterator found
+              = locSetToAliasMapId.find(locs);
+          int aliasMapSetId;
+          if (found != locSetToAliasMapId.end()) {
+              aliasMapSetId = found->second;
+          } else {
+              aliasMapSetId = aliasMap->makeEmptySet();
+              LocSet::iterator locIter;
+              for (locIter=locs.begin(); locIter!=locs.end(); locIter++) {
+                  aliasMap->addLocation(*locIter, aliasMapSetId);
+              }
+              locSetToAliasMapId[locs] = aliasMapSetId;
+          }
+          aliasMap->mapMemRefToMapSet(mre, aliasMapSetId);
+      }
+
+      // store off the aliasmap for this procedure
+      mInterAliasMap->mapProcToAliasMap(proc,aliasMap);
+    }
+
+    // map the mem ref handles to the sets of their mres
+    std::map<MemRefHandle,ProcHandle>::iterator refprocIter;
+    for (refprocIter=mMemRefHandleToProc.begin();
+         refprocIter!=mMemRefHandleToProc.end(); refprocIter++ )
+    {
+        MemRefHandle memref = refprocIter->first;
+        ProcHandle proc = refprocIter->second;
+        OA_ptr<AliasMap> aliasMap = mInterAliasMap->getAliasMapResults(proc);
+
+        OA_ptr<MemRefExprIterator> mreIterPtr
+            = mIR->getMemRefExprIterator(memref);
+        for (; mreIterPtr->isValid(); (*mreIterPtr)++) {
+            OA_ptr<OA::MemRefExpr> mre = mreIterPtr->current();
+
+            // only map those MREs that do not involve an addressOf operation
+            if (mre->isaAddressOf()) { continue; }
+
+            int setId = aliasMap->getMapSetId(mre);
+            if (setId == AliasMap::SET_ID_NONE) {
+                setId = aliasMap->getUnknownLocSetId();
+            }
+            aliasMap->mapMemRefToMapSet(memref, setId);
+        }
+    }
+}
+
+  } // end of namespace Alias
+} // end of namespace OA
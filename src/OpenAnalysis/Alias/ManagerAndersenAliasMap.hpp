@@ -0,0 +1,156 @@
+/*! \file
+
+  \brief Declarations of the AnnotationManager that generates AliasMaps
+         with an inclusion-based points-to analysis.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef ManagerAndersenAliasMap_H
+#define ManagerAndersenAliasMap_H
+
+//--------------------------------------------------------------------
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Alias/InterAliasMap.hpp>
+#include <OpenAnalysis/Alias/ManagerFIAlias.hpp>
+#include <OpenAnalysis/Utils/SparseBitVector.hpp>
+#include <map>
+#include <set>
+#include <deque>
+#include <list>
+#include <vector>
+
+namespace OA {
+  namespace Alias {
+
+/*!
+    Creates AliasMaps for the whole program, which satisfy the
+    Alias::Interface.hpp, with a flow and context insensitive
+    inclusion-based points-to analysis (Andersen 1994) over the
+    same MRE input as ManagerFIAlias.
+
+    Every MRE is a constraint variable for the set of abstract
+    objects that the MRE may access.  Named, unnamed, and unknown
+    refs are the objects, each with a variable for the objects whose
+    addresses it may hold.  Pointer assignments and parameter bindings
+    become the usual address, copy, load, and store constraints.
+    SubSetRefs access the whole object they are based on.  Indirect
+    calls are bound to callees as function objects reach their call
+    MRE.
+
+    The constraints are solved with difference propagation, only the
+    objects new to a variable are pushed along its edges, and with
+    lazy cycle detection (Hardekopf and Lin, PLDI 2007), variables
+    on a cycle of copy edges are collapsed into one.  Points-to sets
+    are SparseBitVectors of MRE ids.
+
+    Unlike FIAlias, MREs that only share the objects they point to
+    through different pointers do not end up in the same set, so
+    each MRE gets the AliasMap set for exactly the locations it may
+    access.
+*/
+class ManagerAndersenAliasMap : public ManagerFIAlias
+{
+public:
+  ManagerAndersenAliasMap(OA_ptr<AliasIRInterface> _ir);
+  ~ManagerAndersenAliasMap () {}
+
+  //! Perform the inter-procedural analysis on all procedures in procIter
+  OA_ptr<Alias::InterAliasMap>
+  performAnalysis(OA_ptr<IRProcIterator> procIter);
+
+  //---------------------------------
+  // statistics
+  //---------------------------------
+  //! number of constraint variables, including the collapsed ones
+  int getNumNodes() { return mNodes.size(); }
+  //! number of variables that were collapsed into another
+  int getNumCollapsed() { return mNumCollapsed; }
+  //! number of objects in the points-to sets of all MREs
+  int getTotalPointsToSize();
+
+private:
+  //! one constraint variable
+  struct Node {
+    SparseBitVector mPts;      //!< objects, by MRE id
+    SparseBitVector mPrevPts;  //!< part of mPts already propagated
+    std::set<int> mCopyTo;     //!< n -> m: pts(m) includes pts(n)
+    std::vector<int> mLoadTo;  //!< m: pts(m) includes pts(*n)
+    std::vector<int> mStoreFrom; //!< m: pts(*n) includes pts(m)
+  };
+
+  //--------------------------------------------------------
+  // building the constraints
+  //--------------------------------------------------------
+  void buildConstraints(OA_ptr<IRProcIterator> procIter);
+  //! variable holding the objects whose addresses source evaluates to
+  int valueNode(OA_ptr<MemRefExpr> source);
+  //! id of an mre recorded by initMemRefExprs, 0 if it was not
+  int idOf(OA_ptr<MemRefExpr> mre);
+  //! formal/actual bindings of call to callee
+  void bindCall(CallHandle call, ProcHandle callee);
+  //! binds indirect calls to the procedures that reached them,
+  //! returns true if a new binding was made
+  bool resolveIndirectCalls();
+
+  //--------------------------------------------------------
+  // the solver
+  //--------------------------------------------------------
+  int newNode();
+  int rep(int n) { return mRep->Find(n); }
+  void push(int n);
+  void addCopyEdge(int src, int dst);
+  void addLoad(int ptr, int dst);
+  void addStore(int ptr, int src);
+  void solve();
+  void processNode(int n);
+  //! collapses the cycles of copy edges reachable from start
+  void detectCycles(int start);
+  void collapse(int into, int from);
+
+  //--------------------------------------------------------
+  // results
+  //--------------------------------------------------------
+  void buildAliasMaps(OA_ptr<IRProcIterator> procIter);
+
+private:
+  //! A map from procedures to alias maps.
+  OA_ptr<InterAliasMap> mInterAliasMap;
+
+  // nodes 0..mCount-1 are the variables for the mre with that id,
+  // the rest are object contents and temporaries
+  std::deque<Node> mNodes;
+  OA_ptr<UnionFindUniverse> mRep;
+  std::vector<OA_ptr<MemRefExpr> > mIDToMRE;
+  //! for each object mre id the variable for its contents, -1 if
+  //! the mre is not an object
+  std::vector<int> mContentNode;
+  //! value variable for a non-AddressOf source mre id
+  std::map<int,int> mValueNode;
+
+  std::list<int> mWorklist;
+  std::vector<bool> mOnWorklist;
+  //! copy edges that have already triggered cycle detection
+  std::set<std::pair<int,int> > mCheckedEdges;
+  int mNumCollapsed;
+
+  //! indirect call sites and the callees bound to them so far
+  struct IndirectCall {
+    IndirectCall(CallHandle call, int callNode)
+      : mCall(call), mCallNode(callNode) {}
+    CallHandle mCall;
+    int mCallNode;
+    std::set<ProcHandle> mCallees;
+  };
+  std::vector<IndirectCall> mIndirectCalls;
+};
+
+  } // end of Alias namespace
+} // end of OA namespace
+
+#endif
@@ -0,0 +1,528 @@
+/*! \file
+
+  \brief The manager that answers points-to queries for single memory
+         references on demand.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerDemandAlias.hpp"
+#include "ManagerFIAliasAliasMap.hpp"
+#include <Utils/Util.hpp>
+
+
+namespace OA {
+  namespace Alias {
+
+static bool debug = false;
+
+ManagerDemandAlias::ManagerDemandAlias(OA_ptr<AliasIRInterface> _ir)
+  : ManagerFIAlias(_ir), mBudget(100000), mNumNodes(0), mCost(0),
+    mNumQueries(0), mNumFallbacks(0), mNumEvaluations(0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerDemandAlias:ALL", debug);
+}
+
+//--------------------------------------------------------------------
+// building the constraints
+//--------------------------------------------------------------------
+
+void ManagerDemandAlias::performAnalysis( OA_ptr<IRProcIterator> procIter )
+{
+    mProcIter = procIter;
+
+    // map each MemRefExpr to a unique id
+    initMemRefExprs(procIter);
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        mAnalyzedProcs.insert(procIter->current());
+    }
+
+    mIDToMRE.resize(mCount);
+    mContentNode.resize(mCount, -1);
+    for (int i=0; i<mCount; i++) {
+        newNode();
+    }
+
+    // objects and the constraints between an mre and its sub mre
+    MemRefExprIDTable::iterator mreIter;
+    for (mreIter=mMREToID.begin(); mreIter!=mMREToID.end(); mreIter++) {
+        mIDToMRE[mreIter->second] = mreIter->first;
+    }
+    for (int id=1; id<mCount; id++) {
+        OA_ptr<MemRefExpr> mre = mIDToMRE[id];
+        if (mre.ptrEqual(0)) { continue; }
+
+        if (mre->isaNamed() || mre->isaUnnamed() || mre->isaUnknown()) {
+            // an object accesses itself
+            int content = newNode();
+            mContentNode[id] = content;
+            mContentOf[content] = id;
+
+        } else if (mre->isaRefOp()) {
+            OA_ptr<RefOp> refop = mre.convert<RefOp>();
+            if (refop->isaAddressOf()) { continue; }
+
+            int inner = idOf(refop->getMemRefExpr());
+            if (inner == 0) { continue; }
+            if (refop->isaDeref()) {
+                // *q accesses what q points to
+                mLoadFrom[id].push_back(inner);
+            } else {
+                // subsets access the same objects as their base
+                mCopyFrom[id].push_back(inner);
+            }
+        }
+    }
+
+    // formals, so indirect calls can be bound when they are queried
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        ProcHandle proc = procIter->current();
+        int formalCount = 0;
+        SymHandle formalSym;
+        while ( (formalSym=mIR->getFormalSym(proc,formalCount))
+                != SymHandle(0) )
+        {
+            OA_ptr<MemRefExpr> formalmre;
+            formalmre = new NamedRef(MemRefExpr::DEF, formalSym);
+            int formal = idOf(formalmre);
+            if (formal != 0) {
+                mFormalOf[formal]
+                    = std::pair<ProcHandle,int>(proc, formalCount);
+            }
+            formalCount++;
+        }
+    }
+
+    // pointer assignments and calls
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        ProcHandle currProc = procIter->current();
+        OA_ptr<IRStmtIterator> stmtIterPtr = mIR->getStmtIterator(currProc);
+        for ( ; stmtIterPtr->isValid(); ++(*stmtIterPtr)) {
+            StmtHandle stmt = stmtIterPtr->current();
+
+            OA_ptr<PtrAssignPairStmtIterator> pairIter
+                = mIR->getPtrAssignStmtPairIterator(stmt);
+            for ( ; pairIter->isValid(); (*pairIter)++ ) {
+                int target = idOf(pairIter->currentTarget());
+                int value = valueNode(pairIter->currentSource());
+                if (target == 0 || value < 0) { continue; }
+                addStore(target, value);
+            }
+
+            OA_ptr<IRCallsiteIterator> callIter = mIR->getCallsites(stmt);
+            for ( ; callIter->isValid(); (*callIter)++ ) {
+                CallHandle call = callIter->current();
+                OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
+                if (callMRE->isaNamed()) {
+                    SymHandle sym = callMRE.convert<NamedRef>()->getSymHandle();
+                    ProcHandle callee = mIR->getProcHandle(sym);
+                    if (callee != ProcHandle(0)) {
+                        bindCall(call, callee);
+                    }
+                    continue;
+                }
+
+                // the callees are only known once the call mre is queried
+                int callNode = idOf(callMRE);
+                if (callNode == 0) { continue; }
+                IndirectCall indirect(callNode);
+                OA_ptr<ParamBindPtrAssignIterator> bindIter
+                    = mIR->getParamBindPtrAssignIterator(call);
+                for ( ; bindIter->isValid(); (*bindIter)++ ) {
+                    int value = valueNode(bindIter->currentActual());
+                    if (value < 0) { continue; }
+                    indirect.mBindings.push_back(std::pair<int,int>(
+                        bindIter->currentFormalId(), value));
+                }
+                mIndirectCalls.push_back(indirect);
+            }
+        }
+    }
+
+    if (debug) {
+        std::cout << "ManagerDemandAlias: " << mNumNodes << " nodes, "
+                  << mIndirectStores.size() << " stores through pointers, "
+                  << mIndirectCalls.size() << " indirect calls" << std::endl;
+    }
+}
+
+int ManagerDemandAlias::newNode()
+{
+    mCopyFrom.push_back(std::vector<int>());
+    mLoadFrom.push_back(std::vector<int>());
+    mContentOf.push_back(-1);
+    return mNumNodes++;
+}
+
+int ManagerDemandAlias::idOf(OA_ptr<MemRefExpr> mre)
+{
+    MemRefExprIDTable::iterator found = mMREToID.find(mre);
+    if (found == mMREToID.end()) { return 0; }
+    return found->second;
+}
+
+int ManagerDemandAlias::valueNode(OA_ptr<MemRefExpr> source)
+{
+    // &x evaluates to the objects x accesses
+    if (source->isaRefOp()) {
+        OA_ptr<RefOp> refop = source.convert<RefOp>();
+        if (refop->isaAddressOf()) {
+            int inner = idOf(refop->getMemRefExpr());
+            return inner == 0 ? -1 : inner;
+        }
+    }
+
+    // anything else evaluates to what the objects it accesses point to
+    int id = idOf(source);
+    if (id == 0) { return -1; }
+    std::map<int,int>::iterator found = mValueNode.find(id);
+    if (found != mValueNode.end()) { return found->second; }
+
+    int value = newNode();
+    mLoadFrom[value].push_back(id);
+    mValueNode[id] = value;
+    return value;
+}
+
+void ManagerDemandAlias::addStore(int ptr, int src)
+{
+    // the variable of a named or unnamed ref only holds that object
+    if (ptr < mCount && mContentNode[ptr] >= 0) {
+        mDirectStores[ptr].push_back(src);
+    } else {
+        mIndirectStores.push_back(std::pair<int,int>(ptr, src));
+    }
+}
+
+void ManagerDemandAlias::bindCall(CallHandle call, ProcHandle callee)
+{
+    OA_ptr<ParamBindPtrAssignIterator> pairIter
+        = mIR->getParamBindPtrAssignIterator(call);
+    for ( ; pairIter->isValid(); (*pairIter)++ ) {
+        SymHandle formalSym
+            = mIR->getFormalSym(callee, pairIter->currentFormalId());
+        // if the signature doesn't match then don't process
+        if (formalSym==SymHandle(0)) { continue; }
+
+        OA_ptr<MemRefExpr> formalmre;
+        formalmre = new NamedRef(MemRefExpr::DEF, formalSym);
+        int formal = idOf(formalmre);
+        int value = valueNode(pairIter->currentActual());
+        if (formal == 0 || value < 0) { continue; }
+
+        // formal = actual
+        addStore(formal, value);
+    }
+}
+
+//--------------------------------------------------------------------
+// answering a query
+//--------------------------------------------------------------------
+
+bool ManagerDemandAlias::solve(int node, SparseBitVector& result)
+{
+    std::map<int,SparseBitVector>::iterator solved = mSolved.find(node);
+    if (solved != mSolved.end()) {
+        result = solved->second;
+        return true;
+    }
+
+    mPts.clear();
+    mUsers.clear();
+    mWorklist.clear();
+    mOnWorklist.clear();
+    mCost = 0;
+
+    demand(node, -1);
+    bool finished = true;
+    while (!mWorklist.empty()) {
+        if (mBudget > 0 && mCost > mBudget) {
+            finished = false;
+            break;
+        }
+        int n = mWorklist.front();
+        mWorklist.pop_front();
+        mOnWorklist.erase(n);
+
+        SparseBitVector pts;
+        evaluate(n, pts);
+        if (mPts[n].unionWith(pts)) {
+            std::set<int>& users = mUsers[n];
+            std::set<int>::iterator userIter;
+            for (userIter=users.begin(); userIter!=users.end(); userIter++) {
+                if (mOnWorklist.insert(*userIter).second) {
+                    mWorklist.push_back(*userIter);
+                }
+            }
+        }
+    }
+    mNumEvaluations += mCost;
+
+    if (debug) {
+        std::cout << "ManagerDemandAlias::solve(" << node << "): "
+                  << mPts.size() << " nodes, cost " << mCost
+                  << (finished ? "" : ", out of budget") << std::endl;
+    }
+
+    // everything evaluated is at its fixed point, keep it
+    if (finished) {
+        std::map<int,SparseBitVector>::iterator ptsIter;
+        for (ptsIter=mPts.begin(); ptsIter!=mPts.end(); ptsIter++) {
+            mSolved[ptsIter->first].unionWith(ptsIter->second);
+        }
+        result = mSolved[node];
+    }
+    mPts.clear();
+    mUsers.clear();
+    mWorklist.clear();
+    mOnWorklist.clear();
+    return finished;
+}
+
+const SparseBitVector& ManagerDemandAlias::demand(int node, int user)
+{
+    std::map<int,SparseBitVector>::iterator solved = mSolved.find(node);
+    if (solved != mSolved.end()) { return solved->second; }
+
+    std::map<int,SparseBitVector>::iterator found = mPts.find(node);
+    if (found == mPts.end()) {
+        found = mPts.insert(
+            std::pair<int,SparseBitVector>(node, SparseBitVector())).first;
+        mOnWorklist.insert(node);
+        mWorklist.push_back(node);
+    }
+    if (user >= 0) { mUsers[node].insert(user); }
+    return found->second;
+}
+
+void ManagerDemandAlias::evaluate(int node, SparseBitVector& result)
+{
+    mCost++;
+
+    // an object accesses itself
+    if (node < mCount && mContentNode[node] >= 0) {
+        result.set(node);
+    }
+
+    std::vector<int>::iterator iter;
+    for (iter=mCopyFrom[node].begin(); iter!=mCopyFrom[node].end(); iter++) {
+        mCost++;
+        result.unionWith(demand(*iter, node));
+    }
+
+    for (iter=mLoadFrom[node].begin(); iter!=mLoadFrom[node].end(); iter++) {
+        std::vector<unsigned int> objs;
+        demand(*iter, node).getBits(objs);
+        std::vector<unsigned int>::iterator objIter;
+        for (objIter=objs.begin(); objIter!=objs.end(); objIter++) {
+            mCost++;
+            int content = mContentNode[*objIter];
+            if (content >= 0) {
+                result.unionWith(demand(content, node));
+            }
+        }
+    }
+
+    // the contents of an object get what is stored into it
+    int obj = mContentOf[node];
+    if (obj < 0) { return; }
+
+    std::map<int,std::vector<int> >::iterator direct
+        = mDirectStores.find(obj);
+    if (direct != mDirectStores.end()) {
+        for (iter=direct->second.begin(); iter!=direct->second.end(); iter++) {
+            mCost++;
+            result.unionWith(demand(*iter, node));
+        }
+    }
+
+    std::vector<std::pair<int,int> >::iterator store;
+    for (store=mIndirectStores.begin(); store!=mIndirectStores.end();
+         store++)
+    {
+        mCost++;
+        if (demand(store->first, node).test(obj)) {
+            result.unionWith(demand(store->second, node));
+        }
+    }
+
+    // formals get the actuals of the indirect calls that reach their proc
+    std::map<int,std::pair<ProcHandle,int> >::iterator formal
+        = mFormalOf.find(obj);
+    if (formal == mFormalOf.end()) { return; }
+    ProcHandle proc = formal->second.first;
+    int formalId = formal->second.second;
+
+    std::vector<IndirectCall>::iterator callIter;
+    for (callIter=mIndirectCalls.begin(); callIter!=mIndirectCalls.end();
+         callIter++)
+    {
+        std::vector<std::pair<int,int> >::iterator bindIter;
+        std::vector<int> values;
+        for (bindIter=callIter->mBindings.begin();
+             bindIter!=callIter->mBindings.end(); bindIter++)
+        {
+            if (bindIter->first == formalId) {
+                values.push_back(bindIter->second);
+            }
+        }
+        if (values.empty()) { continue; }
+
+        bool reaches = false;
+        for (SparseBitVectorIterator calleeIter(demand(callIter->mCallNode,
+                                                       node));
+             calleeIter.isValid() && !reaches; ++calleeIter)
+        {
+            mCost++;
+            OA_ptr<MemRefExpr> callee = mIDToMRE[calleeIter.current()];
+            if (callee->isaNamed()
+                && mIR->getProcHandle(
+                       callee.convert<NamedRef>()->getSymHandle()) == proc)
+            {
+                reaches = true;
+            }
+        }
+        if (!reaches) { continue; }
+
+        for (iter=values.begin(); iter!=values.end(); iter++) {
+            result.unionWith(demand(*iter, node));
+        }
+    }
+}
+
+OA_ptr<LocIterator> ManagerDemandAlias::getMayLocs(MemRefHandle ref)
+{
+    OA_ptr<LocSet> locs;
+    locs = new LocSet;
+
+    std::map<MemRefHandle,ProcHandle>::iterator found
+        = mMemRefHandleToProc.find(ref);
+    if (found == mMemRefHandleToProc.end()) {
+        OA_ptr<Location> unknown;
+        unknown = new UnknownLoc();
+        locs->insert(unknown);
+    } else {
+        OA_ptr<MemRefExprIterator> mreIterPtr
+            = mIR->getMemRefExprIterator(ref);
+        for (; mreIterPtr->isValid(); (*mreIterPtr)++) {
+            mayLocs(mreIterPtr->current(), found->second, *locs);
+        }
+    }
+
+    OA_ptr<LocIterator> retval;
+    retval = new LocSetIterator(locs);
+    return retval;
+}
+
+OA_ptr<LocIterator>
+ManagerDemandAlias::getMayLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc)
+{
+    OA_ptr<LocSet> locs;
+    locs = new LocSet;
+    mayLocs(mre, proc, *locs);
+
+    OA_ptr<LocIterator> retval;
+    retval = new LocSetIterator(locs);
+    return retval;
+}
+
+void ManagerDemandAlias::mayLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc,
+                                 LocSet& locs)
+{
+    // mres with an addressOf don't access memory
+    if (mre->isaAddressOf()) { return; }
+    mNumQueries++;
+
+    // an mre with a fixed location only accesses that location
+    OA_ptr<Interface> noAliasResults;
+    FixedLocationVisitor visitor(mIR, proc, noAliasResults);
+    mre->acceptVisitor(visitor);
+    OA_ptr<LocSetIterator> locSetIterPtr = visitor.getDirectRefLocIterator();
+    if (locSetIterPtr->isValid()) {
+        for (; locSetIterPtr->isValid(); ++(*locSetIterPtr) ) {
+            locs.insert(locSetIterPtr->current());
+        }
+        return;
+    }
+
+    int id = idOf(mre);
+    SparseBitVector pts;
+    if (id == 0) {
+        OA_ptr<Location> unknown;
+        unknown = new UnknownLoc();
+        locs.insert(unknown);
+    } else if (solve(id, pts)) {
+        objectsToLocs(mre, proc, pts, locs);
+    } else {
+        mNumFallbacks++;
+        fallbackMayLocs(mre, proc, locs);
+    }
+}
+
+void ManagerDemandAlias::objectsToLocs(OA_ptr<MemRefExpr> mre,
+                                       ProcHandle proc,
+                                       const SparseBitVector& pts,
+                                       LocSet& locs)
+{
+    LocSet objLocs;
+    bool unknown = false;
+    bool allVisible = true;
+    OA_ptr<Interface> noAliasResults;
+    for (SparseBitVectorIterator objIter(pts); objIter.isValid(); ++objIter) {
+        OA_ptr<MemRefExpr> obj = mIDToMRE[objIter.current()];
+        if (obj->isaUnknown()) { unknown = true; break; }
+
+        FixedLocationVisitor objVisitor(mIR, proc, noAliasResults);
+        obj->acceptVisitor(objVisitor);
+        OA_ptr<LocSetIterator> objLocIter
+            = objVisitor.getDirectRefLocIterator();
+        if (!objLocIter->isValid()) { allVisible = false; }
+        for (; objLocIter->isValid(); ++(*objLocIter)) {
+            objLocs.insert(objLocIter->current());
+        }
+    }
+
+    // objects not visible here are reached through formals
+    // and non-locals, which is what InvisibleLocs stand for
+    if (!unknown && (!allVisible || pts.empty())) {
+        InvisibleLocationVisitor invVisitor(mIR, proc,
+                                            mProcToFormalSet[proc]);
+        mre->acceptVisitor(invVisitor);
+        if (invVisitor.isInvisibleRef()) {
+            objLocs.insert(invVisitor.getInvisibleRefLoc());
+        } else if (!allVisible) {
+            unknown = true;
+        }
+    }
+
+    // nothing known about what it accesses
+    if (unknown || objLocs.empty()) {
+        OA_ptr<Location> unknownLoc;
+        unknownLoc = new UnknownLoc();
+        locs.insert(unknownLoc);
+        return;
+    }
+    locs.insert(objLocs.begin(), objLocs.end());
+}
+
+void ManagerDemandAlias::fallbackMayLocs(OA_ptr<MemRefExpr> mre,
+                                         ProcHandle proc, LocSet& locs)
+{
+    if (mFallback.ptrEqual(0)) {
+        ManagerFIAliasAliasMap fialiasman(mIR);
+        mFallback = fialiasman.performAnalysis(mProcIter);
+    }
+
+    OA_ptr<LocIterator> locIter
+        = mFallback->getAliasMapResults(proc)->getMayLocs(*mre, proc);
+    for ( ; locIter->isValid(); ++(*locIter)) {
+        locs.insert(locIter->current());
+    }
+}
+
+  } // end of namespace Alias
+} // end of namespace OA
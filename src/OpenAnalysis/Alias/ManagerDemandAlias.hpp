@@ -0,0 +1,163 @@
+/*! \file
+
+  \brief Declarations of a manager that answers points-to queries for
+         single memory references on demand.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef ManagerDemandAlias_H
+#define ManagerDemandAlias_H
+
+//--------------------------------------------------------------------
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Alias/InterAliasMap.hpp>
+#include <OpenAnalysis/Alias/ManagerFIAlias.hpp>
+#include <OpenAnalysis/Utils/SparseBitVector.hpp>
+#include <map>
+#include <list>
+#include <set>
+#include <vector>
+
+namespace OA {
+  namespace Alias {
+
+/*!
+    Answers which locations a MemRefHandle or MRE may access without
+    analyzing the whole program first.
+
+    performAnalysis only gathers the same address, copy, load, and
+    store constraints that ManagerAndersenAliasMap solves.  A query
+    starts at the variable for the MRE and works backwards, only
+    evaluating the variables its points-to set depends on, until none
+    of them change (Heintze and Tardieu, PLDI 2001).  Stores whose
+    target is a named or unnamed ref are indexed by that object, so
+    only stores through pointers make a query look at other pointers.
+    The points-to sets of every variable a finished query evaluated
+    are kept for later queries.
+
+    Each query may evaluate at most the budget worth of constraints.
+    If it runs out, the answer comes from ManagerFIAliasAliasMap,
+    which is run over the whole program the first time that happens.
+*/
+class ManagerDemandAlias : public ManagerFIAlias
+{
+public:
+  ManagerDemandAlias(OA_ptr<AliasIRInterface> _ir);
+  ~ManagerDemandAlias () {}
+
+  //! gathers the constraints of all procedures in procIter, nothing
+  //! is solved until it is asked for
+  void performAnalysis(OA_ptr<IRProcIterator> procIter);
+
+  //! constraints a query may evaluate before it falls back to
+  //! FIAlias, 0 means no limit
+  void setBudget(int budget) { mBudget = budget; }
+
+  //! locations the mres of ref may access
+  OA_ptr<LocIterator> getMayLocs(MemRefHandle ref);
+  //! locations mre may access within proc
+  OA_ptr<LocIterator> getMayLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc);
+
+  //---------------------------------
+  // statistics
+  //---------------------------------
+  int getNumQueries() { return mNumQueries; }
+  //! queries that ran out of budget and were answered by FIAlias
+  int getNumFallbacks() { return mNumFallbacks; }
+  //! constraints evaluated by all queries
+  int getNumEvaluations() { return mNumEvaluations; }
+
+private:
+  //--------------------------------------------------------
+  // building the constraints
+  //--------------------------------------------------------
+  int newNode();
+  //! variable holding the objects whose addresses source evaluates to
+  int valueNode(OA_ptr<MemRefExpr> source);
+  //! id of an mre recorded by initMemRefExprs, 0 if it was not
+  int idOf(OA_ptr<MemRefExpr> mre);
+  //! the objects ptr accesses may point to what src points to
+  void addStore(int ptr, int src);
+  //! formal/actual bindings of call to callee
+  void bindCall(CallHandle call, ProcHandle callee);
+
+  //--------------------------------------------------------
+  // answering a query
+  //--------------------------------------------------------
+  //! points-to set of node, false if the budget ran out
+  bool solve(int node, SparseBitVector& result);
+  //! evaluates the constraints of node from what is known so far
+  void evaluate(int node, SparseBitVector& result);
+  //! what is known so far about node, which user depends on
+  const SparseBitVector& demand(int node, int user);
+  //! adds the locations mre may access within proc to locs
+  void mayLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc, LocSet& locs);
+  //! locations for mre given the objects it may access
+  void objectsToLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc,
+                     const SparseBitVector& pts, LocSet& locs);
+  void fallbackMayLocs(OA_ptr<MemRefExpr> mre, ProcHandle proc,
+                       LocSet& locs);
+
+private:
+  OA_ptr<IRProcIterator> mProcIter;
+  int mBudget;
+
+  // nodes 0..mCount-1 are the variables for the mre with that id,
+  // the rest are object contents and temporaries
+  int mNumNodes;
+  std::vector<OA_ptr<MemRefExpr> > mIDToMRE;
+  //! pts(n) includes pts(m) for each m in mCopyFrom[n]
+  std::vector<std::vector<int> > mCopyFrom;
+  //! pts(n) includes pts(*p) for each p in mLoadFrom[n]
+  std::vector<std::vector<int> > mLoadFrom;
+  //! for each object mre id the variable for its contents, -1 if
+  //! the mre is not an object
+  std::vector<int> mContentNode;
+  //! the object of each content variable, -1 for other nodes
+  std::vector<int> mContentOf;
+  //! value variable for a non-AddressOf source mre id
+  std::map<int,int> mValueNode;
+  //! stores into a named or unnamed ref, by that object
+  std::map<int,std::vector<int> > mDirectStores;
+  //! stores through a pointer, ptr and src
+  std::vector<std::pair<int,int> > mIndirectStores;
+
+  //! the proc and formal id of each formal object
+  std::map<int,std::pair<ProcHandle,int> > mFormalOf;
+  //! indirect call sites, with the formal id and value variable of
+  //! each actual
+  struct IndirectCall {
+    IndirectCall(int callNode) : mCallNode(callNode) {}
+    int mCallNode;
+    std::vector<std::pair<int,int> > mBindings;
+  };
+  std::vector<IndirectCall> mIndirectCalls;
+
+  //! points-to sets from finished queries
+  std::map<int,SparseBitVector> mSolved;
+
+  // state of the current query
+  std::map<int,SparseBitVector> mPts;
+  std::map<int,std::set<int> > mUsers;
+  std::list<int> mWorklist;
+  std::set<int> mOnWorklist;
+  int mCost;
+
+  //! FIAlias results, made when a query first runs out of budget
+  OA_ptr<InterAliasMap> mFallback;
+
+  int mNumQueries;
+  int mNumFallbacks;
+  int mNumEvaluations;
+};
+
+  } // end of Alias namespace
+} // end of OA namespace
+
+#endif
@@ -136,7 +136,9 @@ void FixedLocationVisitor::visitFieldAccess(FieldAccess& ref)
 /*!
 */
 ManagerFIAlias::ManagerFIAlias( OA_ptr<AliasIRInterface> _ir) : mIR(_ir),
-    mCount(1)
+    mCount(1), mNumThreads(0), mSubSetDepth(-1), mSubSetBudget(-1),
+    mNumSubSets(0), mNumCollapsedSubSets(0),
+    mReusedLoaded(false), mNumReusedSets(0), mNumChangedProcs(0)
 {
     OA_DEBUG_CTRL_MACRO("DEBUG_ManagerFIAlias:ALL", debug);
 }
@@ -384,7 +386,7 @@ void VisibleBaseVisitor::visitSubSetRef(SubSetRef& ref)
  *
 void ManagerFIAlias::mergeSubSetRefs(OA_ptr<UnionFindUniverse> ufset) {
 
-     std::map<OA_ptr<MemRefExpr>,int>::iterator mapIter;
+     MemRefExprIDTable::iterator mapIter;
      for (mapIter=mMREToID.begin(); mapIter!=mMREToID.end(); mapIter++) {
           OA_ptr<MemRefExpr> mymre = mapIter->first;
               
@@ -441,9 +443,12 @@ ManagerFIAlias::doPhase1Iteration(StmtHandle stmt, ProcHandle currProc,
         }
                 
         // then union the sets with *target and *source 
-        ufset->Union( ufset->Find(mMREToID[targetDeref]),
-                      ufset->Find(mMREToID[sourceDeref]),
-                      ufset->Find(mMREToID[sourceDeref]) );
+        int targetPart = ufset->Find(mMREToID[targetDeref]);
+        int sourcePart = ufset->Find(mMREToID[sourceDeref]);
+        ufset->Union( targetPart, sourcePart, sourcePart );
+        if (targetPart != sourcePart) {
+            noteUnion(targetPart, sourcePart, ufset);
+        }
 
     } // iteration over ptr assign pairs
 
@@ -451,77 +456,68 @@ ManagerFIAlias::doPhase1Iteration(StmtHandle stmt, ProcHandle currProc,
 
 bool
 ManagerFIAlias::doPhase2Iteration(OA_ptr<UnionFindUniverse> ufset,
-                                  std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map) 
+                                  PartRefOpMap & map) 
 {
     bool changed = false;
+    registerNewMREs(ufset);
 
     // for each memref
-    std::map<OA_ptr<MemRefExpr>,int>::iterator mreMapIter;
-    for (mreMapIter=mMREToID.begin(); 
-         mreMapIter!=mMREToID.end(); mreMapIter++ ) 
-    {
-        OA_ptr<MemRefExpr> mre = mreMapIter->first;
-        if (debug) {
-            std::cout << std::endl << "\tmre = ";
-            mre->output(*mIR);
-            std::cout << "\t\tFind(mMREToID[mre]) = " 
-                      << ufset->Find(mMREToID[mre]) << std::endl;
+    int numIDs = mIDToMRE.size();
+    for (int id=1; id<numIDs; id++) {
+        if (doPhase2Constraint(id, ufset, map)) {
+            changed = true;
         }
+    } // over mre
+    return changed;
+}
 
-        // only do the following for real MREs, if the MRE is part of
-        // an addressOf operation then the outermost MRE doesn't involve
-        // any memory being accessed
-        if(mre->isaRefOp()) {
-            OA_ptr<RefOp> refop = mre.convert<RefOp>();
-            if(!refop->isaAddressOf()) {
-                OuterRefOpVisitor outerRefVisitor;
-                mre->acceptVisitor(outerRefVisitor);
-                OA_ptr<RefOp> justRefop = outerRefVisitor.getOuterRefOp();
-                OA_ptr<MemRefExpr> innerMRE = refop->getMemRefExpr();
+//! Ryder phase 2 for a single mre: the mre must be in the same set
+//! as map[find(innerMRE)][outer refop].  Returns true if a set or
+//! the map had to change.  The mre must have been registered.
+bool
+ManagerFIAlias::doPhase2Constraint(int mreID,
+                                   OA_ptr<UnionFindUniverse> ufset,
+                                   PartRefOpMap & map) 
+{
+    // only do the following for real MREs, if the MRE is part of
+    // an addressOf operation then the outermost MRE doesn't involve
+    // any memory being accessed
+    int refopID = mIDToRefOpID[mreID];
+    if (refopID == 0) { return false; }
+
+    // the inner mre hasn't been recorded yet, see registerNewMREs
+    int innerID = mIDToInnerID[mreID];
+    if (innerID == 0) { return false; }
+    int part = ufset->Find(mreID);
+    int innerPart = ufset->Find(innerID);
 
-                if (debug) {
-                    std::cout << "\t\tinnerMRE = ";
-                    if (! innerMRE.ptrEqual(0) ) {
-                        innerMRE->output(*mIR);
-                    } else { 
-                        std::cout << "<null MRE>" << std::endl;
-                    }
-                    std::cout << "\t\tFind( innerMRE ) = "
-                              << ufset->Find(mMREToID[innerMRE])
-                              << std::endl;
-                    std::cout << "\t\tjustRefop = ";
-                    if (! justRefop.ptrEqual(0) ) {
-                        justRefop->output(*mIR);
-                    } else { 
-                        std::cout << "<null MREF>" << std::endl;
-                    }
-                }
+    if (debug) {
+        std::cout << std::endl << "\tmre = ";
+        mIDToMRE[mreID]->output(*mIR);
+        std::cout << "\t\tFind(mMREToID[mre]) = " << part << std::endl;
+        std::cout << "\t\tFind( innerMRE ) = " << innerPart << std::endl;
+        std::cout << "\t\tjustRefop id = " << refopID << std::endl;
+    }
 
-                // if find(memref)!=find( map[find(innerMRE)][justRefop] )
-                int setID = ufset->Find( 
-                    map[ufset->Find(mMREToID[innerMRE])][justRefop] );
-                if ( ufset->Find(mMREToID[mre]) != setID ) {
-                    changed = true;
-                    // if map[find(memref->getMemRef)][refop] is not in a part yet
-                    if (setID == 0) {
-                        // then put it in the one for memref
-                        map[ufset->Find(mMREToID[innerMRE])][justRefop] 
-                            = ufset->Find(mMREToID[mre]);
-                    // else
-                    } else {
-                        merge(ufset->Find(mMREToID[mre]), setID, ufset, map);
-                    }
-                }
-            }// does not have address taken
-        } // is a refop
-    } // over mre
-    return changed;
+    // if find(memref)!=find( map[find(innerMRE)][justRefop] )
+    int setID = ufset->Find( map[innerPart][refopID] );
+    if ( part == setID ) { return false; }
+
+    // if map[find(memref->getMemRef)][refop] is not in a part yet
+    if (setID == 0) {
+        // then put it in the one for memref
+        map[innerPart][refopID] = part;
+    // else
+    } else {
+        merge(part, setID, ufset, map);
+    }
+    return true;
 }
 
 void 
 ManagerFIAlias::doPhase3Iteration(CallHandle call, ProcHandle currProc,
                                   OA_ptr<UnionFindUniverse> ufset,
-                                  std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map)
+                                  PartRefOpMap & map)
 {
     // get the mre for the function call (eg. NamedRef('foo'))
     OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
@@ -599,44 +595,19 @@ ManagerFIAlias::doPhase3Iteration(CallHandle call, ProcHandle currProc,
         // and hasn't already been analyzed.
         addProcToWorkList(proc);
 
-        // for each implicit ptrassignpair due to formal/actual binding
-        OA_ptr<ParamBindPtrAssignIterator> pairIter
-            = mIR->getParamBindPtrAssignIterator(call);
-        for ( ; pairIter->isValid(); (*pairIter)++ ) {
- 	
-            int formalId = pairIter->currentFormalId();
-            OA_ptr<MemRefExpr> actualMRE = pairIter->currentActual();        
-            
-            if (debug) {
-                std::cout << "Call mre: ";
-                callMRE->output(*mIR);
-                std::cout << " formal id: " << formalId << std::endl;
-            }
+        // remember the binding so saved results can record the
+        // same derefs again
+        noteBinding(call, proc);
 
-            // get the formal symbol for the param binding
-            // we are handling
-            SymHandle formalSym = mIR->getFormalSym(proc,formalId);
-            // if the signature doesn't match then don't process
-            if (formalSym==SymHandle(0)) { continue; }
-
-            // make mre for the formal
-            // FIXME: since already do this, could save time
-            // by memoizing in a map[proc][formalID]
-            // Create a namedRef for the formal.
-            bool addressTaken = false;
-            bool fullAccuracy = true;
-            // DEF since formal = actual.
-            MemRefExpr::MemRefType mrType = MemRefExpr::DEF;
-            OA_ptr<MemRefExpr> formalmre; 
-            formalmre = new NamedRef(mrType, formalSym);
-
-            // create a dereference for the formalref and actualref
-            // record both the dereferences
-            // union the sets they are in
-            OA_ptr<MemRefExpr> targetDeref = createDeref( formalmre );
-            recordMRE(targetDeref, proc );
-            OA_ptr<MemRefExpr> sourceDeref = createDeref( actualMRE );
-            recordMRE(sourceDeref, currProc);
+        // for each implicit ptrassignpair due to formal/actual binding
+        std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > > 
+            derefs;
+        recordParamBindDerefs(call, currProc, proc, derefs);
+        std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >
+            ::iterator pairIter;
+        for (pairIter=derefs.begin(); pairIter!=derefs.end(); pairIter++) {
+            OA_ptr<MemRefExpr> targetDeref = pairIter->first;
+            OA_ptr<MemRefExpr> sourceDeref = pairIter->second;
                  
             if (debug) {
                 std::cout << "ParamBindPtrAssign: ";
@@ -660,6 +631,53 @@ ManagerFIAlias::doPhase3Iteration(CallHandle call, ProcHandle currProc,
     } // paramBindPtrAssigns
 }
 
+void 
+ManagerFIAlias::recordParamBindDerefs(CallHandle call, ProcHandle caller,
+        ProcHandle callee,
+        std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >& 
+            derefs)
+{
+    // for each implicit ptrassignpair due to formal/actual binding
+    OA_ptr<ParamBindPtrAssignIterator> pairIter
+        = mIR->getParamBindPtrAssignIterator(call);
+    for ( ; pairIter->isValid(); (*pairIter)++ ) {
+
+        int formalId = pairIter->currentFormalId();
+        OA_ptr<MemRefExpr> actualMRE = pairIter->currentActual();        
+            
+        if (debug) {
+            std::cout << "Call: " << mIR->toString(call)
+                      << " formal id: " << formalId << std::endl;
+        }
+
+        // get the formal symbol for the param binding
+        // we are handling
+        SymHandle formalSym = mIR->getFormalSym(callee,formalId);
+        // if the signature doesn't match then don't process
+        if (formalSym==SymHandle(0)) { continue; }
+
+        // make mre for the formal
+        // FIXME: since already do this, could save time
+        // by memoizing in a map[proc][formalID]
+        // Create a namedRef for the formal.
+        // DEF since formal = actual.
+        MemRefExpr::MemRefType mrType = MemRefExpr::DEF;
+        OA_ptr<MemRefExpr> formalmre; 
+        formalmre = new NamedRef(mrType, formalSym);
+
+        // create a dereference for the formalref and actualref
+        // record both the dereferences
+        OA_ptr<MemRefExpr> targetDeref = createDeref( formalmre );
+        recordMRE(targetDeref, callee );
+        OA_ptr<MemRefExpr> sourceDeref = createDeref( actualMRE );
+        recordMRE(sourceDeref, caller);
+
+        derefs.push_back(
+            std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> >(
+                targetDeref, sourceDeref));
+    }
+}
+
 OA_ptr<UnionFindUniverse>
 ManagerFIAlias::performFIAlias( OA_ptr<IRProcIterator> procIter,
                                 FIAliasImplement implement )
@@ -667,12 +685,21 @@ ManagerFIAlias::performFIAlias( OA_ptr<IRProcIterator> procIter,
     OA_ptr<UnionFindUniverse> ufset;
 
     mImplement = implement;
+    mReusedLoaded = false;
+    mNumReusedSets = 0;
+    mNumChangedProcs = 0;
     if ( mImplement == ALL_PROCS ) {
         ufset = performFIAliasAllProcs(procIter);
     } else { 
         ufset = performFIAliasReachableProcs(procIter);
     }
 
+    // the sets are only queried from here on
+    ufset->canonicalize();
+    if ( mImplement == ALL_PROCS ) {
+        mResultSets = ufset;
+    }
+
     if ( debug ) {
         OA_ptr<IRProcIterator> analyzedProcIter = getAnalyzedProcIter();
         int numAnalyzedProcs = 0;
@@ -696,106 +723,78 @@ ManagerFIAlias::performFIAliasAllProcs( OA_ptr<IRProcIterator> procIter)
     // ptr to union find datastructure
     OA_ptr<UnionFindUniverse> ufset;
 
-    // map each MemRefExpr to a unique id and count them all
-    initMemRefExprs(procIter);
+    // gather the mres, ptr assign pairs, and call sites of every 
+    // procedure from the IR, in parallel
+    std::vector<OA_ptr<Phase1Buffer> > buffers;
+    gatherPhase1(procIter, buffers);
 
-    // declare the union-find datastructure
-    // 1 for each memrefExpr we have seen so far and each one
-    // could get a deref added in the worse case, the extra
-    // 1 is for zero
-    ufset = new UnionFindUniverse(2*mCount+1);
+    noteProcs(buffers);
 
-//   mergeSubSetRefs(ufset);
+    // map each MemRefExpr to a unique id and count them all
+    std::vector<OA_ptr<Phase1Buffer> >::iterator bufIter;
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
+        recordMREs(**bufIter);
+    }
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
+        recordDerefPairs(**bufIter);
+    }
 
-    // for all the stmts in the whole program
-    // Iterate over all the procedures in the program
-    for (procIter->reset() ; procIter->isValid(); ++(*procIter)) { 
-      ProcHandle currProc = procIter->current();
+    // declare the union-find datastructure
+    // 1 for each memrefExpr we have seen so far, the extra
+    // 1 is for zero.  Derefs added later grow the universe.
+    ufset = new UnionFindUniverse(mCount+1);
 
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
       // Add this procedure to the set of those that are reachable 
       // and have already been analyzed (or are about to be analyzed,
       // as with currProc).
       // FIAlias visits all procs; this makes more sense for 
       // FIAliasReachable.
-      mAnalyzedProcs.insert(currProc);
-
-      // Iterate over the statements of this procedure
-      OA_ptr<IRStmtIterator> stmtIterPtr = mIR->getStmtIterator(currProc);
-      // Iterate over the statements of this block adding procedure references
-      for ( ; stmtIterPtr->isValid(); ++(*stmtIterPtr)) {
-
-        StmtHandle stmt = stmtIterPtr->current();
+      mAnalyzedProcs.insert((*bufIter)->mProc);
+    }
 
-        if (debug) {
-          std::cout << "===========================" << std::endl << "stmt = ";
-          mIR->dump(stmt,std::cout);
-          std::cout << std::endl;
-        }
+    // nothing to do if the loaded results are for the same input,
+    // otherwise the phases go on from the loaded sets still valid
+    if (!mLoaded.ptrEqual(0) && reuseLoadedResults(buffers, ufset)) {
+        return ufset;
+    }
 
-        doPhase1Iteration(stmt, currProc, ufset);
+//   mergeSubSetRefs(ufset);
 
-      } // over stmts
+    // for all the ptr assign pairs in the whole program, in 
+    // procedure order so the result doesn't depend on the threads
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
+      doPhase1Unions(**bufIter, ufset);
     } // over procedures
 
     // this will be the default value for this
     // for each partition
     //    map[part][memref] = 0; 
-    std::map<int,std::map<OA_ptr<MemRefExpr>,int> > map;
-
-    bool changed = true;
-
-    while (changed) {
-
-        //// Phase 2 in FIAlias algorithm plus some additions for SubSetRefs
-        // do this until there are no more changes
-      
-        // Please note that 'phases' are a bit of a misnomer since we
-        // iterate over phases 2 and 3 together-- as opposed to 
-        // separately iterating over phase 2, then phase 3.  Doing them
-        // separately appears to be a bug in Fig 5 of the Ryder 2001 paper.
-
-        if (debug) { 
-            std::cout << std::endl 
-                      << "======== Beginning of Phase 2 while loop =====" 
-                      << std::endl; 
-        }
-
-        changed = doPhase2Iteration(ufset, map);
-        
-        //// Phase 3 in FIAlias: accounting for calls through function ptrs
-        ////                     and non-function ptr calls
-      
-        if (debug) { 
-            std::cout << std::endl 
-                      << "======== Beginning of Phase 3 while loop =====" 
-                      << std::endl; 
-        }
-
-        // for all the stmts in the whole program
-        // Iterate over all the procedures in the program
-        for (procIter->reset() ; procIter->isValid(); ++(*procIter)) { 
-            ProcHandle currProc = procIter->current();
-
-            // Iterate over the statements of this procedure
-            OA_ptr<IRStmtIterator> stmtIterPtr = mIR->getStmtIterator(currProc);
-            // Iterate over the statements of this block adding procedure references
-            for ( ; stmtIterPtr->isValid(); ++(*stmtIterPtr)) {
-                StmtHandle stmt = stmtIterPtr->current();
-                // for all the callsites in the stmt
-                OA_ptr<IRCallsiteIterator> callIter = mIR->getCallsites(stmt);
-                for ( ; callIter->isValid(); (*callIter)++ ) {
-                    CallHandle call = callIter->current();
-
-                    if (debug) {
-                        std::cout << "Call site: " << mIR->toString(call) << std::endl;
-                    }
+    PartRefOpMap map;
+
+    //// Phases 2 and 3 in FIAlias algorithm, plus some additions for
+    //// SubSetRefs, iterated to a fixed point.  
+    // Please note that 'phases' are a bit of a misnomer since we
+    // iterate over phases 2 and 3 together-- as opposed to 
+    // separately iterating over phase 2, then phase 3.  Doing them
+    // separately appears to be a bug in Fig 5 of the Ryder 2001 paper.
+    // Rather than rescanning everything each round, only the mres and
+    // call sites whose sets have been merged are revisited.
+
+    // every mre recorded so far gets its phase 2 constraint checked
+    registerNewMREs(ufset);
+
+    // every callsite gets phase 3 at least once
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
+        std::vector<CallHandle>::iterator callIter;
+        for (callIter=(*bufIter)->mCallsites.begin(); 
+             callIter!=(*bufIter)->mCallsites.end(); callIter++) 
+        {
+            addCallSite(*callIter, (*bufIter)->mProc, ufset);
+        } // call sites
+    } // over procedures
 
-                    doPhase3Iteration(call, currProc, ufset, map);
-            
-                } // call sites
-            } // over stmts
-        } // over procedures
-    } // iterating to fixed point 
+    solveDeltas(ufset, map);
 
     return ufset;
 }
@@ -817,11 +816,6 @@ ManagerFIAlias::performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter)
       addProcToWorkList(currProc);
     }
 
-    // Keep a list of ambiguous/indirect calls that require
-    // alias analysis for resolution.  The ProcHandle is the
-    // caller.
-    std::set<std::pair<CallHandle,ProcHandle> > indirect_calls;
-
     // ptr to union find datastructure
     OA_ptr<UnionFindUniverse> ufset;
 
@@ -834,19 +828,16 @@ ManagerFIAlias::performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter)
     // would complicate the loop below.  Instead, just
     // set it to something arbitrary and let it grow.
     int initialSize = 1024;
-    ufset = new UnionFindUniverse(2*initialSize+1);
+    ufset = new UnionFindUniverse(initialSize);
 
     // this will be the default value for this
     // for each partition
     //    map[part][memref] = 0; 
-    std::map<int,std::map<OA_ptr<MemRefExpr>,int> > map;
-
-    bool changed = true;
+    PartRefOpMap map;
 
-    unsigned int iter_count = 0;
     unsigned int stmts_analyzed = 0;
 
-    while ( changed ) {
+    while ( true ) {
 
         // Iterate over the worlist
         while ( mWorklist.begin() != mWorklist.end() ) {
@@ -884,17 +875,12 @@ ManagerFIAlias::performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter)
 
                 // End Ryder phase 1.
 
-                // Visit each call in the current proc.  If the
-                // target is Named (i.e., resolvable), 
-                // then add it to the worklist.  [However, notice
-                // that this happens in doPhase3Iteration.] 
-                // If the target is not a Named mre, 
-		// then it is an indirect call--
-                // add it to the list of indirect_calls.
-                // In any case, perform phase 2b-- i.e., param
-                // bindings.
-
-                // For all the callsites in the stmt
+                // Every call in the current proc gets param binding,
+                // i.e., phase 2b.  If the target is Named (i.e.,
+                // resolvable), then doPhase3Iteration adds it to the
+                // worklist.  If the target is not a Named mre, 
+		// then it is an indirect call and will be revisited
+                // whenever the set of its call mre grows.
                 OA_ptr<IRCallsiteIterator> callIter = mIR->getCallsites(stmt);
                 for ( ; callIter->isValid(); (*callIter)++ ) {
                     CallHandle call = callIter->current();
@@ -905,17 +891,7 @@ ManagerFIAlias::performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter)
                                   << std::endl;
                     }
 
-                    // Get the mre for the function call (eg. NamedRef('foo'))
-                    OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
-
-                    if (!callMRE->isaNamed()) {
-                        // The call is not a named MRE-- it must be an
-                        // indirect call.
-                        indirect_calls.insert(std::pair<CallHandle,ProcHandle>(call,currProc));
-                    }
-
-		    // Perform param binding-- i.e., phase 2b.
-                    doPhase3Iteration(call, currProc, ufset, map);
+                    addCallSite(call, currProc, ufset);
 
                 } // End iteration over call sites
 
@@ -924,45 +900,15 @@ ManagerFIAlias::performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter)
         } // over worklist
         
         //// Phase 2 in FIAlias algorithm plus some additions for SubSetRefs
-        // do this until there are no more changes
-      
-        // Please note that 'phases' are a bit of a misnomer since we
-        // iterate over phases 2 and 3 together-- as opposed to 
-        // separately iterating over phase 2, then phase 3.  Doing them
-        // separately appears to be a bug in Fig 5 of the Ryder 2001 paper.
-
-        if (debug) { 
-            std::cout << std::endl 
-		      << "======== Beginning of Phase 2 while loop =====" 
-		      << std::endl; 
-        }
-
-        changed = doPhase2Iteration(ufset, map);
-        
-        //// Phase 3 in FIAlias: accounting for calls through function ptrs
-        ////                     and non-function ptr calls
-      
-        if (debug) { 
-            std::cout << std::endl 
-                      << "======== Beginning of Phase 3 while loop =====" 
-                      << std::endl; 
-        }
-
-        // Ryder phase 3/CGO phase 2b performs param binding.
-        // Notice that we have already done this above.  However,
-	// an indirect call site may have acquired a static
-        // resolution through alias analysis.  Therefore, revisit
-        // all indirect call sites and (re-)apply param binding.
-
-        for ( std::set<std::pair<CallHandle,ProcHandle> >::iterator it = indirect_calls.begin();
-              it != indirect_calls.end(); ++it) {
-
-            CallHandle call = it->first;
-            ProcHandle caller = it->second;
-
-            doPhase3Iteration(call, caller, ufset, map);
-        } // call sites
-        ++iter_count;
+        //// and phase 3, accounting for calls through function ptrs and
+        //// non-function ptr calls, for everything that changed.
+        // Ryder phase 3/CGO phase 2b performs param binding.  An
+        // indirect call site may acquire a static resolution through
+        // alias analysis, which can put new procedures on the worklist.
+        registerNewMREs(ufset);
+        solveDeltas(ufset, map);
+
+        if ( mWorklist.empty() ) { break; }
     } // iterating to fixed point 
 
     return ufset;
@@ -983,11 +929,15 @@ ManagerFIAlias::recordMRE( OA_ptr<MemRefExpr> mre, ProcHandle proc )
     }
 
     // check if it doesn't already have an id in the range 1..
-    if (mMREToID[mre] == 0) {
-        mMREToID[mre] = mCount++;
+    int& id = mMREToID[mre];
+    if (id == 0) {
+        id = mCount++;
+        mNewMREs.push_back(mre);
+        mIDToMemRefHandles.resize(mCount);
+        mIDToProcs.resize(mCount);
     }
 
-    mMREToProcs[mre].insert(proc);
+    mIDToProcs[id].insert(proc);
 }
 
 /*!
@@ -1010,14 +960,18 @@ ManagerFIAlias::recordMRE( OA_ptr<MemRefExpr> mre, ProcHandle proc,
     mMemRefHandleToProc[memref] = proc;
 
     // check if it doesn't already have an id in the range 1..
-    if (mMREToID[mre] == 0) {
-        mMREToID[mre] = mCount++;
+    int& id = mMREToID[mre];
+    if (id == 0) {
+        id = mCount++;
+        mNewMREs.push_back(mre);
+        mIDToMemRefHandles.resize(mCount);
+        mIDToProcs.resize(mCount);
     }
 
     // keep track of which MemRefHandles an MRE expresses and which procs
     // it is found in
-    mMREToMemRefHandles[mre].insert(memref);
-    mMREToProcs[mre].insert(proc);
+    mIDToMemRefHandles[id].insert(memref);
+    mIDToProcs[id].insert(proc);
 }
 
 //! creates a dereferenced version of the given mre
@@ -1059,19 +1013,25 @@ ManagerFIAlias::allMemRefExprsInSameSet( OA_ptr<MemRefExpr> pMRE,
 {
     std::set<OA_ptr<MemRefExpr> > retval;
 
+    // make sure the reverse index covers every recorded mre
+    registerNewMREs(ufset);
+
     int setID = ufset->Find(mMREToID[pMRE]);
 
-    std::map<OA_ptr<MemRefExpr>,int>::iterator mapIter;
-    for (mapIter=mMREToID.begin(); mapIter!=mMREToID.end(); mapIter++)
+    std::map<int,std::list<int> >::iterator found
+        = mPartToMemberIDs.find(setID);
+    if (found == mPartToMemberIDs.end()) { return retval; }
+
+    std::list<int>::iterator idIter;
+    for (idIter=found->second.begin(); idIter!=found->second.end(); 
+         idIter++)
     {
-        OA_ptr<MemRefExpr> mre = mapIter->first;
+        OA_ptr<MemRefExpr> mre = mIDToMRE[*idIter];
         if (debug) {
             std::cout << "allMemRefExprsInSameSet: mre = ";
             mre->dump(std::cout);
         }
-        if ( ufset->Find(mMREToID[mre]) == setID ) {
-            retval.insert(mre);
-        }
+        retval.insert(mre);
     }
 
     return retval;
@@ -1079,7 +1039,7 @@ ManagerFIAlias::allMemRefExprsInSameSet( OA_ptr<MemRefExpr> pMRE,
 
 /*!
    Visitor over memory reference expressions that grabs all sub 
-   MREs and makes sure that they are recorded.
+   MREs and adds them to the list of mres to record.
 
    NOTE that we are treating the non-address of namedref as a sub
    MRE to the named ref that has its address set.
@@ -1088,21 +1048,22 @@ ManagerFIAlias::allMemRefExprsInSameSet( OA_ptr<MemRefExpr> pMRE,
 
 class RecordMREsVisitor : public virtual MemRefExprVisitor {
   public:
-    RecordMREsVisitor(ManagerFIAlias &manager, ProcHandle proc )
-        : mManager(manager), mProc(proc) {}
+    RecordMREsVisitor(
+        std::vector<std::pair<OA_ptr<MemRefExpr>,MemRefHandle> >& mres)
+        : mMREs(mres) {}
     ~RecordMREsVisitor() {}
 
     void visitNamedRef(NamedRef& ref) { 
         OA_ptr<MemRefExpr> mre = ref.clone();
-        mManager.recordMRE(mre, mProc); 
+        record(mre);
     }
     void visitUnnamedRef(UnnamedRef& ref) {
         OA_ptr<MemRefExpr> mre = ref.clone();
-        mManager.recordMRE(mre, mProc); 
+        record(mre);
     }
     void visitUnknownRef(UnknownRef& ref) {
         OA_ptr<MemRefExpr> mre = ref.clone();
-        mManager.recordMRE(mre, mProc); 
+        record(mre);
     }
     void visitAddressOf(AddressOf& ref) {
         // do not record the addressOf, but record its child
@@ -1114,7 +1075,7 @@ class RecordMREsVisitor : public virtual MemRefExprVisitor {
     void visitDeref(Deref& ref) { 
         // record self
         OA_ptr<MemRefExpr> mref = ref.clone();
-        mManager.recordMRE(mref, mProc); 
+        record(mref);
         // must also visit child memory reference
         OA_ptr<MemRefExpr> mre = ref.getMemRefExpr();
         if (!mre.ptrEqual(0)) { 
@@ -1125,7 +1086,7 @@ class RecordMREsVisitor : public virtual MemRefExprVisitor {
     void visitSubSetRef(SubSetRef& ref) {
         // record self
         OA_ptr<MemRefExpr> mref = ref.clone();
-        mManager.recordMRE(mref, mProc); 
+        record(mref);
         
         // must also visit child memory reference
         OA_ptr<MemRefExpr> mre = ref.getMemRefExpr();
@@ -1134,16 +1095,28 @@ class RecordMREsVisitor : public virtual MemRefExprVisitor {
         }
     }
   private:
-    ManagerFIAlias& mManager;
-    ProcHandle mProc;
+    void record(OA_ptr<MemRefExpr> mre) {
+        mMREs.push_back(
+            std::pair<OA_ptr<MemRefExpr>,MemRefHandle>(mre,MemRefHandle(0)));
+    }
+    std::vector<std::pair<OA_ptr<MemRefExpr>,MemRefHandle> >& mMREs;
 
 };
 
 
 void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
 {
+    Phase1Buffer buffer(currProc);
+    gatherPhase1(buffer);
+    recordMREs(buffer);
+}
+
+void ManagerFIAlias::gatherPhase1( Phase1Buffer& buffer )
+{
+    ProcHandle currProc = buffer.mProc;
+
     // visitor that can record all mres and sub mres within an mre
-    RecordMREsVisitor visitor(*this, currProc);
+    RecordMREsVisitor visitor(buffer.mMREs);
 
     // Iterate over the statements of this procedure
     OA_ptr<IRStmtIterator> stmtIterPtr = mIR->getStmtIterator(currProc);
@@ -1151,10 +1124,6 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
     for ( ; stmtIterPtr->isValid(); ++(*stmtIterPtr)) {
 
         StmtHandle stmt = stmtIterPtr->current();
-        if (debug) {
-          std::cout << std::endl << "stmt = ";
-          mIR->dump(stmt,std::cout);
-        }
 
         // map each memory reference expr to a unique number in the range 1..
         OA_ptr<MemRefHandleIterator> mrIterPtr = mIR->getAllMemRefs(stmt);
@@ -1171,7 +1140,8 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
                 OA_ptr<OA::MemRefExpr> mre = mreIterPtr->current();
 
                 // associate this mre with the particular MemRefHandle
-                recordMRE(mre, currProc, memref);
+                buffer.mMREs.push_back(
+                    std::pair<OA_ptr<MemRefExpr>,MemRefHandle>(mre,memref));
 
                 // the recordMREs visitor will get all subrefs
                 // and not associate them with a MemRefHandle
@@ -1192,6 +1162,11 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
 
             OA_ptr<MemRefExpr> source = pairIter->currentSource();        
             source->acceptVisitor(visitor);   
+
+            // phase 1 unions *target and *source
+            buffer.mDerefPairs.push_back(
+                std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> >(
+                    createDeref(target), createDeref(source)));
         }
 
         // there can be some implicit MemRefExprs in ParamBindPtrAssigns
@@ -1199,6 +1174,7 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
         OA_ptr<IRCallsiteIterator> callIter = mIR->getCallsites(stmt);
         for ( ; callIter->isValid(); (*callIter)++ ) {
             CallHandle call = callIter->current();
+            buffer.mCallsites.push_back(call);
 
             // get the mre for the function call (eg. NamedRef('foo'))
             OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
@@ -1210,7 +1186,9 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
             for ( ; pairIter->isValid(); (*pairIter)++ ) {
                 OA_ptr<MemRefExpr> actualMRE = pairIter->currentActual();        
 
-                recordMRE(actualMRE, currProc);
+                buffer.mMREs.push_back(
+                    std::pair<OA_ptr<MemRefExpr>,MemRefHandle>(
+                        actualMRE, MemRefHandle(0)));
                 actualMRE->acceptVisitor(visitor);   
             }
         }
@@ -1219,28 +1197,20 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
     } // loop over stmts
 
     // loop over formals for this procedure and recordMREs for each formal
-    // also add this formal SymHandle to the set of formals for currProc
     int formalCount = 0;
     SymHandle formalSym;
     while ( (formalSym=mIR->getFormalSym(currProc,formalCount)) 
             != SymHandle(0) ) 
     {
-        // put ian set of formals for currProc
-        mProcToFormalSet[currProc].insert(formalSym);
+        buffer.mFormals.push_back(formalSym);
 
         // make mre for the formal
         // Create a namedRef for the formal.
-        bool addressTaken = false;
-        bool fullAccuracy = true;
         // DEF since formal = actual.
         MemRefExpr::MemRefType mrType = MemRefExpr::DEF;
         OA_ptr<MemRefExpr> formalmre; 
         formalmre = new NamedRef(mrType, formalSym);
 
-        // recordMRE for formal
-        // update mMREToMemRefHandle, mMREToProc, and mMREToID
-        // and updates mCount of all memory references
-        
         formalmre->acceptVisitor(visitor);   
 
         // increment the count used within this loop
@@ -1248,15 +1218,98 @@ void ManagerFIAlias::initMemRefExprs( ProcHandle currProc )
     }
 }
 
+void ManagerFIAlias::recordMREs( Phase1Buffer& buffer )
+{
+    ProcHandle currProc = buffer.mProc;
+
+    // update mMREToMemRefHandle, mMREToProc, and mMREToID
+    // and updates mCount of all memory references
+    std::vector<std::pair<OA_ptr<MemRefExpr>,MemRefHandle> >::iterator 
+        mreIter;
+    for (mreIter=buffer.mMREs.begin(); mreIter!=buffer.mMREs.end(); 
+         mreIter++) 
+    {
+        if (mreIter->second == MemRefHandle(0)) {
+            recordMRE(mreIter->first, currProc);
+        } else {
+            recordMRE(mreIter->first, currProc, mreIter->second);
+        }
+    }
+
+    // put in set of formals for currProc
+    mProcToFormalSet[currProc].insert(buffer.mFormals.begin(),
+                                      buffer.mFormals.end());
+}
+
+void ManagerFIAlias::recordDerefPairs( Phase1Buffer& buffer )
+{
+    std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >::iterator
+        pairIter;
+    for (pairIter=buffer.mDerefPairs.begin(); 
+         pairIter!=buffer.mDerefPairs.end(); pairIter++) 
+    {
+        recordMRE(pairIter->first, buffer.mProc );
+        recordMRE(pairIter->second, buffer.mProc );
+    }
+}
+
+void ManagerFIAlias::doPhase1Unions( Phase1Buffer& buffer,
+                                     OA_ptr<UnionFindUniverse> ufset )
+{
+    ProcHandle currProc = buffer.mProc;
+
+    std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >::iterator
+        pairIter;
+    for (pairIter=buffer.mDerefPairs.begin(); 
+         pairIter!=buffer.mDerefPairs.end(); pairIter++) 
+    {
+        OA_ptr<MemRefExpr> targetDeref = pairIter->first;
+        OA_ptr<MemRefExpr> sourceDeref = pairIter->second;
+        recordMRE(targetDeref, currProc );
+        recordMRE(sourceDeref, currProc );
+
+        if (debug) {
+            std::cout << "\tsourceDeref = ";
+            sourceDeref->output(*mIR);
+            std::cout << "\ttargetDeref = ";
+            targetDeref->output(*mIR);
+        }
+
+        // then union the sets with *target and *source 
+        int targetPart = ufset->Find(mMREToID[targetDeref]);
+        int sourcePart = ufset->Find(mMREToID[sourceDeref]);
+        ufset->Union( targetPart, sourcePart, sourcePart );
+        if (targetPart != sourcePart) {
+            noteUnion(targetPart, sourcePart, ufset);
+        }
+    }
+}
+
 void ManagerFIAlias::initMemRefExprs( OA_ptr<IRProcIterator> procIter )
 {
-    // for all the stmts in the whole program
-    // Iterate over all the procedures in the program
-    for (procIter->reset() ; procIter->isValid(); ++(*procIter)) { 
-      ProcHandle currProc = procIter->current();
-      initMemRefExprs(currProc);
+    std::vector<OA_ptr<Phase1Buffer> > buffers;
+    gatherPhase1(procIter, buffers);
+
+    std::vector<OA_ptr<Phase1Buffer> >::iterator bufIter;
+    for (bufIter=buffers.begin(); bufIter!=buffers.end(); bufIter++) {
+        recordMREs(**bufIter);
     }
+}
+
+void ManagerFIAlias::gatherPhase1( OA_ptr<IRProcIterator> procIter,
+                                   std::vector<OA_ptr<Phase1Buffer> >& buffers)
+{
+    ThreadPool pool(mNumThreads);
+    for (procIter->reset() ; procIter->isValid(); ++(*procIter)) { 
+        OA_ptr<Phase1Buffer> buffer;
+        buffer = new Phase1Buffer(procIter->current());
+        buffers.push_back(buffer);
 
+        OA_ptr<ThreadTask> task;
+        task = new Phase1Task(*this, buffer);
+        pool.add(task);
+    }
+    pool.wait();
 }
 
 /*! An implementation of the merge function in the Ryder2001 description
@@ -1264,14 +1317,15 @@ void ManagerFIAlias::initMemRefExprs( OA_ptr<IRProcIterator> procIter )
  */
 void ManagerFIAlias::merge(int part1, int part2, 
         OA_ptr<UnionFindUniverse> ufset, 
-        std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map  ) 
+        PartRefOpMap & map  ) 
 {
     int part1_find = ufset->Find(part1);
     int part2_find = ufset->Find(part2);
     if (part1_find != part2_find) {
-        std::map<OA_ptr<MemRefExpr>,int> &old1 = map[part1_find];
-        std::map<OA_ptr<MemRefExpr>,int> &old2 = map[part2_find];
+        std::map<int,int> &old1 = map[part1_find];
+        std::map<int,int> &old2 = map[part2_find];
         ufset->Union(part1_find, part2_find, part2_find);
+        noteUnion(part1_find, part2_find, ufset);
 
         if (debug) {
             std::cout << "\t===> Union ( "
@@ -1282,10 +1336,10 @@ void ManagerFIAlias::merge(int part1, int part2,
         // I think the fastest way to do this is to look over the mres
         // in the two old sets.  Otherwise I have to loop over all the MREs
         // and figure out which ones are in the new set.
-        std::map<OA_ptr<MemRefExpr>,int>::iterator mapIter;
+        std::map<int,int>::iterator mapIter;
         part1_find = ufset->Find(part1);
         for (mapIter = old1.begin(); mapIter != old1.end(); mapIter++) {
-            OA_ptr<MemRefExpr> mre = mapIter->first;
+            int mre = mapIter->first;
             if ( old1[mre]==0 && old2[mre]==0 ) {
                 map[part1_find][mre] = 0;
             } else if (old2[mre]==0) {
@@ -1297,7 +1351,7 @@ void ManagerFIAlias::merge(int part1, int part2,
             }
         }
         for (mapIter = old2.begin(); mapIter != old2.end(); mapIter++) {
-            OA_ptr<MemRefExpr> mre = mapIter->first;
+            int mre = mapIter->first;
             if ( old1[mre]==0 && old2[mre]==0 ) {
                 map[part1_find][mre] = 0;
             } else if (old2[mre]==0) {
@@ -1312,17 +1366,289 @@ void ManagerFIAlias::merge(int part1, int part2,
 
 }
 
+//--------------------------------------------------------------------
+// Tracking which sets changed, so the fixed point only revisits the
+// phase 2 constraints and indirect call sites that depend on them.
+//--------------------------------------------------------------------
+
+/*! Called after the sets part1 and part2 (both names of sets before
+ *  the union) have been unioned.  A phase 2 constraint whose mre and
+ *  inner mre were both in the surviving set still holds, because
+ *  merge combined the refop maps of the two sets, so only those
+ *  listed under the losing set are looked at again.  Indirect call
+ *  sites in the surviving set only need another look when the losing
+ *  set brings in procedure names.
+ */
+void ManagerFIAlias::noteUnion(int part1, int part2,
+                               OA_ptr<UnionFindUniverse> ufset)
+{
+    int newPart = ufset->Find(part1);
+    int oldPart = (newPart == part1) ? part2 : part1;
+
+    // phase 3 has to look at a call whose bindings were redone from
+    // loaded results after all, the set may have new procedure names
+    if (!mRedonePartCalls.empty()) {
+        int parts[2] = { part1, part2 };
+        for (int i=0; i<2; i++) {
+            std::map<int,std::list<CallHandle> >::iterator calls
+                = mRedonePartCalls.find(parts[i]);
+            if (calls == mRedonePartCalls.end()) { continue; }
+            std::list<CallHandle>::iterator callIter;
+            for (callIter=calls->second.begin();
+                 callIter!=calls->second.end(); callIter++)
+            {
+                mRedoneCalls.erase(*callIter);
+            }
+            mRedonePartCalls.erase(calls);
+        }
+    }
+
+    std::list<int>::iterator idIter;
+    bool bringsNames = false;
+    std::map<int,std::list<int> >::iterator found;
+    found = mPartToMemberIDs.find(oldPart);
+    if (found != mPartToMemberIDs.end()) {
+        for (idIter=found->second.begin(); 
+             !bringsNames && idIter!=found->second.end(); idIter++)
+        {
+            bringsNames = mIDToMRE[*idIter]->isaNamed();
+        }
+        mPartToMemberIDs[newPart].splice(mPartToMemberIDs[newPart].end(),
+                                         found->second);
+        mPartToMemberIDs.erase(found);
+    }
+
+    found = mPartToMREIDs.find(oldPart);
+    if (found != mPartToMREIDs.end()) {
+        for (idIter=found->second.begin(); idIter!=found->second.end();
+             idIter++)
+        {
+            if (!mMREDirty[*idIter]) {
+                mMREDirty[*idIter] = true;
+                mDirtyMREIDs.push_back(*idIter);
+            }
+        }
+        mPartToMREIDs[newPart].splice(mPartToMREIDs[newPart].end(),
+                                      found->second);
+        mPartToMREIDs.erase(found);
+    }
+
+    if (bringsNames) {
+        found = mPartToCallIDs.find(newPart);
+        if (found != mPartToCallIDs.end()) {
+            for (idIter=found->second.begin(); idIter!=found->second.end();
+                 idIter++)
+            {
+                if (!mCallDirty[*idIter]) {
+                    mCallDirty[*idIter] = true;
+                    mDirtyCallIDs.push_back(*idIter);
+                }
+            }
+        }
+    }
+    found = mPartToCallIDs.find(oldPart);
+    if (found != mPartToCallIDs.end()) {
+        for (idIter=found->second.begin(); idIter!=found->second.end();
+             idIter++)
+        {
+            if (!mCallDirty[*idIter]) {
+                mCallDirty[*idIter] = true;
+                mDirtyCallIDs.push_back(*idIter);
+            }
+        }
+        mPartToCallIDs[newPart].splice(mPartToCallIDs[newPart].end(),
+                                       found->second);
+        mPartToCallIDs.erase(found);
+    }
+}
+
+/*! Gives each mre recorded since the last call a phase 2 constraint
+ *  that is checked the next time solveDeltas runs, and is checked
+ *  again whenever the set of the mre or of its inner mre changes.
+ *  A refop whose inner mre hasn't been recorded yet, such as *formal
+ *  for a callee phase 3 just added to the worklist, waits until it
+ *  is.
+ */
+void ManagerFIAlias::registerNewMREs(OA_ptr<UnionFindUniverse> ufset)
+{
+    while (!mNewMREs.empty()) {
+        OA_ptr<MemRefExpr> mre = mNewMREs.front();
+        mNewMREs.pop_front();
+
+        int id = mMREToID[mre];
+        if ((int)mIDToMRE.size() <= id) {
+            mIDToMRE.resize(id+1);
+            mIDToInnerID.resize(id+1, 0);
+            mIDToRefOpID.resize(id+1, 0);
+            mMREDirty.resize(id+1, false);
+        }
+        mIDToMRE[id] = mre;
+        mPartToMemberIDs[ufset->Find(id)].push_back(id);
+
+        // refops that were waiting for this mre
+        std::map<OA_ptr<MemRefExpr>,std::list<int> >::iterator waiting
+            = mWaitingForInner.find(mre);
+        if (waiting != mWaitingForInner.end()) {
+            std::list<int> waitingIDs;
+            waitingIDs.swap(waiting->second);
+            mWaitingForInner.erase(waiting);
+            std::list<int>::iterator idIter;
+            for (idIter=waitingIDs.begin(); idIter!=waitingIDs.end(); 
+                 idIter++) 
+            {
+                resolveInnerID(*idIter, id, ufset);
+            }
+        }
+
+        if(!mre->isaRefOp()) { continue; }
+        OA_ptr<RefOp> refop = mre.convert<RefOp>();
+        if(refop->isaAddressOf()) { continue; }
+
+        OuterRefOpVisitor outerRefVisitor;
+        mre->acceptVisitor(outerRefVisitor);
+        OA_ptr<MemRefExpr> justRefop = outerRefVisitor.getOuterRefOp();
+        int &refopID = mRefOpToID[justRefop];
+        if (refopID == 0) { refopID = mRefOpToID.size(); }
+        mIDToRefOpID[id] = refopID;
+
+        mPartToMREIDs[ufset->Find(id)].push_back(id);
+
+        OA_ptr<MemRefExpr> inner = refop->getMemRefExpr();
+        MemRefExprIDTable::iterator found
+            = mMREToID.find(inner);
+        if (found != mMREToID.end() && found->second < (int)mIDToMRE.size()
+            && !mIDToMRE[found->second].ptrEqual(0)) 
+        {
+            resolveInnerID(id, found->second, ufset);
+        } else {
+            // the inner mre is registered later in this loop or in a
+            // later call
+            mWaitingForInner[inner].push_back(id);
+        }
+    }
+}
+
+/*! The inner mre of refop mre id now has an id.  Only from here on
+ *  does the phase 2 constraint of id mean anything, and only now can
+ *  it be decided whether a SubSetRef is collapsed.
+ */
+void ManagerFIAlias::resolveInnerID(int id, int innerID,
+                                    OA_ptr<UnionFindUniverse> ufset)
+{
+    mIDToInnerID[id] = innerID;
+    mPartToMREIDs[ufset->Find(innerID)].push_back(id);
+    if (!mMREDirty[id]) {
+        mMREDirty[id] = true;
+        mDirtyMREIDs.push_back(id);
+    }
+
+    // field or index accesses past the limits share the set of
+    // what they are applied to
+    OA_ptr<RefOp> refop = mIDToMRE[id].convert<RefOp>();
+    if (refop->isaSubSetRef() && collapseSubSet(mIDToMRE[id])) {
+        int part = ufset->Find(id);
+        int innerPart = ufset->Find(innerID);
+        if (part != innerPart) {
+            ufset->Union( part, innerPart, innerPart );
+            noteUnion(part, innerPart, ufset);
+        }
+    }
+}
+
+bool ManagerFIAlias::collapseSubSet(OA_ptr<MemRefExpr> mre)
+{
+    // number of SubSetRefs down to the first thing that isn't one
+    int depth = 0;
+    OA_ptr<MemRefExpr> sub = mre;
+    while (sub->isaRefOp()) {
+        OA_ptr<RefOp> refop = sub.convert<RefOp>();
+        if (!refop->isaSubSetRef()) { break; }
+        depth++;
+        sub = refop->getMemRefExpr();
+        if (sub.ptrEqual(0)) { break; }
+    }
+
+    if ((mSubSetDepth >= 0 && depth > mSubSetDepth)
+        || (mSubSetBudget >= 0 && mNumSubSets >= mSubSetBudget))
+    {
+        mNumCollapsedSubSets++;
+        return true;
+    }
+    mNumSubSets++;
+    return false;
+}
+
+/*! Queues phase 3 for the call site, unless its bindings were redone
+ *  from loaded results.  Calls through something other than a
+ *  NamedRef are queued again whenever the set of their call mre
+ *  changes.
+ */
+void ManagerFIAlias::addCallSite(CallHandle call, ProcHandle caller,
+                                 OA_ptr<UnionFindUniverse> ufset)
+{
+    int callID = mCallSites.size();
+    mCallSites.push_back(std::pair<CallHandle,ProcHandle>(call,caller));
+    if (mRedoneCalls.find(call) == mRedoneCalls.end()) {
+        mCallDirty.push_back(true);
+        mDirtyCallIDs.push_back(callID);
+    } else {
+        mCallDirty.push_back(false);
+    }
+
+    OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(call);
+    if (!callMRE->isaNamed()) {
+        mPartToCallIDs[ufset->Find(mMREToID[callMRE])].push_back(callID);
+    }
+}
+
+/*! Runs phases 2 and 3 on the queued mres and call sites until
+ *  nothing changes.
+ */
+void ManagerFIAlias::solveDeltas(OA_ptr<UnionFindUniverse> ufset,
+        PartRefOpMap & map  ) 
+{
+    int numConstraints = 0, numCalls = 0;
+    while (!mDirtyMREIDs.empty() || !mDirtyCallIDs.empty()) {
+
+        while (!mDirtyMREIDs.empty()) {
+            int id = mDirtyMREIDs.front();
+            mDirtyMREIDs.pop_front();
+            mMREDirty[id] = false;
+            doPhase2Constraint(id, ufset, map);
+            numConstraints++;
+        }
+
+        if (!mDirtyCallIDs.empty()) {
+            int callID = mDirtyCallIDs.front();
+            mDirtyCallIDs.pop_front();
+            mCallDirty[callID] = false;
+            doPhase3Iteration(mCallSites[callID].first,
+                              mCallSites[callID].second, ufset, map);
+            numCalls++;
+        }
+
+        // phase 3 can record new mres
+        registerNewMREs(ufset);
+    }
+
+    if (debug) {
+        std::cout << "ManagerFIAlias::solveDeltas: checked "
+                  << numConstraints << " phase 2 constraints and "
+                  << numCalls << " call sites" << std::endl;
+    }
+}
+
 void ManagerFIAlias::outputMREsInSet(int setID, 
         OA_ptr<UnionFindUniverse> ufset, 
-        std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map  ) 
+        PartRefOpMap & map  ) 
 {
   std::cout << "All mres in setID = " << setID << std::endl;
-  std::map<OA_ptr<MemRefExpr>,int>::iterator mapIter;
-  for (mapIter=mMREToID.begin(); mapIter!=mMREToID.end(); mapIter++) {
-    if ( ufset->Find(mMREToID[mapIter->first]) == ufset->Find(setID) ) {
-      OA_ptr<MemRefExpr> mymre = mapIter->first;
-      mymre->output(*mIR);
-    }
+  std::set<OA_ptr<MemRefExpr> > mres;
+  mres = allMemRefExprsInSameSet(mIDToMRE[setID], ufset);
+  std::set<OA_ptr<MemRefExpr> >::iterator mreIter;
+  for (mreIter=mres.begin(); mreIter!=mres.end(); mreIter++) {
+    OA_ptr<MemRefExpr> mymre = *mreIter;
+    mymre->output(*mIR);
   }
 }
 
@@ -19,12 +19,18 @@
 #include <cassert>
 #include <map>
 #include <set>
+#include <list>
+#include <vector>
+#include <string>
+#include <iostream>
 
 // OpenAnalysis headers
 #include <OpenAnalysis/IRInterface/AliasIRInterface.hpp>
 #include <OpenAnalysis/Utils/UnionFindUniverse.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 #include <OpenAnalysis/MemRefExpr/MemRefExprVisitor.hpp>
 #include <OpenAnalysis/Alias/Interface.hpp>
+#include <OpenAnalysis/Alias/MemRefExprIDTable.hpp>
 #include <OpenAnalysis/Location/Locations.hpp>
 
 namespace OA {
@@ -185,6 +191,29 @@ enum FIAliasImplement { ALL_PROCS = 0, REACHABLE_PROCS };
     relations (via performAnalysis) is now left to subclasses 
     of ManagerFIAlias, such as ManagerFIAliasEquivSets and 
     ManagerFIAliasAliasMap.
+
+    When analyzing all procs, the MREs and ptr assign pairs of the
+    procedures are gathered from the IR on a ThreadPool and then
+    recorded in procedure order, so the ids and sets are the same as
+    gathering them one procedure at a time.
+
+    A SubSetRef such as a field access gets its set through the phase
+    2 map of the set of the mre it is applied to, so different fields
+    of the same struct stay apart.  setFieldSensitivity bounds how
+    deep such paths and how many of them are kept apart, putting the
+    rest in the set of their sub mre.
+
+    The sets found when analyzing all procs can be saved with
+    saveResults and loaded into a later manager with loadResults.
+    Each procedure is saved with a fingerprint of the MREs, ptr assign
+    pairs, formals, and call sites gathered from it.  If none of them
+    differ, performFIAlias loads the sets from the file instead of
+    iterating phases 2 and 3.  Otherwise a saved set is dropped if it
+    has an MRE of a changed procedure, since it can owe its merges to
+    that procedure and sets are never split again, and so is one
+    whose MREs are derefs of MREs in dropped sets or that an indirect
+    call in a dropped set bound through.  The other saved sets are
+    loaded and phases 2 and 3 go on from them.
 */
 class ManagerFIAlias 
 { 
@@ -200,21 +229,59 @@ public:
 
   void mergeSubSetRefs(OA_ptr<UnionFindUniverse> ufset);
 
+  //! threads used to gather from the IR, 0 means ThreadPool's default
+  void setNumThreads(unsigned int numThreads) { mNumThreads = numThreads; }
+
+  //! SubSetRefs nested more than depth deep over a base that isn't a
+  //! SubSetRef are put in the set of their sub mre, so 0 puts every
+  //! field or index access in the set of the ref it is applied to.
+  //! Past budget SubSetRef mres, the rest are put in the set of
+  //! their sub mre too.  -1 means no limit, which is the default.
+  //! A SubSetRef is only checked against the limits once its sub mre
+  //! has been recorded, so it counts against budget at most once.
+  void setFieldSensitivity(int depth, int budget)
+    { mSubSetDepth = depth; mSubSetBudget = budget; }
+  //! SubSetRef mres put in the set of their sub mre by the limits
+  int getNumCollapsedSubSets() { return mNumCollapsedSubSets; }
+
+  //---------------------------------
+  // saved results
+  //---------------------------------
+  //! writes the sets found by the last ALL_PROCS performFIAlias,
+  //! returns false if there are none
+  bool saveResults(std::ostream& os);
+  //! reads results written by saveResults for the next ALL_PROCS
+  //! performFIAlias to start from, returns false if is doesn't
+  //! hold any.  is has to be seekable, such as a file.
+  bool loadResults(std::istream& is);
+  //! whether the last performFIAlias took its sets from the loaded
+  //! results without iterating
+  bool reusedLoadedResults() { return mReusedLoaded; }
+  //! loaded sets the last performFIAlias started from
+  int getNumReusedSets() { return mNumReusedSets; }
+  //! procedures in the last performFIAlias whose fingerprint did
+  //! not match the loaded results
+  int getNumChangedProcs() { return mNumChangedProcs; }
+
 protected:
   OA_ptr<AliasIRInterface> mIR;
 
   //===== helper datastructures and routines
+  //! for each set, the set that each outer refop (by refop id) applied
+  //! to mres in the set leads to, 0 if not known yet
+  typedef std::map<int,std::map<int,int> > PartRefOpMap;
+
   // mapping of MemRefExpr to unique ids
-  std::map<OA_ptr<MemRefExpr>,int> mMREToID;
+  MemRefExprIDTable mMREToID;
   // use a counter to assign unique ids to each MemRefExpr
   int mCount;
 
-  // mapping of MemRefExpr to set of MemRefHandles that can
-  // be expressed by said MemRefExpr
-  std::map<OA_ptr<MemRefExpr>,std::set<MemRefHandle> > mMREToMemRefHandles;
+  // set of MemRefHandles that can be expressed by the MemRefExpr
+  // with each id
+  std::vector<std::set<MemRefHandle> > mIDToMemRefHandles;
 
-  // mapping of MemRefExpr to procedures it shows up in
-  std::map<OA_ptr<MemRefExpr>,std::set<ProcHandle> > mMREToProcs;
+  // procedures the MemRefExpr with each id shows up in
+  std::vector<std::set<ProcHandle> > mIDToProcs;
 
   // mapping of MemRefHandles to procedures, each MemRefHandle is only in
   // one procedure
@@ -233,6 +300,42 @@ protected:
     allMemRefExprsInSameSet( OA_ptr<MemRefExpr> pMRE, 
                              OA_ptr<UnionFindUniverse> ufset);
 
+  //! What phase 1 needs from the IR for one procedure.  Filled in
+  //! without changing the manager, so that procedures can be
+  //! gathered in parallel and then recorded in procedure order.
+  class Phase1Buffer {
+    public:
+      Phase1Buffer(ProcHandle proc) : mProc(proc) {}
+      ProcHandle mProc;
+      //! mres in the order initMemRefExprs records them, with the
+      //! MemRefHandle they came from or MemRefHandle(0)
+      std::vector<std::pair<OA_ptr<MemRefExpr>,MemRefHandle> > mMREs;
+      std::vector<SymHandle> mFormals;
+      //! deref of target and deref of source for each ptr assign pair
+      std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > > 
+          mDerefPairs;
+      std::vector<CallHandle> mCallsites;
+  };
+
+  //! fills in buffer for its procedure, only queries the IR
+  void gatherPhase1(Phase1Buffer& buffer);
+  //! a buffer for each procedure in procIter, filled in in parallel
+  void gatherPhase1(OA_ptr<IRProcIterator> procIter,
+                    std::vector<OA_ptr<Phase1Buffer> >& buffers);
+  //! records the mres and formals gathered in buffer
+  void recordMREs(Phase1Buffer& buffer);
+  //! records the derefs of the gathered ptr assign pairs
+  void recordDerefPairs(Phase1Buffer& buffer);
+  //! records the derefs of the gathered ptr assign pairs and unions them
+  void doPhase1Unions(Phase1Buffer& buffer, OA_ptr<UnionFindUniverse> ufset);
+
+  //! records the derefs of the formals of callee and the actuals
+  //! bound to them at call, target deref first in each pair
+  void recordParamBindDerefs(CallHandle call, ProcHandle caller,
+          ProcHandle callee,
+          std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >& 
+              derefs);
+
   //! records all memory reference expressions in a given procedure
   void initMemRefExprs( ProcHandle proc );
 
@@ -246,10 +349,13 @@ protected:
   void doPhase1Iteration(StmtHandle stmt, ProcHandle currProc, OA_ptr<UnionFindUniverse> ufset);
 
   //! perform Ryder phase 2
-  bool doPhase2Iteration(OA_ptr<UnionFindUniverse> ufset, std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map);
+  bool doPhase2Iteration(OA_ptr<UnionFindUniverse> ufset, PartRefOpMap & map);
+
+  //! perform Ryder phase 2 for the mre with the given id
+  bool doPhase2Constraint(int mreID, OA_ptr<UnionFindUniverse> ufset, PartRefOpMap & map);
 
   //! perform Ryder phase 3 on the callsite call invoked from caller currProc.
-  void doPhase3Iteration(CallHandle call, ProcHandle currProc,OA_ptr<UnionFindUniverse> ufset, std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map);
+  void doPhase3Iteration(CallHandle call, ProcHandle currProc,OA_ptr<UnionFindUniverse> ufset, PartRefOpMap & map);
 
   //! A set of reachable procs that have been analyzed.
   std::set<ProcHandle> mAnalyzedProcs;
@@ -262,21 +368,123 @@ protected:
   OA_ptr<UnionFindUniverse>
   performFIAliasReachableProcs( OA_ptr<IRProcIterator> procIter );
 
-  friend class RecordMREsVisitor;
-
 private: // helper functions
 void outputMREsInSet(int setID, 
         OA_ptr<UnionFindUniverse> ufset, 
-        std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map  );
+        PartRefOpMap & map  );
 void merge(int part1, int part2, OA_ptr<UnionFindUniverse> ufset, 
-           std::map<int,std::map<OA_ptr<MemRefExpr>,int> > & map  );
+           PartRefOpMap & map  );
+
+void noteUnion(int part1, int part2, OA_ptr<UnionFindUniverse> ufset);
+void registerNewMREs(OA_ptr<UnionFindUniverse> ufset);
+void resolveInnerID(int id, int innerID, OA_ptr<UnionFindUniverse> ufset);
+  //! whether the SubSetRef mre is past the field sensitivity limits,
+  //! called once per mre from resolveInnerID
+  bool collapseSubSet(OA_ptr<MemRefExpr> mre);
+void addCallSite(CallHandle call, ProcHandle caller,
+                 OA_ptr<UnionFindUniverse> ufset);
+void solveDeltas(OA_ptr<UnionFindUniverse> ufset, 
+                 PartRefOpMap & map  );
+
+  //! text identifying mre that doesn't depend on the addresses of
+  //! handles, so it can be compared between runs
+  std::string mreKey(OA_ptr<MemRefExpr> mre);
+  unsigned int fingerprint(Phase1Buffer& buffer);
+  //! fingerprints the procedures and numbers their call sites
+  void noteProcs(std::vector<OA_ptr<Phase1Buffer> >& buffers);
+  //! call binds callee in phase 3 for the first time
+  void noteBinding(CallHandle call, ProcHandle callee);
+  //! puts the mres of each loaded set that is still valid in that
+  //! set, returns true if they all are and nothing is left to solve
+  bool reuseLoadedResults(std::vector<OA_ptr<Phase1Buffer> >& buffers,
+                          OA_ptr<UnionFindUniverse> ufset);
 
   //! The list of procedures to be analyzed.
   std::set<ProcHandle> mWorklist;
 
+  //===== state for only revisiting what changed
+  //! mres given an id since the last registerNewMREs
+  std::list<OA_ptr<MemRefExpr> > mNewMREs;
+  std::vector<OA_ptr<MemRefExpr> > mIDToMRE;
+  //! for refops, the id of the inner mre and of the outer refop
+  std::vector<int> mIDToInnerID;
+  std::vector<int> mIDToRefOpID;
+  //! refops waiting for their inner mre to be recorded, by inner mre
+  std::map<OA_ptr<MemRefExpr>,std::list<int> > mWaitingForInner;
+  //! unique ids for outer refops, so the partition map compares ints
+  MemRefExprIDTable mRefOpToID;
+  //! ids of all the mres in each set, indexed by set name
+  std::map<int,std::list<int> > mPartToMemberIDs;
+  //! ids of mres whose phase 2 constraint involves the set
+  std::map<int,std::list<int> > mPartToMREIDs;
+  //! indirect call sites whose call mre is in the set
+  std::map<int,std::list<int> > mPartToCallIDs;
+  std::vector<std::pair<CallHandle,ProcHandle> > mCallSites;
+  std::list<int> mDirtyMREIDs;
+  std::vector<bool> mMREDirty;
+  std::list<int> mDirtyCallIDs;
+  std::vector<bool> mCallDirty;
+
   //! The flavor of FIAlias--examine all procs or only reachable procs.
   FIAliasImplement mImplement;
 
+  unsigned int mNumThreads;
+
+  //===== limits on keeping SubSetRefs apart
+  int mSubSetDepth;
+  int mSubSetBudget;
+  //! SubSetRef mres that were kept in sets of their own
+  int mNumSubSets;
+  int mNumCollapsedSubSets;
+
+  //===== state for saving and loading results
+  //! results read by loadResults
+  class LoadedResults {
+    public:
+      //! field sensitivity the sets were found with
+      int mSubSetDepth;
+      int mSubSetBudget;
+      std::vector<std::string> mProcNames;
+      std::vector<unsigned int> mFingerprints;
+      //! key, set, inner mre id (0 if none), and procedure indices
+      //! of each mre, indexed by id
+      std::vector<std::string> mKeys;
+      std::vector<int> mSets;
+      std::vector<int> mInnerIDs;
+      std::vector<std::vector<int> > mProcs;
+      //! caller index, call site index in the caller, callee name
+      std::vector<std::pair<std::pair<int,int>,std::string> > mBindings;
+  };
+  OA_ptr<LoadedResults> mLoaded;
+  //! the sets of the last ALL_PROCS performFIAlias
+  OA_ptr<UnionFindUniverse> mResultSets;
+  //! name and fingerprint of each procedure, in procedure order
+  std::vector<std::pair<std::string,unsigned int> > mProcFingerprints;
+  std::map<ProcHandle,int> mProcIndex;
+  //! procedure index and index within the procedure of each call site
+  std::map<CallHandle,std::pair<int,int> > mCallSiteIndex;
+  //! callees bound to call sites by phase 3, in the order they were
+  std::vector<std::pair<CallHandle,ProcHandle> > mBindings;
+  std::set<std::pair<CallHandle,ProcHandle> > mBindingSet;
+  //! call sites whose bindings were all redone from the loaded
+  //! results, see reuseLoadedResults, and the indirect ones by the
+  //! set of their call mre until it is unioned
+  std::set<CallHandle> mRedoneCalls;
+  std::map<int,std::list<CallHandle> > mRedonePartCalls;
+  bool mReusedLoaded;
+  int mNumReusedSets;
+  int mNumChangedProcs;
+
+  class Phase1Task : public virtual ThreadTask {
+    public:
+      Phase1Task(ManagerFIAlias& manager, OA_ptr<Phase1Buffer> buffer)
+          : mManager(manager), mBuffer(buffer) {}
+      void run() { mManager.gatherPhase1(*mBuffer); }
+    private:
+      ManagerFIAlias& mManager;
+      OA_ptr<Phase1Buffer> mBuffer;
+  };
+
 };
 
 
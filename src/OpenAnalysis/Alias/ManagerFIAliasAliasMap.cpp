@@ -64,7 +64,7 @@ ManagerFIAliasAliasMap::buildAliasMaps( OA_ptr<UnionFindUniverse> ufset,
     std::set<int> allufsetIDs;
 
     // loop all the mres and get a set of mres for each ufset
-    std::map<OA_ptr<MemRefExpr>,int>::iterator mreMapIter;
+    MemRefExprIDTable::iterator mreMapIter;
     for (mreMapIter=mMREToID.begin(); mreMapIter!=mMREToID.end();
          mreMapIter++ )
     {
@@ -58,7 +58,7 @@ ManagerFIAliasEquivSets::buildEquivSets( OA_ptr<UnionFindUniverse> ufset,
     std::map<int,int> equivSetIdToNumLocs;
     std::map<int,bool> equivSetIdHasMemRefHandle; // do any map to equiv set 
     std::map<int,std::set<OA_ptr<MemRefExpr> > > ufSetToMREs;
-    std::map<OA_ptr<MemRefExpr>,int>::iterator mreMapIter;
+    MemRefExprIDTable::iterator mreMapIter;
     for (mreMapIter=mMREToID.begin(); mreMapIter!=mMREToID.end(); mreMapIter++ )
     {
         OA_ptr<MemRefExpr> mre = mreMapIter->first;
@@ -159,7 +159,8 @@ ManagerFIAliasEquivSets::buildEquivSets( OA_ptr<UnionFindUniverse> ufset,
             std::cout << "\t\tmre = ";
             mre->output(*mIR);
           }
-          if (mMREToProcs[mre].find(proc) != mMREToProcs[mre].end() ) {
+          std::set<ProcHandle>& procs = mIDToProcs[mMREToID[mre]];
+          if (procs.find(proc) != procs.end() ) {
             foundProc = true;
             break;
           }
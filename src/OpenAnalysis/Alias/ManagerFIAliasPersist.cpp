@@ -0,0 +1,660 @@
+/*! \file
+
+  \brief Saving and loading the sets found by ManagerFIAlias.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerFIAlias.hpp"
+#include <Utils/Util.hpp>
+#include <sstream>
+#include <algorithm>
+
+namespace OA {
+  namespace Alias {
+
+static bool debug = false;
+
+//! identifies files written by saveResults
+static const char sMagic[4] = { 'O', 'A', 'F', 'I' };
+//! changes whenever the layout or the meaning of the file changes
+static const unsigned int sVersion = 4;
+
+/*!
+   The file is:
+     magic, version, SubSetRef depth and budget,
+     number of procs, then name and fingerprint of each,
+     number of mre ids (including 0), then for each id >= 1 its key,
+         set, inner mre id, and number of procs and index of each,
+         where the number of procs stands for one that wasn't analyzed,
+     number of bindings, then caller index, call site index, and
+         callee name of each.
+   Unsigned ints are written as 4 bytes, low byte first, and strings
+   as their length followed by their characters.
+*/
+static void writeUInt(std::ostream& os, unsigned int val)
+{
+    char bytes[4];
+    for (int i=0; i<4; i++) { bytes[i] = (char)((val >> (8*i)) & 0xff); }
+    os.write(bytes, 4);
+}
+
+static bool readUInt(std::istream& is, unsigned int& val)
+{
+    unsigned char bytes[4];
+    if (!is.read((char*)bytes, 4)) { return false; }
+    val = 0;
+    for (int i=0; i<4; i++) { val |= ((unsigned int)bytes[i]) << (8*i); }
+    return true;
+}
+
+static void writeString(std::ostream& os, const std::string& str)
+{
+    writeUInt(os, str.size());
+    os.write(str.data(), str.size());
+}
+
+//! bytes between the read position of is and end
+static unsigned long bytesLeft(std::istream& is, std::streampos end)
+{
+    std::streampos pos = is.tellg();
+    if (pos < 0 || end < pos) { return 0; }
+    return (unsigned long)(end - pos);
+}
+
+static bool readString(std::istream& is, std::string& str,
+                       std::streampos end)
+{
+    unsigned int size;
+    if (!readUInt(is, size) || size > bytesLeft(is, end)) { return false; }
+    str.resize(size);
+    return size == 0 || is.read(&str[0], size);
+}
+
+//! FNV-1a
+static unsigned int hashString(unsigned int hash, const std::string& str)
+{
+    for (unsigned int i=0; i<str.size(); i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+    // separator, so "ab","c" and "a","bc" differ
+    hash ^= 0xff;
+    hash *= 16777619u;
+    return hash;
+}
+
+/*!
+   Visitor that writes out an MRE with the names the IR gives its
+   handles, so that it reads the same in the next run.  Follows what
+   the MRE comparison operators look at, plus the MemRefType of each
+   level.
+*/
+class MREKeyVisitor : public virtual MemRefExprVisitor {
+  public:
+    MREKeyVisitor(OA_ptr<AliasIRInterface> ir) : mIR(ir) {}
+    ~MREKeyVisitor() {}
+
+    std::string getKey() { return mKey.str(); }
+
+    void visitNamedRef(NamedRef& ref)
+      { type(ref); mKey << "N(" << mIR->toString(ref.getSymHandle()) << ")"; }
+    void visitUnnamedRef(UnnamedRef& ref)
+      { type(ref); mKey << "U(" << mIR->toString(ref.getExprHandle()) << ")"; }
+    void visitUnknownRef(UnknownRef& ref) { type(ref); mKey << "?"; }
+    void visitAddressOf(AddressOf& ref)
+      { type(ref); mKey << "&"; visitInner(ref); }
+    void visitDeref(Deref& ref)
+      { type(ref); mKey << "*" << ref.getNumDerefs(); visitInner(ref); }
+    void visitSubSetRef(SubSetRef& ref)
+      { type(ref); mKey << "S"; visitInner(ref); }
+    void visitIdxAccess(IdxAccess& ref)
+      { type(ref); mKey << "I" << ref.getIdx(); visitInner(ref); }
+    void visitIdxExprAccess(IdxExprAccess& ref)
+      { type(ref); mKey << "E(" << mIR->toString(ref.getExpr()) << ")";
+        visitInner(ref); }
+    void visitFieldAccess(FieldAccess& ref)
+      { type(ref); mKey << "F(" << ref.getFieldName() << ")"; visitInner(ref); }
+
+  private:
+    //! the MemRefType as a digit; the comparison operators ignore it,
+    //! so only the key tells a USE from a DEF recorded under an id
+    void type(MemRefExpr& ref) { mKey << (int)ref.getMRType(); }
+
+    void visitInner(RefOp& ref) {
+        OA_ptr<MemRefExpr> inner = ref.getMemRefExpr();
+        mKey << "(";
+        if (!inner.ptrEqual(0)) { inner->acceptVisitor(*this); }
+        mKey << ")";
+    }
+
+    OA_ptr<AliasIRInterface> mIR;
+    std::ostringstream mKey;
+};
+
+std::string ManagerFIAlias::mreKey(OA_ptr<MemRefExpr> mre)
+{
+    MREKeyVisitor visitor(mIR);
+    mre->acceptVisitor(visitor);
+    return visitor.getKey();
+}
+
+/*! Covers everything phase 1 gathered for the procedure.  What
+ *  phase 3 does at a call site depends on the callee, which is
+ *  covered by its own fingerprint.
+ */
+unsigned int ManagerFIAlias::fingerprint(Phase1Buffer& buffer)
+{
+    unsigned int hash = 2166136261u;
+    hash = hashString(hash, mIR->toString(buffer.mProc));
+
+    std::vector<std::pair<OA_ptr<MemRefExpr>,MemRefHandle> >::iterator
+        mreIter;
+    for (mreIter=buffer.mMREs.begin(); mreIter!=buffer.mMREs.end();
+         mreIter++)
+    {
+        hash = hashString(hash, mreKey(mreIter->first));
+        if (mreIter->second != MemRefHandle(0)) {
+            hash = hashString(hash, mIR->toString(mreIter->second));
+        }
+    }
+
+    std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >::iterator
+        pairIter;
+    for (pairIter=buffer.mDerefPairs.begin();
+         pairIter!=buffer.mDerefPairs.end(); pairIter++)
+    {
+        hash = hashString(hash, mreKey(pairIter->first));
+        hash = hashString(hash, mreKey(pairIter->second));
+    }
+
+    std::vector<SymHandle>::iterator formalIter;
+    for (formalIter=buffer.mFormals.begin();
+         formalIter!=buffer.mFormals.end(); formalIter++)
+    {
+        hash = hashString(hash, mIR->toString(*formalIter));
+    }
+
+    std::vector<CallHandle>::iterator callIter;
+    for (callIter=buffer.mCallsites.begin();
+         callIter!=buffer.mCallsites.end(); callIter++)
+    {
+        hash = hashString(hash, mIR->toString(*callIter));
+    }
+
+    return hash;
+}
+
+void ManagerFIAlias::noteProcs(std::vector<OA_ptr<Phase1Buffer> >& buffers)
+{
+    mProcFingerprints.clear();
+    mProcIndex.clear();
+    mCallSiteIndex.clear();
+    for (unsigned int i=0; i<buffers.size(); i++) {
+        Phase1Buffer& buffer = *buffers[i];
+        mProcIndex[buffer.mProc] = i;
+        mProcFingerprints.push_back(std::pair<std::string,unsigned int>(
+            mIR->toString(buffer.mProc), fingerprint(buffer)));
+        for (unsigned int j=0; j<buffer.mCallsites.size(); j++) {
+            mCallSiteIndex[buffer.mCallsites[j]]
+                = std::pair<int,int>(i,j);
+        }
+    }
+}
+
+void ManagerFIAlias::noteBinding(CallHandle call, ProcHandle callee)
+{
+    std::pair<CallHandle,ProcHandle> binding(call, callee);
+    if (mBindingSet.insert(binding).second) {
+        mBindings.push_back(binding);
+    }
+}
+
+bool ManagerFIAlias::saveResults(std::ostream& os)
+{
+    if (mResultSets.ptrEqual(0)) { return false; }
+
+    os.write(sMagic, 4);
+    writeUInt(os, sVersion);
+    writeUInt(os, (unsigned int)mSubSetDepth);
+    writeUInt(os, (unsigned int)mSubSetBudget);
+
+    writeUInt(os, mProcFingerprints.size());
+    std::vector<std::pair<std::string,unsigned int> >::iterator procIter;
+    for (procIter=mProcFingerprints.begin();
+         procIter!=mProcFingerprints.end(); procIter++)
+    {
+        writeString(os, procIter->first);
+        writeUInt(os, procIter->second);
+    }
+
+    // the next run matches its mres to these by key
+    std::vector<std::string> keys(mCount);
+    MemRefExprIDTable::iterator mreIter;
+    for (mreIter=mMREToID.begin(); mreIter!=mMREToID.end(); mreIter++) {
+        if (mreIter->second == 0) { continue; }
+        keys[mreIter->second] = mreKey(mreIter->first);
+    }
+    writeUInt(os, mCount);
+    for (int id=1; id<mCount; id++) {
+        writeString(os, keys[id]);
+        writeUInt(os, mResultSets->Find(id));
+        writeUInt(os, id < (int)mIDToInnerID.size() ? mIDToInnerID[id] : 0);
+        writeUInt(os, mIDToProcs[id].size());
+        std::set<ProcHandle>::iterator idProcIter;
+        for (idProcIter=mIDToProcs[id].begin();
+             idProcIter!=mIDToProcs[id].end(); idProcIter++)
+        {
+            std::map<ProcHandle,int>::iterator found
+                = mProcIndex.find(*idProcIter);
+            writeUInt(os, found == mProcIndex.end()
+                          ? mProcFingerprints.size() : found->second);
+        }
+    }
+
+    writeUInt(os, mBindings.size());
+    std::vector<std::pair<CallHandle,ProcHandle> >::iterator bindIter;
+    for (bindIter=mBindings.begin(); bindIter!=mBindings.end(); bindIter++) {
+        std::pair<int,int> index = mCallSiteIndex[bindIter->first];
+        writeUInt(os, index.first);
+        writeUInt(os, index.second);
+        writeString(os, mIR->toString(bindIter->second));
+    }
+
+    if (debug) {
+        std::cout << "ManagerFIAlias::saveResults: "
+                  << mProcFingerprints.size() << " procs, "
+                  << mCount-1 << " mres, " << mBindings.size()
+                  << " bindings" << std::endl;
+    }
+
+    return !os.fail();
+}
+
+bool ManagerFIAlias::loadResults(std::istream& is)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerFIAlias:ALL", debug);
+
+    OA_ptr<LoadedResults> none;
+    mLoaded = none;
+
+    // lengths and counts are checked against what is left of is
+    // before anything is allocated for them
+    std::streampos start = is.tellg();
+    if (start < 0 || !is.seekg(0, std::ios::end)) { return false; }
+    std::streampos end = is.tellg();
+    if (end < 0 || !is.seekg(start)) { return false; }
+
+    char magic[4];
+    unsigned int version;
+    if (!is.read(magic, 4) || !std::equal(magic, magic+4, sMagic)
+        || !readUInt(is, version) || version != sVersion)
+    {
+        return false;
+    }
+
+    OA_ptr<LoadedResults> loaded;
+    loaded = new LoadedResults;
+
+    unsigned int depth, budget;
+    if (!readUInt(is, depth) || !readUInt(is, budget)) { return false; }
+    loaded->mSubSetDepth = (int)depth;
+    loaded->mSubSetBudget = (int)budget;
+
+    unsigned int numProcs;
+    if (!readUInt(is, numProcs)) { return false; }
+    for (unsigned int i=0; i<numProcs; i++) {
+        std::string name;
+        unsigned int fingerprint;
+        if (!readString(is, name, end) || !readUInt(is, fingerprint)) {
+            return false;
+        }
+        loaded->mProcNames.push_back(name);
+        loaded->mFingerprints.push_back(fingerprint);
+    }
+
+    unsigned int count;
+    // each id after 0 takes at least a key length, a set, an inner id,
+    // and a number of procs
+    if (!readUInt(is, count) || count == 0
+        || count-1 > bytesLeft(is, end) / 16)
+    {
+        return false;
+    }
+    loaded->mKeys.resize(count);
+    loaded->mSets.resize(count, 0);
+    loaded->mInnerIDs.resize(count, 0);
+    loaded->mProcs.resize(count);
+    for (unsigned int id=1; id<count; id++) {
+        unsigned int set, inner, idProcs;
+        if (!readString(is, loaded->mKeys[id], end) || !readUInt(is, set)
+            || set == 0 || set >= count
+            || !readUInt(is, inner) || inner >= count
+            || !readUInt(is, idProcs) || idProcs > bytesLeft(is, end) / 4)
+        {
+            return false;
+        }
+        loaded->mSets[id] = set;
+        loaded->mInnerIDs[id] = inner;
+        for (unsigned int i=0; i<idProcs; i++) {
+            unsigned int proc;
+            if (!readUInt(is, proc) || proc > numProcs) { return false; }
+            loaded->mProcs[id].push_back(proc);
+        }
+    }
+
+    unsigned int numBindings;
+    if (!readUInt(is, numBindings)) { return false; }
+    for (unsigned int i=0; i<numBindings; i++) {
+        unsigned int caller, call;
+        std::string callee;
+        if (!readUInt(is, caller) || caller >= numProcs
+            || !readUInt(is, call) || !readString(is, callee, end))
+        {
+            return false;
+        }
+        loaded->mBindings.push_back(
+            std::pair<std::pair<int,int>,std::string>(
+                std::pair<int,int>(caller,call), callee));
+    }
+
+    mLoaded = loaded;
+    return true;
+}
+
+//! marks the loaded set dropped, to be looked at from dropped
+static void dropSet(int set, std::vector<bool>& isDropped,
+                    std::vector<int>& dropped)
+{
+    if (!isDropped[set]) {
+        isDropped[set] = true;
+        dropped.push_back(set);
+    }
+}
+
+/*! Works out which loaded sets, by loaded id, can still be used.
+ *  Starting from those with an mre of a procedure that changed or is
+ *  gone, a set is dropped if it has a deref (or other refop) of an
+ *  mre in a dropped set, whose phase 2 constraint the bad merges may
+ *  have satisfied, or the call mre of an indirect call.  The call
+ *  may not bind the callees it did, so the procedures on both ends
+ *  count as changed.
+ *
+ *  The current mres are matched to the loaded ones by key.  Those
+ *  of each set left are loaded into ufset together, each other mre
+ *  is left in a set of its own, and phases 1 to 3 then only merge
+ *  what the new constraints and the dropped sets need.  The bindings
+ *  between procedures that didn't change are redone first, so that
+ *  their derefs are recorded and matched too, and phase 3 skips the
+ *  call sites whose bindings were all redone until the set of their
+ *  call mre changes.
+ *
+ *  How many SubSetRefs are kept apart under a budget depends on the
+ *  order they are recorded in, so with a budget the loaded sets are
+ *  only used if nothing changed.
+ */
+bool
+ManagerFIAlias::reuseLoadedResults(
+        std::vector<OA_ptr<Phase1Buffer> >& buffers,
+        OA_ptr<UnionFindUniverse> ufset)
+{
+    LoadedResults& loaded = *mLoaded;
+    if (loaded.mSubSetDepth != mSubSetDepth
+        || loaded.mSubSetBudget != mSubSetBudget)
+    {
+        return false;
+    }
+
+    // loaded procs by name, and whether each changed; the one past
+    // the last stands for procs that weren't analyzed
+    int numLoadedProcs = loaded.mProcNames.size();
+    std::map<std::string,int> loadedIndex;
+    for (int i=0; i<numLoadedProcs; i++) {
+        loadedIndex[loaded.mProcNames[i]] = i;
+    }
+    std::vector<bool> changed(numLoadedProcs+1, true);
+    std::vector<int> currentIndex(numLoadedProcs, -1);
+    bool newProcs = false;
+    for (unsigned int i=0; i<buffers.size(); i++) {
+        std::map<std::string,int>::iterator found
+            = loadedIndex.find(mProcFingerprints[i].first);
+        if (found == loadedIndex.end()) {
+            mNumChangedProcs++;
+            newProcs = true;
+        } else if (loaded.mFingerprints[found->second]
+                   != mProcFingerprints[i].second)
+        {
+            mNumChangedProcs++;
+        } else {
+            changed[found->second] = false;
+            currentIndex[found->second] = i;
+        }
+    }
+    bool sameProcs = (mNumChangedProcs == 0);
+    for (int i=0; i<numLoadedProcs; i++) {
+        if (changed[i]) { sameProcs = false; }
+    }
+    if (!sameProcs && mSubSetBudget >= 0) { return false; }
+
+    // what a dropped set drags along
+    int count = loaded.mKeys.size();
+    std::vector<std::vector<int> > members(count);
+    std::vector<std::vector<int> > outerIDs(count);
+    std::vector<std::vector<int> > procIDs(numLoadedProcs+1);
+    for (int id=1; id<count; id++) {
+        members[loaded.mSets[id]].push_back(id);
+        if (loaded.mInnerIDs[id] != 0) {
+            outerIDs[loaded.mInnerIDs[id]].push_back(id);
+        }
+        std::vector<int>::iterator procIter;
+        for (procIter=loaded.mProcs[id].begin();
+             procIter!=loaded.mProcs[id].end(); procIter++)
+        {
+            procIDs[*procIter].push_back(id);
+        }
+    }
+
+    std::vector<bool> isDropped(count, false);
+    std::vector<int> dropped;
+
+    // keys that name more than one loaded mre can't be matched
+    std::map<std::string,int> keyToID;
+    for (int id=1; id<count; id++) {
+        std::pair<std::map<std::string,int>::iterator,bool> inserted
+            = keyToID.insert(std::pair<std::string,int>(loaded.mKeys[id],id));
+        if (!inserted.second) {
+            dropSet(loaded.mSets[id], isDropped, dropped);
+            dropSet(loaded.mSets[inserted.first->second], isDropped, dropped);
+        }
+    }
+
+    // the callee of each binding, and the set of its call mre if the
+    // call is indirect
+    int numBindings = loaded.mBindings.size();
+    std::vector<int> bindCallee(numBindings, numLoadedProcs);
+    std::vector<std::vector<int> > setBindings(count);
+    for (int b=0; b<numBindings; b++) {
+        std::map<std::string,int>::iterator found
+            = loadedIndex.find(loaded.mBindings[b].second);
+        if (found != loadedIndex.end()) { bindCallee[b] = found->second; }
+
+        int caller = loaded.mBindings[b].first.first;
+        int call = loaded.mBindings[b].first.second;
+        if (changed[caller]) { continue; }
+        Phase1Buffer& buffer = *buffers[currentIndex[caller]];
+        if (call < 0 || call >= (int)buffer.mCallsites.size()) {
+            return false;
+        }
+        OA_ptr<MemRefExpr> callMRE
+            = mIR->getCallMemRefExpr(buffer.mCallsites[call]);
+        if (callMRE->isaNamed()) { continue; }
+        std::map<std::string,int>::iterator callID
+            = keyToID.find(mreKey(callMRE));
+        if (callID == keyToID.end()) {
+            changed[caller] = changed[bindCallee[b]] = true;
+        } else {
+            setBindings[loaded.mSets[callID->second]].push_back(b);
+        }
+    }
+
+    std::list<int> changedProcs;
+    for (int i=0; i<=numLoadedProcs; i++) {
+        if (changed[i]) { changedProcs.push_back(i); }
+    }
+    while (!changedProcs.empty() || !dropped.empty()) {
+        if (!changedProcs.empty()) {
+            int proc = changedProcs.front();
+            changedProcs.pop_front();
+            std::vector<int>::iterator idIter;
+            for (idIter=procIDs[proc].begin(); idIter!=procIDs[proc].end();
+                 idIter++)
+            {
+                dropSet(loaded.mSets[*idIter], isDropped, dropped);
+            }
+            continue;
+        }
+
+        int set = dropped.back();
+        dropped.pop_back();
+        std::vector<int>::iterator idIter, outerIter, bindIter;
+        for (idIter=members[set].begin(); idIter!=members[set].end();
+             idIter++)
+        {
+            for (outerIter=outerIDs[*idIter].begin();
+                 outerIter!=outerIDs[*idIter].end(); outerIter++)
+            {
+                dropSet(loaded.mSets[*outerIter], isDropped, dropped);
+            }
+        }
+        for (bindIter=setBindings[set].begin();
+             bindIter!=setBindings[set].end(); bindIter++)
+        {
+            int ends[2] = { loaded.mBindings[*bindIter].first.first,
+                            bindCallee[*bindIter] };
+            for (int e=0; e<2; e++) {
+                if (!changed[ends[e]]) {
+                    changed[ends[e]] = true;
+                    changedProcs.push_back(ends[e]);
+                }
+            }
+        }
+    }
+
+    // the bindings left still hold, since their call mre is in the
+    // same set as the callee's name in anything found from here
+    std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > > derefs;
+    std::set<CallHandle> partlyRedone;
+    for (int b=0; b<numBindings; b++) {
+        int caller = loaded.mBindings[b].first.first;
+        if (changed[caller]) { continue; }
+        Phase1Buffer& buffer = *buffers[currentIndex[caller]];
+        CallHandle call = buffer.mCallsites[loaded.mBindings[b].first.second];
+        if (changed[bindCallee[b]]) {
+            partlyRedone.insert(call);
+            continue;
+        }
+        ProcHandle callee = buffers[currentIndex[bindCallee[b]]]->mProc;
+        noteBinding(call, callee);
+        recordParamBindDerefs(call, buffer.mProc, callee, derefs);
+    }
+
+    // each set left is named after the first of its mres
+    std::vector<int> sets(mCount);
+    for (int id=0; id<mCount; id++) { sets[id] = id; }
+    std::vector<int> setName(count, 0);
+    bool allLoaded = sameProcs && (mCount == count);
+    MemRefExprIDTable::iterator mreIter;
+    for (mreIter=mMREToID.begin(); mreIter!=mMREToID.end(); mreIter++) {
+        int id = mreIter->second;
+        if (id == 0) { continue; }
+        std::map<std::string,int>::iterator found
+            = keyToID.find(mreKey(mreIter->first));
+        int set = (found == keyToID.end()) ? 0 : loaded.mSets[found->second];
+        if (set == 0 || isDropped[set]) {
+            allLoaded = false;
+            continue;
+        }
+        if (setName[set] == 0) {
+            setName[set] = id;
+            mNumReusedSets++;
+        }
+        sets[id] = setName[set];
+    }
+    if (!allLoaded && mSubSetBudget >= 0) {
+        mNumReusedSets = 0;
+        return false;
+    }
+    ufset->load(sets);
+
+    // phase 3 would bind the same callees at a call of an unchanged
+    // procedure whose bindings were all redone, if it is direct or its
+    // call mre is in a loaded set, unless a new procedure's name could
+    // be in that set
+    for (int i=0; i<numLoadedProcs; i++) {
+        if (changed[i]) { continue; }
+        Phase1Buffer& buffer = *buffers[currentIndex[i]];
+        std::vector<CallHandle>::iterator callIter;
+        for (callIter=buffer.mCallsites.begin();
+             callIter!=buffer.mCallsites.end(); callIter++)
+        {
+            if (partlyRedone.find(*callIter) != partlyRedone.end()) {
+                continue;
+            }
+            OA_ptr<MemRefExpr> callMRE = mIR->getCallMemRefExpr(*callIter);
+            bool redone;
+            if (callMRE->isaNamed()) {
+                ProcHandle callee = mIR->getProcHandle(
+                    callMRE.convert<NamedRef>()->getSymHandle());
+                redone = (callee == ProcHandle(0)
+                          || mBindingSet.find(
+                                 std::pair<CallHandle,ProcHandle>(
+                                     *callIter, callee))
+                             != mBindingSet.end());
+            } else {
+                std::map<std::string,int>::iterator found
+                    = keyToID.find(mreKey(callMRE));
+                redone = !newProcs && found != keyToID.end()
+                         && !isDropped[loaded.mSets[found->second]];
+            }
+            if (!redone) { continue; }
+            mRedoneCalls.insert(*callIter);
+            if (!callMRE->isaNamed()) {
+                mRedonePartCalls[ufset->Find(mMREToID[callMRE])]
+                    .push_back(*callIter);
+            }
+        }
+    }
+
+    // the merges phase 3 made for the bindings redone
+    std::vector<std::pair<OA_ptr<MemRefExpr>,OA_ptr<MemRefExpr> > >::iterator
+        pairIter;
+    for (pairIter=derefs.begin(); pairIter!=derefs.end(); pairIter++) {
+        int targetPart = ufset->Find(mMREToID[pairIter->first]);
+        int sourcePart = ufset->Find(mMREToID[pairIter->second]);
+        if (targetPart != sourcePart) {
+            ufset->Union( targetPart, sourcePart, sourcePart );
+            noteUnion(targetPart, sourcePart, ufset);
+        }
+    }
+
+    if (debug) {
+        int numDropped = 0;
+        for (int set=1; set<count; set++) {
+            if (isDropped[set]) { numDropped++; }
+        }
+        std::cout << "ManagerFIAlias::reuseLoadedResults: "
+                  << mNumChangedProcs << " procs changed, reused "
+                  << mNumReusedSets << " sets, dropped " << numDropped
+                  << std::endl;
+    }
+
+    mReusedLoaded = allLoaded;
+    return allLoaded;
+}
+
+  } // end of namespace Alias
+} // end of namespace OA
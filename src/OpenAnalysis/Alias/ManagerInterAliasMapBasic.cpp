@@ -23,19 +23,28 @@ static bool debug = false;
 OA_ptr<Alias::InterAliasMap> 
 ManagerInterAliasMapBasic::performAnalysis( OA_ptr<IRProcIterator> procIter)
 {
-  // manager for intraprocedural AliasMap construction
-  OA_ptr<ManagerAliasMapBasic> aliasmapman;
-  aliasmapman = new ManagerAliasMapBasic(mIR);
+  std::vector<ProcHandle> procs;
+  for (procIter->reset();  procIter->isValid(); (*procIter)++ ) {
+      procs.push_back(procIter->current());
+  }
+
+  // one slot per procedure, sized before any task writes to it
+  std::vector<OA_ptr<AliasMap> > results(procs.size());
+  ThreadPool pool(mNumThreads);
+  for (unsigned int i=0; i<procs.size(); i++) {
+      OA_ptr<ThreadTask> task;
+      task = new BuildTask(mIR, procs[i], results[i]);
+      pool.add(task);
+  }
+  pool.wait();
 
   // container for proc to alias results
   OA_ptr<InterAliasMap> retval;
   retval = new InterAliasMap();
 
-  for (procIter->reset();  procIter->isValid(); (*procIter)++ ) {
-      ProcHandle proc = procIter->current();
-
+  for (unsigned int i=0; i<procs.size(); i++) {
       // store off the aliasmap for this procedure
-      retval->mapProcToAliasMap(proc, aliasmapman->performAnalysis(proc));
+      retval->mapProcToAliasMap(procs[i], results[i]);
   }
 
   return retval;
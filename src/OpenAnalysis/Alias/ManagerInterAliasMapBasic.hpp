@@ -17,11 +17,13 @@
 
 //--------------------------------------------------------------------
 #include <cassert>
+#include <vector>
 
 // OpenAnalysis headers
 #include <OpenAnalysis/Utils/OA_ptr.hpp>
 #include <OpenAnalysis/Alias/InterAliasMap.hpp>
 #include <OpenAnalysis/IRInterface/AliasIRInterface.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 
 namespace OA {
   namespace Alias {
@@ -30,17 +32,43 @@ namespace OA {
    Will just create a Manager for the intraprocedural results and pass
    that to InterProcedural results, which will then generate intraprocedural
    results on demand.
+
+   The intraprocedural AliasMaps don't depend on each other, so each
+   one is built by its own ManagerAliasMapBasic on a ThreadPool.  Every
+   task fills in its own slot, and the slots are put in the
+   InterAliasMap in procedure order once the pool is done.
 */
 class ManagerInterAliasMapBasic { //??? eventually public OA::AnnotationManager
 public:
-  ManagerInterAliasMapBasic(OA_ptr<AliasIRInterface> _ir) : mIR(_ir) {}
+  ManagerInterAliasMapBasic(OA_ptr<AliasIRInterface> _ir) 
+      : mIR(_ir), mNumThreads(0) {}
   ~ManagerInterAliasMapBasic () {}
 
   OA_ptr<Alias::InterAliasMap> performAnalysis(OA_ptr<IRProcIterator> procIter);
 
+  //! threads to build AliasMaps on, 0 means ThreadPool's default
+  void setNumThreads(unsigned int numThreads) { mNumThreads = numThreads; }
+
 private:
-  OA_ptr<AliasIRInterface> mIR;
+  class BuildTask : public virtual ThreadTask {
+    public:
+      BuildTask(OA_ptr<AliasIRInterface> ir, ProcHandle proc,
+                OA_ptr<AliasMap>& result)
+          : mIR(ir), mProc(proc), mResult(result) {}
+      void run() 
+      {
+          // ManagerAliasMapBasic keeps the proc being analyzed
+          ManagerAliasMapBasic aliasmapman(mIR);
+          mResult = aliasmapman.performAnalysis(mProc);
+      }
+    private:
+      OA_ptr<AliasIRInterface> mIR;
+      ProcHandle mProc;
+      OA_ptr<AliasMap>& mResult;
+  };
 
+  OA_ptr<AliasIRInterface> mIR;
+  unsigned int mNumThreads;
 };
 
   } // end of Alias namespace
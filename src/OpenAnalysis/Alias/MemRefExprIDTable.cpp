@@ -0,0 +1,79 @@
+/*! \file
+
+  \brief Implementation of MemRefExprIDTable.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "MemRefExprIDTable.hpp"
+
+namespace OA {
+  namespace Alias {
+
+int& MemRefExprIDTable::operator[](OA_ptr<MemRefExpr> mre)
+{
+    unsigned long h = hash(mre);
+    int index = findIndex(mre, h);
+    if (index < 0) {
+        index = mEntries.size();
+        mEntries.push_back(Entry(mre, 0));
+        mBuckets[h].push_back(index);
+    }
+    return mEntries[index].second;
+}
+
+MemRefExprIDTable::iterator MemRefExprIDTable::find(OA_ptr<MemRefExpr> mre)
+{
+    int index = findIndex(mre, hash(mre));
+    return index < 0 ? mEntries.end() : mEntries.begin() + index;
+}
+
+void MemRefExprIDTable::clear()
+{
+    mEntries.clear();
+    mBuckets.clear();
+}
+
+unsigned long MemRefExprIDTable::hash(OA_ptr<MemRefExpr> mre)
+{
+    // a null OA_ptr is a key of its own, as it is for OA_ptr::operator<
+    unsigned long h = 0;
+    while (!mre.ptrEqual(0)) {
+        h = h * 31 + mre->getOrder();
+        if (mre->isaNamed()) {
+            return h * 31 + mre.convert<NamedRef>()->getSymHandle().hval();
+        }
+        if (mre->isaUnnamed()) {
+            return h * 31 + mre.convert<UnnamedRef>()->getExprHandle().hval();
+        }
+        if (!mre->isaRefOp()) { return h; }
+
+        OA_ptr<RefOp> refop = mre.convert<RefOp>();
+        if (refop->isaDeref()) {
+            h = h * 31 + refop.convert<Deref>()->getNumDerefs();
+        }
+        mre = refop->getMemRefExpr();
+    }
+    return h;
+}
+
+int MemRefExprIDTable::findIndex(OA_ptr<MemRefExpr> mre, unsigned long h)
+{
+    std::map<unsigned long,std::vector<int> >::iterator bucket
+        = mBuckets.find(h);
+    if (bucket == mBuckets.end()) { return -1; }
+    std::vector<int>::iterator indexIter;
+    for (indexIter=bucket->second.begin(); indexIter!=bucket->second.end();
+         indexIter++)
+    {
+        if (mEntries[*indexIter].first == mre) { return *indexIter; }
+    }
+    return -1;
+}
+
+  } // end of Alias namespace
+} // end of OA namespace
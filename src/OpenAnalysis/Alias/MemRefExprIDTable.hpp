@@ -0,0 +1,73 @@
+/*! \file
+
+  \brief Declarations for a table that gives each distinct MemRefExpr
+         an int.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef MemRefExprIDTable_H
+#define MemRefExprIDTable_H
+
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/MemRefExpr/MemRefExpr.hpp>
+
+namespace OA {
+  namespace Alias {
+
+/*!
+   Maps MemRefExprs to ints as a std::map<OA_ptr<MemRefExpr>,int>
+   would, with equal MemRefExprs sharing one entry.  Ordering the
+   MemRefExprs compares them level by level on every step down the
+   map, so instead each one is hashed once from its structure and only
+   compared with the entries that have the same hash.
+
+   Entries are kept in the order they were added, which is the order
+   begin() to end() goes over them.  Adding an entry doesn't move the
+   others, so the references operator[] returns stay good.
+*/
+class MemRefExprIDTable {
+public:
+  typedef std::pair<OA_ptr<MemRefExpr>,int> Entry;
+  typedef std::deque<Entry>::iterator iterator;
+
+  MemRefExprIDTable() {}
+  ~MemRefExprIDTable() {}
+
+  //! the int of mre, added as 0 if mre isn't in the table yet
+  int& operator[](OA_ptr<MemRefExpr> mre);
+
+  //! the entry of mre, end() if there is none
+  iterator find(OA_ptr<MemRefExpr> mre);
+
+  iterator begin() { return mEntries.begin(); }
+  iterator end() { return mEntries.end(); }
+  int size() const { return mEntries.size(); }
+  void clear();
+
+private:
+  //! hash of the kinds, symbols, expressions, and deref counts that
+  //! MemRefExpr::operator== compares
+  static unsigned long hash(OA_ptr<MemRefExpr> mre);
+
+  //! index of the entry equal to mre among those with hash h, -1 if
+  //! there is none
+  int findIndex(OA_ptr<MemRefExpr> mre, unsigned long h);
+
+  std::deque<Entry> mEntries;
+  //! indexes into mEntries, by hash
+  std::map<unsigned long,std::vector<int> > mBuckets;
+};
+
+  } // end of Alias namespace
+} // end of OA namespace
+
+#endif
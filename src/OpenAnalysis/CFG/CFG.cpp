@@ -880,6 +880,95 @@ CFG::splitBlock (OA_ptr<Node> block, StmtHandle splitPoint)
   return newBlock;
 }
 
+/*!
+   \brief Append the statements of 'succ' to 'block' and remove 'succ'.
+
+   'succ' must be the only successor of 'block' and 'block' the only
+   predecessor of 'succ'.  The outgoing edges of 'succ' become outgoing
+   edges of 'block' and labels on 'succ' are moved to 'block'.
+*/
+void
+CFG::mergeBlocks (OA_ptr<Node> block, OA_ptr<Node> succ)
+{
+  assert(block->num_outgoing() == 1 && succ->num_incoming() == 1);
+  assert(!(block == succ));
+
+  // 1. Move the statements over
+  OA_ptr<NodeStatementsIteratorInterface> si
+      = succ->getNodeStatementsIterator();
+  for ( ; si->isValid(); ++(*si)) {
+    block->add(si->current());
+  }
+
+  // 2. Outgoing edges of 'succ' become outgoing edges of 'block',
+  // disconnecting 'succ' also removes the edge from 'block'
+  std::list<OA_ptr<EdgeInterface> > out_list;
+  OA_ptr<EdgesIteratorInterface> ei;
+  for (ei = succ->getCFGOutgoingEdgesIterator(); ei->isValid(); ++(*ei)) {
+    out_list.push_back(ei->currentCFGEdge());
+  }
+  OA_ptr<NodeInterface> succNode = succ;
+  disconnect(succNode);
+
+  std::list<OA_ptr<EdgeInterface> >::iterator oli;
+  for (oli = out_list.begin(); oli != out_list.end(); oli++) {
+    connect(block, (*oli)->getCFGSink(), (*oli)->getType(), 
+            (*oli)->getExpr());
+  }
+
+  // 3. Update label->block maps
+  remapLabels(succ, block);
+}
+
+/*!
+   \brief Remove the empty block 'block', redirecting its incoming
+          edges to its only successor.
+
+   Each incoming edge keeps its expression, and its type unless the
+   edge out of 'block' is a BACK_EDGE, so that an edge that closed a
+   loop through 'block' still does.  'block' must have
+   no statements, exactly one successor other than itself, and no
+   predecessor that already has an edge to that successor, since
+   edges between the same two nodes are not kept apart.
+*/
+void
+CFG::removeEmptyBlock (OA_ptr<Node> block)
+{
+  assert(block->empty() && block->num_outgoing() == 1);
+
+  OA_ptr<EdgesIteratorInterface> ei = block->getCFGOutgoingEdgesIterator();
+  OA_ptr<Node> succ = ei->currentCFGEdge()->getCFGSink().convert<Node>();
+  assert(!(succ == block));
+  bool backEdge = (ei->currentCFGEdge()->getType() == BACK_EDGE);
+
+  std::list<OA_ptr<EdgeInterface> > in_list;
+  for (ei = block->getCFGIncomingEdgesIterator(); ei->isValid(); ++(*ei)) {
+    in_list.push_back(ei->currentCFGEdge());
+  }
+  OA_ptr<NodeInterface> blockNode = block;
+  disconnect(blockNode);
+
+  std::list<OA_ptr<EdgeInterface> >::iterator ili;
+  for (ili = in_list.begin(); ili != in_list.end(); ili++) {
+    EdgeType type = backEdge ? BACK_EDGE : (*ili)->getType();
+    connect((*ili)->getCFGSource(), succ, type, (*ili)->getExpr());
+  }
+
+  remapLabels(block, succ);
+}
+
+//! Labels mapped to 'from' are mapped to 'to' instead
+void
+CFG::remapLabels (OA_ptr<Node> from, OA_ptr<Node> to)
+{
+  std::map<OA::StmtLabel, OA_ptr<Node> >::iterator mIter;
+  for (mIter = mlabel_to_node_map.begin(); 
+       mIter != mlabel_to_node_map.end(); mIter++) 
+  {
+    if (mIter->second.ptrEqual(from)) { mIter->second = to; }
+  }
+}
+
 //--------------------------------------------------------------------
 //! Connect the src to each of the nodes in dst_list.
 void
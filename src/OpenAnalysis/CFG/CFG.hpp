@@ -459,6 +459,9 @@ public:
       void setExit(OA_ptr<Node> n);
 
       OA_ptr<Node> splitBlock(OA_ptr<Node>, StmtHandle);
+      void mergeBlocks(OA_ptr<Node> block, OA_ptr<Node> succ);
+      void removeEmptyBlock(OA_ptr<Node> block);
+      void remapLabels(OA_ptr<Node> from, OA_ptr<Node> to);
 
       OA_ptr<Edge> connect(OA_ptr<NodeInterface> src,
                        OA_ptr<NodeInterface> dst,
@@ -0,0 +1,122 @@
+/*! \file
+
+  \brief Implementation of EachCFGConcurrent.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "EachCFGConcurrent.hpp"
+#include <algorithm>
+
+namespace OA {
+  namespace CFG {
+
+EachCFGConcurrent::EachCFGConcurrent(OA_ptr<CFGIRInterface> ir,
+                                     bool buildStmtLevelCFG,
+                                     unsigned int numThreads)
+    : mIR(ir), mBuildStmtLevelCFG(buildStmtLevelCFG),
+      mNumThreads(numThreads), mNodeBudget(0), mNumCachedNodes(0),
+      mNumBuilds(0)
+{
+}
+
+OA_ptr<CFG> EachCFGConcurrent::build(ProcHandle proc)
+{
+    ManagerCFGStandard cfgman(mIR, mBuildStmtLevelCFG);
+    return cfgman.performAnalysis(proc);
+}
+
+OA_ptr<CFG::CFGInterface> EachCFGConcurrent::getCFGResults(ProcHandle proc)
+{
+    OA_ptr<CFG> cfg;
+    {
+        MutexLock guard(mLock);
+
+        // asking for it again means the client wants it kept
+        mReleased.remove(proc);
+
+        while (mInProgress.find(proc) != mInProgress.end()) {
+            mBuildDone.wait(mLock);
+        }
+        std::map<ProcHandle,OA_ptr<CFG> >::iterator found
+            = mProcToCFGMap.find(proc);
+        if (found != mProcToCFGMap.end()) {
+            return found->second;
+        }
+        mInProgress.insert(proc);
+    }
+
+    // build without holding the lock so other procedures can proceed
+    cfg = build(proc);
+
+    MutexLock guard(mLock);
+    mProcToCFGMap[proc] = cfg;
+    mNumCachedNodes += cfg->getNumNodes();
+    mNumBuilds++;
+    mInProgress.erase(proc);
+    mBuildDone.broadcast();
+    evict();
+    return cfg;
+}
+
+void EachCFGConcurrent::prebuild(OA_ptr<IRProcIterator> procIter)
+{
+    ThreadPool pool(mNumThreads);
+    for (procIter->reset(); procIter->isValid(); ++(*procIter)) {
+        OA_ptr<ThreadTask> task;
+        task = new BuildTask(*this, procIter->current());
+        pool.add(task);
+    }
+    pool.wait();
+}
+
+void EachCFGConcurrent::setNodeBudget(int maxNodes)
+{
+    MutexLock guard(mLock);
+    mNodeBudget = maxNodes;
+    evict();
+}
+
+void EachCFGConcurrent::release(ProcHandle proc)
+{
+    MutexLock guard(mLock);
+    if (mProcToCFGMap.find(proc) == mProcToCFGMap.end()) {
+        return;
+    }
+    mReleased.remove(proc);
+    mReleased.push_back(proc);
+    evict();
+}
+
+int EachCFGConcurrent::getNumBuilds()
+{
+    MutexLock guard(mLock);
+    return mNumBuilds;
+}
+
+int EachCFGConcurrent::getNumCachedNodes()
+{
+    MutexLock guard(mLock);
+    return mNumCachedNodes;
+}
+
+void EachCFGConcurrent::evict()
+{
+    if (mNodeBudget <= 0) { return; }
+    while (mNumCachedNodes > mNodeBudget && !mReleased.empty()) {
+        ProcHandle victim = mReleased.front();
+        mReleased.pop_front();
+        std::map<ProcHandle,OA_ptr<CFG> >::iterator found
+            = mProcToCFGMap.find(victim);
+        if (found == mProcToCFGMap.end()) { continue; }
+        mNumCachedNodes -= found->second->getNumNodes();
+        mProcToCFGMap.erase(found);
+    }
+}
+
+  } // end of CFG namespace
+} // end of OA namespace
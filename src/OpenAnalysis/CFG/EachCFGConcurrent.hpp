@@ -0,0 +1,104 @@
+/*! \file
+
+  \brief Declarations for a procedure to CFG map that can be shared
+         between threads and built up front in parallel.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef EachCFGConcurrent_H
+#define EachCFGConcurrent_H
+
+#include <OpenAnalysis/CFG/ManagerCFG.hpp>
+#include <OpenAnalysis/CFG/EachCFGInterface.hpp>
+#include <OpenAnalysis/IRInterface/CFGIRInterface.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
+#include <map>
+#include <set>
+#include <list>
+
+namespace OA {
+  namespace CFG {
+
+/*!
+   Memoizing EachCFGInterface that can be queried from several threads
+   at once.  Each CFG is built at most once: a thread asking for a CFG
+   that another thread is building waits for that build instead of
+   starting its own.  Every build uses its own ManagerCFGStandard, since
+   the manager keeps per-procedure state while building.
+
+   prebuild() builds the CFGs for a set of procedures on a ThreadPool,
+   so that later getCFGResults calls are lookups.
+
+   With a node budget set, CFGs for procedures the client has release()d
+   are dropped, least recently released first, whenever the cached CFGs
+   hold more nodes than the budget.  A dropped CFG is rebuilt if it is
+   asked for again.  CFGs that were never released are never dropped,
+   so the budget can be exceeded.
+*/
+class EachCFGConcurrent : public virtual EachCFGInterface {
+  public:
+    //! numThreads is used by prebuild, 0 means ThreadPool's default
+    EachCFGConcurrent(OA_ptr<CFGIRInterface> ir,
+                      bool buildStmtLevelCFG = false,
+                      unsigned int numThreads = 0);
+    virtual ~EachCFGConcurrent() {}
+
+    //! Returns CFG results for the given procedure
+    OA_ptr<CFG::CFGInterface> getCFGResults(ProcHandle proc);
+
+    //! Builds the CFGs for all procedures in procIter, in parallel
+    void prebuild(OA_ptr<IRProcIterator> procIter);
+
+    //! Caps the number of CFG nodes kept for released procedures,
+    //! 0 (the default) means no cap
+    void setNodeBudget(int maxNodes);
+
+    //! The client no longer needs the CFG for proc, it may be dropped
+    //! to stay under the node budget
+    void release(ProcHandle proc);
+
+    //! number of CFGs built so far, including rebuilds
+    int getNumBuilds();
+
+    //! number of CFG nodes currently held
+    int getNumCachedNodes();
+
+  private:
+    OA_ptr<CFG> build(ProcHandle proc);
+
+    //! drops released CFGs until under budget, caller holds mLock
+    void evict();
+
+    class BuildTask : public virtual ThreadTask {
+      public:
+        BuildTask(EachCFGConcurrent& cache, ProcHandle proc)
+            : mCache(cache), mProc(proc) {}
+        void run() { mCache.getCFGResults(mProc); }
+      private:
+        EachCFGConcurrent& mCache;
+        ProcHandle mProc;
+    };
+
+    OA_ptr<CFGIRInterface> mIR;
+    bool mBuildStmtLevelCFG;
+    unsigned int mNumThreads;
+
+    Mutex mLock;
+    CondVar mBuildDone;
+    std::map<ProcHandle,OA_ptr<CFG> > mProcToCFGMap;
+    std::set<ProcHandle> mInProgress;
+    std::list<ProcHandle> mReleased;   // oldest release first
+    int mNodeBudget;
+    int mNumCachedNodes;
+    int mNumBuilds;
+};
+
+  } // end of CFG namespace
+} // end of OA namespace
+
+#endif
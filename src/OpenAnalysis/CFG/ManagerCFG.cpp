@@ -44,8 +44,10 @@ namespace OA {
 static bool debug = false;
 
   ManagerCFGStandard::ManagerCFGStandard (OA_ptr<CFGIRInterface> _ir,
-                                bool _build_stmt_level_cfg /* = false */ )
-        : mIR(_ir), mBuildStmtLevelCFG(_build_stmt_level_cfg)
+                                bool _build_stmt_level_cfg /* = false */,
+                                bool _compact_cfg /* = false */ )
+        : mIR(_ir), mBuildStmtLevelCFG(_build_stmt_level_cfg),
+          mCompactCFG(_compact_cfg)
         {
  
        
@@ -95,11 +97,128 @@ static bool debug = false;
     mCFG->connect(*return_nodes, final);
     // finalize control flow for unstructured constructs
     HandleDelayedBranches();
+    if (mCompactCFG) {
+      compact(mCFG);
+    }
     return mCFG;
 
   }
 
 
+  //--------------------------------------------------------------------
+  // CFG compaction
+  //--------------------------------------------------------------------
+
+  //! An empty block can be bypassed if it has one successor other than
+  //! itself and bypassing does not give a predecessor two edges to that
+  //! successor.
+  bool ManagerCFGStandard::is_removable_empty(OA_ptr<CFG> cfg, 
+                                              OA_ptr<Node> n)
+  {
+      if (!n->empty() || n->num_outgoing() != 1) { return false; }
+      if (n.ptrEqual(cfg->getEntry().convert<Node>()) 
+          || n.ptrEqual(cfg->getExit().convert<Node>())) 
+      { 
+          return false; 
+      }
+
+      OA_ptr<NodesIteratorInterface> succIter = n->getCFGSuccNodesIterator();
+      OA_ptr<NodeInterface> succ = succIter->currentCFGNode();
+      if (succ->getId() == n->getId()) { return false; }
+
+      std::set<unsigned int> preds;
+      OA_ptr<NodesIteratorInterface> predIter;
+      for (predIter = n->getCFGPredNodesIterator(); predIter->isValid();
+           ++(*predIter))
+      {
+          OA_ptr<NodeInterface> pred = predIter->currentCFGNode();
+          // a second edge from the same predecessor
+          if (!preds.insert(pred->getId()).second) { return false; }
+          OA_ptr<NodesIteratorInterface> sIter;
+          for (sIter = pred->getCFGSuccNodesIterator(); sIter->isValid();
+               ++(*sIter))
+          {
+              if (sIter->currentCFGNode()->getId() == succ->getId()) {
+                  return false;
+              }
+          }
+      }
+      return true;
+  }
+
+  //! A block can absorb its successor if it falls through to it and
+  //! is its only predecessor
+  bool ManagerCFGStandard::is_mergeable(OA_ptr<CFG> cfg, OA_ptr<Node> n)
+  {
+      if (n->num_outgoing() != 1) { return false; }
+      OA_ptr<EdgesIteratorInterface> edgeIter 
+          = n->getCFGOutgoingEdgesIterator();
+      OA_ptr<EdgeInterface> edge = edgeIter->currentCFGEdge();
+      if (edge->getType() != FALLTHROUGH_EDGE) { return false; }
+
+      OA_ptr<NodeInterface> succ = edge->getCFGSink();
+      if (succ->getId() == n->getId() || succ->num_incoming() != 1) {
+          return false;
+      }
+      if (n.ptrEqual(cfg->getEntry().convert<Node>()) 
+          || succ.ptrEqual(cfg->getExit())) 
+      {
+          return false;
+      }
+      return true;
+  }
+
+  int ManagerCFGStandard::compact(OA_ptr<CFG> cfg)
+  {
+      int numNodesBefore = cfg->getNumNodes();
+      int numEdgesBefore = cfg->getNumEdges();
+
+      // snapshot the nodes, the node set changes as blocks are removed
+      std::list<OA_ptr<Node> > nodes;
+      std::set<unsigned int> removed;
+      OA_ptr<NodesIteratorInterface> nodeIter;
+      for (nodeIter = cfg->getCFGNodesIterator(); nodeIter->isValid();
+           ++(*nodeIter))
+      {
+          nodes.push_back(nodeIter->currentCFGNode().convert<Node>());
+      }
+
+      // 1. bypass empty blocks
+      std::list<OA_ptr<Node> >::iterator nIter;
+      for (nIter = nodes.begin(); nIter != nodes.end(); nIter++) {
+          if (is_removable_empty(cfg, *nIter)) {
+              cfg->removeEmptyBlock(*nIter);
+              removed.insert((*nIter)->getId());
+          }
+      }
+
+      // 2. merge straight-line chains, a statement level CFG must keep
+      // one statement per block
+      if (!mBuildStmtLevelCFG) {
+          for (nIter = nodes.begin(); nIter != nodes.end(); nIter++) {
+              OA_ptr<Node> n = *nIter;
+              if (removed.find(n->getId()) != removed.end()) { continue; }
+              while (is_mergeable(cfg, n)) {
+                  OA_ptr<NodesIteratorInterface> succIter 
+                      = n->getCFGSuccNodesIterator();
+                  OA_ptr<Node> succ 
+                      = succIter->currentCFGNode().convert<Node>();
+                  cfg->mergeBlocks(n, succ);
+                  removed.insert(succ->getId());
+              }
+          }
+      }
+
+      if (debug) {
+          std::cout << "ManagerCFGStandard::compact: nodes "
+                    << numNodesBefore << " -> " << cfg->getNumNodes()
+                    << ", edges " << numEdgesBefore << " -> " 
+                    << cfg->getNumEdges() << std::endl;
+      }
+      return numNodesBefore - cfg->getNumNodes();
+  }
+
+
   //--------------------------------------------------------------------
   IRStmtType
   ManagerCFGStandard::build_block (OA_ptr<Node> prev_node,
@@ -49,13 +49,22 @@ class Worklist;
 */
 class ManagerCFGStandard { //??? eventually public OA::AnnotationManager
 public:
-  ManagerCFGStandard(OA_ptr<CFGIRInterface> _ir, bool _build_stmt_level_cfg = false);
+  ManagerCFGStandard(OA_ptr<CFGIRInterface> _ir, bool _build_stmt_level_cfg = false,
+                     bool _compact_cfg = false);
   virtual ~ManagerCFGStandard () { }
 
   //??? don't think this guy need AQM, but will eventually have
   //to have one so is standard with other AnnotationManagers
   virtual OA_ptr<CFG> performAnalysis(ProcHandle);
 
+  //! Simplify a built CFG: empty pass-through blocks are removed and,
+  //! unless building a statement level CFG, straight-line chains of
+  //! blocks are merged.  Statements keep their order within the
+  //! surviving blocks and labels are mapped to the surviving blocks.
+  //! Entry and exit blocks are kept.  Returns number of blocks removed.
+  //! Done by performAnalysis when constructed with _compact_cfg.
+  int compact(OA_ptr<CFG> cfg);
+
 
 
   //------------------------------------------------------------------
@@ -161,6 +170,12 @@ private:
   OA_ptr<CFG> mCFG;
 
 
+  //------------------------------------------
+  // helpers for compact
+  //------------------------------------------
+  bool is_removable_empty(OA_ptr<CFG> cfg, OA_ptr<Node> n);
+  bool is_mergeable(OA_ptr<CFG> cfg, OA_ptr<Node> n);
+
   //------------------------------------------
   // data structures for handling delay slots
   //------------------------------------------
@@ -170,6 +185,9 @@ private:
   // build a CFG for individual statements rather than basic blocks
   //---------------------------------------------------------------
   const bool mBuildStmtLevelCFG;
+
+  //! run compact on every CFG built
+  const bool mCompactCFG;
    };
 
   } // end of CFG namespace
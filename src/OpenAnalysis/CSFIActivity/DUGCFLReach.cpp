@@ -0,0 +1,504 @@
+/*! \file
+
+  \brief Implementation of CFLReach.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+*/
+
+#include <iostream>
+#include "DUGCFLReach.hpp"
+
+namespace OA {
+  namespace DUG {
+
+#if defined(DEBUG_ALL) || defined(DEBUG_DUGCFLReach)
+static bool debug = true;
+#else
+static bool debug = false;
+#endif
+
+// summaries for paths outside of any call, before and after the value
+// went through a global
+static const int STRICT_SUMMARY = 0;
+static const int GLOBAL_SUMMARY = 1;
+
+CFLReach::CFLReach(OA_ptr<DUGCompact> graph)
+    : mGraph(graph), mWriteResults(true), mForward(true), mNumSummaries(0),
+      mNumPathEdges(0)
+{
+    mDUG = mGraph->getDUG();
+}
+
+CFLReach::StepKind CFLReach::stepKind(int edge) const
+{
+    switch (mGraph->getType(edge)) {
+	case CALL_EDGE:
+	    return mForward ? ENTER_STEP : EXIT_STEP;
+	case RETURN_EDGE:
+	    return mForward ? EXIT_STEP : ENTER_STEP;
+	default:
+	    return FLOW_STEP;
+    }
+}
+
+bool CFLReach::canStep(int edge) const
+{
+    if (mForward) { return true; }
+
+    // walking back only goes to varied nodes, and only enters a callee
+    // by the RETURN edges that varied values came back by
+    if (!mGraph->getVaried().test(stepTo(edge))) { return false; }
+#ifdef CONTEXT_SENSITIVITY
+    if (mGraph->getType(edge) == RETURN_EDGE) {
+	int node = stepFrom(edge);
+	CallHandle call = mGraph->getCall(edge);
+	bool variedContext = mWriteResults
+	    ? mGraph->getNode(node)->isVariedContext(call)
+	    : (mVariedContexts.find(std::make_pair(node, call))
+	       != mVariedContexts.end());
+	if (!variedContext) { return false; }
+    }
+#endif
+    return true;
+}
+
+int CFLReach::numStepsOut(int node) const
+{
+    return mForward ? mGraph->outEnd(node) - mGraph->outBegin(node)
+	            : mGraph->inEnd(node) - mGraph->inBegin(node);
+}
+
+int CFLReach::stepOut(int node, int i) const
+{
+    return mForward ? mGraph->outBegin(node) + i
+	            : mGraph->inEdge(mGraph->inBegin(node) + i);
+}
+
+int CFLReach::numStepsIn(int node) const
+{
+    return mForward ? mGraph->inEnd(node) - mGraph->inBegin(node)
+	            : mGraph->outEnd(node) - mGraph->outBegin(node);
+}
+
+int CFLReach::stepIn(int node, int i) const
+{
+    return mForward ? mGraph->inEdge(mGraph->inBegin(node) + i)
+	            : mGraph->outBegin(node) + i;
+}
+
+int CFLReach::summaryFor(int node, ProcHandle proc)
+{
+    std::pair<int,ProcHandle> key(node, proc);
+    std::map<std::pair<int,ProcHandle>,int>::iterator found
+	= mSummaryIndex.find(key);
+    if (found != mSummaryIndex.end()) { return found->second; }
+
+    int summary = mPathEdges.size();
+    mSummaryIndex[key] = summary;
+    mPathEdges.push_back(std::set<std::pair<int,ProcHandle> >());
+    mExits.push_back(std::set<int>());
+    mCallers.push_back(std::set<std::pair<int,int> >());
+    mNumSummaries++;
+    return summary;
+}
+
+void CFLReach::propagate(int summary, int node, ProcHandle proc)
+{
+    if (!mPathEdges[summary].insert(std::make_pair(node, proc)).second) {
+	return;
+    }
+    mNumPathEdges++;
+    mReached[node] = true;
+    mWorklist.push_back(std::make_pair(summary, std::make_pair(node, proc)));
+}
+
+/*!
+   Tabulates the paths from the seeds one (summary, node, proc) at a
+   time.  proc is the procedure the recursive walk would think it is
+   in, which only differs from the proc of node for globals.
+*/
+void CFLReach::reach(const std::vector<int>& seeds)
+{
+    mSummaryIndex.clear();
+    mPathEdges.assign(2, std::set<std::pair<int,ProcHandle> >());
+    mExits.assign(2, std::set<int>());
+    mCallers.assign(2, std::set<std::pair<int,int> >());
+    mWorklist.clear();
+    mReached.assign(mGraph->getNumNodes(), false);
+    mTaken.assign(mGraph->getNumEdges(), false);
+    mSeeds.clear();
+    mNumSummaries = 0;
+    mNumPathEdges = 0;
+
+    std::vector<int>::const_iterator seedIter;
+    for (seedIter=seeds.begin(); seedIter!=seeds.end(); seedIter++) {
+	mSeeds.insert(*seedIter);
+	propagate(STRICT_SUMMARY, *seedIter, mGraph->getProc(*seedIter));
+    }
+
+    while (!mWorklist.empty()) {
+	int summary = mWorklist.front().first;
+	int node = mWorklist.front().second.first;
+	ProcHandle proc = mWorklist.front().second.second;
+	mWorklist.pop_front();
+
+	int numSteps = numStepsOut(node);
+	for (int i=0; i<numSteps; i++) {
+	    int k = stepOut(node, i);
+	    if (!canStep(k)) { continue; }
+	    int to = stepTo(k);
+	    switch (stepKind(k)) {
+		case FLOW_STEP:
+		{
+		    mTaken[k] = true;
+		    ProcHandle toProc = mGraph->getEdgeProc(k);
+		    propagate(proc == toProc ? summary : GLOBAL_SUMMARY,
+			      to, toProc);
+		    break;
+		}
+
+		case ENTER_STEP:
+		{
+		    mTaken[k] = true;
+		    ProcHandle calleeProc = mGraph->getProc(to);
+		    int callee = summaryFor(to, calleeProc);
+		    propagate(callee, to, calleeProc);
+
+		    int returnTo = (proc == mGraph->getProc(node))
+			? summary : GLOBAL_SUMMARY;
+		    if (!mCallers[callee].insert(std::make_pair(returnTo, k)).second) {
+			break;
+		    }
+		    // reuse what the callee was already found to reach
+		    std::set<int>::iterator exitIter;
+		    for (exitIter=mExits[callee].begin();
+			 exitIter!=mExits[callee].end(); exitIter++)
+		    {
+			int exit = *exitIter;
+			if (mGraph->getCall(exit) != mGraph->getCall(k)) { continue; }
+			mTaken[exit] = true;
+			propagate(returnTo, stepTo(exit), mGraph->getEdgeProc(exit));
+		    }
+		    break;
+		}
+
+		case EXIT_STEP:
+		    if (summary == GLOBAL_SUMMARY) {
+			mTaken[k] = true;
+			propagate(GLOBAL_SUMMARY, to, mGraph->getEdgeProc(k));
+		    } else if (summary != STRICT_SUMMARY) {
+			if (!mExits[summary].insert(k).second) { break; }
+			std::set<std::pair<int,int> >::iterator callerIter;
+			for (callerIter=mCallers[summary].begin();
+			     callerIter!=mCallers[summary].end(); callerIter++)
+			{
+			    if (mGraph->getCall(callerIter->second)
+				!= mGraph->getCall(k))
+			    {
+				continue;
+			    }
+			    mTaken[k] = true;
+			    propagate(callerIter->first, to, mGraph->getEdgeProc(k));
+			}
+		    }
+		    break;
+	    }
+	}
+    }
+
+    if (debug) {
+	std::cout << "CFLReach: " << mNumSummaries << " summaries, "
+		  << mNumPathEdges << " path edges" << std::endl;
+    }
+}
+
+/*!
+   The recursive walk sees a formal as self dependent when a CFLOW edge
+   leads back to it while it is still on the path.  Here that is a
+   CFLOW edge into the formal from a node in the same strongly
+   connected component of the steps that were taken.
+*/
+void CFLReach::findSelfDependent()
+{
+    SparseBitVector& selfDependent = mGraph->getSelfDependent();
+    int numNodes = mGraph->getNumNodes();
+    std::vector<int> index(numNodes, -1), low(numNodes, 0), component(numNodes, -1);
+    std::vector<bool> onStack(numNodes, false);
+    std::vector<int> stack;
+    std::vector<std::pair<int,int> > dfs;
+    int counter = 0;
+    int numComponents = 0;
+
+    for (int root=0; root<numNodes; root++) {
+	if (!mReached[root] || index[root] != -1) { continue; }
+	dfs.push_back(std::make_pair(root, 0));
+	while (!dfs.empty()) {
+	    int node = dfs.back().first;
+	    int next = dfs.back().second;
+	    if (next == 0) {
+		index[node] = low[node] = counter++;
+		stack.push_back(node);
+		onStack[node] = true;
+	    }
+	    if (next < numStepsOut(node)) {
+		dfs.back().second++;
+		int k = stepOut(node, next);
+		int succ = stepTo(k);
+		if (!mTaken[k]) { continue; }
+		if (index[succ] == -1) {
+		    dfs.push_back(std::make_pair(succ, 0));
+		} else if (onStack[succ] && index[succ] < low[node]) {
+		    low[node] = index[succ];
+		}
+		continue;
+	    }
+	    dfs.pop_back();
+	    if (!dfs.empty() && low[node] < low[dfs.back().first]) {
+		low[dfs.back().first] = low[node];
+	    }
+	    if (low[node] == index[node]) {
+		int member;
+		do {
+		    member = stack.back();
+		    stack.pop_back();
+		    onStack[member] = false;
+		    component[member] = numComponents;
+		} while (member != node);
+		numComponents++;
+	    }
+	}
+    }
+
+    std::list<int> worklist;
+    for (int node=0; node<numNodes; node++) {
+	if (!mReached[node]) { continue; }
+	if (mGraph->isFormalParam(node)) {
+	    int numSteps = numStepsIn(node);
+	    for (int i=0; i<numSteps; i++) {
+		int k = stepIn(node, i);
+		if (mTaken[k] && mGraph->getType(k) == CFLOW_EDGE
+		    && component[stepFrom(k)] == component[node])
+		{
+		    selfDependent.set(node);
+		    break;
+		}
+	    }
+	}
+	if (selfDependent.test(node)) { worklist.push_back(node); }
+    }
+
+    // actuals passed to a self dependent formal are self dependent in
+    // the context of that call
+    while (!worklist.empty()) {
+	int node = worklist.front();
+	worklist.pop_front();
+	int numSteps = numStepsIn(node);
+	for (int i=0; i<numSteps; i++) {
+	    int k = stepIn(node, i);
+	    if (!mTaken[k] || mGraph->getType(k) != CALL_EDGE) { continue; }
+	    int actual = stepFrom(k);
+	    insertVariedContext(actual, mGraph->getCall(k));
+	    if (selfDependent.set(actual)) {
+		worklist.push_back(actual);
+	    }
+	}
+    }
+}
+
+void CFLReach::insertVariedContext(int node, CallHandle call)
+{
+    if (mWriteResults) {
+	mGraph->getNode(node)->insertVariedContext(call);
+    } else {
+	mVariedContexts.insert(std::make_pair(node, call));
+    }
+}
+
+/*!
+   An actual or formal that was only reached through CALL edges and
+   whose only successors are RETURN edges back to where it was reached
+   from just passes the value back.
+*/
+bool CFLReach::unsetsVaried(int node)
+{
+    OA_ptr<Node> n = mGraph->getNode(node);
+    if (mSeeds.find(node) != mSeeds.end()
+	|| mGraph->getSelfDependent().test(node)
+	|| mDUG->isDependent(n->getProc(), n->getSym()))
+    {
+	return false;
+    }
+
+    std::set<int> parents;
+    for (int i=mGraph->inBegin(node); i<mGraph->inEnd(node); i++) {
+	int edge = mGraph->inEdge(i);
+	if (mGraph->getType(edge) != CALL_EDGE) {
+	    if (mReached[mGraph->getSource(edge)]) { return false; }
+	} else if (mTaken[edge]) {
+	    parents.insert(mGraph->getSource(edge));
+	}
+    }
+    if (parents.empty()) { return false; }
+
+    for (int edge=mGraph->outBegin(node); edge<mGraph->outEnd(node); edge++) {
+	if (mGraph->getType(edge) != RETURN_EDGE || parents.size() > 1
+	    || parents.find(mGraph->getSink(edge)) == parents.end())
+	{
+	    return false;
+	}
+    }
+    return true;
+}
+
+void CFLReach::markVaried(bool activeWithVariedOnly)
+{
+    mForward = true;
+
+    std::vector<int> seeds;
+    std::list<std::pair<SymHandle, ProcHandle> >& indepSyms
+	= mDUG->getIndepSyms();
+    std::list<std::pair<SymHandle, ProcHandle> >::iterator indepIter;
+    for (indepIter=indepSyms.begin(); indepIter!=indepSyms.end(); indepIter++) {
+	int node = mGraph->findNode(indepIter->first, indepIter->second);
+	if (node >= 0) { seeds.push_back(node); }
+    }
+    reach(seeds);
+
+#ifdef CONTEXT_SENSITIVITY
+    // values that came back from a call vary in the context of that call
+    int numEdges = mGraph->getNumEdges();
+    for (int edge=0; edge<numEdges; edge++) {
+	if (mTaken[edge] && mGraph->getType(edge) == RETURN_EDGE) {
+	    insertVariedContext(mGraph->getSink(edge), mGraph->getCall(edge));
+	}
+    }
+#endif
+    findSelfDependent();
+
+    SparseBitVector& varied = mGraph->getVaried();
+    int numNodes = mGraph->getNumNodes();
+    for (int node=0; node<numNodes; node++) {
+	if (mReached[node] && !unsetsVaried(node)) { varied.set(node); }
+    }
+    if (activeWithVariedOnly) {
+	for (int node=0; node<numNodes; node++) {
+	    if (mReached[node]) { mActive.set(node); }
+	}
+    }
+    if (!mWriteResults) { return; }
+
+    mGraph->writeFlags();
+    for (SparseBitVectorIterator activeIter(mActive); activeIter.isValid();
+	 ++activeIter)
+    {
+	mGraph->getNode(activeIter.current())->setActive();
+    }
+}
+
+/*!
+   Mirrors the checks Node::markUseful makes after walking back from
+   node, for the step arrival into it.
+*/
+bool CFLReach::skipsUseful(int node, int arrival)
+{
+    if (arrival < 0) { return false; }
+    EdgeType type = mGraph->getType(arrival);
+    if (type != CALL_EDGE && type != RETURN_EDGE) {
+	return false;
+    }
+    OA_ptr<Node> n = mGraph->getNode(node);
+    if (mGraph->getSelfDependent().test(node)
+	|| mDUG->isIndependent(n->getProc(), n->getSym()))
+    {
+	return false;
+    }
+
+    // every predecessor is the node walked back from, by the same call
+    for (int i=mGraph->inBegin(node); i<mGraph->inEnd(node); i++) {
+	int edge = mGraph->inEdge(i);
+	if (mGraph->getSource(edge) != stepFrom(arrival)
+	    || mGraph->getCall(edge) != mGraph->getCall(arrival))
+	{
+	    return false;
+	}
+    }
+    return true;
+}
+
+void CFLReach::markUseful()
+{
+    mForward = false;
+    SparseBitVector& varied = mGraph->getVaried();
+    SparseBitVector& useful = mGraph->getUseful();
+
+    std::vector<int> seeds;
+    std::list<std::pair<SymHandle, ProcHandle> >& depSyms = mDUG->getDepSyms();
+    std::list<std::pair<SymHandle, ProcHandle> >::iterator depIter;
+    for (depIter=depSyms.begin(); depIter!=depSyms.end(); depIter++) {
+	int node = mGraph->findNode(depIter->first, depIter->second);
+	if (node >= 0 && varied.test(node)) { seeds.push_back(node); }
+    }
+    reach(seeds);
+
+    SparseBitVector active;
+    int numNodes = mGraph->getNumNodes();
+    for (int node=0; node<numNodes; node++) {
+	if (!mReached[node]) { continue; }
+	useful.set(node);
+
+	bool nonCallPredEdge = false;
+	for (int i=mGraph->inBegin(node); i<mGraph->inEnd(node); i++) {
+	    if (mGraph->getType(mGraph->inEdge(i)) != CALL_EDGE) {
+		nonCallPredEdge = true;
+	    }
+	}
+	bool nonReturnSuccEdge = false;
+	for (int edge=mGraph->outBegin(node); edge<mGraph->outEnd(node); edge++) {
+	    if (mGraph->getType(edge) != RETURN_EDGE) { nonReturnSuccEdge = true; }
+	}
+
+	// the recursive walk activates node after the first step into it
+	// that it does not skip, or after a second step if the first one
+	// left it useful
+	int numArrivals = 0;
+	bool notSkipped = false;
+	if (mSeeds.find(node) != mSeeds.end()) {
+	    numArrivals++;
+	    notSkipped = true;
+	}
+	int numSteps = numStepsIn(node);
+	for (int i=0; i<numSteps; i++) {
+	    int k = stepIn(node, i);
+	    if (!mTaken[k]) { continue; }
+	    numArrivals++;
+	    if (!skipsUseful(node, k)) { notSkipped = true; }
+	}
+
+	if (notSkipped || (numArrivals > 1 && nonReturnSuccEdge)) {
+	    if (nonCallPredEdge || mGraph->getSelfDependent().test(node)
+		|| nonReturnSuccEdge)
+	    {
+		active.set(node);
+	    }
+	} else if (!nonReturnSuccEdge) {
+	    useful.reset(node);
+	}
+    }
+    mActive.unionWith(active);
+    if (!mWriteResults) { return; }
+
+    mGraph->writeFlags();
+    for (SparseBitVectorIterator activeIter(active); activeIter.isValid();
+	 ++activeIter)
+    {
+	mGraph->getNode(activeIter.current())->setActive();
+    }
+}
+
+  } // end of namespace DUG
+} // end of namespace OA
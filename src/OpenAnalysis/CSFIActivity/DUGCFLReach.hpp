@@ -0,0 +1,154 @@
+/*! \file
+
+  \brief Declarations for marking a DUG varied and useful with
+         summaries of matched call/return paths.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+*/
+
+#ifndef DUGCFLReach_H
+#define DUGCFLReach_H
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/CSFIActivity/DUGCompact.hpp>
+
+namespace OA {
+  namespace DUG {
+
+/*!
+   Marks the same nodes of a DUGStandard varied, useful, and active as
+   Node::markVaried and Node::markUseful, without walking each callee
+   again for every call stack that reaches it.  The marking walks the
+   arrays of a DUGCompact and sets its bit vectors, which are copied
+   to the DUG nodes at the end.
+
+   Both markings look for paths on which CALL and RETURN edges with the
+   same CallHandle match like parentheses (CFL-reachability, Reps,
+   Horwitz, and Sagiv, POPL 1995).  The first time a callee node is
+   entered through a CALL edge, everything it reaches without leaving
+   the callee, and the RETURN edges it leaves by, are recorded for it.
+   Every other CALL edge into that node reuses the record.  markUseful
+   does the same over the reversed graph, where RETURN edges enter a
+   callee and CALL edges leave it.
+
+   As in the recursive walk, following a CFLOW or PARAM edge of another
+   procedure means the value went through a global.  From then on
+   RETURN edges may be followed without a matching CALL.
+
+   The recursive walk only follows each edge once, so on some graphs it
+   misses nodes that a matched path reaches.  This marks those as well,
+   so its results are a superset of the walk's and not the same.  With
+   setWriteResults(false) nothing is written to the DUG, and the nodes
+   are only marked in the DUGCompact bit vectors and getActive(), which
+   is how ManagerDUActive checks one marking against the other.
+*/
+class CFLReach {
+public:
+    CFLReach(OA_ptr<DUGCompact> graph);
+    ~CFLReach() {}
+
+    //! marks the nodes reachable from the independent variables varied
+    void markVaried(bool activeWithVariedOnly);
+
+    //! marks the varied nodes that reach the dependent variables useful,
+    //! markVaried must have been called first
+    void markUseful();
+
+    //! whether the markings copy their results to the DUG nodes,
+    //! true by default
+    void setWriteResults(bool write) { mWriteResults = write; }
+
+    //! nodes the markings made active
+    SparseBitVector& getActive() { return mActive; }
+
+    //---------------------------------
+    // statistics of the last marking
+    //---------------------------------
+    //! callee nodes whose paths were summarized
+    int getNumSummaries() { return mNumSummaries; }
+    //! (summary, node) pairs that were explored
+    int getNumPathEdges() { return mNumPathEdges; }
+
+private:
+    enum StepKind { FLOW_STEP, ENTER_STEP, EXIT_STEP };
+
+    // an edge of the graph seen in the direction of the current
+    // marking, entering a callee goes to the proc of stepTo and the
+    // other steps go to the proc of the edge
+    int stepFrom(int edge) const
+	{ return mForward ? mGraph->getSource(edge) : mGraph->getSink(edge); }
+    int stepTo(int edge) const
+	{ return mForward ? mGraph->getSink(edge) : mGraph->getSource(edge); }
+    StepKind stepKind(int edge) const;
+    //! whether the current marking may take the step at all
+    bool canStep(int edge) const;
+    //! steps out of node are stepOut(node, 0..numStepsOut(node)-1)
+    int numStepsOut(int node) const;
+    int stepOut(int node, int i) const;
+    int numStepsIn(int node) const;
+    int stepIn(int node, int i) const;
+
+    //! finds the nodes the seeds reach, marking the steps used
+    void reach(const std::vector<int>& seeds);
+    void propagate(int summary, int node, ProcHandle proc);
+    //! summary for paths starting at node within proc
+    int summaryFor(int node, ProcHandle proc);
+
+    //! formals on a cycle of the varied part of the graph are self
+    //! dependent, as are the actuals passed to self dependent formals
+    void findSelfDependent();
+
+    //! node is varied in the context of call
+    void insertVariedContext(int node, CallHandle call);
+
+    //! what the recursive walk unsets after it returns from node
+    bool unsetsVaried(int node);
+
+    //! whether the recursive walk leaves node alone after the step
+    //! into it, -1 for the dependent variable itself
+    bool skipsUseful(int node, int arrival);
+
+private:
+    OA_ptr<DUGCompact> mGraph;
+    OA_ptr<DUGStandard> mDUG;
+
+    bool mWriteResults;
+    SparseBitVector mActive;
+    //! varied contexts of the nodes when they aren't written
+    std::set<std::pair<int,CallHandle> > mVariedContexts;
+
+    bool mForward;
+    //! steps the last marking took, by edge
+    std::vector<bool> mTaken;
+
+    // state of reach, summaries 0 and 1 are paths outside any call
+    // without and with values that went through globals
+    std::map<std::pair<int,ProcHandle>,int> mSummaryIndex;
+    std::vector<std::set<std::pair<int,ProcHandle> > > mPathEdges;
+    //! exit steps reached by each summary
+    std::vector<std::set<int> > mExits;
+    //! summary each enter step returns to, by the summary it enters
+    std::vector<std::set<std::pair<int,int> > > mCallers;
+    std::list<std::pair<int,std::pair<int,ProcHandle> > > mWorklist;
+    std::vector<bool> mReached;
+    std::set<int> mSeeds;
+
+    int mNumSummaries;
+    int mNumPathEdges;
+};
+
+  } // end of DUG namespace
+} // end of OA namespace
+
+#endif
@@ -0,0 +1,143 @@
+/*! \file
+
+  \brief Implementation of DUGCompact.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+*/
+
+#include <algorithm>
+#include <map>
+#include "DUGCompact.hpp"
+
+namespace OA {
+  namespace DUG {
+
+DUGCompact::DUGCompact(OA_ptr<DUGStandard> dug) : mDUG(dug)
+{
+    // the DGraph ids are numbered across every graph, so they are only
+    // mapped to node numbers while the edges are placed
+    std::map<unsigned int,int> nodeOfId;
+    OA_ptr<NodesIteratorInterface> nodeIter = mDUG->getDUGNodesIterator();
+    for ( ; nodeIter->isValid(); ++(*nodeIter)) {
+	OA_ptr<Node> node = nodeIter->currentDUGNode().convert<Node>();
+	int number = mNodes.size();
+	nodeOfId[node->getId()] = number;
+	mNodeOfSym.push_back(std::pair<SymHandle,int>(node->getSym(), number));
+	mNodes.push_back(node);
+	mProcs.push_back(node->getProc());
+	if (node->isFormalParamNode()) { mFormalParam.set(number); }
+	if (node->isVaried()) { mVaried.set(number); }
+	if (node->isUseful()) { mUseful.set(number); }
+	if (node->isSelfDependent()) { mSelfDependent.set(number); }
+    }
+    std::sort(mNodeOfSym.begin(), mNodeOfSym.end());
+    int numNodes = mNodes.size();
+
+    // count the edges out of and into each node, then place them
+    std::vector<OA_ptr<EdgeInterface> > edges;
+    std::vector<std::pair<int,int> > ends;
+    mOutStart.assign(numNodes+1, 0);
+    mInStart.assign(numNodes+1, 0);
+    OA_ptr<EdgesIteratorInterface> edgeIter = mDUG->getDUGEdgesIterator();
+    for ( ; edgeIter->isValid(); ++(*edgeIter)) {
+	OA_ptr<EdgeInterface> edge = edgeIter->currentDUGEdge();
+	int source = nodeOfId[edge->getDUGSource()->getId()];
+	int sink = nodeOfId[edge->getDUGSink()->getId()];
+	mOutStart[source+1]++;
+	mInStart[sink+1]++;
+	edges.push_back(edge);
+	ends.push_back(std::pair<int,int>(source, sink));
+    }
+    for (int node=0; node<numNodes; node++) {
+	mOutStart[node+1] += mOutStart[node];
+	mInStart[node+1] += mInStart[node];
+    }
+
+    int numEdges = edges.size();
+    mSources.resize(numEdges);
+    mSinks.resize(numEdges);
+    mTypes.resize(numEdges);
+    mCalls.resize(numEdges);
+    mEdgeProcs.resize(numEdges);
+    mInEdges.resize(numEdges);
+    std::vector<int> nextOut(mOutStart.begin(), mOutStart.end()-1);
+    std::vector<int> nextIn(mInStart.begin(), mInStart.end()-1);
+    for (int e=0; e<numEdges; e++) {
+	OA_ptr<EdgeInterface> edge = edges[e];
+	int source = ends[e].first;
+	int sink = ends[e].second;
+	int id = nextOut[source]++;
+	mSources[id] = source;
+	mSinks[id] = sink;
+	mTypes[id] = edge->getType();
+	mCalls[id] = edge->getCall();
+	mEdgeProcs[id] = edge->getProc();
+	mInEdges[nextIn[sink]++] = id;
+    }
+}
+
+/*!
+   A symbol without a node of its own has the node of the first
+   symbol its location fully overlaps that has one.
+*/
+int DUGCompact::findNode(SymHandle sym, ProcHandle proc)
+{
+    int node = findSymNode(sym);
+    if (node >= 0) { return node; }
+
+    OA_ptr<Location> loc = mDUG->mIR->getLocation(proc, sym);
+    if (loc.ptrEqual(0)) { return -1; }
+    OA_ptr<NamedLoc> nloc = loc.convert<NamedLoc>();
+    OA_ptr<SymHandleIterator> symIter = nloc->getFullOverlapIter();
+    for ( ; symIter->isValid(); (*symIter)++) {
+	node = findSymNode(symIter->current());
+	if (node >= 0) { return node; }
+    }
+    return -1;
+}
+
+int DUGCompact::findSymNode(SymHandle sym) const
+{
+    std::vector<std::pair<SymHandle,int> >::const_iterator found
+	= std::lower_bound(mNodeOfSym.begin(), mNodeOfSym.end(),
+			   std::pair<SymHandle,int>(sym, -1));
+    if (found == mNodeOfSym.end() || found->first != sym) { return -1; }
+    return found->second;
+}
+
+void DUGCompact::writeFlags()
+{
+    int numNodes = mNodes.size();
+    for (int node=0; node<numNodes; node++) {
+	if (mVaried.test(node)) {
+	    mNodes[node]->setVaried();
+	} else {
+	    mNodes[node]->unsetVaried();
+	}
+	if (mUseful.test(node)) {
+	    mNodes[node]->setUseful();
+	} else {
+	    mNodes[node]->unsetUseful();
+	}
+	if (mSelfDependent.test(node)) {
+	    mNodes[node]->setSelfDependent();
+	}
+    }
+}
+
+unsigned int DUGCompact::getSizeInBytes() const
+{
+    return mNodes.size() * (sizeof(OA_ptr<Node>) + sizeof(ProcHandle))
+	+ mNodeOfSym.size() * sizeof(std::pair<SymHandle,int>)
+	+ (mOutStart.size() + mInStart.size()) * sizeof(int)
+	+ mSinks.size() * (3*sizeof(int) + sizeof(unsigned char)
+			   + sizeof(CallHandle) + sizeof(ProcHandle));
+}
+
+  } // end of namespace DUG
+} // end of namespace OA
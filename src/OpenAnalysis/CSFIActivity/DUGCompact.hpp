@@ -0,0 +1,125 @@
+/*! \file
+
+  \brief Declarations for a frozen copy of a DUG in flat arrays.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+*/
+
+#ifndef DUGCompact_H
+#define DUGCompact_H
+
+#include <utility>
+#include <vector>
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/Utils/SparseBitVector.hpp>
+#include <OpenAnalysis/CSFIActivity/DUGStandard.hpp>
+
+namespace OA {
+  namespace DUG {
+
+/*!
+   The nodes and edges of a DUGStandard once it has been built, so
+   that marking it does not go through OA_ptrs and newly allocated
+   iterators for every edge.
+
+   Nodes are numbered 0 to getNumNodes()-1 in the order the DUG
+   iterates over them, whatever their DGraph ids are.  Edges are numbered so the
+   edges out of a node are consecutive (compressed sparse rows), with
+   the ids of the edges into each node in a second array.  The type,
+   call, and proc of each edge are kept in arrays indexed by edge id.
+
+   The varied, useful, and self dependent flags are kept as bit
+   vectors over the node numbers.  They start out as the flags of the
+   DUG nodes, and writeFlags copies them back.
+
+   The DUG must not change after this has been built.
+*/
+class DUGCompact {
+public:
+    DUGCompact(OA_ptr<DUGStandard> dug);
+    ~DUGCompact() {}
+
+    OA_ptr<DUGStandard> getDUG() const { return mDUG; }
+
+    //-------------------------------------
+    // nodes
+    //-------------------------------------
+    int getNumNodes() const { return mNodes.size(); }
+    OA_ptr<Node> getNode(int node) const { return mNodes[node]; }
+    ProcHandle getProc(int node) const { return mProcs[node]; }
+    bool isFormalParam(int node) const { return mFormalParam.test(node); }
+    //! number of the DUG node sym has in proc, -1 if there is none,
+    //! found as DUGStandard::isNode does without adding to the DUG
+    int findNode(SymHandle sym, ProcHandle proc);
+
+    //-------------------------------------
+    // edges
+    //-------------------------------------
+    int getNumEdges() const { return mSinks.size(); }
+    //! edges out of node are outBegin(node) to outEnd(node)-1
+    int outBegin(int node) const { return mOutStart[node]; }
+    int outEnd(int node) const { return mOutStart[node+1]; }
+    //! ids of the edges into node are inEdge(inBegin(node)) to
+    //! inEdge(inEnd(node)-1)
+    int inBegin(int node) const { return mInStart[node]; }
+    int inEnd(int node) const { return mInStart[node+1]; }
+    int inEdge(int i) const { return mInEdges[i]; }
+
+    int getSource(int edge) const { return mSources[edge]; }
+    int getSink(int edge) const { return mSinks[edge]; }
+    EdgeType getType(int edge) const { return (EdgeType)mTypes[edge]; }
+    CallHandle getCall(int edge) const { return mCalls[edge]; }
+    //! proc the edge is used in
+    ProcHandle getEdgeProc(int edge) const { return mEdgeProcs[edge]; }
+
+    //-------------------------------------
+    // flags
+    //-------------------------------------
+    SparseBitVector& getVaried() { return mVaried; }
+    SparseBitVector& getUseful() { return mUseful; }
+    SparseBitVector& getSelfDependent() { return mSelfDependent; }
+
+    //! sets the flags of the DUG nodes from the bit vectors
+    void writeFlags();
+
+    //! bytes used by the node and edge arrays, for comparing with
+    //! the DUG
+    unsigned int getSizeInBytes() const;
+
+private:
+    //! number of the node of sym itself, -1 if it has none
+    int findSymNode(SymHandle sym) const;
+
+    OA_ptr<DUGStandard> mDUG;
+
+    std::vector<OA_ptr<Node> > mNodes;
+    std::vector<ProcHandle> mProcs;
+    //! (symbol, node number) of each node, sorted by symbol
+    std::vector<std::pair<SymHandle,int> > mNodeOfSym;
+    SparseBitVector mFormalParam;
+
+    std::vector<int> mOutStart;
+    std::vector<int> mInStart;
+    std::vector<int> mInEdges;
+    std::vector<int> mSources;
+    std::vector<int> mSinks;
+    std::vector<unsigned char> mTypes;
+    std::vector<CallHandle> mCalls;
+    std::vector<ProcHandle> mEdgeProcs;
+
+    SparseBitVector mVaried;
+    SparseBitVector mUseful;
+    SparseBitVector mSelfDependent;
+};
+
+  } // end of DUG namespace
+} // end of OA namespace
+
+#endif
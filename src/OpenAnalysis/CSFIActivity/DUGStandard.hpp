@@ -375,6 +375,7 @@ class DUGStandard : public virtual DUGInterface
 public:
 
     friend class Node;  
+    friend class DUGCompact;
     
     DUGStandard (
 	OA_ptr<DUGIRInterface>,
@@ -30,15 +30,59 @@ static bool debug = false;
 ManagerDUActive::ManagerDUActive(
     OA_ptr<Activity::ActivityIRInterface> _ir,
     OA_ptr<OA::DUG::DUGStandard> _dug)
-    : mIR(_ir), mDUG(_dug)
+    : mIR(_ir), mDUG(_dug), mEngine(DFS_MARKING), mCheck(false)
 {    
 }
 
+void
+ManagerDUActive::makeReach()
+{
+    mGraph = new DUG::DUGCompact(mDUG);
+    mReach = new DUG::CFLReach(mGraph);
+    mReach->setWriteResults(!mCheck);
+}
+
+/*!
+   The walks leave no active flag on the nodes, so a node mReach made
+   active is only checked to have an active symbol.
+ */
+void
+ManagerDUActive::checkMarking(bool useful)
+{
+    SparseBitVector& marked
+	= useful ? mGraph->getUseful() : mGraph->getVaried();
+    SparseBitVector& active = mReach->getActive();
+    int numNodes = mGraph->getNumNodes();
+    for (int i=0; i<numNodes; i++) {
+	OA_ptr<DUG::Node> node = mGraph->getNode(i);
+	bool walked = useful ? node->isUseful() : node->isVaried();
+	bool summarized = marked.test(i);
+	bool activeSym = !active.test(i) || mDUG->isActive(node->getSym());
+	if (walked == summarized && activeSym) { continue; }
+
+	mDiffering.set(i);
+	if (debug) {
+	    std::cout << "ManagerDUActive::checkMarking: "
+		      << mIR->toString(node->getSym())
+		      << (useful ? " useful" : " varied")
+		      << " by summaries/walk: " << summarized << "/" << walked
+		      << (activeSym ? "" : ", active only by summaries")
+		      << std::endl;
+	}
+    }
+}
+
 /*!
  */
 void
 ManagerDUActive::markVaried(bool activeWithVariedOnly)
 {
+    if (mEngine == SUMMARY_MARKING) {
+	makeReach();
+	mReach->markVaried(activeWithVariedOnly);
+	if (!mCheck) { return; }
+    }
+
     std::list<CallHandle> callStack;
     std::set<OA_ptr<DUG::EdgeInterface> > visited;
     std::set<std::pair<unsigned,unsigned> > onPath;
@@ -69,7 +113,10 @@ ManagerDUActive::markVaried(bool activeWithVariedOnly)
 	    onPath.erase(pathNode);
 	}
     }
-  
+
+    if (mEngine == SUMMARY_MARKING) {
+	checkMarking(false);
+    }
 }
 
 /*!
@@ -77,6 +124,12 @@ ManagerDUActive::markVaried(bool activeWithVariedOnly)
 void
 ManagerDUActive::markUseful()
 {
+    if (mEngine == SUMMARY_MARKING) {
+	if (mReach.ptrEqual(0)) { makeReach(); }
+	mReach->markUseful();
+	if (!mCheck) { return; }
+    }
+
     std::list<CallHandle> callStack;
     std::set<OA_ptr<DUG::EdgeInterface> > visited;
     std::set<std::pair<unsigned,unsigned> > onPath;
@@ -110,6 +163,10 @@ ManagerDUActive::markUseful()
 	    onPath.erase(pathNode);
 	}
     }
+
+    if (mEngine == SUMMARY_MARKING) {
+	checkMarking(true);
+    }
 }
 
 /*!
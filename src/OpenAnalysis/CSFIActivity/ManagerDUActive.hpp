@@ -21,6 +21,7 @@
 // OpenAnalysis headers
 #include <OpenAnalysis/Utils/OA_ptr.hpp>
 #include <OpenAnalysis/CSFIActivity/DUGStandard.hpp>
+#include <OpenAnalysis/CSFIActivity/DUGCFLReach.hpp>
 #include <OpenAnalysis/Activity/InterActiveFortran.hpp>
 #include <OpenAnalysis/IRInterface/ActivityIRInterface.hpp>
 
@@ -35,9 +36,24 @@ namespace OA {
 
 /*! 
   Generates InterActiveFortran.
+
+  By default the DUG is marked by the recursive walks in DUG::Node,
+  which go through a callee again for each call stack that reaches it.
+  SUMMARY_MARKING uses DUG::CFLReach instead, which summarizes each
+  callee once and walks a DUG::DUGCompact copy of the DUG.  It also
+  marks the nodes a matched call/return path reaches that the walks
+  miss, so it can make more symbols active, never fewer; it is only
+  used when asked for.
+
+  With setCheckMarking(true), SUMMARY_MARKING marks the DUG with the
+  walks as DFS_MARKING does, and runs DUG::CFLReach next to them
+  without writing its results.  The nodes the two mark differently are
+  counted, and printed with DEBUG_ManagerDUActive.
 */
 class ManagerDUActive  {
 public:
+  enum MarkingEngine { DFS_MARKING, SUMMARY_MARKING };
+
   ManagerDUActive(OA_ptr<Activity::ActivityIRInterface>,
                   OA_ptr<OA::DUG::DUGStandard>);
   ~ManagerDUActive () {}
@@ -48,10 +64,28 @@ public:
   void markVaried(bool activeWithVariedOnly);
   void markUseful();
 
+  //! how markVaried and markUseful walk the DUG
+  void setMarkingEngine(MarkingEngine engine) { mEngine = engine; }
+
+  //! whether SUMMARY_MARKING only checks DUG::CFLReach against the
+  //! recursive walks, false by default
+  void setCheckMarking(bool check) { mCheck = check; }
+
+  //! nodes the check found marked differently so far
+  int getNumMarkingDifferences() { return mDiffering.count(); }
+
   //! Indicate whether the given symbol is active or not within any procedure
   bool isActive(SymHandle sym){ return mDUG->isActive(sym); }
 
 private:
+  //! builds mGraph and mReach, which only writes to the DUG if the
+  //! marking isn't being checked
+  void makeReach();
+
+  //! notes the nodes mReach marked varied, or useful, and active
+  //! that the walks didn't, and the other way around
+  void checkMarking(bool useful);
+
   OA_ptr<Activity::ActivityIRInterface>        mIR;
   std::map<ProcHandle,OA_ptr<ActiveStandard> > mActiveMap;
   OA_ptr<InterActiveFortran> mInterActiveFortran;
@@ -60,6 +94,12 @@ private:
   OA_ptr<Alias::InterAliasInterface>           mInterAlias;
 
   OA_ptr<OA::DUG::DUGStandard>                 mDUG;
+
+  MarkingEngine                                mEngine;
+  OA_ptr<OA::DUG::DUGCompact>                  mGraph;
+  OA_ptr<OA::DUG::CFLReach>                    mReach;
+  bool                                         mCheck;
+  SparseBitVector                              mDiffering;
 };
 
   } // end of Activity namespace
@@ -66,7 +66,7 @@ private:
 
 ManagerDUGStandard::ManagerDUGStandard(OA_ptr<DUGIRInterface> _ir, 
                                        OA_ptr<Activity::ActivityIRInterface> _air) 
-    : mIR(_ir), mActIR(_air)
+    : mIR(_ir), mActIR(_air), mNumThreads(0)
 { 
 }
 
@@ -308,15 +308,16 @@ ManagerDUGStandard::collectDependentSyms( ProcHandle proc)
 
 
 
-// for each (use, def) pair of a stmt
-void ManagerDUGStandard::labelUseDefEdges(
-    StmtHandle stmt, ProcHandle proc)
+// collect the (use, def) pairs of a stmt
+void ManagerDUGStandard::collectUseDefs(StmtFragment& frag)
 {
-
+    StmtHandle stmt = frag.mStmt;
 #ifdef DEBUG_DUAA
-  std::cout << "labelUseDefEdges: " <<  mIR->toString(stmt) << std::endl;
+  std::cout << "collectUseDefs: " <<  mIR->toString(stmt) << std::endl;
 #endif
-    std::set<SymHandle> useSet, defSet, allSyms;
+    std::set<SymHandle>& useSet = frag.mUses;
+    std::set<SymHandle>& defSet = frag.mDefs;
+    std::set<SymHandle> allSyms;
 
     // collect all locations in the stmt
     OA_ptr<MemRefHandleIterator> mrIterPtr;
@@ -385,8 +386,7 @@ void ManagerDUGStandard::labelUseDefEdges(
 		OA_ptr<NamedRef> namedRef = mre.convert<NamedRef>();
 		SymHandle use = namedRef->getSymHandle();
 
-		mDUG->mapSymToMemRefSet(use, mref);
-		mDUG->mapSymToStmtSet(use, stmt);
+		frag.mRefs.push_back(std::make_pair(use, mref));
 
 		useSet.insert(use);
 
@@ -403,8 +403,7 @@ void ManagerDUGStandard::labelUseDefEdges(
 			OA_ptr<NamedRef> namedRef = mre.convert<NamedRef>();
 			SymHandle use = namedRef->getSymHandle();
 
-			mDUG->mapSymToMemRefSet(use, mref);
-			mDUG->mapSymToStmtSet(use, stmt);
+			frag.mRefs.push_back(std::make_pair(use, mref));
 
 			useSet.insert(use);
 
@@ -413,8 +412,7 @@ void ManagerDUGStandard::labelUseDefEdges(
 		} else {
 		    SymHandle use = refOp->getBaseSym();
 
-		    mDUG->mapSymToMemRefSet(use, mref);
-		    mDUG->mapSymToStmtSet(use, stmt);
+		    frag.mRefs.push_back(std::make_pair(use, mref));
 
 		    useSet.insert(use);
 		}
@@ -447,8 +445,7 @@ void ManagerDUGStandard::labelUseDefEdges(
 		if (allSyms.find(def) != allSyms.end())
 		{
             
-		    mDUG->mapSymToMemRefSet(def, mref);
-		    mDUG->mapSymToStmtSet(def, stmt);
+		    frag.mRefs.push_back(std::make_pair(def, mref));
  
 		    defSet.insert(def);
 		}
@@ -467,8 +464,7 @@ void ManagerDUGStandard::labelUseDefEdges(
 			if (allSyms.find(def) != allSyms.end())
 			{
 
-			    mDUG->mapSymToMemRefSet(def, mref);
-			    mDUG->mapSymToStmtSet(def, stmt);
+			    frag.mRefs.push_back(std::make_pair(def, mref));
 
 			    defSet.insert(def);
 			}
@@ -480,8 +476,7 @@ void ManagerDUGStandard::labelUseDefEdges(
             
 		    if (allSyms.find(def) != allSyms.end()) {
 
-			mDUG->mapSymToMemRefSet(def, mref);
-			mDUG->mapSymToStmtSet(def, stmt);
+			frag.mRefs.push_back(std::make_pair(def, mref));
 
 			defSet.insert(def);
 		    }
@@ -491,6 +486,22 @@ void ManagerDUGStandard::labelUseDefEdges(
 
 	}
     }
+}
+
+// for each (use, def) pair of a stmt
+void ManagerDUGStandard::labelUseDefEdges(
+    StmtFragment& frag, ProcHandle proc)
+{
+#ifdef DEBUG_DUAA
+  std::cout << "labelUseDefEdges: " <<  mIR->toString(frag.mStmt) << std::endl;
+#endif
+    std::vector<std::pair<SymHandle,MemRefHandle> >::iterator refIter;
+    for (refIter=frag.mRefs.begin(); refIter!=frag.mRefs.end(); refIter++) {
+	mDUG->mapSymToMemRefSet(refIter->first, refIter->second);
+	mDUG->mapSymToStmtSet(refIter->first, frag.mStmt);
+    }
+    std::set<SymHandle>& useSet = frag.mUses;
+    std::set<SymHandle>& defSet = frag.mDefs;
 
     // map all uses to may defs and vice versa for this statement
     // have to do this after removing implicit deps in case it will be
@@ -538,6 +549,33 @@ SymHandle ManagerDUGStandard::getQuickAndDirtySymHandle(OA_ptr<MemRefExpr> mre)
   assert(0);
 }
 
+/*!
+  Gathers the pointer assignments and the uses and defs of each
+  statement in proc, without changing the DUG.
+*/
+void ManagerDUGStandard::collectFragment(ProcHandle proc, 
+                                         ProcFragment& fragment)
+{
+    OA_ptr<OA::IRStmtIterator> sItPtr; 
+    sItPtr = mIR->getPtrAsgnIterator(proc);
+    for ( ; sItPtr->isValid(); (*sItPtr)++) {
+	StmtHandle stmt = sItPtr->current();
+	OA_ptr<OA::Alias::PtrAssignPairStmtIterator> pasIt; 
+	pasIt=mIR->getPtrAssignStmtPairIterator(stmt); 
+	fragment.mPtrAssigns.push_back(
+	    std::make_pair(pasIt->currentTarget(), pasIt->currentSource()));
+    }
+
+    sItPtr = mIR->getStmtIterator(proc);
+    for ( ; sItPtr->isValid(); (*sItPtr)++) {
+	fragment.mStmts.push_back(StmtFragment(sItPtr->current()));
+	StmtFragment& stmt = fragment.mStmts.back();
+	collectUseDefs(stmt);
+	stmt.mHasCall = stmt_has_call(stmt.mStmt);
+    }
+    fragment.mCollected = true;
+}
+
 OA_ptr<DUGStandard> ManagerDUGStandard::performAnalysis( 
     OA_ptr<IRProcIterator> procIter,
     OA_ptr<DataFlow::ParamBindings> paramBind,
@@ -559,7 +597,46 @@ OA_ptr<DUGStandard> ManagerDUGStandard::performAnalysis(
 	collectDependentSyms  (procIter->current());
     }
 
+    // procedures the call graph reaches from those with independent
+    // or dependent variables, only these can become of interest
+    std::vector<ProcHandle> procs;
+    std::map<ProcHandle,int> procIndex;
+    std::list<OA_ptr<CallGraph::NodeInterface> > worklist;
     OA_ptr<OA::CallGraph::NodesIteratorInterface> callGraphIter;
+    callGraphIter = cgraph->getCallGraphNodesIterator();
+    for ( ; callGraphIter->isValid(); ++(*callGraphIter)) {
+	OA_ptr<CallGraph::NodeInterface> node;
+	node = callGraphIter->currentCallGraphNode();
+	if (mProcsOfInterest.find(node->getProc()) != mProcsOfInterest.end()) {
+	    worklist.push_back(node);
+	}
+    }
+    while (!worklist.empty()) {
+	OA_ptr<CallGraph::NodeInterface> node = worklist.front();
+	worklist.pop_front();
+	ProcHandle proc = node->getProc();
+	if (proc == ProcHandle(0) || procIndex.find(proc) != procIndex.end()) {
+	    continue;
+	}
+	procIndex[proc] = procs.size();
+	procs.push_back(proc);
+	OA_ptr<OA::CallGraph::NodesIteratorInterface> calleeIter;
+	calleeIter = node->getCallGraphSinkNodesIterator();
+	for ( ; calleeIter->isValid(); ++(*calleeIter)) {
+	    worklist.push_back(calleeIter->currentCallGraphNode());
+	}
+    }
+
+    // one slot per procedure, sized before any task writes to it
+    std::vector<ProcFragment> fragments(procs.size());
+    ThreadPool pool(mNumThreads);
+    for (unsigned int i=0; i<procs.size(); i++) {
+	OA_ptr<ThreadTask> task;
+	task = new FragmentTask(*this, procs[i], fragments[i]);
+	pool.add(task);
+    }
+    pool.wait();
+
     callGraphIter = cgraph->getCallGraphReversePostDFSIterator(DGraph::DEdgeOrg);
 
     for ( ; callGraphIter->isValid(); ++(*callGraphIter)) {
@@ -571,30 +648,32 @@ OA_ptr<DUGStandard> ManagerDUGStandard::performAnalysis(
 	// skip unreachable procedures
 	if(mProcsOfInterest.find(proc) == mProcsOfInterest.end()) continue;
 
+	// procs of interest the walk above did not reach
+	ProcFragment extra;
+	std::map<ProcHandle,int>::iterator found = procIndex.find(proc);
+	ProcFragment& fragment 
+	    = found == procIndex.end() ? extra : fragments[found->second];
+	if (!fragment.mCollected) {
+	    collectFragment(proc, fragment);
+	}
 
-	OA_ptr<OA::IRStmtIterator> sItPtr; 
-	sItPtr = mIR->getPtrAsgnIterator(proc);
-	for ( ; sItPtr->isValid(); (*sItPtr)++) {
-	    StmtHandle stmt = sItPtr->current();
-	    OA_ptr<OA::Alias::PtrAssignPairStmtIterator> pasIt; 
-	    pasIt=mIR->getPtrAssignStmtPairIterator(stmt); 
-	    OA_ptr<OA::MemRefExpr> source, target;
-	    source=pasIt->currentSource(); 
-	    target=pasIt->currentTarget();
-	    SymHandle sourceSym=getQuickAndDirtySymHandle(source);
-	    SymHandle targetSym=getQuickAndDirtySymHandle(target);
+	unsigned int i;
+	for (i=0; i<fragment.mPtrAssigns.size(); i++) {
+	    SymHandle sourceSym
+		= getQuickAndDirtySymHandle(fragment.mPtrAssigns[i].second);
+	    SymHandle targetSym
+		= getQuickAndDirtySymHandle(fragment.mPtrAssigns[i].first);
             std::cout << "ManagerDUGStandard::performAnalysis::src pointer ---" << mIR->toString(sourceSym) << std::endl;
             std::cout << "ManagerDUGStandard::performAnalysis::tgt pointer ---" << mIR->toString(targetSym) << std::endl;
 	    insertEdge(sourceSym,targetSym,CFLOW_EDGE, CallHandle(0), proc, proc, proc);
 	    insertEdge(targetSym,sourceSym,CFLOW_EDGE, CallHandle(0), proc, proc, proc);
 	}
 
-	sItPtr = mIR->getStmtIterator(proc);
-	for ( ; sItPtr->isValid(); (*sItPtr)++) {
-	    StmtHandle stmt = sItPtr->current();
+	for (i=0; i<fragment.mStmts.size(); i++) {
+	    StmtFragment& stmt = fragment.mStmts[i];
 	    labelUseDefEdges(stmt, proc);
-	    if (stmt_has_call(stmt)){
-		labelCallRetEdges(stmt, proc);
+	    if (stmt.mHasCall){
+		labelCallRetEdges(stmt.mStmt, proc);
 	    }
 	}
     }
@@ -28,6 +28,8 @@
 #include <OpenAnalysis/Location/Locations.hpp>
 #include <OpenAnalysis/Activity/DepDFSet.hpp>
 #include <OpenAnalysis/CSFIActivity/DUGStandard.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
+#include <vector>
 
 
 /*
@@ -46,6 +48,14 @@ namespace OA {
    The AnnotationManager for DUGStandard.
    This class can build an DUGStandard, 
    (eventually) read one in from a file, and write one out to a file.
+
+   What the statements of each procedure use and define is gathered
+   from the IR on a ThreadPool, one task per procedure the call graph
+   reaches from the procedures with independent or dependent
+   variables.  The DUG is then built from those fragments in call graph
+   order on one thread, adding the CALL and RETURN edges as it goes,
+   so the nodes and edges are added in the same order as when each
+   statement is queried while building.
 */
 class ManagerDUGStandard { 
 public:
@@ -59,13 +69,57 @@ public:
 
   void transitiveClosureDepMatrix(OA_ptr<OA::CallGraph::CallGraphInterface>);
 
+  //! threads to query the IR on, 0 means ThreadPool's default
+  void setNumThreads(unsigned int numThreads) { mNumThreads = numThreads; }
+
+private: // helper types
+
+  //! the symbols a statement uses and defines
+  class StmtFragment {
+    public:
+      StmtFragment(StmtHandle stmt) : mStmt(stmt), mHasCall(false) {}
+      StmtHandle mStmt;
+      //! symbols and the memrefs they are accessed by
+      std::vector<std::pair<SymHandle,MemRefHandle> > mRefs;
+      std::set<SymHandle> mUses;
+      std::set<SymHandle> mDefs;
+      bool mHasCall;
+  };
+
+  //! the statements of a procedure, in order
+  class ProcFragment {
+    public:
+      ProcFragment() : mCollected(false) {}
+      bool mCollected;
+      //! targets and sources of pointer assignments
+      std::vector<std::pair<OA_ptr<MemRefExpr>,
+                            OA_ptr<MemRefExpr> > > mPtrAssigns;
+      std::vector<StmtFragment> mStmts;
+  };
+
+  class FragmentTask : public virtual ThreadTask {
+    public:
+      FragmentTask(ManagerDUGStandard& manager, ProcHandle proc,
+                   ProcFragment& result)
+          : mManager(manager), mProc(proc), mResult(result) {}
+      void run() { mManager.collectFragment(mProc, mResult); }
+    private:
+      ManagerDUGStandard& mManager;
+      ProcHandle mProc;
+      ProcFragment& mResult;
+  };
+
 private: // helper functions
 
+  //! only queries mIR, so tasks for different procs can run at once
+  void collectFragment(ProcHandle, ProcFragment&);
+  void collectUseDefs(StmtFragment&);
+
   bool stmt_has_call(StmtHandle stmt);
 
   void insertEdge(SymHandle, SymHandle, EdgeType, CallHandle, ProcHandle, ProcHandle, ProcHandle);
   void labelCallRetEdges(StmtHandle, ProcHandle);
-  void labelUseDefEdges(StmtHandle, ProcHandle);
+  void labelUseDefEdges(StmtFragment&, ProcHandle);
   void collectIndependentSyms( ProcHandle);
   void collectDependentSyms( ProcHandle);
 
@@ -88,6 +142,7 @@ private: // member variables
   OA_ptr<Activity::ActivityIRInterface> mActIR;
   OA_ptr<DUGStandard> mDUG;     
   OA_ptr<DataFlow::ParamBindings> mParamBind;
+  unsigned int mNumThreads;
 
   // dependence matrix
   std::map<ProcHandle, 
@@ -16,6 +16,7 @@
 
 #include "CallGraphDFSolver.hpp"
 #include <Utils/Util.hpp>
+#include <set>
 
 namespace OA {
   namespace DataFlow {
@@ -24,7 +25,8 @@ static bool debug = false;
 
 
 CallGraphDFSolver::CallGraphDFSolver(CallGraphDirectionType pDirection, CallGraphDFProblem& prob) 
-      : mDirection(pDirection), mDFProb(prob)
+      : mDirection(pDirection), mSCCSchedule(false), mNumThreads(0),
+        mPool(0), mDFProb(prob)
 {
   OA_DEBUG_CTRL_MACRO("DEBUG_CallGraphDFSolver:ALL", debug);
 }       
@@ -44,11 +46,258 @@ CallGraphDFSolver::solve(OA_ptr<CallGraph::CallGraphInterface> callGraph,
 
   mTop = mDFProb.initializeTop();
 
+  if (mSCCSchedule) {
+      solveSCCs(callGraph);
+      return;
+  }
+
   DataFlow::DGraphSolverDFP::solve(callGraph, 
           ((mDirection==TopDown) ? DGraph::DEdgeOrg : DGraph::DEdgeRev),
           algorithm);
 }
 
+//========================================================
+// SCC scheduling
+//========================================================
+
+//! solves one SCC then lets the solver start the ones waiting for it
+class CallGraphSCCTask : public ThreadTask {
+public:
+  CallGraphSCCTask(CallGraphDFSolver& solver, unsigned int i)
+      : mSolver(solver), mIndex(i) {}
+  void run()
+  {
+      mSolver.solveSCC(mSolver.mSCCs[mIndex]);
+      mSolver.finishSCC(mIndex);
+  }
+private:
+  CallGraphDFSolver& mSolver;
+  unsigned int mIndex;
+};
+
+/*!
+   Tarjan's algorithm over the edges the data-flow comes in on, kept
+   iterative because call chains can be deep.  Tarjan finishes a
+   component only after every component reachable from it, so mSCCs
+   ends up in an order that can be solved serially.
+*/
+void CallGraphDFSolver::buildSCCs(
+        OA_ptr<CallGraph::CallGraphInterface> callGraph)
+{
+    mSCCs.clear();
+
+    // number the nodes
+    std::vector<OA_ptr<CallGraph::NodeInterface> > nodes;
+    std::map<OA_ptr<CallGraph::NodeInterface>,unsigned int> nodeToIndex;
+    OA_ptr<CallGraph::NodesIteratorInterface> nodeIterPtr;
+    nodeIterPtr = callGraph->getCallGraphNodesIterator();
+    for ( ;nodeIterPtr->isValid(); ++(*nodeIterPtr) ) {
+        OA_ptr<CallGraph::NodeInterface> node 
+            = nodeIterPtr->currentCallGraphNode();
+        nodeToIndex[node] = nodes.size();
+        nodes.push_back(node);
+    }
+    unsigned int numNodes = nodes.size();
+
+    // nodes each node's data-flow comes from
+    std::vector<std::vector<unsigned int> > from(numNodes);
+    std::vector<bool> selfEdge(numNodes, false);
+    for (unsigned int v=0; v<numNodes; v++) {
+        OA_ptr<CallGraph::EdgesIteratorInterface> it;
+        if (mDirection==TopDown) {
+            it = nodes[v]->getCallGraphIncomingEdgesIterator();
+        } else {
+            it = nodes[v]->getCallGraphOutgoingEdgesIterator();
+        }
+        for (; it->isValid(); ++(*it)) {
+            OA_ptr<CallGraph::EdgeInterface> edge = it->currentCallGraphEdge();
+            OA_ptr<CallGraph::NodeInterface> other;
+            if (mDirection==TopDown) {
+                other = edge->getCallGraphSource();
+            } else {
+                other = edge->getCallGraphSink();
+            }
+            unsigned int w = nodeToIndex[other];
+            if (w == v) { selfEdge[v] = true; }
+            from[v].push_back(w);
+        }
+    }
+
+    const unsigned int unvisited = numNodes;
+    std::vector<unsigned int> index(numNodes, unvisited);
+    std::vector<unsigned int> low(numNodes, 0);
+    std::vector<bool> onStack(numNodes, false);
+    std::vector<unsigned int> sccOf(numNodes, 0);
+    std::vector<unsigned int> stack;
+    // (node, next position in its from list)
+    std::vector<std::pair<unsigned int,unsigned int> > visit;
+    unsigned int nextIndex = 0;
+
+    for (unsigned int root=0; root<numNodes; root++) {
+        if (index[root] != unvisited) { continue; }
+        visit.push_back(std::make_pair(root, 0U));
+        index[root] = low[root] = nextIndex++;
+        stack.push_back(root); onStack[root] = true;
+
+        while (!visit.empty()) {
+            unsigned int v = visit.back().first;
+            unsigned int& pos = visit.back().second;
+            if (pos < from[v].size()) {
+                unsigned int w = from[v][pos++];
+                if (index[w] == unvisited) {
+                    index[w] = low[w] = nextIndex++;
+                    stack.push_back(w); onStack[w] = true;
+                    visit.push_back(std::make_pair(w, 0U));
+                } else if (onStack[w] && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+
+            // done with v
+            visit.pop_back();
+            if (!visit.empty()) {
+                unsigned int parent = visit.back().first;
+                if (low[v] < low[parent]) { low[parent] = low[v]; }
+            }
+            if (low[v] != index[v]) { continue; }
+
+            // v is the root of a component
+            mSCCs.push_back(SCC());
+            SCC& scc = mSCCs.back();
+            unsigned int w;
+            do {
+                w = stack.back(); stack.pop_back();
+                onStack[w] = false;
+                sccOf[w] = mSCCs.size()-1;
+                scc.mNodes.push_back(nodes[w]);
+            } while (w != v);
+            scc.mCyclic = scc.mNodes.size() > 1 || selfEdge[v];
+        }
+    }
+
+    // components each component waits for
+    for (unsigned int i=0; i<mSCCs.size(); i++) {
+        std::set<unsigned int> waitFor;
+        std::vector<OA_ptr<CallGraph::NodeInterface> >::iterator nodeIter;
+        for (nodeIter=mSCCs[i].mNodes.begin();
+             nodeIter!=mSCCs[i].mNodes.end(); nodeIter++)
+        {
+            unsigned int v = nodeToIndex[*nodeIter];
+            std::vector<unsigned int>::iterator wIter;
+            for (wIter=from[v].begin(); wIter!=from[v].end(); wIter++) {
+                if (sccOf[*wIter] != i) { waitFor.insert(sccOf[*wIter]); }
+            }
+        }
+        mSCCs[i].mNumPending = waitFor.size();
+        std::set<unsigned int>::iterator sccIter;
+        for (sccIter=waitFor.begin(); sccIter!=waitFor.end(); sccIter++) {
+            mSCCs[*sccIter].mDependents.push_back(i);
+        }
+    }
+
+    if (debug) {
+        std::cout << "CallGraphDFSolver::buildSCCs: " << numNodes 
+                  << " nodes, " << mSCCs.size() << " SCCs" << std::endl;
+    }
+}
+
+/*!
+   With one thread the components are solved in the order buildSCCs
+   found them.  Otherwise each component is a task that is added to
+   the pool once the components it waits for are solved.
+*/
+void CallGraphDFSolver::solveSCCs(
+        OA_ptr<CallGraph::CallGraphInterface> callGraph)
+{
+    initialize(callGraph);
+    buildSCCs(callGraph);
+
+    ThreadPool pool(mNumThreads);
+    if (pool.getNumThreads() <= 1) {
+        std::vector<SCC>::iterator sccIter;
+        for (sccIter=mSCCs.begin(); sccIter!=mSCCs.end(); sccIter++) {
+            solveSCC(*sccIter);
+        }
+    } else {
+        // find all the ready components before adding any, the
+        // running tasks count down mNumPending
+        std::vector<unsigned int> ready;
+        for (unsigned int i=0; i<mSCCs.size(); i++) {
+            if (mSCCs[i].mNumPending == 0) { ready.push_back(i); }
+        }
+        mPool = &pool;
+        std::vector<unsigned int>::iterator readyIter;
+        for (readyIter=ready.begin(); readyIter!=ready.end(); readyIter++) {
+            OA_ptr<ThreadTask> task;
+            task = new CallGraphSCCTask(*this, *readyIter);
+            pool.add(task);
+        }
+        pool.wait();
+        mPool = 0;
+    }
+
+    mSCCs.clear();
+}
+
+/*!
+   Same upcalls as the whole-graph solver, but for each node the edges
+   the data-flow comes in on are visited before the node.  Those edges
+   belong to this component, so tasks never write the same node or
+   edge sets.
+*/
+void CallGraphDFSolver::solveSCC(SCC& scc)
+{
+    DGraph::DGraphEdgeDirection orient 
+        = (mDirection==TopDown) ? DGraph::DEdgeOrg : DGraph::DEdgeRev;
+
+    bool changed;
+    do {
+        changed = false;
+        std::vector<OA_ptr<CallGraph::NodeInterface> >::iterator nodeIter;
+        for (nodeIter=scc.mNodes.begin(); nodeIter!=scc.mNodes.end(); 
+             nodeIter++) 
+        {
+            OA_ptr<CallGraph::NodeInterface> node = *nodeIter;
+            OA_ptr<CallGraph::EdgesIteratorInterface> it;
+            if (mDirection==TopDown) {
+                it = node->getCallGraphIncomingEdgesIterator();
+            } else {
+                it = node->getCallGraphOutgoingEdgesIterator();
+            }
+            for (; it->isValid(); ++(*it)) {
+                OA_ptr<DGraph::EdgeInterface> edge = it->currentCallGraphEdge();
+                changed |= atDGraphEdge(edge, orient);
+            }
+            OA_ptr<DGraph::NodeInterface> dnode = node;
+            changed |= atDGraphNode(dnode, orient);
+        }
+    } while (changed && scc.mCyclic);
+}
+
+//! add the components that were only waiting for component i
+void CallGraphDFSolver::finishSCC(unsigned int i)
+{
+    std::vector<unsigned int> ready;
+    {
+        MutexLock guard(mSCCLock);
+        std::vector<unsigned int>::iterator depIter;
+        for (depIter=mSCCs[i].mDependents.begin(); 
+             depIter!=mSCCs[i].mDependents.end(); depIter++) 
+        {
+            if (--mSCCs[*depIter].mNumPending == 0) { 
+                ready.push_back(*depIter); 
+            }
+        }
+    }
+    std::vector<unsigned int>::iterator readyIter;
+    for (readyIter=ready.begin(); readyIter!=ready.end(); readyIter++) {
+        OA_ptr<ThreadTask> task;
+        task = new CallGraphSCCTask(*this, *readyIter);
+        mPool->add(task);
+    }
+}
+
 //========================================================
 // implementation of DGraphIterativeDFP callbacks
 //========================================================
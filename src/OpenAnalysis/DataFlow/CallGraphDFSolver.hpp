@@ -32,11 +32,14 @@
 #include <OpenAnalysis/DataFlow/DataFlowSet.hpp>
 #include <OpenAnalysis/DataFlow/CallGraphDFProblem.hpp>
 #include <OpenAnalysis/CallGraph/CallGraphInterface.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 #include <map>
+#include <vector>
 
 namespace OA {
   namespace DataFlow {
 
+class CallGraphSCCTask;
   
 //*********************************************************************
 // class CallGraphDFProblemNew
@@ -49,6 +52,10 @@ private:
 //  OA_ptr<DataFlowSet> mBottom;
   CallGraphDirectionType mDirection;
 
+  // SCC scheduling
+  bool mSCCSchedule;
+  unsigned int mNumThreads;
+
 public:
   //--------------------------------------------------------
   // constructor/destructor
@@ -61,6 +68,18 @@ public:
   void solve(OA_ptr<CallGraph::CallGraphInterface> callGraph, 
                     DFPImplement algorithm);
 
+  //! Instead of iterating over the whole call graph, solve each
+  //! strongly connected component of it to a fixed point on its own,
+  //! after the components its data-flow comes from (callees for
+  //! BottomUp, callers for TopDown).  Components that don't depend on
+  //! each other are solved concurrently on a ThreadPool with numThreads
+  //! threads, 0 means the pool's default.  The algorithm passed to
+  //! solve is not used.  With more than one thread the callbacks must
+  //! be safe to call for procedures in different components at the
+  //! same time.
+  void setSCCSchedule(bool scc, unsigned int numThreads = 0)
+    { mSCCSchedule = scc; mNumThreads = numThreads; }
+
   //========================================================
   // implementation of DGraphIterativeDFP callbacks
   // These are implemented in CallGraphDFProblem.cpp for a 
@@ -95,6 +114,31 @@ public:
 
 
 private:
+  //! a strongly connected component of the call graph
+  class SCC {
+  public:
+    SCC() : mCyclic(false), mNumPending(0) {}
+    std::vector<OA_ptr<CallGraph::NodeInterface> > mNodes;
+    //! more than one node, or a node that calls itself
+    bool mCyclic;
+    //! components whose data-flow comes from this one
+    std::vector<unsigned int> mDependents;
+    //! components this one still waits for
+    unsigned int mNumPending;
+  };
+  friend class CallGraphSCCTask;
+
+  void buildSCCs(OA_ptr<CallGraph::CallGraphInterface> callGraph);
+  void solveSCCs(OA_ptr<CallGraph::CallGraphInterface> callGraph);
+  void solveSCC(SCC& scc);
+  void finishSCC(unsigned int i);
+
+  // in data-flow order, each component comes after the ones it
+  // depends on
+  std::vector<SCC> mSCCs;
+  ThreadPool* mPool;
+  Mutex mSCCLock;
+
   // In and Out in this context refer to the data-flow direction
   // which in the case of bottom-up is in the reverse direction
   // of edges in the graph
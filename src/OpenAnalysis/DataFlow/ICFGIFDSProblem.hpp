@@ -0,0 +1,137 @@
+/*! \file
+
+  \brief Abstract class for specifying IFDS dataflow problems on ICFGs.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+  An IFDS problem (Reps, Horwitz, and Sagiv, POPL 1995) has a finite
+  domain of facts and flow functions that distribute over union, so
+  each flow function is given one fact at a time.  Facts are numbered
+  by the problem, an IFDSFactTable can do the numbering.  Fact 0 is
+  the zero fact, it holds everywhere that is reachable and the solver
+  keeps it flowing, so flow functions only need to handle it to
+  generate facts.
+
+  The callbacks match those of ICFGDFProblem.  For example:
+    - liveness (backward): facts are locations, transfer kills the
+      defs and generates the uses of the statement from any fact,
+      callerToCallee/calleeToCaller map locations through the
+      parameter bindings.
+    - reaching definitions (forward): facts are statements.
+    - vary (forward) and useful (backward) activity: facts are
+      locations, transfer maps a fact used by the statement to the
+      locations defined by it.  ManagerICFGVaryIFDS does vary.
+*/
+
+#ifndef ICFGIFDSProblem_h
+#define ICFGIFDSProblem_h
+
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/IRInterface/IRHandles.hpp>
+#include <set>
+#include <map>
+#include <vector>
+#include <cassert>
+
+namespace OA {
+  namespace DataFlow {
+
+typedef unsigned int IFDSFact;
+typedef std::set<IFDSFact> IFDSFactSet;
+
+//! the fact that holds at every reachable point
+const IFDSFact IFDS_ZERO_FACT = 0;
+
+//*********************************************************************
+// class ICFGIFDSProblem
+//*********************************************************************
+class ICFGIFDSProblem  {
+public:
+  //--------------------------------------------------------
+  // constructor/destructor
+  //--------------------------------------------------------
+  ICFGIFDSProblem() {}
+  virtual ~ICFGIFDSProblem() {}
+
+  //--------------------------------------------------------
+  // initialization callbacks
+  //--------------------------------------------------------
+
+  //! Facts that hold on entry to proc (at its exit for a backward
+  //! problem) in every context, added to result
+  virtual void initialFacts(ProcHandle proc, IFDSFactSet& result) = 0;
+
+  //--------------------------------------------------------
+  // solver callbacks, each adds the facts that fact maps to
+  // into result
+  //--------------------------------------------------------
+
+  //! Proc is procedure that contains the statement.
+  virtual void transfer(ProcHandle proc, IFDSFact fact,
+                        OA::StmtHandle stmt, IFDSFactSet& result) = 0;
+
+  //! Propagate a fact from caller to callee
+  virtual void callerToCallee(ProcHandle caller, IFDSFact fact,
+                              CallHandle call, ProcHandle callee,
+                              IFDSFactSet& result) = 0;
+
+  //! Propagate a fact from callee to caller
+  virtual void calleeToCaller(ProcHandle callee, IFDSFact fact,
+                              CallHandle call, ProcHandle caller,
+                              IFDSFactSet& result) = 0;
+
+  //! Propagate a fact from call node to return node
+  virtual void callToReturn(ProcHandle caller, IFDSFact fact,
+                            CallHandle call, ProcHandle callee,
+                            IFDSFactSet& result) = 0;
+};
+
+//*********************************************************************
+// class IFDSFactTable
+//*********************************************************************
+/*!
+   Numbers the values of an IFDS domain, starting at 1 so that 0 is
+   left for the zero fact.  T needs an operator<, OA_ptr<Location>
+   and the IRHandle classes work.
+*/
+template <class T>
+class IFDSFactTable {
+public:
+  IFDSFactTable() { mValues.push_back(T()); }
+
+  //! fact for val, numbering it if it is new
+  IFDSFact getFact(const T& val)
+  {
+      typename std::map<T,IFDSFact>::iterator found = mFactMap.find(val);
+      if (found != mFactMap.end()) { return found->second; }
+      IFDSFact fact = mValues.size();
+      mValues.push_back(val);
+      mFactMap[val] = fact;
+      return fact;
+  }
+
+  //! whether val has been numbered
+  bool hasFact(const T& val) const
+    { return mFactMap.find(val) != mFactMap.end(); }
+
+  //! value for a fact other than the zero fact
+  const T& getValue(IFDSFact fact) const
+    { assert(fact != IFDS_ZERO_FACT && fact < mValues.size());
+      return mValues[fact]; }
+
+  //! number of facts, including the zero fact
+  unsigned int size() const { return mValues.size(); }
+
+private:
+  std::map<T,IFDSFact> mFactMap;
+  std::vector<T> mValues;
+};
+
+  } // end of DataFlow namespace
+}  // end of OA namespace
+
+#endif
@@ -0,0 +1,375 @@
+/*! \file
+
+  \brief Definition of the IFDS tabulation solver for ICFGs.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ICFGIFDSSolver.hpp"
+#include <Utils/Util.hpp>
+
+namespace OA {
+  namespace DataFlow {
+
+static bool debug = false;
+
+ICFGIFDSSolver::ICFGIFDSSolver(DFDirectionType pDirection,
+                               ICFGIFDSProblem& prob)
+    : mDirection(pDirection), mProb(prob), mNumPathEdges(0),
+      mNumSummaries(0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ICFGIFDSSolver:ALL", debug);
+}
+
+void ICFGIFDSSolver::solve(OA_ptr<ICFG::ICFGInterface> icfg)
+{
+    mWorkList.clear();
+    mPathEdges.clear();
+    mIncoming.clear();
+    mEndSummary.clear();
+    mEndNode.clear();
+    mNodeFlowCache.clear();
+    mNumPathEdges = 0;
+    mNumSummaries = 0;
+
+    // seed the start of each procedure
+    OA_ptr<ICFG::NodesIteratorInterface> nodeIter;
+    for (nodeIter = icfg->getICFGNodesIterator(); nodeIter->isValid();
+         ++(*nodeIter))
+    {
+        OA_ptr<ICFG::NodeInterface> node = nodeIter->currentICFGNode();
+        if (!isStart(node)) { continue; }
+
+        // procedures nobody calls are reached with just the zero fact
+        bool called = false;
+        OA_ptr<ICFG::EdgesIteratorInterface> edgeIter;
+        for (edgeIter = predEdges(node); edgeIter->isValid(); ++(*edgeIter)) {
+            if (edgeIter->currentICFGEdge()->getType() == callEdgeType()) {
+                called = true;
+            }
+        }
+        if (!called) {
+            propagate(IFDS_ZERO_FACT, node, IFDS_ZERO_FACT);
+        }
+
+        IFDSFactSet facts;
+        mProb.initialFacts(node->getProc(), facts);
+        IFDSFactSet::iterator factIter;
+        for (factIter = facts.begin(); factIter != facts.end(); factIter++) {
+            propagate(IFDS_ZERO_FACT, node, *factIter);
+        }
+    }
+
+    while (!mWorkList.empty()) {
+        PathEdge pe = mWorkList.front();
+        mWorkList.pop_front();
+        processPathEdge(pe);
+    }
+
+    if (debug) {
+        std::cout << "ICFGIFDSSolver::solve: " << mNumPathEdges
+                  << " path edges, " << mNumSummaries << " summary facts"
+                  << std::endl;
+    }
+}
+
+//--------------------------------------------------------
+// tabulation
+//--------------------------------------------------------
+void ICFGIFDSSolver::propagate(IFDSFact d1, OA_ptr<ICFG::NodeInterface> n,
+                               IFDSFact d2)
+{
+    if (mPathEdges[n->getId()].insert(std::make_pair(d1,d2)).second) {
+        mNumPathEdges++;
+        mWorkList.push_back(PathEdge(d1,n,d2));
+    }
+}
+
+void ICFGIFDSSolver::processPathEdge(const PathEdge& pe)
+{
+    OA_ptr<ICFG::NodeInterface> node = pe.mNode;
+    IFDSFactSet::const_iterator factIter;
+
+    // reaching the end of the procedure extends the summary for the
+    // start fact and returns the new facts to the known call sites
+    if (isEnd(node)) {
+        ProcHandle proc = node->getProc();
+        mEndNode[proc] = node;
+        ProcFact key(proc, pe.mD1);
+        const IFDSFactSet& endFacts = nodeFlow(node, pe.mD2);
+        for (factIter = endFacts.begin(); factIter != endFacts.end();
+             factIter++)
+        {
+            if (!mEndSummary[key].insert(*factIter).second) { continue; }
+            mNumSummaries++;
+            std::set<CallContext>& callers = mIncoming[key];
+            std::set<CallContext>::iterator ctxIter;
+            for (ctxIter = callers.begin(); ctxIter != callers.end();
+                 ctxIter++)
+            {
+                returnToCaller(node, *factIter, *ctxIter);
+            }
+        }
+    }
+
+    OA_ptr<ICFG::EdgesIteratorInterface> edgeIter;
+    for (edgeIter = succEdges(node); edgeIter->isValid(); ++(*edgeIter)) {
+        OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+        OA_ptr<ICFG::NodeInterface> succ = succNode(edge);
+
+        if (edge->getType() == ICFG::CFLOW_EDGE) {
+            const IFDSFactSet& outFacts = nodeFlow(node, pe.mD2);
+            for (factIter = outFacts.begin(); factIter != outFacts.end();
+                 factIter++)
+            {
+                propagate(pe.mD1, succ, *factIter);
+            }
+
+        } else if (edge->getType() == ICFG::CALL_RETURN_EDGE) {
+            IFDSFactSet result;
+            mProb.callToReturn(predProc(edge), pe.mD2, edge->getCall(),
+                               succProc(edge), result);
+            if (pe.mD2 == IFDS_ZERO_FACT) { result.insert(IFDS_ZERO_FACT); }
+            for (factIter = result.begin(); factIter != result.end();
+                 factIter++)
+            {
+                propagate(pe.mD1, succ, *factIter);
+            }
+
+        } else if (edge->getType() == callEdgeType()) {
+            IFDSFactSet result;
+            ProcHandle callee = succProc(edge);
+            mProb.callerToCallee(predProc(edge), pe.mD2, edge->getCall(),
+                                 callee, result);
+            if (pe.mD2 == IFDS_ZERO_FACT) { result.insert(IFDS_ZERO_FACT); }
+
+            CallContext ctx(edge->getCall(), pe.mD1);
+            for (factIter = result.begin(); factIter != result.end();
+                 factIter++)
+            {
+                propagate(*factIter, succ, *factIter);
+
+                // the callee may already have a summary for this fact
+                ProcFact key(callee, *factIter);
+                if (!mIncoming[key].insert(ctx).second) { continue; }
+                std::map<ProcFact,IFDSFactSet>::iterator sumIter
+                    = mEndSummary.find(key);
+                if (sumIter == mEndSummary.end()) { continue; }
+                IFDSFactSet::iterator endIter;
+                for (endIter = sumIter->second.begin();
+                     endIter != sumIter->second.end(); endIter++)
+                {
+                    returnToCaller(mEndNode[callee], *endIter, ctx);
+                }
+            }
+        }
+        // edges leaving a callee are followed through the summaries
+    }
+}
+
+void ICFGIFDSSolver::returnToCaller(OA_ptr<ICFG::NodeInterface> end,
+                                    IFDSFact fact, const CallContext& ctx)
+{
+    OA_ptr<ICFG::EdgesIteratorInterface> edgeIter;
+    for (edgeIter = succEdges(end); edgeIter->isValid(); ++(*edgeIter)) {
+        OA_ptr<ICFG::EdgeInterface> edge = edgeIter->currentICFGEdge();
+        if (edge->getType() != returnEdgeType()
+            || edge->getCall() != ctx.mCall)
+        {
+            continue;
+        }
+        IFDSFactSet result;
+        mProb.calleeToCaller(predProc(edge), fact, ctx.mCall,
+                             succProc(edge), result);
+        if (fact == IFDS_ZERO_FACT) { result.insert(IFDS_ZERO_FACT); }
+        IFDSFactSet::iterator factIter;
+        for (factIter = result.begin(); factIter != result.end(); factIter++) {
+            propagate(ctx.mD1, succNode(edge), *factIter);
+        }
+    }
+}
+
+const IFDSFactSet& ICFGIFDSSolver::nodeFlow(OA_ptr<ICFG::NodeInterface> n,
+                                            IFDSFact fact)
+{
+    NodeFact key(n->getId(), fact);
+    std::map<NodeFact,IFDSFactSet>::iterator found
+        = mNodeFlowCache.find(key);
+    if (found != mNodeFlowCache.end()) { return found->second; }
+
+    IFDSFactSet curr;
+    curr.insert(fact);
+
+    // apply the statement transfer functions in the problem direction
+    std::list<StmtHandle> stmts;
+    OA_ptr<CFG::NodeStatementsIteratorInterface> stmtIter;
+    for (stmtIter = n->getNodeStatementsIterator(); stmtIter->isValid();
+         ++(*stmtIter))
+    {
+        if (mDirection == Forward) {
+            stmts.push_back(stmtIter->current());
+        } else {
+            stmts.push_front(stmtIter->current());
+        }
+    }
+
+    std::list<StmtHandle>::iterator sIter;
+    for (sIter = stmts.begin(); sIter != stmts.end(); sIter++) {
+        IFDSFactSet next;
+        IFDSFactSet::iterator factIter;
+        for (factIter = curr.begin(); factIter != curr.end(); factIter++) {
+            mProb.transfer(n->getProc(), *factIter, *sIter, next);
+        }
+        if (curr.find(IFDS_ZERO_FACT) != curr.end()) {
+            next.insert(IFDS_ZERO_FACT);
+        }
+        curr.swap(next);
+    }
+
+    IFDSFactSet& retval = mNodeFlowCache[key];
+    retval.swap(curr);
+    return retval;
+}
+
+//--------------------------------------------------------
+// direction
+//--------------------------------------------------------
+bool ICFGIFDSSolver::isStart(OA_ptr<ICFG::NodeInterface> n)
+{
+    return n->getType() ==
+        ((mDirection==Forward) ? ICFG::ENTRY_NODE : ICFG::EXIT_NODE);
+}
+
+bool ICFGIFDSSolver::isEnd(OA_ptr<ICFG::NodeInterface> n)
+{
+    return n->getType() ==
+        ((mDirection==Forward) ? ICFG::EXIT_NODE : ICFG::ENTRY_NODE);
+}
+
+OA_ptr<ICFG::EdgesIteratorInterface>
+ICFGIFDSSolver::succEdges(OA_ptr<ICFG::NodeInterface> n)
+{
+    if (mDirection==Forward) {
+        return n->getICFGOutgoingEdgesIterator();
+    } else {
+        return n->getICFGIncomingEdgesIterator();
+    }
+}
+
+OA_ptr<ICFG::EdgesIteratorInterface>
+ICFGIFDSSolver::predEdges(OA_ptr<ICFG::NodeInterface> n)
+{
+    if (mDirection==Forward) {
+        return n->getICFGIncomingEdgesIterator();
+    } else {
+        return n->getICFGOutgoingEdgesIterator();
+    }
+}
+
+OA_ptr<ICFG::NodeInterface>
+ICFGIFDSSolver::succNode(OA_ptr<ICFG::EdgeInterface> e)
+{
+    return (mDirection==Forward) ? e->getICFGSink() : e->getICFGSource();
+}
+
+ProcHandle ICFGIFDSSolver::succProc(OA_ptr<ICFG::EdgeInterface> e)
+{
+    return (mDirection==Forward) ? e->getSinkProc() : e->getSourceProc();
+}
+
+ProcHandle ICFGIFDSSolver::predProc(OA_ptr<ICFG::EdgeInterface> e)
+{
+    return (mDirection==Forward) ? e->getSourceProc() : e->getSinkProc();
+}
+
+ICFG::EdgeType ICFGIFDSSolver::callEdgeType()
+{
+    return (mDirection==Forward) ? ICFG::CALL_EDGE : ICFG::RETURN_EDGE;
+}
+
+ICFG::EdgeType ICFGIFDSSolver::returnEdgeType()
+{
+    return (mDirection==Forward) ? ICFG::RETURN_EDGE : ICFG::CALL_EDGE;
+}
+
+//--------------------------------------------------------
+// results
+//--------------------------------------------------------
+bool ICFGIFDSSolver::isReached(OA_ptr<ICFG::NodeInterface> n)
+{
+    return mPathEdges.find(n->getId()) != mPathEdges.end();
+}
+
+OA_ptr<IFDSFactSet>
+ICFGIFDSSolver::getInFacts(OA_ptr<ICFG::NodeInterface> n)
+{
+    OA_ptr<IFDSFactSet> retval;
+    retval = new IFDSFactSet;
+    std::map<unsigned int,std::set<std::pair<IFDSFact,IFDSFact> > >::iterator
+        found = mPathEdges.find(n->getId());
+    if (found == mPathEdges.end()) { return retval; }
+
+    std::set<std::pair<IFDSFact,IFDSFact> >::iterator peIter;
+    for (peIter = found->second.begin(); peIter != found->second.end();
+         peIter++)
+    {
+        if (mDirection == Forward) {
+            retval->insert(peIter->second);
+        } else {
+            const IFDSFactSet& facts = nodeFlow(n, peIter->second);
+            retval->insert(facts.begin(), facts.end());
+        }
+    }
+    retval->erase(IFDS_ZERO_FACT);
+    return retval;
+}
+
+OA_ptr<IFDSFactSet>
+ICFGIFDSSolver::getOutFacts(OA_ptr<ICFG::NodeInterface> n)
+{
+    OA_ptr<IFDSFactSet> retval;
+    retval = new IFDSFactSet;
+    std::map<unsigned int,std::set<std::pair<IFDSFact,IFDSFact> > >::iterator
+        found = mPathEdges.find(n->getId());
+    if (found == mPathEdges.end()) { return retval; }
+
+    std::set<std::pair<IFDSFact,IFDSFact> >::iterator peIter;
+    for (peIter = found->second.begin(); peIter != found->second.end();
+         peIter++)
+    {
+        if (mDirection == Backward) {
+            retval->insert(peIter->second);
+        } else {
+            const IFDSFactSet& facts = nodeFlow(n, peIter->second);
+            retval->insert(facts.begin(), facts.end());
+        }
+    }
+    retval->erase(IFDS_ZERO_FACT);
+    return retval;
+}
+
+//--------------------------------------------------------
+// debugging
+//--------------------------------------------------------
+void ICFGIFDSSolver::dump(std::ostream& os)
+{
+    std::map<unsigned int,std::set<std::pair<IFDSFact,IFDSFact> > >::iterator
+        mapIter;
+    for (mapIter=mPathEdges.begin(); mapIter!=mPathEdges.end(); mapIter++) {
+        os << "Node (" << mapIter->first << "):";
+        std::set<std::pair<IFDSFact,IFDSFact> >::iterator peIter;
+        for (peIter = mapIter->second.begin();
+             peIter != mapIter->second.end(); peIter++)
+        {
+            os << " " << peIter->first << "->" << peIter->second;
+        }
+        os << std::endl;
+    }
+}
+
+  } // end of DataFlow namespace
+}  // end of OA namespace
@@ -0,0 +1,147 @@
+/*! \file
+
+  \brief Tabulation solver for IFDS dataflow problems on ICFGs.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+  Context-sensitive counterpart of ICFGDFSolver.  Implements the
+  tabulation algorithm of Reps, Horwitz, and Sagiv: path edges record
+  which facts at a node are reachable from which fact at the start of
+  its procedure, and the facts reaching the end of a procedure from a
+  start fact are kept as a summary for that callee.  A callee is only
+  analyzed once per start fact, later call sites reuse its summary,
+  and facts only return to the call sites they came from.
+
+  The data-flow values are taken on the same sides of nodes and edges
+  as ICFGDFSolver uses, so a problem can be written against either.
+  Statements in ENTRY and EXIT nodes are not transformed, those nodes
+  are empty in ICFGs built by ManagerICFGStandard.
+*/
+
+#ifndef ICFGIFDSSolver_H
+#define ICFGIFDSSolver_H
+
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+#include <OpenAnalysis/DataFlow/ICFGIFDSProblem.hpp>
+#include <OpenAnalysis/ICFG/ICFGInterface.hpp>
+#include <map>
+#include <set>
+#include <list>
+
+namespace OA {
+  namespace DataFlow {
+
+
+//*********************************************************************
+// class ICFGIFDSSolver
+//*********************************************************************
+class ICFGIFDSSolver {
+public:
+  typedef enum { Forward, Backward } DFDirectionType;
+
+  //--------------------------------------------------------
+  // constructor/destructor
+  //--------------------------------------------------------
+  ICFGIFDSSolver(DFDirectionType pDirection, ICFGIFDSProblem& prob);
+  virtual ~ICFGIFDSSolver() {}
+
+  //! solves the problem starting from every procedure that is
+  //! not called, and from the initialFacts of every procedure
+  void solve(OA_ptr<ICFG::ICFGInterface> icfg);
+
+  //---------------------------------
+  // results, merged over all contexts, without the zero fact
+  //---------------------------------
+  OA_ptr<IFDSFactSet> getInFacts(OA_ptr<ICFG::NodeInterface> n);
+  OA_ptr<IFDSFactSet> getOutFacts(OA_ptr<ICFG::NodeInterface> n);
+
+  //! whether the solver found a path to the node
+  bool isReached(OA_ptr<ICFG::NodeInterface> n);
+
+  //---------------------------------
+  // statistics
+  //---------------------------------
+  int getNumPathEdges() { return mNumPathEdges; }
+  int getNumSummaries() { return mNumSummaries; }
+
+  //--------------------------------------------------------
+  // debugging
+  //--------------------------------------------------------
+  void dump(std::ostream& os);
+
+private:
+  //! a fact, d2, holds before node when d1 held at start of its proc
+  struct PathEdge {
+    PathEdge(IFDSFact d1, OA_ptr<ICFG::NodeInterface> n, IFDSFact d2)
+        : mD1(d1), mNode(n), mD2(d2) {}
+    IFDSFact mD1;
+    OA_ptr<ICFG::NodeInterface> mNode;
+    IFDSFact mD2;
+  };
+
+  //! a call site that reached a callee start with some fact
+  struct CallContext {
+    CallContext(CallHandle call, IFDSFact d1) : mCall(call), mD1(d1) {}
+    bool operator<(const CallContext& other) const
+      { return mCall < other.mCall
+               || (!(other.mCall < mCall) && mD1 < other.mD1); }
+    CallHandle mCall;
+    IFDSFact mD1;  // fact at start of caller
+  };
+
+  typedef std::pair<ProcHandle,IFDSFact> ProcFact;
+  typedef std::pair<unsigned int,IFDSFact> NodeFact;
+
+  void propagate(IFDSFact d1, OA_ptr<ICFG::NodeInterface> n, IFDSFact d2);
+  void processPathEdge(const PathEdge& pe);
+
+  //! pass the fact at the end of callee back to the call site in ctx
+  void returnToCaller(OA_ptr<ICFG::NodeInterface> end, IFDSFact fact,
+                      const CallContext& ctx);
+
+  //! facts after the statements of n given fact before them, cached
+  const IFDSFactSet& nodeFlow(OA_ptr<ICFG::NodeInterface> n, IFDSFact fact);
+
+  //--------------------------------------------------------
+  // edges and node kinds in the direction of the problem
+  //--------------------------------------------------------
+  bool isStart(OA_ptr<ICFG::NodeInterface> n);
+  bool isEnd(OA_ptr<ICFG::NodeInterface> n);
+  OA_ptr<ICFG::EdgesIteratorInterface>
+      succEdges(OA_ptr<ICFG::NodeInterface> n);
+  OA_ptr<ICFG::EdgesIteratorInterface>
+      predEdges(OA_ptr<ICFG::NodeInterface> n);
+  OA_ptr<ICFG::NodeInterface> succNode(OA_ptr<ICFG::EdgeInterface> e);
+  ProcHandle succProc(OA_ptr<ICFG::EdgeInterface> e);
+  ProcHandle predProc(OA_ptr<ICFG::EdgeInterface> e);
+  //! edge type that enters a callee and that leaves it
+  ICFG::EdgeType callEdgeType();
+  ICFG::EdgeType returnEdgeType();
+
+private:
+  DFDirectionType mDirection;
+  ICFGIFDSProblem& mProb;
+
+  std::list<PathEdge> mWorkList;
+  // for each node id the (d1,d2) path edges that reach it
+  std::map<unsigned int,std::set<std::pair<IFDSFact,IFDSFact> > > mPathEdges;
+  std::map<unsigned int,OA_ptr<ICFG::NodeInterface> > mIdToNode;
+  // call sites that reached a callee start fact
+  std::map<ProcFact,std::set<CallContext> > mIncoming;
+  // facts after the end of a callee for a callee start fact
+  std::map<ProcFact,IFDSFactSet> mEndSummary;
+  std::map<ProcHandle,OA_ptr<ICFG::NodeInterface> > mEndNode;
+  std::map<NodeFact,IFDSFactSet> mNodeFlowCache;
+
+  int mNumPathEdges;
+  int mNumSummaries;
+};
+
+  } // end of DataFlow namespace
+}  // end of OA namespace
+
+#endif
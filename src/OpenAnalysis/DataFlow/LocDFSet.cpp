@@ -835,6 +835,13 @@ void LocDFSet::updateMap()
 
 }
 
+void LocDFSet::buildOverlapMap()
+{
+    if (!mBaseLocToSetMapValid) {
+        updateMap();
+    }
+}
+
 //! whether the give loc overlaps with anything in the given set
 bool LocDFSet::setHasOverlapLoc(OA_ptr<Location> loc, OA_ptr<LocSet> aSet)
 {
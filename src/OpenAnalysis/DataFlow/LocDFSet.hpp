@@ -85,6 +85,11 @@ public:
   //! iterator over locations in set that overlap with given location
   OA_ptr<LocIterator> getOverlapLocIterator(OA_ptr<Location> loc);
 
+  //! builds the map hasOverlapLoc and getOverlapLocIterator use now
+  //! instead of at the next query, so that until the set changes the
+  //! queries don't modify it and several threads can make them
+  void buildOverlapMap();
+
   //! Converts this set of locations to equivalent set in callee
   //! and returns a newly created set.
   //! Since this needs an IRInterface, probably only callable from within
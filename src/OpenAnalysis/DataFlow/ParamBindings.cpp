@@ -18,11 +18,20 @@
 namespace OA {
   namespace DataFlow {
 
+// The queries look entries up with find rather than operator[], so
+// that they do not change the maps and several threads can ask at once.
+
 //! get caller mem ref associated with callee formal
 MemRefHandle 
 ParamBindings::getCallerMemRef(CallHandle call, SymHandle calleeFormal)
 {
-    return mCalleeToCallerMap[call][calleeFormal];
+    std::map<CallHandle,std::map<SymHandle,MemRefHandle> >::const_iterator
+        callIter = mCalleeToCallerMap.find(call);
+    if (callIter == mCalleeToCallerMap.end()) { return MemRefHandle(0); }
+    std::map<SymHandle,MemRefHandle>::const_iterator 
+        formalIter = callIter->second.find(calleeFormal);
+    if (formalIter == callIter->second.end()) { return MemRefHandle(0); }
+    return formalIter->second;
 }
 
 //! returns an iterator over the memory reference parameters for a call
@@ -30,11 +39,12 @@ OA_ptr<MemRefHandleIterator> ParamBindings::getActualIterator(CallHandle call)
 {
     OA_ptr<MemRefIterator> retval;
     OA_ptr<std::set<OA::MemRefHandle> > retSet;
-    OA_ptr<std::set<OA::MemRefHandle> > memrefSet = mCallToActualSetMap[call];
-    if (memrefSet.ptrEqual(0)) {
+    std::map<CallHandle,OA_ptr<std::set<MemRefHandle> > >::const_iterator
+        found = mCallToActualSetMap.find(call);
+    if (found == mCallToActualSetMap.end() || found->second.ptrEqual(0)) {
         retSet = new std::set<OA::MemRefHandle>;
     } else {
-        retSet = mCallToActualSetMap[call];
+        retSet = found->second;
     }
     retval = new MemRefIterator(retSet);
     return retval;
@@ -45,19 +55,31 @@ SymHandle
 ParamBindings::getCalleeFormal(CallHandle call, MemRefHandle callerRef,
                                ProcHandle callee)
 {
-    return mCallerToCalleeMap[call][callee][callerRef];
+    std::map<CallHandle,std::map<ProcHandle,
+                                 std::map<MemRefHandle,SymHandle> > >
+        ::const_iterator callIter = mCallerToCalleeMap.find(call);
+    if (callIter == mCallerToCalleeMap.end()) { return SymHandle(0); }
+    std::map<ProcHandle,std::map<MemRefHandle,SymHandle> >::const_iterator
+        calleeIter = callIter->second.find(callee);
+    if (calleeIter == callIter->second.end()) { return SymHandle(0); }
+    std::map<MemRefHandle,SymHandle>::const_iterator 
+        refIter = calleeIter->second.find(callerRef);
+    if (refIter == calleeIter->second.end()) { return SymHandle(0); }
+    return refIter->second;
 }
 
 //! returns an iterator over the formal symbols for a procedure
 OA_ptr<SymHandleIterator> ParamBindings::getFormalIterator(ProcHandle proc)
 {
     OA_ptr<SymIterator> retval;
-    if (mProcToFormalSetMap[proc].ptrEqual(0)) {
+    std::map<ProcHandle,OA_ptr<std::set<SymHandle> > >::const_iterator
+        found = mProcToFormalSetMap.find(proc);
+    if (found == mProcToFormalSetMap.end() || found->second.ptrEqual(0)) {
         OA_ptr<std::set<SymHandle> > emptySet;
         emptySet = new std::set<SymHandle>;
         retval = new SymIterator(emptySet);
     } else {
-        retval = new SymIterator(mProcToFormalSetMap[proc]);
+        retval = new SymIterator(found->second);
     }
     return retval;
 }
@@ -67,24 +89,38 @@ OA_ptr<ExprHandleIterator>
 ParamBindings::getActualExprHandleIterator(CallHandle call) {
 
   OA_ptr<ExprHandleIterator> retval;
-  if (mCallToExprListMap[call].ptrEqual(0)) {
+  std::map<CallHandle,OA_ptr<std::list<ExprHandle> > >::const_iterator
+      found = mCallToExprListMap.find(call);
+  if (found == mCallToExprListMap.end() || found->second.ptrEqual(0)) {
     OA_ptr<std::list<ExprHandle> > emptyList;
     emptyList = new std::list<ExprHandle>;
     retval = new ExprIterator(emptyList);
   } else {
-    retval = new ExprIterator(mCallToExprListMap[call]);
+    retval = new ExprIterator(found->second);
   }
   return retval;
 }
 
 //! get ExprTree for actual ExprHandle
 OA_ptr<ExprTree> ParamBindings::getActualExprTree(ExprHandle expr){
-  return mExprToTreeMap[expr];
+  std::map<ExprHandle,OA_ptr<ExprTree> >::const_iterator
+      found = mExprToTreeMap.find(expr);
+  if (found == mExprToTreeMap.end()) {
+    OA_ptr<ExprTree> none;
+    return none;
+  }
+  return found->second;
 }
 
 //! get actual ExprHandle in CallHandle for formal SymHandle
 ExprHandle ParamBindings::getActualExprHandle(CallHandle call, SymHandle formal) {
-  return mCallToFormalToActualMap[call][formal];
+  std::map<CallHandle,std::map<SymHandle,ExprHandle> >::const_iterator
+      callIter = mCallToFormalToActualMap.find(call);
+  if (callIter == mCallToFormalToActualMap.end()) { return ExprHandle(0); }
+  std::map<SymHandle,ExprHandle>::const_iterator 
+      formalIter = callIter->second.find(formal);
+  if (formalIter == callIter->second.end()) { return ExprHandle(0); }
+  return formalIter->second;
 }
 
 
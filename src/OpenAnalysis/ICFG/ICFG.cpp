@@ -91,6 +91,68 @@ void Node::removeCallEdge( OA_ptr<Edge> e) { mCallEdges->remove(e); }
 
 void Node::removeReturnEdge( OA_ptr<Edge> e) { mReturnEdges->remove(e); }
 
+void Node::setCFGNode(OA_ptr<CFG::NodeInterface> cNode) { mCFGNode = cNode; }
+
+/*! Only the entry and exit nodes of a procedure exist before its
+    body has been built, so those are the only ones that need to check.
+*/
+void Node::demand() const
+{
+    if ((mType==ENTRY_NODE || mType==EXIT_NODE) && !mICFG.ptrEqual(0)
+        && mICFG->isPending(mProc)) 
+    {
+        mICFG->materializeProc(mProc);
+    }
+}
+
+int Node::num_incoming () const
+{
+    demand();
+    return DGraph::NodeImplement::num_incoming();
+}
+
+int Node::num_outgoing () const
+{
+    demand();
+    return DGraph::NodeImplement::num_outgoing();
+}
+
+bool Node::isAnEntry() const
+{
+    demand();
+    return DGraph::NodeImplement::isAnEntry();
+}
+
+bool Node::isAnExit() const
+{
+    demand();
+    return DGraph::NodeImplement::isAnExit();
+}
+
+OA_ptr<DGraph::EdgesIteratorInterface> Node::getIncomingEdgesIterator() const
+{
+    demand();
+    return DGraph::NodeImplement::getIncomingEdgesIterator();
+}
+
+OA_ptr<DGraph::EdgesIteratorInterface> Node::getOutgoingEdgesIterator() const
+{
+    demand();
+    return DGraph::NodeImplement::getOutgoingEdgesIterator();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> Node::getSourceNodesIterator() const
+{
+    demand();
+    return DGraph::NodeImplement::getSourceNodesIterator();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> Node::getSinkNodesIterator() const
+{
+    demand();
+    return DGraph::NodeImplement::getSinkNodesIterator();
+}
+
 /*
 unsigned int Node::getId() const { return mDGNode.getId(); }
 
@@ -561,6 +623,7 @@ ICFG::ICFG()
   mReturnNodes = new std::list<OA_ptr<Node> >;
   mCallEdges = new std::list<OA_ptr<Edge> >;
   mReturnEdges = new std::list<OA_ptr<Edge> >;
+  mNumMaterialized = 0;
 
 }
 
@@ -713,6 +776,98 @@ void ICFG::removeEdge(OA_ptr<Edge> pEdge)
 
 }
 
+//--------------------------------------------------------------------
+// Demand-driven construction
+//--------------------------------------------------------------------
+void ICFG::setMaterializer(OA_ptr<ProcMaterializer> materializer)
+{
+    mMaterializer = materializer;
+}
+
+void ICFG::addPendingProc(ProcHandle proc, OA_ptr<Node> entry)
+{
+    assert(!mMaterializer.ptrEqual(0));
+    mPendingProcs[proc] = entry;
+}
+
+bool ICFG::isPending(ProcHandle proc) const
+{
+    if (mPendingProcs.empty()) { return false; }
+    return mPendingProcs.find(proc) != mPendingProcs.end();
+}
+
+void ICFG::materializeProc(ProcHandle proc)
+{
+    std::map<ProcHandle,OA_ptr<Node> >::iterator pos 
+        = mPendingProcs.find(proc);
+    if (pos == mPendingProcs.end()) { return; }
+
+    // the placeholder entry node knows its enclosing ICFG, use it
+    // to hand ourselves to the materializer
+    OA_ptr<ICFG> self = pos->second->mICFG;
+
+    // no longer pending before building so that queries made
+    // while building do not recurse
+    mPendingProcs.erase(pos);
+    mNumMaterialized++;
+    if (debug) {
+        std::cout << "ICFG::materializeProc: proc = " << proc.hval() 
+                  << std::endl;
+    }
+    mMaterializer->materialize(self, proc);
+}
+
+void ICFG::materializeAll()
+{
+    // building a procedure can add new pending callees
+    while (!mPendingProcs.empty()) {
+        materializeProc(mPendingProcs.begin()->first);
+    }
+}
+
+int ICFG::getNumNodes()
+{
+    materializeAll();
+    return DGraph::DGraphImplement::getNumNodes();
+}
+
+int ICFG::getNumEdges()
+{
+    materializeAll();
+    return DGraph::DGraphImplement::getNumEdges();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> ICFG::getNodesIterator() const
+{
+    const_cast<ICFG*>(this)->materializeAll();
+    return DGraph::DGraphImplement::getNodesIterator();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> ICFG::getEntryNodesIterator() const
+{
+    const_cast<ICFG*>(this)->materializeAll();
+    return DGraph::DGraphImplement::getEntryNodesIterator();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> ICFG::getExitNodesIterator() const
+{
+    const_cast<ICFG*>(this)->materializeAll();
+    return DGraph::DGraphImplement::getExitNodesIterator();
+}
+
+OA_ptr<DGraph::EdgesIteratorInterface> ICFG::getEdgesIterator() const
+{
+    const_cast<ICFG*>(this)->materializeAll();
+    return DGraph::DGraphImplement::getEdgesIterator();
+}
+
+OA_ptr<DGraph::NodesIteratorInterface> 
+ICFG::getReversePostDFSIterator(DGraph::DGraphEdgeDirection pOrient)
+{
+    materializeAll();
+    return DGraph::DGraphImplement::getReversePostDFSIterator(pOrient);
+}
+
 /*
      //from MustMayActive branch:
 void ICFG::removeNode(OA_ptr<DGraph::NodeInterface> pNode)
@@ -58,6 +58,21 @@ namespace OA {
   class EdgesIterator;
   class ICFG;
 
+  //--------------------------------------------------------
+  /*! Callback used by a demand-driven ICFG to build the nodes and
+      edges for the body of a procedure the first time one of the
+      procedure's entry or exit nodes is reached.
+  */
+  class ProcMaterializer {
+  public:
+    ProcMaterializer() {}
+    virtual ~ProcMaterializer() {}
+
+    //! Add the nodes and edges for the body of proc to icfg,
+    //! reusing the entry and exit nodes for proc already in icfg.
+    virtual void materialize(OA_ptr<ICFG> icfg, ProcHandle proc) = 0;
+  };
+
  
   //--------------------------------------------------------
   class Node : public virtual NodeInterface,
@@ -102,6 +117,10 @@ namespace OA {
     void removeCallEdge( OA_ptr<Edge> e);
     void removeReturnEdge( OA_ptr<Edge> e);
 
+    //! Set the CFG node this node stands for.  Used to fill in the
+    //! entry and exit nodes of a procedure built on demand.
+    void setCFGNode(OA_ptr<CFG::NodeInterface> cNode);
+
     /*
     //========================================================
     // Construction
@@ -167,6 +186,20 @@ namespace OA {
 
     OA_ptr<NodesIteratorInterface> getICFGSinkNodesIterator() const;
 
+    //========================================================
+    // DGraph::NodeInterface methods that first build the body
+    // of our procedure when the enclosing ICFG is demand-driven
+    //========================================================
+    int num_incoming () const;
+    int num_outgoing () const;
+    bool isAnEntry() const;
+    bool isAnExit() const;
+
+    OA_ptr<DGraph::EdgesIteratorInterface> getIncomingEdgesIterator() const;
+    OA_ptr<DGraph::EdgesIteratorInterface> getOutgoingEdgesIterator() const;
+    OA_ptr<DGraph::NodesIteratorInterface> getSourceNodesIterator() const;
+    OA_ptr<DGraph::NodesIteratorInterface> getSinkNodesIterator() const;
+
     //========================================================
     // Output
     //========================================================
@@ -188,6 +221,10 @@ namespace OA {
   private:
      void Ctor();
 
+     //! entry and exit nodes of a procedure that has not been built
+     //! yet ask the enclosing ICFG to build it
+     void demand() const;
+
     // ========================================================== 
     // if we are a ENTRY_Node and have CallEdges then we
     // are the entry to a CFG and the CallEdges are incoming
@@ -403,6 +440,30 @@ public:
 
   //void removeNode(OA_ptr<DGraph::NodeInterface> n);
 
+  //========================================================
+  // Demand-driven construction
+  //   Only the entry and exit nodes of a pending procedure are in
+  //   the graph.  Its body is built by the ProcMaterializer when
+  //   one of those nodes is first asked for its edges, or when
+  //   an iterator over the whole graph is requested.
+  //========================================================
+  void setMaterializer(OA_ptr<ProcMaterializer> materializer);
+
+  //! the entry and exit nodes of proc must already be in the ICFG
+  void addPendingProc(ProcHandle proc, OA_ptr<Node> entry);
+
+  bool isPending(ProcHandle proc) const;
+
+  //! build the body of proc if it is still pending
+  void materializeProc(ProcHandle proc);
+
+  //! build the bodies of all pending procedures, including the ones
+  //! that only become reachable while doing so
+  void materializeAll();
+
+  //! number of procedures whose bodies have been built on demand
+  int getNumMaterializedProcs() const { return mNumMaterialized; }
+
   // can't do connect by creating a new edge in a member function
   // because edges have to have an OA_ptr to containing ICFG
   //void connect(OA_ptr<Node> pNode1, OA_ptr<Node> pNode2,
@@ -473,6 +534,20 @@ public:
   OA_ptr<NodesIteratorInterface> 
       getICFGDFSIterator(OA_ptr<NodeInterface> n);
 
+  //========================================================
+  // DGraph::DGraphInterface methods that need the whole graph,
+  // all pending procedures are built first
+  //========================================================
+  int getNumNodes();
+  int getNumEdges();
+
+  OA_ptr<DGraph::NodesIteratorInterface> getNodesIterator() const;
+  OA_ptr<DGraph::NodesIteratorInterface> getEntryNodesIterator() const;
+  OA_ptr<DGraph::NodesIteratorInterface> getExitNodesIterator() const;
+  OA_ptr<DGraph::EdgesIteratorInterface> getEdgesIterator() const;
+  OA_ptr<DGraph::NodesIteratorInterface>
+      getReversePostDFSIterator(DGraph::DGraphEdgeDirection pOrient);
+
  private:
   OA_ptr<Node> mEntry; 
   OA_ptr<Node> mExit;
@@ -491,6 +566,11 @@ public:
   OA_ptr<std::list<OA_ptr<Node> > > mReturnNodes;
   OA_ptr<std::list<OA_ptr<Edge> > > mReturnEdges;
 
+  // procedures whose bodies have not been built yet, mapped to
+  // their placeholder entry node
+  std::map<ProcHandle,OA_ptr<Node> > mPendingProcs;
+  OA_ptr<ProcMaterializer> mMaterializer;
+  int mNumMaterialized;
 
 };
 //--------------------------------------------------------------------
@@ -25,7 +25,7 @@ namespace OA {
 /*!
 */
 ManagerICFGStandard::ManagerICFGStandard(OA_ptr<ICFGIRInterface> _ir) 
-    : mIR(_ir)
+    : mIR(_ir), mDemandDriven(false)
 /*!
  */
 { 
@@ -138,42 +138,48 @@ ManagerICFGStandard::handle_call_node(OA_ptr<ICFG> icfg,
         for ( ; procIter->isValid(); ++(*procIter)) {
           ProcHandle callee = procIter->current();
           if (callee==ProcHandle(0)) { continue; }
-          worklist.push_back(callee);
-          // get CFG
-          OA_ptr<CFG::CFGInterface> calleeCFGInterface 
-            = mEachCFG->getCFGResults(callee);
-          OA_ptr<CFG::CFG> calleeCFG 
-            = calleeCFGInterface.convert<CFG::CFG>();
-          // get entry and exit node
-          OA_ptr<CFG::NodeInterface> temp
-            = calleeCFG->getEntry();
-          OA_ptr<CFG::Node> entryNode 
-            = temp.convert<CFG::Node>();
-          temp = calleeCFG->getExit();
-          OA_ptr<CFG::Node> exitNode 
-            = temp.convert<CFG::Node>();
-          // make an ICFG node for these if necessary
-          if (mCFGNodeToICFGNode[entryNode].ptrEqual(0)) {
-            mCFGNodeToICFGNode[entryNode] 
-              = new Node(icfg, callee, ENTRY_NODE, entryNode);
-            icfg->addNode(mCFGNodeToICFGNode[entryNode]);
-          }
-          if (mCFGNodeToICFGNode[exitNode].ptrEqual(0)) {
-            mCFGNodeToICFGNode[exitNode] 
-              = new Node(icfg, callee, EXIT_NODE, exitNode);
-            icfg->addNode(mCFGNodeToICFGNode[exitNode]);
+          OA_ptr<Node> calleeEntry, calleeExit;
+          if (mDemandDriven) {
+            // callee body is built when first reached
+            get_proc_stubs(icfg, callee, calleeEntry, calleeExit);
+          } else {
+            worklist.push_back(callee);
+            // get CFG
+            OA_ptr<CFG::CFGInterface> calleeCFGInterface 
+              = mEachCFG->getCFGResults(callee);
+            OA_ptr<CFG::CFG> calleeCFG 
+              = calleeCFGInterface.convert<CFG::CFG>();
+            // get entry and exit node
+            OA_ptr<CFG::NodeInterface> temp
+              = calleeCFG->getEntry();
+            OA_ptr<CFG::Node> entryNode 
+              = temp.convert<CFG::Node>();
+            temp = calleeCFG->getExit();
+            OA_ptr<CFG::Node> exitNode 
+              = temp.convert<CFG::Node>();
+            // make an ICFG node for these if necessary
+            if (mCFGNodeToICFGNode[entryNode].ptrEqual(0)) {
+              mCFGNodeToICFGNode[entryNode] 
+                = new Node(icfg, callee, ENTRY_NODE, entryNode);
+              icfg->addNode(mCFGNodeToICFGNode[entryNode]);
+            }
+            if (mCFGNodeToICFGNode[exitNode].ptrEqual(0)) {
+              mCFGNodeToICFGNode[exitNode] 
+                = new Node(icfg, callee, EXIT_NODE, exitNode);
+              icfg->addNode(mCFGNodeToICFGNode[exitNode]);
+            }
+            calleeEntry = mCFGNodeToICFGNode[entryNode];
+            calleeExit = mCFGNodeToICFGNode[exitNode];
           }
           
           // edge to link callICFGNode to entryNode
-          icfgEdge = new Edge(icfg, callICFGNode, 
-                                            mCFGNodeToICFGNode[entryNode], 
-                                            CALL_EDGE, call);
+          icfgEdge = new Edge(icfg, callICFGNode, calleeEntry, 
+                              CALL_EDGE, call);
           icfg->addEdge(icfgEdge);
           
           // edge to link exitNode to prevICFGNode
-          icfgEdge = new Edge(icfg, 
-                                            mCFGNodeToICFGNode[exitNode], 
-                                            prevICFGNode, RETURN_EDGE, call);
+          icfgEdge = new Edge(icfg, calleeExit, prevICFGNode, 
+                              RETURN_EDGE, call);
           icfg->addEdge(icfgEdge);
 
         } // end of loop for each may-called ProcHandle for this CallHandle
@@ -218,74 +224,36 @@ ManagerICFGStandard::break_out_calls(OA_ptr<CFG::Node> cfgNode)
 }
 
 /*!
-    Creates an ICFG based upon the CFGs for the program
+    Creates ICFG nodes for all the CFG nodes of the given procedure.
+    Edges between the nodes are recorded in edgeMap and linked up by
+    link_edges once the predecessor CFG nodes are mapped.
+    Callees are put on the worklist unless building on demand.
 */
-OA_ptr<ICFG> ManagerICFGStandard::performAnalysis( 
-    OA_ptr<IRProcIterator> procIter,
-    OA_ptr<CFG::EachCFGInterface> eachCFG,
-    OA_ptr<CallGraph::CallGraphInterface> cGraph)
+void ManagerICFGStandard::build_proc(OA_ptr<ICFG> icfg, ProcHandle proc,
+        std::list<ProcHandle>& worklist, EdgeMap& edgeMap)
 {
-  OA_ptr<Edge> icfgEdge;
-  OA_ptr<ICFG> icfg; icfg = new ICFG();
-
-  // for use within helper functions
-  mEachCFG = eachCFG;
-  mCallGraph = cGraph;
-
-  // list of edges that are needed, the ICFGStandard::Node is the
-  // sink of the edge and the CFGNodes are predecessors
-  // have to keep these until the end and all CFG nodes are mapped
-  // to ICFG nodes
-  std::map<OA_ptr<Node>,
-           std::set<OA_ptr<CFG::Node> > > edgeMap;
-
-
-  /*
-  // get the CFG for the root procedure
-  OA_ptr<CFG::Interface> rootCFGInterface = eachCFG->getCFGResults(rootProc);
-  OA_ptr<CFG::CFGStandard> rootCFG 
-      = rootCFGInterface.convert<CFG::CFGStandard>();
-  if (debug) {
-      std::cout << "--- rootCFG" << std::endl;
-      rootCFG->dumpdot(std::cout, mIR);
-  }
-
-  // get entry and exit node for cfg
-  OA_ptr<CFG::Interface::Node> temp = rootCFG->getEntry();
-  OA_ptr<CFG::CFGStandard::Node> cfgNode 
-      = temp.convert<CFG::CFGStandard::Node>();
-  OA_ptr<ICFGStandard::Node> icfgNode 
-      = create_icfg_node(icfg, rootProc, ENTRY_NODE, cfgNode);
-
-  temp = rootCFG->getExit();
-  cfgNode = temp.convert<CFG::CFGStandard::Node>();
-  icfgNode = create_icfg_node(icfg, rootProc, EXIT_NODE, cfgNode);
-  */
-
-  // worklist and set of procs that have already been visited
-  std::list<ProcHandle> worklist;
-  std::set<ProcHandle> alreadyVisited;
-  for ( procIter->reset(); procIter->isValid(); (*procIter)++ ) {
-    worklist.push_back(procIter->current());
-  }
-
-  // while there is a proc in the worklist
-  while ( ! worklist.empty() ) {
-    
-    // get next proc and make sure it hasn't already been visited
-    ProcHandle proc = worklist.front();
-    worklist.pop_front();
-    if (alreadyVisited.find(proc)!=alreadyVisited.end()) {
-        continue;
-    } else {
-        alreadyVisited.insert(proc);
-    }
+    OA_ptr<Edge> icfgEdge;
 
     // get cfg 
-    OA_ptr<CFG::CFGInterface> cfgInterface = eachCFG->getCFGResults(proc);
+    OA_ptr<CFG::CFGInterface> cfgInterface = mEachCFG->getCFGResults(proc);
     //cfgInterface->output(*mIR);
  
     OA_ptr<CFG::CFG> cfg = cfgInterface.convert<CFG::CFG>();
+
+    // reuse the placeholder entry and exit nodes
+    if (mDemandDriven) {
+      OA_ptr<Node> entry, exit;
+      get_proc_stubs(icfg, proc, entry, exit);
+      OA_ptr<CFG::NodeInterface> temp = cfg->getEntry();
+      OA_ptr<CFG::Node> cfgNode = temp.convert<CFG::Node>();
+      entry->setCFGNode(cfgNode);
+      mCFGNodeToICFGNode[cfgNode] = entry;
+      temp = cfg->getExit();
+      cfgNode = temp.convert<CFG::Node>();
+      exit->setCFGNode(cfgNode);
+      mCFGNodeToICFGNode[cfgNode] = exit;
+    }
+
     if (debug) {
       std::cout << "\n\n\n--- cfg" << std::endl;
       cfg->output(*mIR);
@@ -434,13 +402,13 @@ OA_ptr<ICFG> ManagerICFGStandard::performAnalysis(
         }
 
     } // end of loop over CFG nodes 
+}
 
-
-  } // worklist loop for procedures          
-  
-  // loop over edges and generate ICFG edges
-  std::map<OA_ptr<Node>,
-           std::set<OA_ptr<CFG::Node> > >::iterator mapIter;
+//! generate ICFG edges for the control-flow edges recorded in edgeMap
+void ManagerICFGStandard::link_edges(OA_ptr<ICFG> icfg, EdgeMap& edgeMap)
+{
+  OA_ptr<Edge> icfgEdge;
+  EdgeMap::iterator mapIter;
   for (mapIter=edgeMap.begin(); mapIter!=edgeMap.end(); mapIter++ ) {
       OA_ptr<Node> icfgNode = mapIter->first;
       std::set<OA_ptr<CFG::Node> >& nodeSet = mapIter->second;
@@ -452,10 +420,117 @@ OA_ptr<ICFG> ManagerICFGStandard::performAnalysis(
           icfg->addEdge(icfgEdge);
       }
   }
+}
+
+/*! Get the placeholder entry and exit nodes for a procedure when
+    building on demand, creating them and registering the procedure as
+    pending with the ICFG the first time.
+*/
+void ManagerICFGStandard::get_proc_stubs(OA_ptr<ICFG> icfg, ProcHandle proc,
+        OA_ptr<Node>& entry, OA_ptr<Node>& exit)
+{
+  if (mProcEntry[proc].ptrEqual(0)) {
+    OA_ptr<CFG::Node> emptyNode;
+    emptyNode = new CFG::Node;
+    mProcEntry[proc] = new Node(icfg, proc, ENTRY_NODE, emptyNode);
+    icfg->addNode(mProcEntry[proc]);
+    emptyNode = new CFG::Node;
+    mProcExit[proc] = new Node(icfg, proc, EXIT_NODE, emptyNode);
+    icfg->addNode(mProcExit[proc]);
+    icfg->addPendingProc(proc, mProcEntry[proc]);
+  }
+  entry = mProcEntry[proc];
+  exit = mProcExit[proc];
+}
+
+/*!
+    Creates an ICFG based upon the CFGs for the program
+*/
+OA_ptr<ICFG> ManagerICFGStandard::performAnalysis( 
+    OA_ptr<IRProcIterator> procIter,
+    OA_ptr<CFG::EachCFGInterface> eachCFG,
+    OA_ptr<CallGraph::CallGraphInterface> cGraph)
+{
+  OA_ptr<ICFG> icfg; icfg = new ICFG();
+
+  // for use within helper functions
+  mEachCFG = eachCFG;
+  mCallGraph = cGraph;
+
+  // list of edges that are needed, the ICFGStandard::Node is the
+  // sink of the edge and the CFGNodes are predecessors
+  // have to keep these until the end and all CFG nodes are mapped
+  // to ICFG nodes
+  EdgeMap edgeMap;
+
+  // worklist and set of procs that have already been visited
+  std::list<ProcHandle> worklist;
+  std::set<ProcHandle> alreadyVisited;
+  for ( procIter->reset(); procIter->isValid(); (*procIter)++ ) {
+    worklist.push_back(procIter->current());
+  }
+
+  // while there is a proc in the worklist
+  while ( ! worklist.empty() ) {
+    
+    // get next proc and make sure it hasn't already been visited
+    ProcHandle proc = worklist.front();
+    worklist.pop_front();
+    if (alreadyVisited.find(proc)!=alreadyVisited.end()) {
+        continue;
+    } else {
+        alreadyVisited.insert(proc);
+    }
+
+    build_proc(icfg, proc, worklist, edgeMap);
+
+  } // worklist loop for procedures          
+  
+  // loop over edges and generate ICFG edges
+  link_edges(icfg, edgeMap);
+
+  return icfg;
+}
+
+/*!
+    Creates an ICFG whose procedure bodies are built on demand
+*/
+OA_ptr<ICFG> ManagerICFGStandard::performDemandAnalysis( 
+    OA_ptr<IRProcIterator> rootIter,
+    OA_ptr<CFG::EachCFGInterface> eachCFG,
+    OA_ptr<CallGraph::CallGraphInterface> cGraph)
+{
+  OA_ptr<ICFG> icfg; icfg = new ICFG();
+
+  // the ICFG holds on to a builder of its own because it keeps 
+  // building after this call returns
+  OA_ptr<ManagerICFGStandard> builder;
+  builder = new ManagerICFGStandard(mIR);
+  builder->mEachCFG = eachCFG;
+  builder->mCallGraph = cGraph;
+  builder->mDemandDriven = true;
+
+  OA_ptr<ProcMaterializer> materializer;
+  materializer = new DemandProcMaterializer(builder);
+  icfg->setMaterializer(materializer);
+
+  for ( rootIter->reset(); rootIter->isValid(); (*rootIter)++ ) {
+    OA_ptr<Node> entry, exit;
+    builder->get_proc_stubs(icfg, rootIter->current(), entry, exit);
+  }
 
   return icfg;
 }
 
+void DemandProcMaterializer::materialize(OA_ptr<ICFG> icfg, ProcHandle proc)
+{
+  // callees only get placeholders so worklist stays empty
+  std::list<ProcHandle> worklist;
+  ManagerICFGStandard::EdgeMap edgeMap;
+  mBuilder->build_proc(icfg, proc, worklist, edgeMap);
+  mBuilder->link_edges(icfg, edgeMap);
+}
+
 
   } // end of namespace MPICFG
 } // end of namespace OA
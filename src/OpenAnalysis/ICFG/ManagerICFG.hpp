@@ -51,8 +51,30 @@ public:
                                         OA_ptr<CFG::EachCFGInterface>,
                                         OA_ptr<CallGraph::CallGraphInterface>);
 
+  /*! Creates an ICFG that only has entry and exit nodes for the given 
+      root procedures.  The CFG and ICFG nodes for the body of a 
+      procedure are built the first time a solver or query reaches
+      the procedure, so procedures that are not reachable from the
+      roots are never built.
+  */
+  OA_ptr<ICFG> performDemandAnalysis( OA_ptr<IRProcIterator> rootIter,
+                                      OA_ptr<CFG::EachCFGInterface>,
+                                      OA_ptr<CallGraph::CallGraphInterface>);
+
 private: // helper functions
 
+  // ICFG node that is the sink of an edge and the CFG nodes that
+  // are the predecessors for that edge
+  typedef std::map<OA_ptr<Node>,std::set<OA_ptr<CFG::Node> > > EdgeMap;
+
+  void build_proc(OA_ptr<ICFG> icfg, ProcHandle proc,
+        std::list<ProcHandle>& worklist, EdgeMap& edgeMap);
+
+  void link_edges(OA_ptr<ICFG> icfg, EdgeMap& edgeMap);
+
+  void get_proc_stubs(OA_ptr<ICFG> icfg, ProcHandle proc,
+        OA_ptr<Node>& entry, OA_ptr<Node>& exit);
+
   bool stmt_has_call(StmtHandle stmt);
 
   StmtHandle 
@@ -83,7 +105,28 @@ private: // member variables
       NodeToNodeMap;
   NodeToNodeMap mCFGNodeToICFGNode;
 
+  // placeholder entry and exit nodes when building on demand
+  bool mDemandDriven;
+  std::map<ProcHandle,OA_ptr<Node> > mProcEntry;
+  std::map<ProcHandle,OA_ptr<Node> > mProcExit;
+
+  friend class DemandProcMaterializer;
+};
+
+/*! 
+   Builds the body of a procedure for an ICFG created by 
+   ManagerICFGStandard::performDemandAnalysis.
+*/
+class DemandProcMaterializer : public virtual ProcMaterializer {
+public:
+  DemandProcMaterializer(OA_ptr<ManagerICFGStandard> builder)
+      : mBuilder(builder) {}
+  ~DemandProcMaterializer() {}
+
+  void materialize(OA_ptr<ICFG> icfg, ProcHandle proc);
 
+private:
+  OA_ptr<ManagerICFGStandard> mBuilder;
 };
 
   } // end of ICFG namespace
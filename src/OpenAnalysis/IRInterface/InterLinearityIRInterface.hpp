@@ -0,0 +1,40 @@
+/*! \file
+  
+  \brief Abstract IR interface for interprocedural Linearity analysis.  
+  
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef InterLinearityIRInterface_h
+#define InterLinearityIRInterface_h
+
+#include <OpenAnalysis/IRInterface/LinearityIRInterface.hpp>
+#include <OpenAnalysis/IRInterface/CalleeToCallerVisitorIRInterface.hpp>
+
+namespace OA {
+  namespace Linearity {
+
+//! The InterLinearityIRInterface abstract base class gives the methods
+//! ManagerInterLinearity needs on top of LinearityIRInterface, finding
+//! the calls in a statement and mapping callee locations to the caller.
+class InterLinearityIRInterface 
+    : public virtual LinearityIRInterface,
+      public virtual DataFlow::CalleeToCallerVisitorIRInterface 
+{
+ public:
+  InterLinearityIRInterface() { }
+  virtual ~InterLinearityIRInterface() { }
+ 
+  //! Given a statement, return its CallHandles
+  virtual OA_ptr<IRCallsiteIterator> getCallsites(StmtHandle h) = 0;
+
+};  
+
+  } // end of namespace Linearity
+} // end of namespace OA
+
+#endif 
@@ -0,0 +1,79 @@
+/*! \file
+  
+  \brief Implementation of InterLinearity.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "InterLinearity.hpp"
+
+namespace OA {
+  namespace Linearity {
+
+OA_ptr<LinearityMatrix> InterLinearity::getLinearityResults(ProcHandle proc)
+{
+    MutexLock guard(mLock);
+    OA_ptr<LinearityMatrix> retval;
+    std::map<ProcHandle,OA_ptr<LinearityMatrix> >::iterator found
+        = mProcToLinearity.find(proc);
+    if (found != mProcToLinearity.end()) { retval = found->second; }
+    return retval;
+}
+
+OA_ptr<LinearityMatrix> InterLinearity::getCallSummary(CallHandle call)
+{
+    MutexLock guard(mLock);
+    OA_ptr<LinearityMatrix> retval;
+    std::map<CallHandle,OA_ptr<LinearityMatrix> >::iterator found
+        = mCallToSummary.find(call);
+    if (found != mCallToSummary.end()) { retval = found->second; }
+    return retval;
+}
+
+void InterLinearity::mapProcToLinearity(ProcHandle proc, 
+                                        OA_ptr<LinearityMatrix> lm)
+{
+    MutexLock guard(mLock);
+    mProcToLinearity[proc] = lm;
+}
+
+void InterLinearity::mapCallToSummary(CallHandle call, 
+                                      OA_ptr<LinearityMatrix> summary,
+                                      IRHandlesIRInterface& ir)
+{
+    MutexLock guard(mLock);
+    std::map<CallHandle,OA_ptr<LinearityMatrix> >::iterator found
+        = mCallToSummary.find(call);
+    if (found == mCallToSummary.end()) {
+        mCallToSummary[call] = summary;
+    } else {
+        found->second = found->second->meet(summary, ir);
+    }
+}
+
+void InterLinearity::dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir)
+{
+    std::map<ProcHandle,OA_ptr<LinearityMatrix> >::iterator procIter;
+    for (procIter = mProcToLinearity.begin(); 
+         procIter != mProcToLinearity.end(); procIter++) 
+    {
+        os << "Procedure( " << ir->toString(procIter->first) << " )" 
+           << std::endl;
+        procIter->second->dump(os, ir);
+    }
+
+    std::map<CallHandle,OA_ptr<LinearityMatrix> >::iterator callIter;
+    for (callIter = mCallToSummary.begin(); 
+         callIter != mCallToSummary.end(); callIter++) 
+    {
+        os << "Call( " << ir->toString(callIter->first) << " )" << std::endl;
+        callIter->second->dump(os, ir);
+    }
+}
+
+  } // end of Linearity namespace
+} // end of OA namespace
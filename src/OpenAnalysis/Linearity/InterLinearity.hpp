@@ -0,0 +1,62 @@
+/*! \file
+  
+  \brief Linearity results for each procedure and summaries for calls.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef InterLinearity_H
+#define InterLinearity_H
+
+#include <OpenAnalysis/Linearity/LinearityMatrixStandard.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
+#include <map>
+
+namespace OA {
+  namespace Linearity {
+
+class InterLinearity {
+  public:
+    InterLinearity() {}
+    virtual ~InterLinearity() {}
+
+    //! Returns the LinearityMatrix at the exit of the given procedure
+    OA_ptr<LinearityMatrix> getLinearityResults(ProcHandle proc);
+        
+    //! Returns the summary of the procedures the call may call, with
+    //! the pairs already mapped to locations in the caller, or a null
+    //! OA_ptr if there isn't one
+    OA_ptr<LinearityMatrix> getCallSummary(CallHandle call);
+        
+    //*****************************************************************
+    // Output
+    //*****************************************************************
+    //! debugging output
+    void dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir);
+   
+    //*****************************************************************
+    // Construction methods 
+    //*****************************************************************
+
+    //! attach LinearityMatrix to procedure
+    void mapProcToLinearity(ProcHandle proc, OA_ptr<LinearityMatrix> lm);
+
+    //! meet summary into the one for the call, a call can have a
+    //! summary for each procedure it may call
+    void mapCallToSummary(CallHandle call, OA_ptr<LinearityMatrix> summary,
+                          IRHandlesIRInterface& ir);
+
+  private:
+    std::map<ProcHandle,OA_ptr<LinearityMatrix> > mProcToLinearity;
+    std::map<CallHandle,OA_ptr<LinearityMatrix> > mCallToSummary;
+    Mutex mLock;
+};
+
+  } // end of Linearity namespace
+} // end of OA namespace
+
+#endif
@@ -21,64 +21,143 @@ namespace OA {
 
 static bool debug = false;
 
+//************************************************************
+// LinearityLocTable
+//************************************************************
+unsigned int LinearityLocTable::idOf(OA_ptr<Location> loc)
+{
+    std::map<OA_ptr<Location>,unsigned int>::const_iterator 
+        found = mIds.find(loc);
+    if (found != mIds.end()) { return found->second; }
+    unsigned int id = mLocs.size();
+    mIds[loc] = id;
+    mLocs.push_back(loc);
+    return id;
+}
+
+int LinearityLocTable::findId(OA_ptr<Location> loc) const
+{
+    std::map<OA_ptr<Location>,unsigned int>::const_iterator 
+        found = mIds.find(loc);
+    return found == mIds.end() ? -1 : (int)found->second;
+}
+
+//************************************************************
+// 2 bit class codes packed into rows
+//************************************************************
+typedef std::vector<unsigned long> LinearityRow;
+
+static const unsigned int sCodesPerWord = sizeof(unsigned long) * 4;
+
+//! NODEP is 00, LINEAR 01 and NONLINEAR 11 so OR is the meet
+static unsigned long codeOf(LinearityClass lclass)
+{
+    switch (lclass.getLClass()) {
+      case LinearityClass::LCLASS_LINEAR:    return 1;
+      case LinearityClass::LCLASS_NONLINEAR: return 3;
+      default:                               return 0;
+    }
+}
+
+static LinearityClass classOf(unsigned long code)
+{
+    if (code == 1) { return LinearityClass(LinearityClass::LCLASS_LINEAR); }
+    return LinearityClass(LinearityClass::LCLASS_NONLINEAR);
+}
+
+static void setCode(LinearityRow& row, unsigned int w, unsigned long code)
+{
+    unsigned int word = w / sCodesPerWord;
+    unsigned int shift = 2 * (w % sCodesPerWord);
+    if (word >= row.size()) { 
+        if (code == 0) { return; }
+        row.resize(word + 1, 0); 
+    }
+    row[word] = (row[word] & ~(3UL << shift)) | (code << shift);
+}
+
+static bool isEmpty(const LinearityRow& row)
+{
+    LinearityRow::const_iterator wordIter;
+    for (wordIter = row.begin(); wordIter != row.end(); wordIter++) {
+        if (*wordIter != 0) { return false; }
+    }
+    return true;
+}
+
+//! words past the end of the shorter row count as 0
+static bool rowsEqual(const LinearityRow& row1, const LinearityRow& row2)
+{
+    unsigned int size = row1.size() > row2.size() ? row1.size() : row2.size();
+    for (unsigned int i = 0; i < size; i++) {
+        unsigned long word1 = i < row1.size() ? row1[i] : 0;
+        unsigned long word2 = i < row2.size() ? row2[i] : 0;
+        if (word1 != word2) { return false; }
+    }
+    return true;
+}
+
+//! ORs from into into
+static void meetRow(LinearityRow& into, const LinearityRow& from)
+{
+    if (into.size() < from.size()) { into.resize(from.size(), 0); }
+    for (unsigned int i = 0; i < from.size(); i++) { into[i] |= from[i]; }
+}
+
+//! ORs code into the code of w
+static void meetCode(LinearityRow& row, unsigned int w, unsigned long code)
+{
+    unsigned int word = w / sCodesPerWord;
+    if (word >= row.size()) { row.resize(word + 1, 0); }
+    row[word] |= code << (2 * (w % sCodesPerWord));
+}
+
 //************************************************************
 //LinearityMatrix Definitions
 //************************************************************
+LinearityMatrix::LinearityMatrix()
+{
+     mLocTable = new LinearityLocTable;
+}
+
+LinearityMatrix::LinearityMatrix(int num)
+{
+     mLocTable = new LinearityLocTable;
+}
+
 // When calculating DEPS, we need to iterate over
 // all the pairs where a particular variable is
 // the first var in the pair.
 //      ie. <<v,w>, class> in IN(b) for a particular v
 OA_ptr<LinearityPairIterator> LinearityMatrix::getPairIteratorForVar( OA_ptr<Location> v )
 {
-     //Return the Iterator to all the LinearityPairs for Abstract *v
-     mIter = mLMmap->find(v);
      OA_ptr<LinearityPairIterator> retval;
-     if (mIter != mLMmap->end()) {
-          retval = new LinearityPairIterator(mIter->second); 
-          return retval; 
+     int id = mLocTable->findId(v);
+     std::map<unsigned int,Row>::iterator rowIter;
+     if (id >= 0 && (rowIter = mRows.find(id)) != mRows.end()) {
+          retval = new LinearityPairIterator(getLPSet(id, rowIter->second)); 
      } else {
           retval = new LinearityPairIterator();
-	  return retval; 
      }
+     return retval; 
 }
 
 void LinearityMatrix::putLPSet(OA_ptr<Location> v, OA_ptr<std::set<OA_ptr<LinearityPair> > >lpSet) {
-     //mLMmap->insert(make_pair(v,lpSet));
-     (*mLMmap)[v] = (lpSet);
+     Row row;
+     std::set<OA_ptr<LinearityPair> >::iterator lpIter;
+     for (lpIter = lpSet->begin(); lpIter != lpSet->end(); lpIter++) {
+          OA_ptr<LinearityPair> lp = *lpIter;
+          setCode(row, mLocTable->idOf(lp->getVar2()), codeOf(lp->getLClass()));
+     }
+     unsigned int id = mLocTable->idOf(v);
+     if (isEmpty(row)) { mRows.erase(id); }
+     else { mRows[id] = row; }
 }
 
 void LinearityMatrix::putLPair(OA_ptr<LinearityPair> lp) {
-     //std::cout << "Find: ";
-     //Locate the Key v
-     mIter = mLMmap->find(lp->getVar1());
-     if (mIter != mLMmap->end()) {
-          //std::cout << "Yes\n";
-
-          //Key v exist, delete current lp and insert new lp to current set
-          mIter->second->erase(lp);
-          mIter->second->insert(lp);
-          //((*mLMmap)[cv])->erase(clp);
-          //((*mLMmap)[cv])->insert(clp);
-			
-	  //std::cout << "  Inserted New Pair! <" << (lp->getVar1()->getVar()) 
-	  //          << "," << (lp->getVar2()->getVar()) << ">," 
-	  //          << lp->getLClass().getLClass() << "\n";
-      } else {
-           //std::cout << "No\n";
-
-           //create emptly set
-           OA_ptr<std::set<OA_ptr<LinearityPair> > > lpSet;
-           lpSet = new std::set<OA_ptr<LinearityPair> >;
-			
-           //mLMmap->insert(std::map<OA_ptr<Location>,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::value_type(cv,lpSet));
-           //insert lp into new set, then insert v and set into map
-           lpSet->insert(lp);
-           mLMmap->insert(make_pair(lp->getVar1(),lpSet));
-			
-           //std::cout << "Created New One! <" << lp->getVar1()->getVar() << "> -> <"
-	   //          << (lp->getVar1()->getVar()) << ","
-	   //          << (lp->getVar2()->getVar()) << ">\n";
-      } 
+     //replaces the class of <v,w> if it is there
+     Row& row = mRows[mLocTable->idOf(lp->getVar1())];
+     setCode(row, mLocTable->idOf(lp->getVar2()), codeOf(lp->getLClass()));
 }
 
 OA_ptr<DataFlow::DataFlowSet> LinearityMatrix::clone()
@@ -94,129 +173,37 @@ OA_ptr<DataFlow::DataFlowSet> LinearityMatrix::clone()
 // the dataflow sets.
 OA_ptr<LinearityMatrix> LinearityMatrix::meet( OA_ptr<LinearityMatrix> other, IRHandlesIRInterface& pIR )
 {
-     //create a result matrix
-     OA_ptr<LinearityMatrix> result; 
-     //start by putting the Other Map into result, then you can
-     //overwrite specific LinearityPairs to that set if nessesary
      if (other.ptrEqual(0)) {
        assert(0);
      }
-     result = new LinearityMatrix(*other);
-     //result = other;
-     //Iterate through the Map
-     for(mIter = mLMmap->begin();mIter != mLMmap->end(); mIter++)
-     {
-          //create set iterator for this map 
-          OA_ptr<LinearityPairIterator> thisIter; 
-          thisIter = new LinearityPairIterator(mIter->second);
-          //create set iterator for other map
-          OA_ptr<LinearityPairIterator> lpIter; 
-          lpIter = other->getPairIteratorForVar(mIter->first);
-          //iterate throught this map's set
-          for ( ; thisIter->isValid(); (*thisIter)++)
-	  {
-               OA_ptr<LinearityPair> lpthis;
-               lpthis = thisIter->current();
-               //look for this LinearityPair match in the other set  
-               lpIter->findIter(lpthis);
-	        		
-               //check for a match in LinearityPair
-               if (lpIter->isValid())
-               {
-                    OA_ptr<LinearityPair> lp;
-                    lp = lpIter->current();
-
-                    if (debug) {
-                      std::cout << "VALID MATCH:\nLinearity Pair OTHER:\n ";
-                      lp->output(pIR);
-                      std::cout << "Linearity Pair THIS:\n";
-                      lpthis->output(pIR);
-                    }
-                    //put LinearityPair in a new LM result after meeting the LClasses;
-                    LinearityClass lc = lpthis->getLClass().meet(lp->getLClass());
-		    if (debug) {
-	              std::cout << "Meet Class: ";
-		      lc.output();
-		    }
-
-        	    if (lc == lpthis->getLClass()) { //std::cout << "Meet First ";lc.output();
-                         result->putLPair(lpthis); }
-        	    else { //std::cout << "Meet Second ";lc.output();
-		         result->putLPair(lp); }
-        				
-               } else {
-	       //there was no match, just insert LinearityPair
-               result->putLPair(lpthis);	
-               }//end if match
-	  }//end for set
-     }//end for map
-     return result;
+     return meet(*other, pIR);
 }
 
 OA_ptr<LinearityMatrix> LinearityMatrix::meet( DataFlowSet &other, IRHandlesIRInterface& pIR )
 {
-     //create a result matrix
+     LinearityMatrix &recastOther = dynamic_cast<LinearityMatrix&>(other);
+
+     //start with the other rows and OR ours into them, pairs only
+     //in one of the matrices keep their class and pairs in both
+     //get the meet of their classes
      OA_ptr<LinearityMatrix> result; 
-     result = new LinearityMatrix;
+     if (mLocTable.ptrEqual(recastOther.mLocTable)) {
+          result = new LinearityMatrix(recastOther);
+          std::map<unsigned int,Row>::const_iterator rowIter;
+          for (rowIter = mRows.begin(); rowIter != mRows.end(); rowIter++) {
+               meetRow(result->mRows[rowIter->first], rowIter->second);
+          }
+     } else {
+          //a new table, so neither operand's table is changed
+          result = new LinearityMatrix;
+          renumberInto(*result);
+          recastOther.renumberInto(*result);
+     }
 
-     LinearityMatrix &recastOther = dynamic_cast<LinearityMatrix&>(other);
-     
-     //start by putting the Other Map into result, then you can
-     //overwrite specific LinearityPairs to that set if nessesary
-     OA_ptr<DataFlow::DataFlowSet> temp = recastOther.clone();
-     result = temp.convert<LinearityMatrix>();
-
-     //Iterate through the Map
-     for(mIter = mLMmap->begin();mIter != mLMmap->end(); mIter++)
-     {
-          //create set iterator for this map 
-          OA_ptr<LinearityPairIterator> thisIter; 
-          thisIter = new LinearityPairIterator(mIter->second);
-          //create set iterator for other map
-          OA_ptr<LinearityPairIterator> lpIter; 
-          lpIter = recastOther.getPairIteratorForVar(mIter->first);
-          //iterate throught this map's set
-          for ( ; thisIter->isValid(); (*thisIter)++)
-	  {
-               OA_ptr<LinearityPair> lpthis;
-               lpthis = thisIter->current();
-               //look for this LinearityPair match in the other set  
-               lpIter->findIter(lpthis);
-	        		
-               //check for a match in LinearityPair
-               if (lpIter->isValid())
-               {
-                    OA_ptr<LinearityPair> lp;
-                    lp = lpIter->current();
-                    //debug output
-                    //std::cout << "\t<<" << lpthis->getVar1()->getVar() << "," \
-	            //     << lpthis->getVar2()->getVar() << ">,";
-	            //     if (lpthis->getLClass().getLClass() == 1) {
-		    //     std::cout << "Linear" << ">  -AND-";
-		    //     } else {
-		    //     std::cout << "Nonlinear" << ">  -AND-";
-		    //     }
-	            //std::cout << "  <<" << lp->getVar1()->getVar() << "," \
-	            //               << lp->getVar2()->getVar() << ">,";
-		    //     if (lp->getLClass().getLClass() == 1) {
-		    //     std::cout << "Linear" << ">\n";
-		    //     } else {
-		    //     std::cout << "Nonlinear" << ">\n";
-                    //     }//end debug output
-				
-                    //put LinearityPair in a new LM result after meeting the LClasses;
-                    LinearityClass lc = lpthis->getLClass().meet(lp->getLClass());
-        	    if (lc == lpthis->getLClass()) { //std::cout << "Meet First ";lc.output();
-                         result->putLPair(lpthis); }
-        	    else { //std::cout << "Meet Second ";lc.output();
-		         result->putLPair(lp); }
-        				
-               } else {
-	       //there was no match, just insert LinearityPair
-               result->putLPair(lpthis);	
-               }//end if match
-	  }//end for set
-     }//end for map
+     if (debug) {
+          std::cout << "LinearityMatrix::meet result" << std::endl;
+          result->output(pIR);
+     }
      return result;
 }
 
@@ -227,13 +214,15 @@ OA_ptr<LinearityMatrix> LinearityMatrix::meet( DataFlowSet &other, IRHandlesIRIn
 //linearity pairs back to the Map for a specific v. 
 void LinearityMatrix::putDepsSet(OA_ptr<Location> v, OA_ptr<LinearityDepsSet> deps)
 {
-     OA_ptr<std::set<OA_ptr<LinearityPair> > > lpdeps;
-     OA_ptr<std::set<OA_ptr<LinearityPair> > > lpSet;
-
-     lpdeps = deps->convertToLinearityPair(v);
-     lpSet = new std::set<OA_ptr<LinearityPair> >(*(lpdeps));
-
-     (*mLMmap)[v] = (lpSet);
+     Row row;
+     OA_ptr<VarClassPairIterator> vcIter = deps->getVarClassPairIterator();
+     for ( ; vcIter->isValid(); (*vcIter)++) {
+          OA_ptr<VarClassPair> vcp = vcIter->current();
+          setCode(row, mLocTable->idOf(vcp->getVar()), codeOf(vcp->getLClass()));
+     }
+     unsigned int id = mLocTable->idOf(v);
+     if (isEmpty(row)) { mRows.erase(id); }
+     else { mRows[id] = row; }
 }
 
 //getDepSet
@@ -247,50 +236,91 @@ OA_ptr<LinearityDepsSet> LinearityMatrix::getDepsSet(OA_ptr<Location> v)
 {
      OA_ptr<LinearityDepsSet> lds; 
      lds = new LinearityDepsSet();
-        	
-     mIter = mLMmap->find(v);
-     if (mIter != mLMmap->end()) {
-          OA_ptr<LinearityPairIterator> lpIter; 
-          lpIter = new LinearityPairIterator(mIter->second);
-          for( ;lpIter->isValid();(*lpIter)++) {
+
+     int id = mLocTable->findId(v);
+     if (id < 0) { return lds; }
+     std::map<unsigned int,Row>::const_iterator rowIter = mRows.find(id);
+     if (rowIter == mRows.end()) { return lds; }
+
+     const Row& row = rowIter->second;
+     for (unsigned int word = 0; word < row.size(); word++) {
+          if (row[word] == 0) { continue; }
+          for (unsigned int i = 0; i < sCodesPerWord; i++) {
+               unsigned long code = (row[word] >> (2 * i)) & 3;
+               if (code == 0) { continue; }
                OA_ptr<VarClassPair> vcp;
-        			
-               OA_ptr<LinearityPair> lp;
-	       lp = lpIter->current();
-               vcp = lp->getVarClassPair();
+               vcp = new VarClassPair(
+                         mLocTable->locOf(word * sCodesPerWord + i), 
+                         classOf(code));
                lds->insert(vcp);
-	  }
+          }
      }
      return lds;
 }
 
+OA_ptr<std::set<OA_ptr<LinearityPair> > > 
+LinearityMatrix::getLPSet(unsigned int v, const Row& row)
+{
+     OA_ptr<std::set<OA_ptr<LinearityPair> > > lpSet;
+     lpSet = new std::set<OA_ptr<LinearityPair> >;
+     OA_ptr<Location> vLoc = mLocTable->locOf(v);
+     for (unsigned int word = 0; word < row.size(); word++) {
+          if (row[word] == 0) { continue; }
+          for (unsigned int i = 0; i < sCodesPerWord; i++) {
+               unsigned long code = (row[word] >> (2 * i)) & 3;
+               if (code == 0) { continue; }
+               OA_ptr<LinearityPair> lp;
+               lp = new LinearityPair(vLoc, 
+                         mLocTable->locOf(word * sCodesPerWord + i), 
+                         classOf(code));
+               lpSet->insert(lp);
+          }
+     }
+     return lpSet;
+}
+
+void LinearityMatrix::renumberInto(LinearityMatrix& into) const
+{
+     std::map<unsigned int,Row>::const_iterator rowIter;
+     for (rowIter = mRows.begin(); rowIter != mRows.end(); rowIter++) {
+          const Row& row = rowIter->second;
+          if (isEmpty(row)) { continue; }
+          Row& intoRow = into.mRows[
+              into.mLocTable->idOf(mLocTable->locOf(rowIter->first))];
+          for (unsigned int word = 0; word < row.size(); word++) {
+               if (row[word] == 0) { continue; }
+               for (unsigned int i = 0; i < sCodesPerWord; i++) {
+                    unsigned long code = (row[word] >> (2 * i)) & 3;
+                    if (code == 0) { continue; }
+                    meetCode(intoRow, into.mLocTable->idOf(
+                                 mLocTable->locOf(word * sCodesPerWord + i)),
+                             code);
+               }
+          }
+     }
+}
 
 //getMap
 OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > LinearityMatrix::getMap() 
 {
-     return mLMmap;
+     OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > retval;
+     retval = new std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >;
+
+     std::map<unsigned int,Row>::const_iterator rowIter;
+     for (rowIter = mRows.begin(); rowIter != mRows.end(); rowIter++) {
+          if (isEmpty(rowIter->second)) { continue; }
+          (*retval)[mLocTable->locOf(rowIter->first)] 
+              = getLPSet(rowIter->first, rowIter->second);
+     }
+     return retval;
 }
 
 
 void LinearityMatrix::output() {
-     for(mIter = mLMmap->begin();mIter != mLMmap->end(); mIter++)
+     OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > lpMap = getMap();
+     std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
+     for(mapIter = lpMap->begin();mapIter != lpMap->end(); mapIter++)
      {
-          //std::cout << "<" << mIter->first->getVar() << ">" << " ->";
-          OA_ptr<LinearityPairIterator> thisIter; 
-          thisIter = new LinearityPairIterator(mIter->second);
-
-          for ( ; thisIter->isValid(); (*thisIter)++)
-          {
-               OA_ptr<LinearityPair> lpthis;
-               lpthis = thisIter->current();
-               //std::cout << "\t<<" << lpthis->getVar1()->getVar() << "," \
-     	       //     << lpthis->getVar2()->getVar() << ">,";
-	       //     if (lpthis->getLClass().getLClass() == 1) {
-	       //     std::cout << "Linear" << ">\n";
-	       //     } else {
-	       //     std::cout << "Nonlinear" << ">\n";
-	       //     }
-          }
           std::cout << std::endl;
      }
 }
@@ -299,25 +329,19 @@ void LinearityMatrix::output(IRHandlesIRInterface& ir)
 {
     sOutBuild->objStart("LinearityStandard");
 
+    OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > lpMap = getMap();
+    std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
+
     sOutBuild->mapStart("mLMmap", "OA_ptr<Location>", ",OA_ptr<std::set<OA_ptr<LinearityPair> > >\n");
-    for (mIter = mLMmap->begin(); mIter != mLMmap->end(); mIter++) {
-//        OA_ptr<Location> s;
-//        SymHandle sym;
-//        if (mIter->first->isaNamed()) {
-//          OA_ptr<NamedLoc> ns = mIter->first.convert<NamedLoc>();
-//          s = new NamedLoc(*ns);
-//          sym = ns->getSymHandle();
-//         }
-        
+    for (mapIter = lpMap->begin(); mapIter != lpMap->end(); mapIter++) {
         OA_ptr<LinearityPairIterator> lpIter; 
-        lpIter = new LinearityPairIterator(mIter->second);
+        lpIter = new LinearityPairIterator(mapIter->second);
 
         if ( !(lpIter->isValid()) ) continue;
 
         sOutBuild->mapEntryStart();
           sOutBuild->mapKeyStart();
-            //std::cout << char(sym.hval());
-            (mIter->first)->output(ir);
+            (mapIter->first)->output(ir);
           sOutBuild->mapKeyEnd();
         sOutBuild->mapValueStart();
 
@@ -341,17 +365,17 @@ void LinearityMatrix::output(IRHandlesIRInterface& ir)
 
 void LinearityMatrix::dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir)
 {
-    for (mIter = mLMmap->begin(); mIter != mLMmap->end(); mIter++) {
-        OA_ptr<Location> v = mIter->first;
+    OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > lpMap = getMap();
+    std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
+    for (mapIter = lpMap->begin(); mapIter != lpMap->end(); mapIter++) {
+        OA_ptr<Location> v = mapIter->first;
 
-        //os << "Location(" << v.hval() << ") " << ir->toString(v) 
-        //   << std::endl << "\tLinearityPair: " << std::endl;
         os << "Location(";
         v->dump(std::cout,ir);
         os <<")\n";
         // iterate over LinearityPairs
         OA_ptr<LinearityPairIterator> lpIter; 
-        lpIter = new LinearityPairIterator(mIter->second);
+        lpIter = new LinearityPairIterator(mapIter->second);
         
         if (!(lpIter->isValid()))
             os << "\tLP=NULL\n";
@@ -368,97 +392,54 @@ void LinearityMatrix::dump(std::ostream& os, OA_ptr<IRHandlesIRInterface> ir)
 
 LinearityMatrix& LinearityMatrix::operator=(const LinearityMatrix& other)
 {
-    mLMmap = other.mLMmap;
+    mRows = other.mRows;
+    mLocTable = other.mLocTable;
     return *this;
 }
 
 bool LinearityMatrix::operator ==(DataFlow::DataFlowSet &other) const
 {
     LinearityMatrix& recastOther = dynamic_cast<LinearityMatrix&>(other);
-    if (mLMmap->size() != recastOther.mLMmap->size()) {
-        return false;
+    if (!mLocTable.ptrEqual(recastOther.mLocTable)) {
+        // compare in a new table, so neither table is changed
+        LinearityMatrix renumbered, otherRenumbered(renumbered.mLocTable);
+        renumberInto(renumbered);
+        recastOther.renumberInto(otherRenumbered);
+        return renumbered == otherRenumbered;
     }
-    std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
-    for(mapIter = mLMmap->begin();mapIter != mLMmap->end(); mapIter++)
-     {
-          //create set iterator for this map 
-          OA_ptr<LinearityPairIterator> thisIter; 
-          thisIter = new LinearityPairIterator(mapIter->second);
-          //create set iterator for other map
-          OA_ptr<LinearityPairIterator> otherIter; 
-          otherIter = recastOther.getPairIteratorForVar(mapIter->first);
-          //iterate throught this map's set and compare
-          for ( ; thisIter->isValid() && otherIter->isValid(); (*thisIter)++,(*otherIter)++)
-	  {
-              //get this linearity pair
-              OA_ptr<LinearityPair> lpthis;
-              lpthis = thisIter->current();
-              //get other linearity pair
-              OA_ptr<LinearityPair> lpother;
-              lpother = otherIter->current();
-
-              //compare and return if not equal
-              if ((*lpthis) != (*lpother))
-                  return false;
 
-          }
-              
-     } 
-
-    
-/*    LinearityMatrix& recastOther = dynamic_cast<LinearityMatrix&>(other);
-
-    if (mLMmap->size() != recastOther.mLMmap->size()) {
-        return false;
+    // a missing row is the same as one with no pairs
+    Row empty;
+    std::map<unsigned int,Row>::const_iterator rowIter, otherIter;
+    for (rowIter = mRows.begin(); rowIter != mRows.end(); rowIter++) {
+        otherIter = recastOther.mRows.find(rowIter->first);
+        const Row& otherRow = otherIter == recastOther.mRows.end() 
+                              ? empty : otherIter->second;
+        if (!rowsEqual(rowIter->second, otherRow)) { return false; }
+    }
+    for (otherIter = recastOther.mRows.begin(); 
+         otherIter != recastOther.mRows.end(); otherIter++) 
+    {
+        if (mRows.find(otherIter->first) == mRows.end()
+            && !isEmpty(otherIter->second)) 
+        { 
+            return false; 
+        }
     }
-*/
     return true;
 }
 
 bool LinearityMatrix::operator !=(DataFlow::DataFlowSet &other) const
 {
-    LinearityMatrix& recastOther = dynamic_cast<LinearityMatrix&>(other);
-    if (mLMmap->size() != recastOther.mLMmap->size()) {
-        return true;
-    }
-    std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
-    for(mapIter = mLMmap->begin();mapIter != mLMmap->end(); mapIter++)
-     {
-          //create set iterator for this map 
-          OA_ptr<LinearityPairIterator> thisIter; 
-          thisIter = new LinearityPairIterator(mapIter->second);
-          //create set iterator for other map
-          OA_ptr<LinearityPairIterator> otherIter; 
-          otherIter = recastOther.getPairIteratorForVar(mapIter->first);
-          //iterate throught this map's set and compare
-          for ( ; thisIter->isValid() && otherIter->isValid(); (*thisIter)++,(*otherIter)++)
-	  {
-              //get this linearity pair
-              OA_ptr<LinearityPair> lpthis;
-              lpthis = thisIter->current();
-              //get other linearity pair
-              OA_ptr<LinearityPair> lpother;
-              lpother = otherIter->current();
-
-              //compare and return if not equal
-              if ((*lpthis) != (*lpother))
-                  return true;
-
-          }
-              
-     } 
-
-    //LinearityMatrix& recastOther = dynamic_cast<LinearityMatrix&>(other);
-    //if (mLMmap->size() != recastOther.mLMmap->size()) {
-    //    return true;
-    //} 
-    return false;
-    //return (!(*this==other)); 
+    return !(*this == other);
 }
 
 bool LinearityMatrix::operator ==(const LinearityMatrix& other) const
 {
-    return LinearityMatrix::operator==(const_cast<LinearityMatrix&>(other));
+    // go through the DataFlowSet version, calling this one with a
+    // LinearityMatrix& would pick this one again
+    DataFlow::DataFlowSet& recastOther = const_cast<LinearityMatrix&>(other);
+    return LinearityMatrix::operator==(recastOther);
 }
 
   } // end of namespace Linearity
@@ -24,6 +24,7 @@
 #include <map>
 #include <set>
 #include <list>
+#include <vector>
 
 // Local headers
 #include "LinearityPair.hpp"
@@ -41,50 +42,57 @@
 namespace OA {
   namespace Linearity {
 
+// Numbers the locations of the LinearityMatrix rows of one analysis,
+// comparing them by value.  There is no lock: matrices sharing a table
+// may be read from several threads, but only changed from one.
+class LinearityLocTable {
+    public:
+        LinearityLocTable() {}
+        ~LinearityLocTable() {}
+
+        //! number of loc, giving it one if it doesn't have one yet
+        unsigned int idOf(OA_ptr<Location> loc);
+        //! number of loc, or -1 if it doesn't have one
+        int findId(OA_ptr<Location> loc) const;
+        OA_ptr<Location> locOf(unsigned int id) const { return mLocs[id]; }
+
+    private:
+        std::map<OA_ptr<Location>,unsigned int> mIds;
+        std::vector<OA_ptr<Location> > mLocs;
+};
+
 // Keep in mind that the default should be LCLASS_NODEP.
 // You probably don't want to store that for all var pairs.
 // Just store info for the ones that aren't that.
+//
+// The row for v packs the class of each <<v,w>,class> into 2 bits at
+// the number w has in the LinearityLocTable of the matrix, 00 for
+// NODEP, 01 for LINEAR and 11 for NONLINEAR, so that the meet of two
+// rows is their bitwise OR.  An explicit NODEP pair is therefore the
+// same as no pair; NODEP is the top of the classes, so it never
+// changes a meet.  Only rows with some pair are kept.
+//
+// Matrices made by the same manager share its table and are met word
+// by word.  A matrix made with the default constructor has a table of
+// its own, and meeting or comparing matrices with different tables
+// renumbers them into a new one first.
 class LinearityMatrix : public virtual DataFlow::DataFlowSet,
                         public virtual Linearity::Interface,
                         public virtual Annotation {
     public:
-        LinearityMatrix() {
-    	   mLMmap = new std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >;
-        }
+        LinearityMatrix();
+
+        //! an empty matrix numbering its locations in locTable
+        LinearityMatrix(OA_ptr<LinearityLocTable> locTable)
+            : mLocTable(locTable) {}
 
         // num is the number of variables to maintain linearity
         // relationships amongst
-        LinearityMatrix(int num) {
-    	   mLMmap = new std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >;
-        }
-
-  //LinearityMatrix(const LinearityMatrix &other) : mLMmap(other.mLMmap) {
-	  // go create an empty mLMmap, and populate it with the cloned contents
-	  // of other.mLMmap.  (make sure that the clones of the contents are
-	  // really making clones)
-        LinearityMatrix(const LinearityMatrix &other) {
-	  mLMmap = new std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >;
-	  // iterate through other.mLMmap and 
-	  std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mapIter;
-	  mapIter = other.mLMmap->begin();
-	  for (; mapIter!=other.mLMmap->end(); mapIter++) {
-	    OA_ptr<Location> loc = mapIter->first;
-	    OA_ptr<std::set<OA_ptr<LinearityPair> > > lpSet = mapIter->second;
-	    OA_ptr<std::set<OA_ptr<LinearityPair> > > cplpSet;
-	    cplpSet = new std::set<OA_ptr<LinearityPair> >;
-	    std::set<OA_ptr<LinearityPair> >::iterator setIter;
-	    setIter = lpSet->begin();
-	    for (; setIter!=lpSet->end(); setIter++) {
-	      OA_ptr<LinearityPair> lp = *setIter;
-	      OA_ptr<LinearityPair> cplp;
-	      cplp = new LinearityPair(lp->getVar1(),lp->getVar2(),lp->getLClass());
-	      cplpSet->insert(cplp);
-	    }
-	    (*mLMmap)[loc]=cplpSet;
-	  }
-	    
-
-        }
+        LinearityMatrix(int num);
+
+        //! shares the table of other
+        LinearityMatrix(const LinearityMatrix &other) 
+            : mRows(other.mRows), mLocTable(other.mLocTable) {}
 
         // When calculating DEPS, we need to iterate over
         // all the pairs where a particular variable is
@@ -121,6 +129,7 @@ class LinearityMatrix : public virtual DataFlow::DataFlowSet,
         OA_ptr<LinearityDepsSet> getDepsSet(OA_ptr<Location> v);
         
         //getMap
+        //Builds the pairs for every row, ordered by location
         OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > getMap(); 
         
         void output();
@@ -141,9 +150,21 @@ class LinearityMatrix : public virtual DataFlow::DataFlowSet,
         bool operator ==(const LinearityMatrix& other) const;
         
     private:
-    //Map an AbstractVar <v> with a set of VarClassPair <w,class>
-    OA_ptr<std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > mLMmap;
-    std::map<OA_ptr<Location> ,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator mIter;
+    //! 2 bit class codes for each numbered w, see above
+    typedef std::vector<unsigned long> Row;
+
+    //! pairs of row v as LinearityPairs
+    OA_ptr<std::set<OA_ptr<LinearityPair> > > getLPSet(unsigned int v,
+                                                       const Row& row);
+
+    //! meets the pairs of this into into, numbered in the table of into
+    void renumberInto(LinearityMatrix& into) const;
+
+    //Map the number of v to the classes of its pairs <<v,w>,class>
+    std::map<unsigned int,Row> mRows;
+
+    //! gives the locations for the numbers in mRows
+    OA_ptr<LinearityLocTable> mLocTable;
 
 };     
 
@@ -0,0 +1,305 @@
+/*! \file
+  
+  \brief The AnnotationManager that generates InterLinearity.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ManagerInterLinearity.hpp"
+#include <Utils/Util.hpp>
+
+
+namespace OA {
+  namespace Linearity {
+
+static bool debug = false;
+
+//! pairs of a matrix being built, meeting the classes of repeated pairs
+typedef std::map<OA_ptr<Location>,std::map<OA_ptr<Location>,LinearityClass> >
+    PairClassMap;
+
+static void meetPair(PairClassMap& pairs, OA_ptr<Location> v, 
+                     OA_ptr<Location> w, LinearityClass lclass)
+{
+    std::map<OA_ptr<Location>,LinearityClass>& row = pairs[v];
+    std::map<OA_ptr<Location>,LinearityClass>::iterator found = row.find(w);
+    if (found == row.end()) {
+        row.insert(std::make_pair(w, lclass));
+    } else {
+        found->second = found->second.meet(lclass);
+    }
+}
+
+static OA_ptr<LinearityMatrix> matrixOf(PairClassMap& pairs)
+{
+    OA_ptr<LinearityMatrix> retval;
+    retval = new LinearityMatrix;
+    PairClassMap::iterator rowIter;
+    for (rowIter = pairs.begin(); rowIter != pairs.end(); rowIter++) {
+        OA_ptr<LinearityDepsSet> deps;
+        deps = new LinearityDepsSet;
+        std::map<OA_ptr<Location>,LinearityClass>::iterator classIter;
+        for (classIter = rowIter->second.begin(); 
+             classIter != rowIter->second.end(); classIter++) 
+        {
+            OA_ptr<VarClassPair> vcp;
+            vcp = new VarClassPair(classIter->first, classIter->second);
+            deps->insert(vcp);
+        }
+        retval->putDepsSet(rowIter->first, deps);
+    }
+    return retval;
+}
+
+/*!
+*/
+ManagerInterLinearity::ManagerInterLinearity(
+  OA_ptr<InterLinearityIRInterface> _ir) : mIR(_ir), mSCCSchedule(false), mNumThreads(0)
+{
+    OA_DEBUG_CTRL_MACRO("DEBUG_ManagerInterLinearity:ALL", debug);
+    mSolver = new DataFlow::CallGraphDFSolver(DataFlow::CallGraphDFSolver::BottomUp,*this);
+}
+
+OA_ptr<InterLinearity> 
+ManagerInterLinearity::performAnalysis(
+        OA_ptr<CallGraph::CallGraphInterface> callGraph,
+        OA_ptr<DataFlow::ParamBindings> paramBind,
+        OA_ptr<Alias::InterAliasInterface> interAlias,
+        OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+        OA_ptr<CFG::EachCFGInterface> eachCFG,
+        DataFlow::DFPImplement algorithm)
+{
+  // store results that will be needed in callbacks
+  mParamBind = paramBind;
+  mInterAlias = interAlias;
+  mInterSE = interSE;
+  mEachCFG = eachCFG;
+
+  // create an empty InterLinearity
+  mInterLinearity = new InterLinearity();
+
+  // call iterative data-flow solver for CallGraph
+  mSolver->setSCCSchedule(mSCCSchedule, mNumThreads);
+  mSolver->solve(callGraph,algorithm);
+  
+  if (debug) { mInterLinearity->dump(std::cout, mIR); }
+
+  return mInterLinearity;
+}
+
+//========================================================
+// implementation of CallGraphDFProblem callbacks
+//========================================================
+//--------------------------------------------------------
+// initialization callbacks
+//--------------------------------------------------------
+
+/*!
+   Data-flow set passed around on the call graph is a
+   LinearityMatrix.  The top value for this is no pairs.
+*/
+OA_ptr<DataFlow::DataFlowSet> ManagerInterLinearity::initializeTop()
+{
+    OA_ptr<LinearityMatrix> retval;
+    retval = new LinearityMatrix;
+    return retval;
+}
+
+OA_ptr<DataFlow::DataFlowSet>  
+ManagerInterLinearity::initializeBottom()
+{
+    OA_ptr<LinearityMatrix> retval;
+    retval = new LinearityMatrix;
+    return retval;
+}
+
+OA_ptr<DataFlow::DataFlowSet>
+ManagerInterLinearity::initializeNodeIN(OA_ptr<CallGraph::NodeInterface> n)
+{
+    return initializeTop();
+}
+
+OA_ptr<DataFlow::DataFlowSet>
+ManagerInterLinearity::initializeNodeOUT(OA_ptr<CallGraph::NodeInterface> n)
+{
+    return initializeTop();
+}
+
+//! Should generate an initial DataFlowSet for a procedure
+OA_ptr<DataFlow::DataFlowSet> 
+ManagerInterLinearity::initializeNode(ProcHandle proc)
+{
+    return initializeTop();
+}
+
+//! Should generate an initial DataFlowSet, use if for a call if both caller
+//! and callee are defined
+OA_ptr<DataFlow::DataFlowSet> 
+ManagerInterLinearity::initializeEdge(CallHandle call, 
+                                      ProcHandle caller,
+                                      ProcHandle callee)
+{
+    return initializeTop();
+}
+
+//! Should generate an initial DataFlowSet for a call,
+//! called when callee is not defined in call graph and therefore
+//! doesn't have a procedure definition handle
+OA_ptr<DataFlow::DataFlowSet> 
+ManagerInterLinearity::initializeEdge(CallHandle call, 
+                                      ProcHandle caller,
+                                      SymHandle callee)
+{
+    return initializeTop();
+}
+
+//--------------------------------------------------------
+// solver callbacks 
+//--------------------------------------------------------
+  
+//! OK to modify set1 and return it as result, because solver
+//! only passes a tempSet in as set1
+OA_ptr<DataFlow::DataFlowSet> 
+ManagerInterLinearity::meet(OA_ptr<DataFlow::DataFlowSet> set1, 
+                            OA_ptr<DataFlow::DataFlowSet> set2)
+{
+    OA_ptr<LinearityMatrix> remapSet1 = set1.convert<LinearityMatrix>();
+    return remapSet1->meet(*set2, *mIR);
+}
+
+//! What the analysis does for the particular procedure
+OA_ptr<DataFlow::DataFlowSet>
+ManagerInterLinearity::atCallGraphNode(
+        OA_ptr<DataFlow::DataFlowSet> inSet, 
+        OA::ProcHandle proc)
+{
+    if (debug) {
+        std::cout << "In ManagerInterLinearity::atCallGraphNode " 
+                  << mIR->toString(proc) << std::endl;
+    }
+
+    // get alias results for this procedure
+    OA_ptr<Alias::Interface> alias = mInterAlias->getAliasResults(proc);
+    
+    // linearity for this procedure using the summaries of the
+    // calls it makes
+    OA_ptr<ManagerLinearity> linman;
+    linman = new ManagerLinearity(mIR);
+    OA_ptr<LinearityMatrix> lm
+        = linman->performAnalysis(proc, mEachCFG->getCFGResults(proc), alias,
+                                  mParamBind, mInterLinearity,
+                                  DataFlow::ITERATIVE);
+
+    mInterLinearity->mapProcToLinearity(proc, lm);
+
+    // the matrix at the exit is the summary sent to each of the
+    // call edges
+    return lm;
+}
+
+//! What the analysis does for a particular call
+//! Use this version if callee is defined
+OA_ptr<DataFlow::DataFlowSet>
+ManagerInterLinearity::atCallGraphEdge(
+        OA_ptr<DataFlow::DataFlowSet> inSet, 
+        CallHandle call, ProcHandle caller, ProcHandle callee )
+{
+   OA_ptr<LinearityMatrix> recastInSet = inSet.convert<LinearityMatrix>();
+
+   assert(callee != ProcHandle(0));
+
+   // map each pair <<v,w>,class> of the callee summary to all the
+   // pairs of caller locations v and w may be, if v or w is local
+   // to the callee there are none
+   PairClassMap pairs;
+   OA_ptr<std::map<OA_ptr<Location>,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > 
+       lpMap = recastInSet->getMap();
+   std::map<OA_ptr<Location>,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator 
+       rowIter;
+   for (rowIter = lpMap->begin(); rowIter != lpMap->end(); rowIter++) {
+     DataFlow::CalleeToCallerVisitor vVisitor(callee, call, caller, 
+                                              mInterAlias, mParamBind, mIR);
+     rowIter->first->acceptVisitor(vVisitor);
+     OA_ptr<LocIterator> vIter = vVisitor.getCallerLocIterator();
+     if (!vIter->isValid()) { continue; }
+
+     std::set<OA_ptr<LinearityPair> >::iterator lpIter;
+     for (lpIter = rowIter->second->begin(); 
+          lpIter != rowIter->second->end(); lpIter++) 
+     {
+       DataFlow::CalleeToCallerVisitor wVisitor(callee, call, caller, 
+                                                mInterAlias, mParamBind, mIR);
+       (*lpIter)->getVar2()->acceptVisitor(wVisitor);
+       OA_ptr<LocIterator> wIter = wVisitor.getCallerLocIterator();
+
+       for (vIter->reset(); vIter->isValid(); (*vIter)++) {
+         for (wIter->reset(); wIter->isValid(); (*wIter)++) {
+           meetPair(pairs, vIter->current(), wIter->current(), 
+                    (*lpIter)->getLClass());
+         }
+       }
+     }
+   }
+   OA_ptr<LinearityMatrix> retval = matrixOf(pairs);
+   
+   if (debug) {
+       std::cout << "ManagerInterLinearity::atCallGraphEdge, summary = ";
+       retval->dump(std::cout, mIR);
+   }
+
+   // the summary must be associated to the specific call
+   // to be of any use
+   mInterLinearity->mapCallToSummary(call, retval, *mIR);
+   
+   return retval;
+}
+
+
+//! What the analysis does for a particular call
+//! Use this version when callee is not defined in the program (i.e. sin, cos)
+OA_ptr<DataFlow::DataFlowSet>
+ManagerInterLinearity::atCallGraphEdge(
+        OA_ptr<DataFlow::DataFlowSet> inSet, 
+        CallHandle call, ProcHandle caller, SymHandle callee )
+{
+  // if callee node is undefined then every location the call may
+  // modify is nonlinear in every location it may use
+  if (debug) { std::cout << "\tcallee is undefined" << std::endl; }
+  PairClassMap pairs;
+  LinearityClass nonlinear(LinearityClass::LCLASS_NONLINEAR);
+  OA_ptr<LocIterator> useIter = mInterSE->getUSEIterator(call);
+  OA_ptr<LocIterator> modIter = mInterSE->getMODIterator(call);
+  for (modIter->reset(); modIter->isValid(); (*modIter)++) {
+    for (useIter->reset(); useIter->isValid(); (*useIter)++) {
+      meetPair(pairs, modIter->current(), useIter->current(), nonlinear);
+    }
+  }
+  OA_ptr<LinearityMatrix> retval = matrixOf(pairs);
+  
+  mInterLinearity->mapCallToSummary(call, retval, *mIR);
+  
+  return retval;
+}
+
+OA_ptr<DataFlow::DataFlowSet>  
+ManagerInterLinearity::nodeToEdge(ProcHandle proc, 
+        OA_ptr<DataFlow::DataFlowSet> procDFSet, CallHandle call)
+{
+  return procDFSet;
+}
+
+//! translate results from caller edge to procedure node if top-down
+//! or from callee edge if bottom-up
+OA_ptr<DataFlow::DataFlowSet>  
+ManagerInterLinearity::edgeToNode(CallHandle call, 
+        OA_ptr<DataFlow::DataFlowSet> callDFSet, ProcHandle proc)
+{
+    return callDFSet;
+}
+
+  } // end of namespace Linearity
+} // end of namespace OA
@@ -0,0 +1,153 @@
+/*! \file
+  
+  \brief The AnnotationManager that generates InterLinearity.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#ifndef ManagerInterLinearity_H
+#define ManagerInterLinearity_H
+
+//--------------------------------------------------------------------
+#include <cassert>
+
+// OpenAnalysis headers
+#include <OpenAnalysis/Alias/InterAliasInterface.hpp>
+#include <OpenAnalysis/SideEffect/InterSideEffectInterface.hpp>
+#include <OpenAnalysis/IRInterface/InterLinearityIRInterface.hpp>
+#include <OpenAnalysis/DataFlow/CallGraphDFProblem.hpp>
+#include <OpenAnalysis/DataFlow/CallGraphDFSolver.hpp>
+#include <OpenAnalysis/DataFlow/ParamBindings.hpp>
+#include <OpenAnalysis/DataFlow/CalleeToCallerVisitor.hpp>
+#include <OpenAnalysis/CFG/EachCFGInterface.hpp>
+
+#include "InterLinearity.hpp"
+#include "ManagerLinearityStandard.hpp"
+
+namespace OA {
+  namespace Linearity {
+
+/*! 
+    Creates InterLinearity, which can be queried for the LinearityMatrix
+    of each procedure.  Does a bottom-up traversal of the CallGraph so
+    that the LinearityMatrix at the exit of a called procedure is known
+    when its callers are analyzed.  That matrix is the summary of the
+    procedure: its pairs from locations the callee also has in the
+    caller, formals mapped to actuals and globals, are mapped to the
+    caller and ManagerLinearity applies them at the call.
+
+    Recursive procedures are iterated until their summaries stop
+    changing.  For calls to procedures that aren't defined every MOD
+    location of the call is made nonlinear in every USE location.
+
+    With setSCCSchedule, SCCs of the CallGraph that don't call into
+    each other are analyzed concurrently, see
+    CallGraphDFSolver::setSCCSchedule.
+*/
+class ManagerInterLinearity : private DataFlow::CallGraphDFProblem
+{ 
+public:
+  ManagerInterLinearity(OA_ptr<InterLinearityIRInterface> _ir);
+  ~ManagerInterLinearity () {}
+
+  //! solve SCC by SCC on numThreads threads (0 means ThreadPool's
+  //! default) instead of over the whole call graph, which is the default
+  void setSCCSchedule(bool scc, unsigned int numThreads = 0)
+    { mSCCSchedule = scc; mNumThreads = numThreads; }
+
+  OA_ptr<InterLinearity> 
+  performAnalysis(OA_ptr<CallGraph::CallGraphInterface> callGraph,
+                  OA_ptr<DataFlow::ParamBindings> paramBind,
+                  OA_ptr<Alias::InterAliasInterface> interAlias,
+                  OA_ptr<SideEffect::InterSideEffectInterface> interSE,
+                  OA_ptr<CFG::EachCFGInterface> eachCFG,
+                  DataFlow::DFPImplement algorithm);
+
+private:
+  //========================================================
+  // implementation of CallGraphDFProblem callbacks
+  //========================================================
+  //--------------------------------------------------------
+  // initialization callbacks
+  //--------------------------------------------------------
+
+  //! Return an initialized top set
+  OA_ptr<DataFlow::DataFlowSet>  initializeTop();
+
+  //! Return an initialized bottom set
+  OA_ptr<DataFlow::DataFlowSet>  initializeBottom();
+
+  OA_ptr<DataFlow::DataFlowSet>
+      initializeNodeIN(OA_ptr<CallGraph::NodeInterface> n);
+  OA_ptr<DataFlow::DataFlowSet>
+      initializeNodeOUT(OA_ptr<CallGraph::NodeInterface> n);
+
+  //! Should generate an initial DataFlowSet for a procedure
+  OA_ptr<DataFlow::DataFlowSet> initializeNode(ProcHandle proc);
+  //! Should generate an initial DataFlowSet, use if for a call if both caller
+  //! and callee are defined
+  OA_ptr<DataFlow::DataFlowSet> initializeEdge(CallHandle call, 
+                                     ProcHandle caller,
+                                     ProcHandle callee);
+  //! Should generate an initial DataFlowSet for a call,
+  //! called when callee is not defined in call graph and therefore
+  //! doesn't have a procedure definition handle
+  OA_ptr<DataFlow::DataFlowSet> initializeEdge(CallHandle call, 
+                                     ProcHandle caller,
+                                     SymHandle callee);
+
+  //--------------------------------------------------------
+  // solver callbacks 
+  //--------------------------------------------------------
+  
+  //! OK to modify set1 and return it as result, because solver
+  //! only passes a tempSet in as set1
+  OA_ptr<DataFlow::DataFlowSet> meet(OA_ptr<DataFlow::DataFlowSet> set1, 
+                           OA_ptr<DataFlow::DataFlowSet> set2); 
+
+  //! What the analysis does for the particular procedure
+  OA_ptr<DataFlow::DataFlowSet>
+  atCallGraphNode(OA_ptr<DataFlow::DataFlowSet> inSet, OA::ProcHandle proc);
+
+  //! What the analysis does for a particular call
+  //! use if both caller and callee are defined
+  OA_ptr<DataFlow::DataFlowSet>
+  atCallGraphEdge(OA_ptr<DataFlow::DataFlowSet> inSet, OA::CallHandle call,
+                  ProcHandle caller, ProcHandle callee);
+  //! use if callee is not defined in the call graph
+  OA_ptr<DataFlow::DataFlowSet>
+  atCallGraphEdge(OA_ptr<DataFlow::DataFlowSet> inSet, CallHandle call,
+		  ProcHandle caller, SymHandle callee);
+
+  //! translate results from procedure node to callee edge if top-down
+  //! or to caller edge if bottom-up
+  OA_ptr<DataFlow::DataFlowSet>  nodeToEdge(ProcHandle proc, 
+          OA_ptr<DataFlow::DataFlowSet> procDFSet, CallHandle call);
+
+  //! translate results from caller edge to procedure node if top-down
+  //! or from callee edge if bottom-up
+  OA_ptr<DataFlow::DataFlowSet>  edgeToNode(CallHandle call, 
+          OA_ptr<DataFlow::DataFlowSet> callDFSet, ProcHandle proc);
+
+
+private:
+  OA_ptr<InterLinearity> mInterLinearity;
+  OA_ptr<InterLinearityIRInterface> mIR;
+  OA_ptr<Alias::InterAliasInterface> mInterAlias;
+  OA_ptr<DataFlow::ParamBindings> mParamBind;
+  OA_ptr<CFG::EachCFGInterface> mEachCFG;
+  OA_ptr<SideEffect::InterSideEffectInterface> mInterSE;
+  OA_ptr<DataFlow::CallGraphDFSolver> mSolver;
+  bool mSCCSchedule;
+  unsigned int mNumThreads;
+  
+};
+
+  } // end of Linearity namespace
+} // end of OA namespace
+
+#endif
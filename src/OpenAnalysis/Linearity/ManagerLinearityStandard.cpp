@@ -32,19 +32,27 @@ static bool debug = false;
 ManagerLinearity::ManagerLinearity(OA_ptr<LinearityIRInterface> _ir) : mIR(_ir)
 {
    mSolver = new DataFlow::CFGDFSolver(DataFlow::CFGDFSolver::Forward,*this);
+   mLocTable = new LinearityLocTable;
+}
+
+ManagerLinearity::ManagerLinearity(OA_ptr<InterLinearityIRInterface> _ir) 
+    : mIR(_ir), mInterIR(_ir)
+{
+   mSolver = new DataFlow::CFGDFSolver(DataFlow::CFGDFSolver::Forward,*this);
+   mLocTable = new LinearityLocTable;
 }
 
 OA_ptr<DataFlow::DataFlowSet> ManagerLinearity::initializeTop()
 {
     OA_ptr<LinearityMatrix>  retval;
-    retval = new LinearityMatrix;
+    retval = new LinearityMatrix(mLocTable);
     return retval;
 }
      
 OA_ptr<DataFlow::DataFlowSet> ManagerLinearity::initializeBottom()
 {
     OA_ptr<LinearityMatrix>  retval;
-    retval = new LinearityMatrix;
+    retval = new LinearityMatrix(mLocTable);
     return retval;
 }
 
@@ -52,7 +60,7 @@ OA_ptr<DataFlow::DataFlowSet>
 ManagerLinearity::initializeNodeIN(OA_ptr<CFG::NodeInterface> n)
 {
     OA_ptr<LinearityMatrix>  retval;
-    retval = new LinearityMatrix;
+    retval = new LinearityMatrix(mLocTable);
     return retval;
 }
 
@@ -60,7 +68,7 @@ OA_ptr<DataFlow::DataFlowSet>
 ManagerLinearity::initializeNodeOUT(OA_ptr<CFG::NodeInterface> n)
 {
     OA_ptr<LinearityMatrix>  retval;
-    retval = new LinearityMatrix;
+    retval = new LinearityMatrix(mLocTable);
     return retval;
 }
 
@@ -69,10 +77,25 @@ OA_ptr<Linearity::LinearityMatrix> ManagerLinearity::performAnalysis(
                                         OA_ptr<CFG::CFGInterface> cfg,
                                         OA_ptr<Alias::Interface> alias,
                                         OA_ptr<DataFlow::ParamBindings> paramBind, DataFlow::DFPImplement algorithm)
+{
+    OA_ptr<InterLinearity> noInterLinearity;
+    return performAnalysis(proc, cfg, alias, paramBind, noInterLinearity,
+                           algorithm);
+}
+
+OA_ptr<Linearity::LinearityMatrix> ManagerLinearity::performAnalysis(
+                                        ProcHandle proc,
+                                        OA_ptr<CFG::CFGInterface> cfg,
+                                        OA_ptr<Alias::Interface> alias,
+                                        OA_ptr<DataFlow::ParamBindings> paramBind,
+                                        OA_ptr<InterLinearity> interLinearity,
+                                        DataFlow::DFPImplement algorithm)
 {
     mProc = proc;
 
-    mLM = new LinearityMatrix;
+    mInterLinearity = interLinearity;
+
+    mLM = new LinearityMatrix(mLocTable);
 
     mCFG = cfg;
 
@@ -211,8 +234,7 @@ ManagerLinearity::meet (OA_ptr<DataFlow::DataFlowSet> set1orig,
         set2->dump(std::cout,mIR);
     }
        
-    OA_ptr<LinearityMatrix> retval; retval = new LinearityMatrix;
-    retval = set1->meet(set2, *mIR);
+    OA_ptr<LinearityMatrix> retval = set1->meet(set2, *mIR);
     if (debug) {
         std::cout << std::endl << "\tretval set = ";
         retval->dump(std::cout,mIR);
@@ -272,6 +294,19 @@ ManagerLinearity::transfer(OA_ptr<DataFlow::DataFlowSet> in, OA::StmtHandle stmt
         }
     }
 
+    // apply the summaries of the calls in the statement
+    if (!mInterLinearity.ptrEqual(0) && !mInterIR.ptrEqual(0)) {
+        OA_ptr<IRCallsiteIterator> callIter = mInterIR->getCallsites(stmt);
+        if (callIter->isValid()) {
+            OA_ptr<DataFlow::DataFlowSet> beforeSet = inRecast->clone();
+            OA_ptr<LinearityMatrix> before 
+                = beforeSet.convert<LinearityMatrix>();
+            for ( ; callIter->isValid(); ++(*callIter)) {
+                applyCallSummary(inRecast, before, callIter->current());
+            }
+        }
+    }
+
     if (debug) {
       std::cout << "Bottom of Transfer:::\n";
       inRecast->output(*mIR);
@@ -281,6 +316,79 @@ ManagerLinearity::transfer(OA_ptr<DataFlow::DataFlowSet> in, OA::StmtHandle stmt
 
 }
 
+//! meet lclass into the class of loc in classes
+static void meetClass(std::map<OA_ptr<Location>,LinearityClass>& classes,
+                      OA_ptr<Location> loc, LinearityClass lclass)
+{
+    std::map<OA_ptr<Location>,LinearityClass>::iterator found 
+        = classes.find(loc);
+    if (found == classes.end()) {
+        classes.insert(std::make_pair(loc, lclass));
+    } else {
+        found->second = found->second.meet(lclass);
+    }
+}
+
+/*!
+   Each row <V,{<W,class>}> of the summary says V may be computed from
+   the value W had before the call.  V then depends on W with that class
+   and on whatever W depended on before the call with the meet of the
+   two classes, as for an assignment V = f(W).  The summary doesn't say
+   which locations the callee always defines, so the pairs V had before
+   the call are kept as well.
+*/
+void ManagerLinearity::applyCallSummary(OA_ptr<LinearityMatrix> inRecast,
+                                        OA_ptr<LinearityMatrix> before,
+                                        CallHandle call)
+{
+    OA_ptr<LinearityMatrix> summary = mInterLinearity->getCallSummary(call);
+    if (summary.ptrEqual(0)) { return; }
+
+    OA_ptr<std::map<OA_ptr<Location>,OA_ptr<std::set<OA_ptr<LinearityPair> > > > > 
+        summaryMap = summary->getMap();
+    std::map<OA_ptr<Location>,OA_ptr<std::set<OA_ptr<LinearityPair> > > >::iterator 
+        rowIter;
+    for (rowIter = summaryMap->begin(); rowIter != summaryMap->end(); 
+         rowIter++) 
+    {
+        std::map<OA_ptr<Location>,LinearityClass> classes;
+
+        OA_ptr<VarClassPairIterator> vcIter 
+            = before->getDepsSet(rowIter->first)->getVarClassPairIterator();
+        for ( ; vcIter->isValid(); (*vcIter)++) {
+            meetClass(classes, vcIter->current()->getVar(), 
+                      vcIter->current()->getLClass());
+        }
+
+        std::set<OA_ptr<LinearityPair> >::iterator lpIter;
+        for (lpIter = rowIter->second->begin(); 
+             lpIter != rowIter->second->end(); lpIter++) 
+        {
+            OA_ptr<Location> w = (*lpIter)->getVar2();
+            LinearityClass lclass = (*lpIter)->getLClass();
+            meetClass(classes, w, lclass);
+
+            vcIter = before->getDepsSet(w)->getVarClassPairIterator();
+            for ( ; vcIter->isValid(); (*vcIter)++) {
+                meetClass(classes, vcIter->current()->getVar(), 
+                          lclass.meet(vcIter->current()->getLClass()));
+            }
+        }
+
+        OA_ptr<LinearityDepsSet> deps;
+        deps = new LinearityDepsSet;
+        std::map<OA_ptr<Location>,LinearityClass>::iterator classIter;
+        for (classIter = classes.begin(); classIter != classes.end(); 
+             classIter++) 
+        {
+            OA_ptr<VarClassPair> vcp;
+            vcp = new VarClassPair(classIter->first, classIter->second);
+            deps->insert(vcp);
+        }
+        inRecast->putDepsSet(rowIter->first, deps);
+    }
+}
+
 OA_ptr<Linearity::LinearityMatrix> ManagerLinearity::performAnalysis2(SymHandle sym)
 {
 
@@ -29,12 +29,14 @@
 #include "LinearityPair.hpp"
 #include "LinearityDepsSet.hpp"
 #include "LinearityMatrixStandard.hpp"
+#include "InterLinearity.hpp"
 
 //OpenAnalysis headers
 #include <OpenAnalysis/Utils/OA_ptr.hpp>
 #include <OpenAnalysis/Location/Locations.hpp>
 #include <OpenAnalysis/IRInterface/IRHandles.hpp>
 #include <OpenAnalysis/IRInterface/LinearityIRInterface.hpp>
+#include <OpenAnalysis/IRInterface/InterLinearityIRInterface.hpp>
 
 #include <OpenAnalysis/CFG/CFGInterface.hpp>
 #include <OpenAnalysis/Alias/Interface.hpp>
@@ -51,9 +53,17 @@
 namespace OA {
   namespace Linearity {
 
+/*!
+   Computes the LinearityMatrix at the exit of a procedure.  Calls have
+   no effect on the matrix unless the manager is given an
+   InterLinearityIRInterface and performAnalysis an InterLinearity, in
+   which case the summary InterLinearity has for each call is applied
+   after the assignments in its statement.
+*/
 class ManagerLinearity : public virtual DataFlow::CFGDFProblem {
 public:
   ManagerLinearity(OA_ptr<LinearityIRInterface> _ir);
+  ManagerLinearity(OA_ptr<InterLinearityIRInterface> _ir);
   virtual ~ManagerLinearity() {}
 
   virtual OA_ptr<LinearityMatrix>
@@ -62,6 +72,14 @@ public:
                          OA_ptr<Alias::Interface> alias,
                          OA_ptr<DataFlow::ParamBindings> paramBind,
                          DataFlow::DFPImplement algorithm);
+  //! uses the call summaries in interLinearity
+  virtual OA_ptr<LinearityMatrix>
+        performAnalysis(ProcHandle proc,
+                         OA_ptr<CFG::CFGInterface> cfg,
+                         OA_ptr<Alias::Interface> alias,
+                         OA_ptr<DataFlow::ParamBindings> paramBind,
+                         OA_ptr<InterLinearity> interLinearity,
+                         DataFlow::DFPImplement algorithm);
   virtual OA_ptr<LinearityMatrix>
         performAnalysis2(SymHandle);
   virtual OA_ptr<LinearityMatrix>
@@ -91,6 +109,11 @@ private:
   OA_ptr<DataFlow::DataFlowSet> 
   transfer(OA_ptr<DataFlow::DataFlowSet> in, OA::StmtHandle stmt); 
 
+  //! applies the summary of call to inRecast, taking the pairs of
+  //! the locations the call uses from before
+  void applyCallSummary(OA_ptr<LinearityMatrix> inRecast,
+                        OA_ptr<LinearityMatrix> before, CallHandle call);
+
 //public:
 //  OA_ptr<IRHandlesIRInterface> getIR() {
 //    return mIR;
@@ -99,7 +122,11 @@ private:
   
 private:
   OA_ptr<LinearityIRInterface> mIR; 
+  OA_ptr<InterLinearityIRInterface> mInterIR;
+  OA_ptr<InterLinearity> mInterLinearity;
   OA_ptr<LinearityMatrix> mLM;
+  //! numbers the locations of the matrices this manager builds
+  OA_ptr<LinearityLocTable> mLocTable;
   ProcHandle mProc;
   OA_ptr<CFG::CFGInterface> mCFG;
   OA_ptr<Alias::Interface> mAlias;
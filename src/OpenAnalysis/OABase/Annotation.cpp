@@ -16,8 +16,15 @@
 
 namespace OA {
 
-// initializing class static variable
-OA_ptr<OutputBuilder> Annotation::sOutBuild;
+// initializing class static variable up front, so that annotations
+// constructed concurrently do not race to set it
+static OA_ptr<OutputBuilder> defaultOutputBuilder()
+{
+    OA_ptr<OutputBuilder> retval;
+    retval = new OutputBuilderText;
+    return retval;
+}
+OA_ptr<OutputBuilder> Annotation::sOutBuild = defaultOutputBuilder();
 
 } // end of OA namespace
 
@@ -33,6 +33,7 @@ InterSideEffectStandard::InterSideEffectStandard()
 //! side effect information is available 
 OA_ptr<ProcIterator> InterSideEffectStandard::getKnownProcIterator()
 {
+    MutexLock guard(mLock);
     // create a procSet
     OA_ptr<std::set<ProcHandle> > procSet;
     procSet = new std::set<ProcHandle>;
@@ -61,6 +62,7 @@ OA_ptr<ProcIterator> InterSideEffectStandard::getKnownProcIterator()
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLMODIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getLMODIterator();
   } else {
@@ -71,6 +73,7 @@ InterSideEffectStandard::getLMODIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getMODIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getMODIterator();
   } else {
@@ -81,6 +84,7 @@ InterSideEffectStandard::getMODIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLDEFIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getLDEFIterator();
   } else {
@@ -91,6 +95,7 @@ InterSideEffectStandard::getLDEFIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getDEFIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getDEFIterator();
   } else {
@@ -101,6 +106,7 @@ InterSideEffectStandard::getDEFIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLUSEIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getLUSEIterator();
   } else {
@@ -111,6 +117,7 @@ InterSideEffectStandard::getLUSEIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getUSEIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getUSEIterator();
   } else {
@@ -121,6 +128,7 @@ InterSideEffectStandard::getUSEIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLREFIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getLREFIterator();
   } else {
@@ -131,6 +139,7 @@ InterSideEffectStandard::getLREFIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getREFIterator(CallHandle call)
 {
+  MutexLock guard(mLock);
   if (mCallToSideEffectMap[call].ptrEqual(0)) {
     return mDefaultSideEffect->getREFIterator();
   } else {
@@ -143,6 +152,7 @@ InterSideEffectStandard::getREFIterator(CallHandle call)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLMODIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getLMODIterator();
   } else {
@@ -153,6 +163,7 @@ InterSideEffectStandard::getLMODIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getMODIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getMODIterator();
   } else {
@@ -163,6 +174,7 @@ InterSideEffectStandard::getMODIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLDEFIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getLDEFIterator();
   } else {
@@ -173,6 +185,7 @@ InterSideEffectStandard::getLDEFIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getDEFIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getDEFIterator();
   } else {
@@ -183,6 +196,7 @@ InterSideEffectStandard::getDEFIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLUSEIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getLUSEIterator();
   } else {
@@ -193,6 +207,7 @@ InterSideEffectStandard::getLUSEIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getUSEIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getUSEIterator();
   } else {
@@ -203,6 +218,7 @@ InterSideEffectStandard::getUSEIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getLREFIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getLREFIterator();
   } else {
@@ -213,6 +229,7 @@ InterSideEffectStandard::getLREFIterator(ProcHandle p)
 OA_ptr<LocIterator> 
 InterSideEffectStandard::getREFIterator(ProcHandle p)
 {
+  MutexLock guard(mLock);
   if (mProcToSideEffectMap[p].ptrEqual(0)) {
     return mDefaultSideEffect->getREFIterator();
   } else {
@@ -320,6 +337,7 @@ bool SideEffectStandard::inREF(ProcHandle p, OA_ptr<Location> loc)
 void InterSideEffectStandard::mapProcToSideEffect(ProcHandle proc, 
     OA_ptr<OA::SideEffect::SideEffectStandard> sideEffect)
 {
+    MutexLock guard(mLock);
     mProcToSideEffectMap[proc] = sideEffect;
 }
 
@@ -327,6 +345,7 @@ void InterSideEffectStandard::mapProcToSideEffect(ProcHandle proc,
 OA_ptr<OA::SideEffect::SideEffectStandard> 
 InterSideEffectStandard::getSideEffectResults(ProcHandle proc)
 {
+    MutexLock guard(mLock);
     return mProcToSideEffectMap[proc];
 }
 
@@ -336,6 +355,7 @@ InterSideEffectStandard::getSideEffectResults(ProcHandle proc)
 void InterSideEffectStandard::mapCallToSideEffect(CallHandle call, 
     OA_ptr<OA::SideEffect::SideEffectStandard> sideEffect)
 {
+    MutexLock guard(mLock);
     if (sideEffect.ptrEqual(0) ) { std::cout << "sideEffect.ptrEqual(0)" << std::endl; }
     if (debug) {
         std::cout << "mapCallToSideEffect(call = " << call.hval() << std::endl;
@@ -345,6 +365,7 @@ void InterSideEffectStandard::mapCallToSideEffect(CallHandle call,
 
 int InterSideEffectStandard::getLocCount(ProcHandle proc)
 {
+    MutexLock guard(mLock);
     if (mProcToSideEffectMap[proc].ptrEqual(0)) {
         return 0;
     }
@@ -398,6 +419,7 @@ int InterSideEffectStandard::getLocCount(ProcHandle proc)
     
 void InterSideEffectStandard::initCallSideEffect(CallHandle call)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[call] = new SideEffectStandard;
     // empty out all the sets
     mCallToSideEffectMap[call]->emptyLMOD();
@@ -413,48 +435,56 @@ void InterSideEffectStandard::initCallSideEffect(CallHandle call)
 //! Insert a location into the LMOD set for the given call
 void InterSideEffectStandard::insertLMOD(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertLMOD(loc);
 }
     
 //! Insert a location into the MOD set for the given call
 void InterSideEffectStandard::insertMOD(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertMOD(loc);
 }
     
 //! Insert a location into the LDEF set for the given call
 void InterSideEffectStandard::insertLDEF(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertLDEF(loc);
 }
     
 //! Insert a location into the DEF set for the given call
 void InterSideEffectStandard::insertDEF(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertDEF(loc);
 }
     
 //! Insert a location into the LUSE set for the given call
 void InterSideEffectStandard::insertLUSE(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertLUSE(loc);
 }
     
 //! Insert a location into the USE set for the given call
 void InterSideEffectStandard::insertUSE(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertUSE(loc);
 }
     
 //! Insert a location into the LREF set for the given call
 void InterSideEffectStandard::insertLREF(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertLREF(loc);
 }
     
 //! Insert a location into the REF set for the given call
 void InterSideEffectStandard::insertREF(CallHandle p, OA_ptr<Location> loc)
 {
+    MutexLock guard(mLock);
     mCallToSideEffectMap[p]->insertREF(loc);
 }
     
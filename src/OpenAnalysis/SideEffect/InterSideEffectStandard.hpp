@@ -23,6 +23,7 @@
 #include <OpenAnalysis/SideEffect/SideEffectStandard.hpp>
 #include <OpenAnalysis/OABase/Annotation.hpp>
 #include <OpenAnalysis/Utils/GenOutputTool.hpp>
+#include <OpenAnalysis/Utils/ThreadPool.hpp>
 
 
 namespace OA {
@@ -219,6 +220,10 @@ class InterSideEffectStandard : public InterSideEffectInterface,
     // default SideEffect results
     OA_ptr<OA::SideEffect::Interface> mDefaultSideEffect;
 
+    // the maps are filled in while procedures in other SCCs of the
+    // call graph are being analyzed
+    Mutex mLock;
+
     //! Iterator over procedures in the mProcToSideEffectMap
     class InterSideEffectProcIter : public virtual ProcIterator,
                                     public IRHandleSetIterator<ProcHandle>
@@ -27,7 +27,7 @@ static bool debug = false;
 /*!
 */
 ManagerInterSideEffectStandard::ManagerInterSideEffectStandard(
-  OA_ptr<InterSideEffectIRInterface> _ir) : mIR(_ir)
+  OA_ptr<InterSideEffectIRInterface> _ir) : mIR(_ir), mSCCSchedule(false), mNumThreads(0)
 {
   OA_DEBUG_CTRL_MACRO("DEBUG_ManagerInterSideEffectStandard:ALL", debug);
   mSolver = new DataFlow::CallGraphDFSolver(DataFlow::CallGraphDFSolver::BottomUp,*this);
@@ -127,6 +127,7 @@ ManagerInterSideEffectStandard::performAnalysis(
   // use the CallGraph dataflow solver to visit procedures iteratively
   // and solve for side-effect sets for each function call
   //DataFlow::CallGraphDFProblemNew::solve(callGraph);
+  mSolver->setSCCSchedule(mSCCSchedule, mNumThreads);
   mSolver->solve(callGraph,algorithm);
 
   return mInterSideEffect;
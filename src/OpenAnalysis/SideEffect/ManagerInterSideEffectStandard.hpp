@@ -38,12 +38,23 @@ namespace OA {
 /*! 
    The AnnotationManager for InterSideEffectStandard.
    This class can build an InterSideEffectStandard. 
+
+   With setSCCSchedule the call graph is solved one SCC at a time,
+   callees first, and SCCs that don't call into each other are
+   analyzed concurrently (see CallGraphDFSolver::setSCCSchedule).  The
+   intraprocedural manager, alias results, and IR are then used from
+   several threads.
 */
 class ManagerInterSideEffectStandard : private DataFlow::CallGraphDFProblem {
 public:
   ManagerInterSideEffectStandard(OA_ptr<InterSideEffectIRInterface> _ir);
   ~ManagerInterSideEffectStandard () {}
 
+  //! solve SCC by SCC on numThreads threads (0 means ThreadPool's
+  //! default) instead of over the whole call graph, which is the default
+  void setSCCSchedule(bool scc, unsigned int numThreads = 0)
+    { mSCCSchedule = scc; mNumThreads = numThreads; }
+
   OA_ptr<InterSideEffectStandard> 
   performAnalysis(OA_ptr<CallGraph::CallGraphInterface> callGraph,
                   OA_ptr<DataFlow::ParamBindings> paramBind,
@@ -136,6 +147,8 @@ private:
   OA_ptr<DataFlow::ParamBindings> mParamBind;
   OA_ptr<ManagerSideEffectStandard> mIntraMan;
   OA_ptr<DataFlow::CallGraphDFSolver> mSolver; 
+  bool mSCCSchedule;
+  unsigned int mNumThreads;
   
 };
 
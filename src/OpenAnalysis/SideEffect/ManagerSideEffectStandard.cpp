@@ -77,7 +77,6 @@ ManagerSideEffectStandard::performAnalysis(ProcHandle proc,
                                  OA_ptr<Alias::Interface> alias,
                                  OA_ptr<InterSideEffectInterface> inter)
 {
-  mProc = proc;
   if (debug) {
       std::cout << "ManagerSideEffectStandard: proc = " << mIR->toString(proc)
                 << std::endl;
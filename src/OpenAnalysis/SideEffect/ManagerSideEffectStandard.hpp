@@ -48,7 +48,6 @@ public:
 private: // member variables
 
   OA_ptr<SideEffectIRInterface> mIR;
-  ProcHandle mProc;
   //OA_ptr<Alias::Interface> mAlias;
 };
 
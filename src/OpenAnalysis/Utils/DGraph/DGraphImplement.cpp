@@ -22,7 +22,7 @@ NodeImplement::NodeImplement()
     {
         std::cout << "Inside DGraphImplement NodeImplement Constructor" << std::endl;
     }
-    mId = sNextId++;
+    mId = OA_ATOMIC_FETCH_AND_INC(sNextId);
     mIncomingEdges = new std::list<OA_ptr<EdgeInterface> >;
     mOutgoingEdges = new std::list<OA_ptr<EdgeInterface> >;
 }
@@ -149,11 +149,11 @@ OA_ptr<NodesIteratorInterface>
 }
 
 
-void DGraphImplement::createDFSList(OA_ptr<NodeInterface> pNode, OA_ptr<std::list<OA_ptr<NodeInterface> > > pList)
+void DGraphImplement::createDFSList(OA_ptr<NodeInterface> pNode, OA_ptr<std::list<OA_ptr<NodeInterface> > > pList, VisitMap& visitMap)
 {
   // mark as visited so that we don't get in an infinite
   // loop on cycles in the graph
-   mVisitMap[pNode] = true;
+   visitMap[pNode] = true;
 
    pList->push_back(pNode);
 
@@ -164,9 +164,9 @@ void DGraphImplement::createDFSList(OA_ptr<NodeInterface> pNode, OA_ptr<std::lis
         n = neighIter->current();
 
         // if the node hasn't been visited then call recursively
-        if (!mVisitMap[n]) {
+        if (!visitMap[n]) {
 //            pList->push_back(pNode);
-            createDFSList(n, pList);
+            createDFSList(n, pList, visitMap);
          }
      }
 
@@ -180,16 +180,17 @@ OA_ptr<NodesIteratorInterface>
     DGraphImplement::getDFSIterator(OA_ptr<NodeInterface> n)
 {
   OA_ptr<NodesIteratorInterface> retval;
+  VisitMap visitMap;
 
          OA_ptr<NodesIteratorInterface> nodeIter = getNodesIterator();
          for ( ; nodeIter->isValid(); (*nodeIter)++ ) {
             OA_ptr<NodeInterface> node = nodeIter->current();
-            mVisitMap[node] = false;
+            visitMap[node] = false;
          }
 
          OA_ptr<std::list<OA_ptr<NodeInterface> > > templist;
          templist = new std::list<OA_ptr<NodeInterface> >;
-         createDFSList(n, templist);
+         createDFSList(n, templist, visitMap);
 
          /*! commented out by PLM 09/13/06
          nodeIter = getEntryNodesIterator();
@@ -376,16 +377,17 @@ OA_ptr<std::list<OA_ptr<NodeInterface> > >
 DGraphImplement::create_reverse_post_order_list(DGraphEdgeDirection pOrient)
 {
     // loop over all nodes and set their visit field to false
+    VisitMap visitMap;
     OA_ptr<NodesIteratorInterface> nodeIter = getNodesIterator();
     for ( ; nodeIter->isValid(); (*nodeIter)++ ) {
         OA_ptr<NodeInterface> node = nodeIter->current();
 
         if(debug)
         {
-            std::cout << "Set mVisitMap[node]=false" << node->getId() << std::endl;
+            std::cout << "Set visitMap[node]=false" << node->getId() << std::endl;
         }
 
-        mVisitMap[node] = false;
+        visitMap[node] = false;
     }
 
     // generate a list of nodes in the requested ordering
@@ -410,7 +412,7 @@ DGraphImplement::create_reverse_post_order_list(DGraphEdgeDirection pOrient)
               std::cout << std::endl;
               std::cout << "*******";
         }
-        reverse_postorder_recurse(nodeIter->current(), pOrient, retval);
+        reverse_postorder_recurse(nodeIter->current(), pOrient, retval, visitMap);
     }
 
     return retval;
@@ -419,7 +421,8 @@ DGraphImplement::create_reverse_post_order_list(DGraphEdgeDirection pOrient)
 
 void DGraphImplement::reverse_postorder_recurse( OA_ptr<NodeInterface> pNode,
                                       DGraphEdgeDirection pOrient,
-                                      OA_ptr<std::list<OA_ptr<NodeInterface> > > pList )
+                                      OA_ptr<std::list<OA_ptr<NodeInterface> > > pList,
+                                      VisitMap& visitMap )
 {
         if (debug) {
           std::cout << "DGraphImplement::reverse_postorder_recurse" << std::endl;
@@ -439,7 +442,7 @@ void DGraphImplement::reverse_postorder_recurse( OA_ptr<NodeInterface> pNode,
 
         // mark as visited so that we don't get in an infinite
         // loop on cycles in the graph
-        mVisitMap[pNode] = true;
+        visitMap[pNode] = true;
 
         // loop over the successors or predecessors based on orientation
         if (pOrient==DGraph::DEdgeOrg) {
@@ -464,8 +467,8 @@ void DGraphImplement::reverse_postorder_recurse( OA_ptr<NodeInterface> pNode,
 
 
            // if the node hasn't been visited then call recursively
-           if (!mVisitMap[n]) {
-             reverse_postorder_recurse(n, pOrient, pList);
+           if (!visitMap[n]) {
+             reverse_postorder_recurse(n, pOrient, pList, visitMap);
            }
          }
 
@@ -510,7 +513,7 @@ void DGraphImplement::reverse_postorder_recurse( OA_ptr<NodeInterface> pNode,
                       OA_ptr<NodeInterface> sink)
             : mSourceNode(source), mSinkNode(sink)
             {
-                mId = sNextId++;
+                mId = OA_ATOMIC_FETCH_AND_INC(sNextId);
             }
 
       void NodeImplement::addOutgoingEdge(OA_ptr<EdgeInterface> e)
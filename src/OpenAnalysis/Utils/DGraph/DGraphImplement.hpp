@@ -239,9 +239,11 @@ namespace OA {
       // Helper methods
       //========================================================
       private:
-        std::map<OA_ptr<NodeInterface>,bool> mVisitMap;
+        // nodes a walk has visited, kept by the walk rather than the
+        // graph so that threads can walk the same graph at once
+        typedef std::map<OA_ptr<NodeInterface>,bool> VisitMap;
 
-        void createDFSList(OA_ptr<NodeInterface> pNode, OA_ptr<std::list<OA_ptr<NodeInterface> > > pList);
+        void createDFSList(OA_ptr<NodeInterface> pNode, OA_ptr<std::list<OA_ptr<NodeInterface> > > pList, VisitMap& visitMap);
     
         //! returns a list of DGraph NodeInterface's that do not have incoming
         OA_ptr<std::list<OA_ptr<NodeInterface> > > create_entry_list() const;
@@ -253,7 +255,8 @@ namespace OA {
         
         void reverse_postorder_recurse( OA_ptr<NodeInterface> pNode,
                                        DGraphEdgeDirection pOrient,
-                                       OA_ptr<std::list<OA_ptr<NodeInterface> > > pList );
+                                       OA_ptr<std::list<OA_ptr<NodeInterface> > > pList,
+                                       VisitMap& visitMap );
 
         friend class NodesIteratorImplement;
        
@@ -42,7 +42,7 @@ class OA_ptr {
         if (OA_ptr_debug) { std::cout << "OA_ptr copy constructor: other = ";
                      other.dump(std::cout);  std::cout << std::endl; }
         if (mRefCountPtr!=NULL) 
-        { (*mRefCountPtr)++; }
+        { OA_ATOMIC_INC(*mRefCountPtr); }
     }
 
     //! getting a new ptr
@@ -77,7 +77,7 @@ class OA_ptr {
             // set mRefCountPtr to NULL            
             mRefCountPtr = other.mRefCountPtr;
             if (mPtr != NULL) {              
-                (*mRefCountPtr)++;            
+                OA_ATOMIC_INC(*mRefCountPtr);
             } 
         }
         return *this;
@@ -124,7 +124,7 @@ class OA_ptr {
         if (OA_ptr_debug) { std::cout << "OA_ptr constructor ptr,cnt: ptr = ";
             //std::cout << mPtr << ", countPtr = " << countPtr << std::endl; 
         }
-        if (mRefCountPtr!=NULL) { (*mRefCountPtr)++; }
+        if (mRefCountPtr!=NULL) { OA_ATOMIC_INC(*mRefCountPtr); }
         if (OA_ptr_debug) { std::cout << "OA_ptr constructor ptr,cnt: *this = ";
                      dump(std::cout);  std::cout << std::endl; }
      }
@@ -327,8 +327,7 @@ class OA_ptr {
             //FIXME: sometimes can get here and have mRefCountPtr==NULL, how?
             //and mPtr be unitialized
             if (mRefCountPtr!=NULL) {
-              (*mRefCountPtr)--;
-              if (*mRefCountPtr == 0) {
+              if (OA_ATOMIC_DEC_AND_FETCH(*mRefCountPtr) == 0) {
                 delete mPtr;
                 delete mRefCountPtr;
               }
@@ -0,0 +1,276 @@
+/*! \file
+
+  \brief Implementation of SparseBitVector.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "SparseBitVector.hpp"
+
+namespace OA {
+
+//! number of bits set in bits
+static unsigned int popCount(unsigned long bits)
+{
+#ifdef __GNUC__
+  return __builtin_popcountl(bits);
+#else
+  unsigned int retval = 0;
+  for ( ; bits != 0; bits &= bits - 1) { retval++; }
+  return retval;
+#endif
+}
+
+//! position of the lowest bit set in bits, which must not be 0
+static unsigned int lowestBit(unsigned long bits)
+{
+#ifdef __GNUC__
+  return __builtin_ctzl(bits);
+#else
+  unsigned int retval = 0;
+  for ( ; (bits & 1) == 0; bits >>= 1) { retval++; }
+  return retval;
+#endif
+}
+
+//*********************************************************************
+// class SparseBitVector
+//*********************************************************************
+
+unsigned int SparseBitVector::lowerBound(unsigned int index) const
+{
+  unsigned int lo = 0, hi = mElements.size();
+  while (lo < hi) {
+    unsigned int mid = (lo + hi) / 2;
+    if (mElements[mid].mIndex < index) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+bool SparseBitVector::test(unsigned int i) const
+{
+  unsigned int pos = lowerBound(i / BITS_PER_WORD);
+  if (pos == mElements.size() || mElements[pos].mIndex != i / BITS_PER_WORD) {
+    return false;
+  }
+  return (mElements[pos].mBits & (Word(1) << (i % BITS_PER_WORD))) != 0;
+}
+
+bool SparseBitVector::set(unsigned int i)
+{
+  unsigned int index = i / BITS_PER_WORD;
+  Word bit = Word(1) << (i % BITS_PER_WORD);
+  unsigned int pos = lowerBound(index);
+  if (pos == mElements.size() || mElements[pos].mIndex != index) {
+    mElements.insert(mElements.begin() + pos, Element(index, bit));
+    return true;
+  }
+  if (mElements[pos].mBits & bit) { return false; }
+  mElements[pos].mBits |= bit;
+  return true;
+}
+
+void SparseBitVector::reset(unsigned int i)
+{
+  unsigned int index = i / BITS_PER_WORD;
+  unsigned int pos = lowerBound(index);
+  if (pos == mElements.size() || mElements[pos].mIndex != index) {
+    return;
+  }
+  mElements[pos].mBits &= ~(Word(1) << (i % BITS_PER_WORD));
+  if (mElements[pos].mBits == 0) {
+    mElements.erase(mElements.begin() + pos);
+  }
+}
+
+unsigned int SparseBitVector::count() const
+{
+  unsigned int retval = 0;
+  std::vector<Element>::const_iterator iter;
+  for (iter = mElements.begin(); iter != mElements.end(); iter++) {
+    retval += popCount(iter->mBits);
+  }
+  return retval;
+}
+
+bool SparseBitVector::unionWith(const SparseBitVector& other)
+{
+  if (other.mElements.empty()) { return false; }
+
+  // common case when propagating, nothing new
+  if (contains(other)) { return false; }
+
+  std::vector<Element> result;
+  result.reserve(mElements.size() + other.mElements.size());
+  unsigned int i = 0, j = 0;
+  while (i < mElements.size() && j < other.mElements.size()) {
+    if (mElements[i].mIndex < other.mElements[j].mIndex) {
+      result.push_back(mElements[i++]);
+    } else if (other.mElements[j].mIndex < mElements[i].mIndex) {
+      result.push_back(other.mElements[j++]);
+    } else {
+      result.push_back(Element(mElements[i].mIndex,
+                               mElements[i].mBits | other.mElements[j].mBits));
+      i++; j++;
+    }
+  }
+  for ( ; i < mElements.size(); i++) { result.push_back(mElements[i]); }
+  for ( ; j < other.mElements.size(); j++) {
+    result.push_back(other.mElements[j]);
+  }
+  mElements.swap(result);
+  return true;
+}
+
+void SparseBitVector::intersectWith(const SparseBitVector& other)
+{
+  unsigned int i = 0, j = 0, k = 0;
+  while (i < mElements.size() && j < other.mElements.size()) {
+    if (mElements[i].mIndex < other.mElements[j].mIndex) {
+      i++;
+    } else if (other.mElements[j].mIndex < mElements[i].mIndex) {
+      j++;
+    } else {
+      Word bits = mElements[i].mBits & other.mElements[j].mBits;
+      if (bits != 0) {
+        mElements[k++] = Element(mElements[i].mIndex, bits);
+      }
+      i++; j++;
+    }
+  }
+  mElements.resize(k, Element(0,0));
+}
+
+void SparseBitVector::setDifference(const SparseBitVector& a,
+                                    const SparseBitVector& b)
+{
+  std::vector<Element> result;
+  unsigned int i = 0, j = 0;
+  while (i < a.mElements.size()) {
+    while (j < b.mElements.size()
+           && b.mElements[j].mIndex < a.mElements[i].mIndex)
+    {
+      j++;
+    }
+    Word bits = a.mElements[i].mBits;
+    if (j < b.mElements.size()
+        && b.mElements[j].mIndex == a.mElements[i].mIndex)
+    {
+      bits &= ~b.mElements[j].mBits;
+    }
+    if (bits != 0) {
+      result.push_back(Element(a.mElements[i].mIndex, bits));
+    }
+    i++;
+  }
+  mElements.swap(result);
+}
+
+bool SparseBitVector::intersects(const SparseBitVector& other) const
+{
+  unsigned int i = 0, j = 0;
+  while (i < mElements.size() && j < other.mElements.size()) {
+    if (mElements[i].mIndex < other.mElements[j].mIndex) {
+      i++;
+    } else if (other.mElements[j].mIndex < mElements[i].mIndex) {
+      j++;
+    } else {
+      if (mElements[i].mBits & other.mElements[j].mBits) { return true; }
+      i++; j++;
+    }
+  }
+  return false;
+}
+
+bool SparseBitVector::contains(const SparseBitVector& other) const
+{
+  unsigned int i = 0, j = 0;
+  while (j < other.mElements.size()) {
+    while (i < mElements.size()
+           && mElements[i].mIndex < other.mElements[j].mIndex)
+    {
+      i++;
+    }
+    if (i == mElements.size()
+        || mElements[i].mIndex != other.mElements[j].mIndex
+        || (other.mElements[j].mBits & ~mElements[i].mBits) != 0)
+    {
+      return false;
+    }
+    j++;
+  }
+  return true;
+}
+
+bool SparseBitVector::operator==(const SparseBitVector& other) const
+{
+  return mElements == other.mElements;
+}
+
+bool SparseBitVector::operator<(const SparseBitVector& other) const
+{
+  unsigned int n = mElements.size() < other.mElements.size()
+                   ? mElements.size() : other.mElements.size();
+  for (unsigned int i = 0; i < n; i++) {
+    if (mElements[i].mIndex != other.mElements[i].mIndex) {
+      return mElements[i].mIndex < other.mElements[i].mIndex;
+    }
+    if (mElements[i].mBits != other.mElements[i].mBits) {
+      return mElements[i].mBits < other.mElements[i].mBits;
+    }
+  }
+  return mElements.size() < other.mElements.size();
+}
+
+void SparseBitVector::getBits(std::vector<unsigned int>& result) const
+{
+  for (SparseBitVectorIterator iter(*this); iter.isValid(); ++iter) {
+    result.push_back(iter.current());
+  }
+}
+
+//*********************************************************************
+// class SparseBitVectorIterator
+//*********************************************************************
+
+SparseBitVectorIterator::SparseBitVectorIterator(const SparseBitVector& bv)
+  : mBV(bv)
+{
+  reset();
+}
+
+void SparseBitVectorIterator::reset()
+{
+  mElem = 0;
+  mRemaining = mBV.mElements.empty() ? 0 : mBV.mElements[0].mBits;
+  settle();
+}
+
+void SparseBitVectorIterator::operator++()
+{
+  if (!isValid()) { return; }
+  // drop the lowest bit
+  mRemaining &= mRemaining - 1;
+  settle();
+}
+
+void SparseBitVectorIterator::settle()
+{
+  while (mRemaining == 0) {
+    mElem++;
+    if (mElem >= mBV.mElements.size()) { return; }
+    mRemaining = mBV.mElements[mElem].mBits;
+  }
+  mCurrent = mBV.mElements[mElem].mIndex * SparseBitVector::BITS_PER_WORD
+             + lowestBit(mRemaining);
+}
+
+} // end of namespace OA
@@ -0,0 +1,109 @@
+/*! \file
+
+  \brief Declarations for a bit vector that only stores its nonzero words.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+  Meant for sets of small integer ids, such as the objects in a
+  points-to set, where most sets are small but the id space is large.
+  The nonzero words are kept sorted by position, so set operations
+  are a merge over the words of both operands.
+*/
+
+#ifndef SparseBitVector_H
+#define SparseBitVector_H
+
+#include <vector>
+
+namespace OA {
+
+class SparseBitVectorIterator;
+
+class SparseBitVector {
+public:
+  SparseBitVector() {}
+  ~SparseBitVector() {}
+
+  //! whether bit i is set
+  bool test(unsigned int i) const;
+  //! sets bit i, returns true if it was not set before
+  bool set(unsigned int i);
+  //! clears bit i
+  void reset(unsigned int i);
+  void clear() { mElements.clear(); }
+
+  bool empty() const { return mElements.empty(); }
+  //! number of bits set
+  unsigned int count() const;
+
+  //! this = this | other, returns true if this changed
+  bool unionWith(const SparseBitVector& other);
+  //! this = this & other
+  void intersectWith(const SparseBitVector& other);
+  //! this = a & ~b
+  void setDifference(const SparseBitVector& a, const SparseBitVector& b);
+
+  //! whether this and other have a bit in common
+  bool intersects(const SparseBitVector& other) const;
+  //! whether every bit of other is set in this
+  bool contains(const SparseBitVector& other) const;
+
+  bool operator==(const SparseBitVector& other) const;
+  bool operator!=(const SparseBitVector& other) const
+    { return !(*this == other); }
+  //! some total order, so bit vectors can be map keys
+  bool operator<(const SparseBitVector& other) const;
+
+  //! appends the bits that are set to result in increasing order
+  void getBits(std::vector<unsigned int>& result) const;
+
+private:
+  typedef unsigned long Word;
+  static const unsigned int BITS_PER_WORD = sizeof(Word)*8;
+
+  struct Element {
+    Element(unsigned int index, Word bits) : mIndex(index), mBits(bits) {}
+    bool operator==(const Element& other) const
+      { return mIndex==other.mIndex && mBits==other.mBits; }
+    unsigned int mIndex; // bit position of the word / BITS_PER_WORD
+    Word mBits;
+  };
+
+  //! position of the first element with mIndex >= index
+  unsigned int lowerBound(unsigned int index) const;
+
+  // sorted by mIndex, never holds a zero word
+  std::vector<Element> mElements;
+
+  friend class SparseBitVectorIterator;
+};
+
+//! iterates over the bits set in a SparseBitVector in increasing
+//! order, the bit vector must not change while iterating
+class SparseBitVectorIterator {
+public:
+  SparseBitVectorIterator(const SparseBitVector& bv);
+  ~SparseBitVectorIterator() {}
+
+  bool isValid() const { return mElem < mBV.mElements.size(); }
+  unsigned int current() const { return mCurrent; }
+  void operator++();
+  void reset();
+
+private:
+  //! moves to the lowest bit of mRemaining, or the next element
+  void settle();
+
+  const SparseBitVector& mBV;
+  unsigned int mElem;
+  SparseBitVector::Word mRemaining;
+  unsigned int mCurrent;
+};
+
+} // end of OA namespace
+
+#endif
@@ -0,0 +1,156 @@
+/*! \file
+
+  \brief Implementation of ThreadPool and the locking primitives.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+*/
+
+#include "ThreadPool.hpp"
+#include <cstdlib>
+
+namespace OA {
+
+//*****************************************************************
+// Mutex and CondVar
+//*****************************************************************
+#ifdef OA_ENABLE_THREADS
+
+Mutex::Mutex() { pthread_mutex_init(&mMutex, NULL); }
+Mutex::~Mutex() { pthread_mutex_destroy(&mMutex); }
+void Mutex::lock() { pthread_mutex_lock(&mMutex); }
+void Mutex::unlock() { pthread_mutex_unlock(&mMutex); }
+
+CondVar::CondVar() { pthread_cond_init(&mCond, NULL); }
+CondVar::~CondVar() { pthread_cond_destroy(&mCond); }
+void CondVar::wait(Mutex& m) { pthread_cond_wait(&mCond, &m.mMutex); }
+void CondVar::signal() { pthread_cond_signal(&mCond); }
+void CondVar::broadcast() { pthread_cond_broadcast(&mCond); }
+
+#else
+
+Mutex::Mutex() {}
+Mutex::~Mutex() {}
+void Mutex::lock() {}
+void Mutex::unlock() {}
+
+CondVar::CondVar() {}
+CondVar::~CondVar() {}
+void CondVar::wait(Mutex&) {}
+void CondVar::signal() {}
+void CondVar::broadcast() {}
+
+#endif
+
+//*****************************************************************
+// ThreadPool
+//*****************************************************************
+unsigned int ThreadPool::defaultNumThreads()
+{
+#ifdef OA_ENABLE_THREADS
+    const char* env = getenv("OA_NUM_THREADS");
+    if (env != NULL) {
+        int n = atoi(env);
+        if (n > 0) { return n; }
+    }
+#endif
+    return 1;
+}
+
+ThreadPool::ThreadPool(unsigned int numThreads)
+    : mNumThreads(numThreads), mNumRunning(0), mShutdown(false)
+{
+    if (mNumThreads == 0) { mNumThreads = defaultNumThreads(); }
+#ifdef OA_ENABLE_THREADS
+    // with a single thread it is cheaper to run the tasks in add()
+    if (mNumThreads > 1) {
+        mThreads.resize(mNumThreads);
+        for (unsigned int i=0; i<mNumThreads; i++) {
+            pthread_create(&mThreads[i], NULL, &ThreadPool::workerStart, this);
+        }
+    }
+#else
+    mNumThreads = 1;
+#endif
+}
+
+ThreadPool::~ThreadPool()
+{
+#ifdef OA_ENABLE_THREADS
+    if (!mThreads.empty()) {
+        {
+            MutexLock guard(mLock);
+            mShutdown = true;
+            mWorkReady.broadcast();
+        }
+        std::vector<pthread_t>::iterator iter;
+        for (iter=mThreads.begin(); iter!=mThreads.end(); iter++) {
+            pthread_join(*iter, NULL);
+        }
+    }
+#endif
+}
+
+void ThreadPool::add(OA_ptr<ThreadTask> task)
+{
+#ifdef OA_ENABLE_THREADS
+    if (!mThreads.empty()) {
+        MutexLock guard(mLock);
+        mQueue.push_back(task);
+        mWorkReady.signal();
+        return;
+    }
+#endif
+    task->run();
+}
+
+void ThreadPool::wait()
+{
+#ifdef OA_ENABLE_THREADS
+    if (!mThreads.empty()) {
+        MutexLock guard(mLock);
+        while (!mQueue.empty() || mNumRunning > 0) {
+            mWorkDone.wait(mLock);
+        }
+    }
+#endif
+}
+
+#ifdef OA_ENABLE_THREADS
+void* ThreadPool::workerStart(void* pool)
+{
+    static_cast<ThreadPool*>(pool)->workerLoop();
+    return NULL;
+}
+
+void ThreadPool::workerLoop()
+{
+    mLock.lock();
+    while (true) {
+        while (mQueue.empty() && !mShutdown) {
+            mWorkReady.wait(mLock);
+        }
+        if (mQueue.empty()) { break; }
+
+        OA_ptr<ThreadTask> task = mQueue.front();
+        mQueue.pop_front();
+        mNumRunning++;
+        mLock.unlock();
+
+        task->run();
+        task = NULL;
+
+        mLock.lock();
+        mNumRunning--;
+        if (mQueue.empty() && mNumRunning == 0) {
+            mWorkDone.broadcast();
+        }
+    }
+    mLock.unlock();
+}
+#endif
+
+} // end of OA namespace
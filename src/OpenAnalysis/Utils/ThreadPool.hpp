@@ -0,0 +1,141 @@
+/*! \file
+
+  \brief Declarations for a simple pool of worker threads and the
+         locking primitives the parallel analysis drivers use.
+
+  \authors agent
+
+  Copyright (c) 2026, Contributors <br>
+  All rights reserved. <br>
+  See ../../../Copyright.txt for details. <br>
+
+  Threads are only used when the library and its clients are compiled
+  with -DOA_ENABLE_THREADS and linked with -lpthread.  Otherwise the
+  locks do nothing and a ThreadPool runs its tasks one after another
+  in the calling thread, in the order they were added.
+
+  Running analyses on more than one thread also requires that the
+  IRInterface given to them can answer queries concurrently.
+*/
+
+#ifndef ThreadPool_H
+#define ThreadPool_H
+
+#include <list>
+#include <vector>
+#include <OpenAnalysis/Utils/OA_ptr.hpp>
+
+#ifdef OA_ENABLE_THREADS
+# include <pthread.h>
+#endif
+
+namespace OA {
+
+//! mutual exclusion lock
+class Mutex {
+public:
+  Mutex();
+  ~Mutex();
+  void lock();
+  void unlock();
+
+private:
+  Mutex(const Mutex&);
+  Mutex& operator=(const Mutex&);
+#ifdef OA_ENABLE_THREADS
+  pthread_mutex_t mMutex;
+  friend class CondVar;
+#endif
+};
+
+//! holds a Mutex for the lifetime of the object
+class MutexLock {
+public:
+  MutexLock(Mutex& m) : mMutex(m) { mMutex.lock(); }
+  ~MutexLock() { mMutex.unlock(); }
+
+private:
+  Mutex& mMutex;
+};
+
+//! condition variable, used with a Mutex that the caller holds
+class CondVar {
+public:
+  CondVar();
+  ~CondVar();
+  //! Without threads this returns at once: callers wait in a loop on
+  //! state only another thread could be changing, so the loop is
+  //! never entered.
+  void wait(Mutex& m);
+  void signal();
+  void broadcast();
+
+private:
+  CondVar(const CondVar&);
+  CondVar& operator=(const CondVar&);
+#ifdef OA_ENABLE_THREADS
+  pthread_cond_t mCond;
+#endif
+};
+
+//! unit of work for a ThreadPool
+class ThreadTask {
+public:
+  ThreadTask() {}
+  virtual ~ThreadTask() {}
+  virtual void run() = 0;
+};
+
+/*!
+   Fixed set of worker threads that run ThreadTasks.
+
+   Example usage:
+
+     OA::ThreadPool pool(4);
+     for (...) { OA_ptr<ThreadTask> t; t = new MyTask(...); pool.add(t); }
+     pool.wait();   // all added tasks have finished
+
+   Tasks must not throw.  Results should be written to storage owned
+   by the task, or to storage protected by a Mutex, and merged by the
+   caller after wait().
+*/
+class ThreadPool {
+public:
+  //! numThreads of 0 means use defaultNumThreads()
+  ThreadPool(unsigned int numThreads = 0);
+  ~ThreadPool();
+
+  //! queue up a task, it may start running right away
+  void add(OA_ptr<ThreadTask> task);
+
+  //! returns once all tasks added so far have finished
+  void wait();
+
+  unsigned int getNumThreads() const { return mNumThreads; }
+
+  //! number of threads from the OA_NUM_THREADS environment
+  //! variable, or 1 if not set or threads are not enabled
+  static unsigned int defaultNumThreads();
+
+private:
+  ThreadPool(const ThreadPool&);
+  ThreadPool& operator=(const ThreadPool&);
+
+#ifdef OA_ENABLE_THREADS
+  void workerLoop();
+  static void* workerStart(void* pool);
+  std::vector<pthread_t> mThreads;
+#endif
+
+  unsigned int mNumThreads;
+  std::list<OA_ptr<ThreadTask> > mQueue;
+  unsigned int mNumRunning;
+  bool mShutdown;
+  Mutex mLock;
+  CondVar mWorkReady;
+  CondVar mWorkDone;
+};
+
+} // end of OA namespace
+
+#endif
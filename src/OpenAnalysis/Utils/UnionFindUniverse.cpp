@@ -13,47 +13,18 @@
 
 
   UNION-FIND algorithm from Aho, Hopcroft & Ullman,
-  The Design and Analysis of Computer Algorithms, Addison Wesley 1974
+  The Design and Analysis of Computer Algorithms, Addison Wesley 1974,
+  with union by rank and path halving (Tarjan and van Leeuwen,
+  Worst-case analysis of set union algorithms, JACM 1984).
 */
 
 
  
 #include "UnionFindUniverse.hpp"
-
-
-#define UF_NIL -1
+#include <cassert>
 
 namespace OA {
 
-//***********************************************************************************************
-// internal class UnionFindElement
-//***********************************************************************************************
-
-class UnionFindElement {
-public:
-  UnionFindElement() { };
-
-  int &Count() { return count; };
-  int &Root() { return root; };
-  int &Parent() { return parent; }
-  int &Name() { return name; }
-  void Init(int i); 
-private:
-  int parent; 
-  int name;
-  int count;
-  int root;
-};
-
-
-void UnionFindElement::Init(int i) 
-{
-  name = root = i; 
-  parent = UF_NIL;
-  count = 1;
-}
-	
-
 //***********************************************************************************************
 // class UnionFindUniverse interface operations
 //***********************************************************************************************
@@ -61,28 +32,27 @@ void UnionFindElement::Init(int i)
 
 UnionFindUniverse::UnionFindUniverse(unsigned int highWaterMark)
 {
-  e = new UnionFindElement[highWaterMark];
-
-  for (unsigned int i = 0; i < highWaterMark; i++) {
-    e[i].Init(i);
+  mParent.reserve(highWaterMark);
+  mRank.reserve(highWaterMark);
+  mName.reserve(highWaterMark);
+  mRoot.reserve(highWaterMark);
+  if (highWaterMark > 0) {
+    grow(highWaterMark-1);
   }
 }
 
 UnionFindUniverse::~UnionFindUniverse()
 {
-  if (e)
-    delete [] e;
 }
 
 
 int UnionFindUniverse::Find(int v)
 {
-  if (Parent(v) == UF_NIL)
-    return Name(v);
-
-  Parent(v) = do_FIND(Parent(v));
-
-  return Name(Parent(v));
+  assert(v >= 0);
+  if (v >= (int)mParent.size()) {
+    return v;
+  }
+  return mName[findRoot(v)];
 }
 
 
@@ -91,54 +61,102 @@ void UnionFindUniverse::Union(int i, int j, int k)
   if ((i == j) && (j == k))
     return;
 
+  grow(i > j ? (i > k ? i : k) : (j > k ? j : k));
+
   int large, small;
-  if (Count(Root(i)) > Count(Root(j))) {
-    large = Root(i);
-    small = Root(j);
+  if (mRank[mRoot[i]] > mRank[mRoot[j]]) {
+    large = mRoot[i];
+    small = mRoot[j];
   } else {
-    large = Root(j);
-    small = Root(i);
+    large = mRoot[j];
+    small = mRoot[i];
   }
 
-  Parent(small) = large;
-  Count(large) += Count(small);
-  Name(large) = k;
-  Root(k) = large; 
+  if (large != small) {
+    mParent[small] = large;
+    if (mRank[large] == mRank[small]) {
+      mRank[large]++;
+    }
+  }
+  mName[large] = k;
+  mRoot[k] = large; 
 }
 
 
-
-//***********************************************************************************************
-// class UnionFindUniverse private operations
-//***********************************************************************************************
-
-int UnionFindUniverse::do_FIND(int v)
+int UnionFindUniverse::unionMany(const std::vector<int>& elems)
 {
-  if (Parent(v) == UF_NIL)
-    return v;
-
-  Parent(v) = do_FIND(Parent(v));
-
-  return Parent(v);
+  if (elems.empty()) { return -1; }
+
+  int name = Find(elems[0]);
+  std::vector<int>::const_iterator iter;
+  for (iter=elems.begin(); iter!=elems.end(); iter++) {
+    int other = Find(*iter);
+    if (other != name) {
+      Union(name, other, name);
+    }
+  }
+  return name;
 }
 
-int &UnionFindUniverse::Count(int i) 
+
+void UnionFindUniverse::canonicalize()
 {
-  return e[i].Count();
+  // parents can have a larger index, so find each root first
+  int n = mParent.size();
+  for (int v = 0; v < n; v++) {
+    mParent[v] = findRoot(v);
+  }
 }
 
-int &UnionFindUniverse::Root(int i) 
+
+void UnionFindUniverse::load(const std::vector<int>& sets)
 {
-  return e[i].Root();
+  int n = sets.size();
+  if (n > 0) { grow(n-1); }
+
+  // each set is rooted at the element it is named after, everything
+  // else points straight at it
+  int size = mParent.size();
+  for (int v = 0; v < size; v++) {
+    mParent[v] = mName[v] = mRoot[v] = v;
+    mRank[v] = 0;
+  }
+  for (int v = 0; v < n; v++) {
+    int name = sets[v];
+    assert(name >= 0 && name < n && sets[name] == name);
+    if (name != v) {
+      mParent[v] = name;
+      mRank[name] = 1;
+    }
+  }
 }
-int &UnionFindUniverse::Parent(int i) 
+
+
+//***********************************************************************************************
+// class UnionFindUniverse private operations
+//***********************************************************************************************
+
+void UnionFindUniverse::grow(int i)
 {
-  return e[i].Parent();
+  int n = mParent.size();
+  if (i < n) { return; }
+
+  mParent.resize(i+1);
+  mRank.resize(i+1, 0);
+  mName.resize(i+1);
+  mRoot.resize(i+1);
+  for (int v = n; v <= i; v++) {
+    mParent[v] = mName[v] = mRoot[v] = v;
+  }
 }
 
-int &UnionFindUniverse::Name(int i) 
+int UnionFindUniverse::findRoot(int v)
 {
-  return e[i].Name();
+  while (mParent[v] != v) {
+    mParent[v] = mParent[mParent[v]];
+    v = mParent[v];
+  }
+  return v;
 }
 
 } // end of namespace OA
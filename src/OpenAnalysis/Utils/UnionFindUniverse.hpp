@@ -15,9 +15,9 @@
 #ifndef UnionFindUniverse_H
 #define UnionFindUniverse_H
 
-namespace OA {
+#include <vector>
 
-class UnionFindElement;
+namespace OA {
 
 /*!
    Here is example usage of this class:
@@ -26,6 +26,11 @@ class UnionFindElement;
 
    ufset.Union( ufset.Find(1), ufset.Find(5), ufset.Find(5) )
 
+   The universe grows as needed, any element or set name past the
+   current size is added as a singleton set named after itself, so
+   highWaterMark is only a hint.  Sets are unioned by rank and Find
+   halves the paths it walks, so a sequence of operations takes
+   nearly linear time and no recursion.
 */
 
 class UnionFindUniverse {
@@ -39,18 +44,39 @@ public:
   //! returns what set i is in
   int Find(int i);
 
+  //! merges the sets of all the elements, the result keeps the
+  //! name of the set that the first element is in, which is returned
+  int unionMany(const std::vector<int>& elems);
+
+  //! points every element directly at the root of its set, so that
+  //! following Finds take one step until the next Union
+  void canonicalize();
+
+  //! replaces the sets with the ones in sets, which puts each element
+  //! i < sets.size() in the set named sets[i].  The element naming a
+  //! set has to name its own set, sets[sets[i]] == sets[i].  Any
+  //! other element is left in a set of its own.  Takes one step per
+  //! element rather than a Union per member.
+  void load(const std::vector<int>& sets);
+
+  //! number of elements in the universe
+  unsigned int size() const { return mParent.size(); }
+
 private: // methods
-  int &Count(int i);
-  int &Root(int i);
-  int &Parent(int i);
-  int &Name(int i);
-  int do_FIND(int i);
+  //! make sure that element i is in the universe
+  void grow(int i);
+  //! returns the root element of the set v is in
+  int findRoot(int v);
 
 private: // data
-  UnionFindElement *e;
+  // one entry per element
+  std::vector<int> mParent;         // the element itself for a root
+  std::vector<unsigned char> mRank; // only maintained for roots
+  std::vector<int> mName;           // only maintained for roots
+  // one entry per set name
+  std::vector<int> mRoot;
 };
  
 } // end of OA namespace
 
 #endif
-
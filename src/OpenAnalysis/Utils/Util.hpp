@@ -28,6 +28,19 @@
 # define OA_MAX(a,b) (((a) > (b)) ? (a) : (b))
 #endif
 
+// Counters shared between threads (reference counts, id generators).
+// They are only atomic when compiled with -DOA_ENABLE_THREADS, see
+// ThreadPool.hpp.  OA_ATOMIC_DEC_AND_FETCH evaluates to the new value.
+#ifdef OA_ENABLE_THREADS
+# define OA_ATOMIC_INC(x) ((void)__sync_add_and_fetch(&(x), 1))
+# define OA_ATOMIC_DEC_AND_FETCH(x) (__sync_sub_and_fetch(&(x), 1))
+# define OA_ATOMIC_FETCH_AND_INC(x) (__sync_fetch_and_add(&(x), 1))
+#else
+# define OA_ATOMIC_INC(x) ((void)++(x))
+# define OA_ATOMIC_DEC_AND_FETCH(x) (--(x))
+# define OA_ATOMIC_FETCH_AND_INC(x) ((x)++)
+#endif
+
 /* 
 Debugging macro
 